@@ -0,0 +1,1802 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Assets/ArenaPaletteName.h"
+#include "Assets/ArenaTypes.h"
+#include "Assets/BinaryAssetLibrary.h"
+#include "Assets/ExeData.h"
+#include "Assets/MIFFile.h"
+#include "Assets/TextAssetLibrary.h"
+#include "Game/Clock.h"
+#include "Entities/CharacterClassLibrary.h"
+#include "Entities/EntityDefinitionLibrary.h"
+#include "Entities/EntityManager.h"
+#include "Entities/EntityType.h"
+#include "Entities/Player.h"
+#include "Game/GameData.h"
+#include "Game/Options.h"
+#include "Math/Constants.h"
+#include "Math/Random.h"
+#include "Interface/Surface.h"
+#include "Media/TextureManager.h"
+#include "Rendering/Renderer.h"
+#include "Rendering/RendererSystemType.h"
+#include "Rendering/SoftwareRenderer.h"
+#include "Utilities/Platform.h"
+#include "World/ArenaWildUtils.h"
+#include "World/ChunkManager.h"
+#include "World/LocationDefinition.h"
+#include "World/LevelInstance.h"
+#include "World/LocationUtils.h"
+#include "World/MapDefinition.h"
+#include "World/MapGeneration.h"
+#include "World/MapType.h"
+#include "World/ProvinceDefinition.h"
+#include "World/SkyGeneration.h"
+#include "World/SkyUtils.h"
+#include "World/VoxelDefinition.h"
+#include "World/VoxelGrid.h"
+#include "World/VoxelType.h"
+#include "World/WeatherType.h"
+#include "World/WeatherUtils.h"
+#include "World/WorldData.h"
+#include "World/WorldMapDefinition.h"
+
+#include "SDL.h"
+
+#include "components/debug/Debug.h"
+#include "components/utilities/Buffer.h"
+#include "components/utilities/File.h"
+#include "components/utilities/String.h"
+#include "components/vfs/manager.hpp"
+
+// Headless benchmark for the 3D renderer. Loads a level from the Arena data, moves the camera
+// along a fixed path, and renders each frame into a plain buffer without opening a window. The
+// per-frame and per-phase timings are written as CSV or JSON so runs can be compared.
+
+// With --golden, it instead renders a fixed set of scenes and camera poses and compares them against
+// reference images, so changes to the renderer can be checked for visual differences.
+
+// With --kernel-diff, it renders the same scenes and poses plus steep floor and ceiling poses with
+// each column shader kernel the CPU supports and checks that they match the scalar kernel exactly.
+
+// With --chunk-stress, it moves the chunk manager's center across many chunk boundaries and reports
+// chunk look-ups per second and how many chunks were allocated.
+
+// With --chunk-delta, it changes a chunk, moves away until the chunk is recycled, visits another
+// map, moves back, and checks that the changes were restored.
+
+// With --voxel-storage, it loads the city and the wilderness and reports the memory used by their
+// compressed voxels and the throughput of VoxelGrid::getVoxel() compared to a dense array.
+
+// With --texture-lookups, it times voxel texture look-ups through the renderer's resolved texture
+// handles against the asset reference comparisons they replaced.
+
+// With --wild-walk, it walks the level update path across the wilderness and checks that the wild
+// block cache stays within the number of chunks in range.
+
+namespace
+{
+	enum class BenchScene { City, Interior, Wilderness };
+	enum class BenchFormat { CSV, JSON };
+
+	struct BenchSettings
+	{
+		std::string arenaPath; // Empty if the options file's ArenaPath should be used.
+		std::string mifName; // Interior .MIF when benchmarking an interior.
+		std::string outputPath; // Empty for standard output.
+		std::string goldenPath; // Reference image folder. Empty unless comparing against references.
+		BenchScene scene;
+		BenchFormat format;
+		int width, height;
+		int warmupFrames, frameCount;
+		int renderThreadsMode;
+		int seed;
+		int hour; // Time of day after the level is loaded.
+		int tolerance; // Largest per-channel difference that still counts as a matching pixel.
+		int maxBadPixels; // Mismatched pixels allowed per reference image.
+		int chunkStressSteps; // Chunk boundaries to cross. Zero unless stress testing the chunk manager.
+		int chunkDeltaVoxels; // Voxels to change. Zero unless testing chunk change persistence.
+		int voxelReadMillions; // Random voxel reads per scene. Zero unless measuring voxel storage.
+		int textureLookupMillions; // Voxel texture look-ups per scene. Zero unless measuring them.
+		int wildWalkSteps; // Wild chunk boundaries to cross. Zero unless walking the wilderness.
+		bool updateGolden; // Whether to write new reference images instead of comparing.
+		bool kernelDiff; // Whether to compare column shader kernels against each other.
+
+		BenchSettings()
+		{
+			this->mifName = "START.MIF";
+			this->scene = BenchScene::City;
+			this->format = BenchFormat::CSV;
+			this->width = 1280;
+			this->height = 720;
+			this->warmupFrames = 30;
+			this->frameCount = 300;
+			this->renderThreadsMode = Options::MAX_RENDER_THREADS_MODE;
+			this->seed = 0;
+			this->hour = 12;
+			this->tolerance = 2;
+			this->maxBadPixels = 0;
+			this->chunkStressSteps = 0;
+			this->chunkDeltaVoxels = 0;
+			this->voxelReadMillions = 0;
+			this->textureLookupMillions = 0;
+			this->wildWalkSteps = 0;
+			this->updateGolden = false;
+			this->kernelDiff = false;
+		}
+	};
+
+	// Timings of one recorded frame, in seconds.
+	struct BenchFrame
+	{
+		double frameTime, visibilityTime, skyTime, distantSkyTime, voxelTime, flatTime;
+		int visFlatCount, visLightCount;
+		int flatShadingHitCount, flatShadingMissCount;
+	};
+
+	// The camera walks a circle of this radius (in voxels) that passes through the player's start
+	// point, looking along the direction of travel so one lap sees the whole level around it.
+	constexpr double PathRadius = 2.0;
+	constexpr double PathPitchAmplitude = 0.25;
+
+	// Scenes and camera poses rendered for reference images. Entries should only be appended since
+	// changing one invalidates existing references.
+	struct GoldenScene
+	{
+		const char *name;
+		BenchScene scene;
+		int hour;
+	};
+
+	struct GoldenPose
+	{
+		double yawDegrees, pitch;
+	};
+
+	constexpr GoldenScene GoldenScenes[] =
+	{
+		{ "interior", BenchScene::Interior, 12 },
+		{ "city_noon", BenchScene::City, 12 },
+		{ "city_night", BenchScene::City, 0 },
+		{ "wilderness", BenchScene::Wilderness, 12 }
+	};
+
+	// Written next to reference images and checked before comparing. Bumped when the benchmark's
+	// level setup changes in a way that makes existing references wrong, rather than the renderer.
+	// - 2: the clock is set before loading, so night scenes have their night lights.
+	constexpr int GoldenVersion = 2;
+	constexpr const char *GoldenVersionFilename = "version.txt";
+
+	// Renderer storage and shading formats chosen at build time. Written after the version so a
+	// comparison between builds with different formats (i.e., float and 16-bit depth) says what it's
+	// comparing.
+	struct BuildFormat
+	{
+		const char *name, *value;
+	};
+
+	constexpr BuildFormat BuildFormats[] =
+	{
+#if defined(TES_DEPTH_TEXEL_UINT16)
+		{ "depth_texel", "uint16" },
+#else
+		{ "depth_texel", "float" },
+#endif
+#if defined(TES_SHADING_DOUBLE)
+		{ "shading_real", "double" }
+#else
+		{ "shading_real", "float" }
+#endif
+	};
+
+	constexpr GoldenPose GoldenPoses[] =
+	{
+		{ 0.0, 0.0 },
+		{ 90.0, 0.0 },
+		{ 180.0, 0.0 },
+		{ 270.0, 0.0 },
+		{ 45.0, 0.35 },
+		{ 225.0, -0.35 }
+	};
+
+	// Extra poses for comparing column kernels, looking steeply down and up so most of the screen is
+	// perspective floors and ceilings (and chasms, where a scene has them). They aren't golden poses
+	// so they don't need references.
+	constexpr GoldenPose KernelDiffPoses[] =
+	{
+		{ 30.0, -0.85 },
+		{ 210.0, 0.85 }
+	};
+
+	// Assets and renderer shared by every level the benchmark loads.
+	struct BenchContext
+	{
+		Options options;
+		BinaryAssetLibrary binaryAssetLibrary;
+		TextAssetLibrary textAssetLibrary;
+		CharacterClassLibrary charClassLibrary;
+		TextureManager textureManager;
+		EntityDefinitionLibrary entityDefLibrary;
+		Renderer renderer;
+		const Palette *palette;
+	};
+
+	// A loaded level and the values its rendering depends on.
+	struct BenchLevel
+	{
+		std::unique_ptr<GameData> gameData;
+		const LevelData *level;
+		CoordDouble3 startPosition;
+		double latitude;
+		bool isExterior;
+	};
+
+	void printUsage()
+	{
+		std::cerr << "Usage: TESArenaBench [options]\n" <<
+			"  --help\n" <<
+			"  --arena-path <path>   Arena data folder (default: ArenaPath in options)\n" <<
+			"  --scene <city|interior|wild>\n" <<
+			"  --mif <name>          Interior .MIF file (default: START.MIF)\n" <<
+			"  --width <n> --height <n>\n" <<
+			"  --warmup <n>          Unrecorded frames before measuring\n" <<
+			"  --frames <n>          Recorded frames (one lap of the camera path)\n" <<
+			"  --threads <mode>      RenderThreadsMode, " << Options::MIN_RENDER_THREADS_MODE << "-" <<
+			Options::MAX_RENDER_THREADS_MODE << "\n" <<
+			"  --seed <n>            Seed for level generation\n" <<
+			"  --hour <n>            Time of day, 0-23 (default: 12)\n" <<
+			"  --format <csv|json>\n" <<
+			"  --output <file>       Default: standard output\n" <<
+			"  --golden <folder>     Compare fixed scenes and poses against reference images\n" <<
+			"  --update-golden <0|1> Write reference images instead of comparing\n" <<
+			"  --tolerance <n>       Per-channel difference allowed per pixel (default: 2)\n" <<
+			"  --max-bad-pixels <n>  Mismatched pixels allowed per image (default: 0)\n" <<
+			"  --kernel-diff <0|1>   Compare each supported column shader kernel against the scalar one\n" <<
+			"  --chunk-stress <n>    Move across n chunk boundaries and report chunk look-up stats\n" <<
+			"  --chunk-delta <n>     Check that n changed voxels survive a chunk being recycled\n" <<
+			"  --voxel-storage <n>   Report voxel memory and n million random voxel reads per scene\n" <<
+			"  --texture-lookups <n> Time n million voxel texture look-ups per scene, by handle and by name\n" <<
+			"  --wild-walk <n>       Move across n wild chunk boundaries and report wild block cache stats\n";
+	}
+
+	bool tryParseInt(const std::string &str, int min, int *outValue)
+	{
+		try
+		{
+			size_t index;
+			const int value = std::stoi(str, &index);
+			if ((index != str.size()) || (value < min))
+			{
+				return false;
+			}
+
+			*outValue = value;
+			return true;
+		}
+		catch (const std::exception&)
+		{
+			return false;
+		}
+	}
+
+	bool tryParseSettings(int argc, char *argv[], BenchSettings *outSettings)
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			const std::string arg(argv[i]);
+			if (arg == "--help")
+			{
+				return false;
+			}
+
+			if ((i + 1) >= argc)
+			{
+				DebugLogError("Missing value for \"" + arg + "\".");
+				return false;
+			}
+
+			const std::string value(argv[++i]);
+			bool success = true;
+			if (arg == "--arena-path")
+			{
+				outSettings->arenaPath = value;
+			}
+			else if (arg == "--scene")
+			{
+				success = (value == "city") || (value == "interior") || (value == "wild");
+				outSettings->scene = (value == "interior") ? BenchScene::Interior :
+					((value == "wild") ? BenchScene::Wilderness : BenchScene::City);
+			}
+			else if (arg == "--mif")
+			{
+				outSettings->mifName = value;
+			}
+			else if (arg == "--width")
+			{
+				success = tryParseInt(value, 1, &outSettings->width);
+			}
+			else if (arg == "--height")
+			{
+				success = tryParseInt(value, 1, &outSettings->height);
+			}
+			else if (arg == "--warmup")
+			{
+				success = tryParseInt(value, 0, &outSettings->warmupFrames);
+			}
+			else if (arg == "--frames")
+			{
+				success = tryParseInt(value, 1, &outSettings->frameCount);
+			}
+			else if (arg == "--threads")
+			{
+				success = tryParseInt(value, Options::MIN_RENDER_THREADS_MODE, &outSettings->renderThreadsMode) &&
+					(outSettings->renderThreadsMode <= Options::MAX_RENDER_THREADS_MODE);
+			}
+			else if (arg == "--seed")
+			{
+				success = tryParseInt(value, 0, &outSettings->seed);
+			}
+			else if (arg == "--hour")
+			{
+				success = tryParseInt(value, 0, &outSettings->hour) && (outSettings->hour < 24);
+			}
+			else if (arg == "--golden")
+			{
+				outSettings->goldenPath = String::addTrailingSlashIfMissing(value);
+			}
+			else if (arg == "--update-golden")
+			{
+				success = (value == "0") || (value == "1");
+				outSettings->updateGolden = value == "1";
+			}
+			else if (arg == "--kernel-diff")
+			{
+				success = (value == "0") || (value == "1");
+				outSettings->kernelDiff = value == "1";
+			}
+			else if (arg == "--tolerance")
+			{
+				success = tryParseInt(value, 0, &outSettings->tolerance);
+			}
+			else if (arg == "--max-bad-pixels")
+			{
+				success = tryParseInt(value, 0, &outSettings->maxBadPixels);
+			}
+			else if (arg == "--chunk-stress")
+			{
+				success = tryParseInt(value, 1, &outSettings->chunkStressSteps);
+			}
+			else if (arg == "--chunk-delta")
+			{
+				success = tryParseInt(value, 1, &outSettings->chunkDeltaVoxels);
+			}
+			else if (arg == "--voxel-storage")
+			{
+				success = tryParseInt(value, 1, &outSettings->voxelReadMillions);
+			}
+			else if (arg == "--texture-lookups")
+			{
+				// Look-up counts are ints.
+				success = tryParseInt(value, 1, &outSettings->textureLookupMillions) &&
+					(outSettings->textureLookupMillions <= 2000);
+			}
+			else if (arg == "--wild-walk")
+			{
+				success = tryParseInt(value, 1, &outSettings->wildWalkSteps);
+			}
+			else if (arg == "--format")
+			{
+				success = (value == "csv") || (value == "json");
+				outSettings->format = (value == "json") ? BenchFormat::JSON : BenchFormat::CSV;
+			}
+			else if (arg == "--output")
+			{
+				outSettings->outputPath = value;
+			}
+			else
+			{
+				DebugLogError("Unrecognized argument \"" + arg + "\".");
+				return false;
+			}
+
+			if (!success)
+			{
+				DebugLogError("Invalid value \"" + value + "\" for \"" + arg + "\".");
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Same location the main menu's test city uses, so it's a premade city with no randomness in
+	// its layout.
+	const LocationDefinition *findImperialCityLocation(const ProvinceDefinition &provinceDef)
+	{
+		for (int i = 0; i < provinceDef.getLocationCount(); i++)
+		{
+			const LocationDefinition &locationDef = provinceDef.getLocationDef(i);
+			if (locationDef.getType() == LocationDefinition::Type::City)
+			{
+				const LocationDefinition::CityDefinition &cityDef = locationDef.getCityDefinition();
+				if ((cityDef.type == LocationDefinition::CityDefinition::Type::CityState) &&
+					cityDef.premade && cityDef.palaceIsMainQuestDungeon)
+				{
+					return &locationDef;
+				}
+			}
+		}
+
+		return nullptr;
+	}
+
+	std::string getSceneName(const BenchSettings &settings)
+	{
+		switch (settings.scene)
+		{
+		case BenchScene::City:
+			return "city";
+		case BenchScene::Wilderness:
+			return "wild";
+		default:
+			return settings.mifName;
+		}
+	}
+
+	double toMilliseconds(double seconds)
+	{
+		return seconds * 1000.0;
+	}
+
+	void writeCSV(std::ostream &stream, const std::vector<BenchFrame> &frames)
+	{
+		stream << "frame,total_ms,visibility_ms,sky_ms,distant_sky_ms,voxels_ms,flats_ms,vis_flats,vis_lights," <<
+			"flat_table_hits,flat_table_misses\n";
+		for (size_t i = 0; i < frames.size(); i++)
+		{
+			const BenchFrame &frame = frames[i];
+			stream << i << ',' <<
+				String::fixedPrecision(toMilliseconds(frame.frameTime), 3) << ',' <<
+				String::fixedPrecision(toMilliseconds(frame.visibilityTime), 3) << ',' <<
+				String::fixedPrecision(toMilliseconds(frame.skyTime), 3) << ',' <<
+				String::fixedPrecision(toMilliseconds(frame.distantSkyTime), 3) << ',' <<
+				String::fixedPrecision(toMilliseconds(frame.voxelTime), 3) << ',' <<
+				String::fixedPrecision(toMilliseconds(frame.flatTime), 3) << ',' <<
+				frame.visFlatCount << ',' << frame.visLightCount << ',' <<
+				frame.flatShadingHitCount << ',' << frame.flatShadingMissCount << '\n';
+		}
+	}
+
+	void writeJSON(std::ostream &stream, const BenchSettings &settings, const std::vector<BenchFrame> &frames)
+	{
+		// Averages first since they're what most comparisons look at.
+		auto getAverage = [&frames](double BenchFrame::*time)
+		{
+			double total = 0.0;
+			for (const BenchFrame &frame : frames)
+			{
+				total += frame.*time;
+			}
+
+			return toMilliseconds(total / static_cast<double>(frames.size()));
+		};
+
+		auto writeTime = [&stream](const char *name, double milliseconds, bool last)
+		{
+			stream << "\"" << name << "\": " << String::fixedPrecision(milliseconds, 3) << (last ? "" : ", ");
+		};
+
+		std::vector<double> sortedFrameTimes;
+		for (const BenchFrame &frame : frames)
+		{
+			sortedFrameTimes.emplace_back(frame.frameTime);
+		}
+
+		std::sort(sortedFrameTimes.begin(), sortedFrameTimes.end());
+		const size_t p99Index = std::min(sortedFrameTimes.size() - 1, (sortedFrameTimes.size() * 99) / 100);
+
+		// Share of flat shading table look-ups over all frames that reused a table.
+		int64_t flatShadingHitCount = 0;
+		int64_t flatShadingLookupCount = 0;
+		for (const BenchFrame &frame : frames)
+		{
+			flatShadingHitCount += frame.flatShadingHitCount;
+			flatShadingLookupCount += frame.flatShadingHitCount + frame.flatShadingMissCount;
+		}
+
+		const double flatShadingHitRate = (flatShadingLookupCount > 0) ?
+			(static_cast<double>(flatShadingHitCount) / static_cast<double>(flatShadingLookupCount)) : 0.0;
+
+		stream << "{\n";
+		stream << "  \"scene\": \"" << getSceneName(settings) << "\",\n";
+		stream << "  \"hour\": " << settings.hour << ",\n";
+		stream << "  \"width\": " << settings.width << ", \"height\": " << settings.height << ",\n";
+		stream << "  \"render_threads_mode\": " << settings.renderThreadsMode << ",\n";
+		for (const BuildFormat &buildFormat : BuildFormats)
+		{
+			stream << "  \"" << buildFormat.name << "\": \"" << buildFormat.value << "\",\n";
+		}
+
+		stream << "  \"average\": { ";
+		writeTime("total_ms", getAverage(&BenchFrame::frameTime), false);
+		writeTime("visibility_ms", getAverage(&BenchFrame::visibilityTime), false);
+		writeTime("sky_ms", getAverage(&BenchFrame::skyTime), false);
+		writeTime("distant_sky_ms", getAverage(&BenchFrame::distantSkyTime), false);
+		writeTime("voxels_ms", getAverage(&BenchFrame::voxelTime), false);
+		writeTime("flats_ms", getAverage(&BenchFrame::flatTime), true);
+		stream << " },\n";
+		stream << "  \"p99_total_ms\": " << String::fixedPrecision(toMilliseconds(sortedFrameTimes[p99Index]), 3) << ",\n";
+		stream << "  \"flat_table_hit_rate\": " << String::fixedPrecision(flatShadingHitRate, 4) << ",\n";
+		stream << "  \"frames\": [\n";
+		for (size_t i = 0; i < frames.size(); i++)
+		{
+			const BenchFrame &frame = frames[i];
+			stream << "    { ";
+			writeTime("total_ms", toMilliseconds(frame.frameTime), false);
+			writeTime("visibility_ms", toMilliseconds(frame.visibilityTime), false);
+			writeTime("sky_ms", toMilliseconds(frame.skyTime), false);
+			writeTime("distant_sky_ms", toMilliseconds(frame.distantSkyTime), false);
+			writeTime("voxels_ms", toMilliseconds(frame.voxelTime), false);
+			writeTime("flats_ms", toMilliseconds(frame.flatTime), false);
+			stream << "\"vis_flats\": " << frame.visFlatCount << ", \"vis_lights\": " << frame.visLightCount <<
+				", \"flat_table_hits\": " << frame.flatShadingHitCount << ", \"flat_table_misses\": " <<
+				frame.flatShadingMissCount << " }" << (((i + 1) < frames.size()) ? "," : "") << "\n";
+		}
+
+		stream << "  ]\n}\n";
+	}
+
+	bool tryInitContext(const BenchSettings &settings, BenchContext &context)
+	{
+		// Options are only read for paths and the gameplay values that affect rendering.
+		const std::string basePath = Platform::getBasePath();
+		Options &options = context.options;
+		options.loadDefaults(basePath + "options/" + Options::DEFAULT_FILENAME);
+
+		const std::string changesOptionsPath = Platform::getOptionsPath() + Options::CHANGES_FILENAME;
+		if (File::exists(changesOptionsPath.c_str()))
+		{
+			options.loadChanges(changesOptionsPath);
+		}
+
+		const std::string arenaPath = [&settings, &options, &basePath]()
+		{
+			const std::string path = settings.arenaPath.empty() ? options.getMisc_ArenaPath() : settings.arenaPath;
+			const bool isRelative = File::pathIsRelative(path.c_str());
+			return String::addTrailingSlashIfMissing((isRelative ? basePath : "") + path);
+		}();
+
+		VFS::Manager::get().initialize(std::string(arenaPath));
+
+		// Determine which version of the game the Arena path is pointing to.
+		bool isFloppyVersion;
+		if (File::exists((arenaPath + ExeData::CD_VERSION_EXE_FILENAME).c_str()))
+		{
+			isFloppyVersion = false;
+		}
+		else if (File::exists((arenaPath + ExeData::FLOPPY_VERSION_EXE_FILENAME).c_str()))
+		{
+			isFloppyVersion = true;
+		}
+		else
+		{
+			DebugLogError("\"" + arenaPath + "\" does not have an Arena executable.");
+			return false;
+		}
+
+		if (!context.binaryAssetLibrary.init(isFloppyVersion))
+		{
+			DebugLogError("Couldn't init binary asset library.");
+			return false;
+		}
+
+		if (!context.textAssetLibrary.init())
+		{
+			DebugLogError("Couldn't init text asset library.");
+			return false;
+		}
+
+		const ExeData &exeData = context.binaryAssetLibrary.getExeData();
+		context.charClassLibrary.init(exeData);
+		context.entityDefLibrary.init(exeData, context.textureManager);
+
+		constexpr RendererSystemType3D rendererSystemType3D = RendererSystemType3D::SoftwareClassic;
+		if (!context.renderer.initHeadless(settings.width, settings.height, rendererSystemType3D,
+			settings.renderThreadsMode))
+		{
+			DebugLogError("Couldn't init headless renderer.");
+			return false;
+		}
+
+		const std::string &defaultPaletteFilename = ArenaPaletteName::Default;
+		const std::optional<PaletteID> defaultPaletteID =
+			context.textureManager.tryGetPaletteID(defaultPaletteFilename.c_str());
+		if (!defaultPaletteID.has_value())
+		{
+			DebugLogError("Couldn't get default palette ID from \"" + defaultPaletteFilename + "\".");
+			return false;
+		}
+
+		context.palette = &context.textureManager.getPaletteHandle(*defaultPaletteID);
+		return true;
+	}
+
+	bool tryLoadLevel(const BenchSettings &settings, BenchScene scene, int hour, BenchContext &context,
+		BenchLevel *outLevel)
+	{
+		// Fixed seed so the player and any generated content are the same every run.
+		Random random(settings.seed);
+		const ExeData &exeData = context.binaryAssetLibrary.getExeData();
+		auto gameData = std::make_unique<GameData>(
+			Player::makeRandom(context.charClassLibrary, exeData, random), context.binaryAssetLibrary);
+
+		const WorldMapDefinition &worldMapDef = gameData->getWorldMapDefinition();
+		const ProvinceDefinition &provinceDef = worldMapDef.getProvinceDef(LocationUtils::CENTER_PROVINCE_ID);
+		const LocationDefinition *locationDefPtr = findImperialCityLocation(provinceDef);
+		if (locationDefPtr == nullptr)
+		{
+			DebugLogError("Couldn't find Imperial City location.");
+			return false;
+		}
+
+		// Set the clock before loading, since loading turns streetlights and the renderer's night
+		// lights on or off for the current hour.
+		gameData->getClock() = Clock(hour, 0, 0);
+
+		const int starCount = SkyUtils::getStarCountFromDensity(context.options.getMisc_StarDensity());
+		if (scene == BenchScene::City)
+		{
+			if (!gameData->loadCity(*locationDefPtr, provinceDef, WeatherType::Clear, starCount,
+				context.entityDefLibrary, context.charClassLibrary, context.binaryAssetLibrary,
+				context.textAssetLibrary, random, context.textureManager, context.renderer))
+			{
+				DebugLogError("Couldn't load city \"" + locationDefPtr->getName() + "\".");
+				return false;
+			}
+		}
+		else if (scene == BenchScene::Wilderness)
+		{
+			const LocationDefinition::CityDefinition &cityDef = locationDefPtr->getCityDefinition();
+			const WeatherType filteredWeatherType =
+				WeatherUtils::getFilteredWeatherType(WeatherType::Clear, cityDef.climateType);
+
+			const bool ignoreGatePos = true;
+			if (!gameData->loadWilderness(*locationDefPtr, provinceDef, Int2(), Int2(), ignoreGatePos,
+				filteredWeatherType, starCount, context.options.getMisc_ChunkDistance(),
+				context.entityDefLibrary, context.charClassLibrary,
+				context.binaryAssetLibrary, random, context.textureManager, context.renderer))
+			{
+				DebugLogError("Couldn't load wilderness \"" + locationDefPtr->getName() + "\".");
+				return false;
+			}
+		}
+		else
+		{
+			MIFFile mif;
+			if (!mif.init(settings.mifName.c_str()))
+			{
+				DebugLogError("Couldn't init .MIF file \"" + settings.mifName + "\".");
+				return false;
+			}
+
+			if (!gameData->loadInterior(*locationDefPtr, provinceDef, ArenaTypes::InteriorType::Dungeon,
+				mif, context.entityDefLibrary, context.charClassLibrary, context.binaryAssetLibrary,
+				random, context.textureManager, context.renderer))
+			{
+				DebugLogError("Couldn't load interior \"" + settings.mifName + "\".");
+				return false;
+			}
+		}
+
+		const WorldData &worldData = gameData->getActiveWorld();
+		outLevel->level = &worldData.getActiveLevel();
+		outLevel->isExterior = worldData.getMapType() != MapType::Interior;
+		outLevel->latitude = gameData->getLocationDefinition().getLatitude();
+		outLevel->startPosition = gameData->getPlayer().getPosition();
+		outLevel->gameData = std::move(gameData);
+		return true;
+	}
+
+	void renderView(BenchContext &context, const BenchLevel &level, const CoordDouble3 &eye,
+		const Double3 &forward, uint32_t *colorBuffer)
+	{
+		const Options &options = context.options;
+		const GameData &gameData = *level.gameData;
+		context.renderer.renderWorldOffscreen(eye, forward, options.getGraphics_VerticalFOV(),
+			gameData.getAmbientPercent(), gameData.getDaytimePercent(), gameData.getChasmAnimPercent(),
+			level.latitude, gameData.nightLightsAreActive(), level.isExterior, options.getMisc_PlayerHasLight(),
+			options.getMisc_ChunkDistance(), level.level->getCeilingHeight(), *level.level,
+			context.entityDefLibrary, *context.palette, colorBuffer);
+	}
+
+	int runBench(const BenchSettings &settings, BenchContext &context)
+	{
+		BenchLevel level;
+		if (!tryLoadLevel(settings, settings.scene, settings.hour, context, &level))
+		{
+			return EXIT_FAILURE;
+		}
+
+		Buffer<uint32_t> colorBuffer(settings.width * settings.height);
+		std::vector<BenchFrame> frames;
+		frames.reserve(settings.frameCount);
+
+		const int totalFrames = settings.warmupFrames + settings.frameCount;
+		for (int i = 0; i < totalFrames; i++)
+		{
+			// Warmup frames use the start of the path.
+			const int pathFrame = std::max(i - settings.warmupFrames, 0);
+			const double angle = Constants::TwoPi * (static_cast<double>(pathFrame) /
+				static_cast<double>(settings.frameCount));
+			const double pitch = PathPitchAmplitude * std::sin(2.0 * angle);
+			const VoxelDouble3 pathOffset(PathRadius * (1.0 - std::cos(angle)), 0.0,
+				-PathRadius * std::sin(angle));
+			const CoordDouble3 eye = level.startPosition + pathOffset;
+			const Double3 forward = Double3(std::sin(angle), pitch, -std::cos(angle)).normalized();
+			renderView(context, level, eye, forward, colorBuffer.get());
+
+			if (i >= settings.warmupFrames)
+			{
+				const Renderer::ProfilerData &profilerData = context.renderer.getProfilerData();
+				BenchFrame frame;
+				frame.frameTime = profilerData.frameTime;
+				frame.visibilityTime = profilerData.visibilityTime;
+				frame.skyTime = profilerData.skyTime;
+				frame.distantSkyTime = profilerData.distantSkyTime;
+				frame.voxelTime = profilerData.voxelTime;
+				frame.flatTime = profilerData.flatTime;
+				frame.visFlatCount = profilerData.visFlatCount;
+				frame.visLightCount = profilerData.visLightCount;
+				frame.flatShadingHitCount = profilerData.flatShadingHitCount;
+				frame.flatShadingMissCount = profilerData.flatShadingMissCount;
+				frames.emplace_back(frame);
+			}
+		}
+
+		std::ofstream outputFile;
+		if (!settings.outputPath.empty())
+		{
+			outputFile.open(settings.outputPath);
+			if (!outputFile.is_open())
+			{
+				DebugLogError("Couldn't open output file \"" + settings.outputPath + "\".");
+				return EXIT_FAILURE;
+			}
+		}
+
+		std::ostream &stream = outputFile.is_open() ? static_cast<std::ostream&>(outputFile) : std::cout;
+		if (settings.format == BenchFormat::CSV)
+		{
+			writeCSV(stream, frames);
+		}
+		else
+		{
+			writeJSON(stream, settings, frames);
+		}
+
+		return EXIT_SUCCESS;
+	}
+
+	bool trySaveImage(const std::string &filename, const uint32_t *pixels, int width, int height)
+	{
+		// The surface copies the pixels, so the const cast doesn't allow writing to them.
+		const Surface surface = Surface::createWithFormatFrom(const_cast<uint32_t*>(pixels), width, height,
+			Renderer::DEFAULT_BPP, width * sizeof(uint32_t), Renderer::DEFAULT_PIXELFORMAT);
+		if (SDL_SaveBMP(surface.get(), filename.c_str()) != 0)
+		{
+			DebugLogError("Couldn't save \"" + filename + "\" (" + std::string(SDL_GetError()) + ").");
+			return false;
+		}
+
+		return true;
+	}
+
+	// Compares an image against its reference, writing a diff image where mismatched pixels are red
+	// (brighter for bigger differences) and matching pixels are a dimmed gray copy of the reference.
+	// Only color channels are compared since alpha isn't meaningful in the frame buffer.
+	void compareImages(const Surface &reference, const uint32_t *pixels, int tolerance,
+		uint32_t *outDiffPixels, int *outBadPixelCount, int *outMaxDifference)
+	{
+		const SDL_PixelFormat *format = reference.get()->format;
+		const int width = reference.getWidth();
+		const int height = reference.getHeight();
+		const int referencePitch = reference.get()->pitch / sizeof(uint32_t);
+		const uint32_t *referencePixels = static_cast<const uint32_t*>(reference.getPixels());
+
+		*outBadPixelCount = 0;
+		*outMaxDifference = 0;
+		for (int y = 0; y < height; y++)
+		{
+			for (int x = 0; x < width; x++)
+			{
+				uint8_t refR, refG, refB, r, g, b;
+				SDL_GetRGB(referencePixels[x + (y * referencePitch)], format, &refR, &refG, &refB);
+				SDL_GetRGB(pixels[x + (y * width)], format, &r, &g, &b);
+
+				const int difference = std::max(std::abs(r - refR),
+					std::max(std::abs(g - refG), std::abs(b - refB)));
+				*outMaxDifference = std::max(*outMaxDifference, difference);
+
+				uint32_t &diffPixel = outDiffPixels[x + (y * width)];
+				if (difference > tolerance)
+				{
+					(*outBadPixelCount)++;
+					const uint8_t intensity = static_cast<uint8_t>(std::min(128 + difference, 255));
+					diffPixel = SDL_MapRGB(format, intensity, 0, 0);
+				}
+				else
+				{
+					const uint8_t gray = static_cast<uint8_t>((refR + refG + refB) / 9);
+					diffPixel = SDL_MapRGB(format, gray, gray, gray);
+				}
+			}
+		}
+	}
+
+	int runGolden(const BenchSettings &settings, BenchContext &context)
+	{
+		Buffer<uint32_t> colorBuffer(settings.width * settings.height);
+		Buffer<uint32_t> diffBuffer(settings.width * settings.height);
+		int failureCount = 0;
+
+		// References made by an older version of the benchmark can't be compared against.
+		const std::string versionFilename = settings.goldenPath + GoldenVersionFilename;
+		if (settings.updateGolden)
+		{
+			std::ofstream versionFile(versionFilename);
+			versionFile << GoldenVersion << "\n";
+			for (const BuildFormat &buildFormat : BuildFormats)
+			{
+				versionFile << buildFormat.name << " " << buildFormat.value << "\n";
+			}
+
+			if (!versionFile)
+			{
+				DebugLogError("Couldn't write \"" + versionFilename + "\".");
+				return EXIT_FAILURE;
+			}
+		}
+		else
+		{
+			std::ifstream versionFile(versionFilename);
+			int referenceVersion;
+			if (!(versionFile >> referenceVersion) || (referenceVersion != GoldenVersion))
+			{
+				std::cout << "FAIL references in \"" << settings.goldenPath << "\" are not version " <<
+					GoldenVersion << ", regenerate them with --update-golden 1\n";
+				return EXIT_FAILURE;
+			}
+
+			// References from before formats were recorded used the defaults.
+			std::string formatName, formatValue;
+			while (versionFile >> formatName >> formatValue)
+			{
+				for (const BuildFormat &buildFormat : BuildFormats)
+				{
+					if ((formatName == buildFormat.name) && (formatValue != buildFormat.value))
+					{
+						std::cout << "Comparing " << buildFormat.name << " " << buildFormat.value <<
+							" against references made with " << formatValue << "\n";
+					}
+				}
+			}
+		}
+
+		for (const GoldenScene &goldenScene : GoldenScenes)
+		{
+			BenchLevel level;
+			if (!tryLoadLevel(settings, goldenScene.scene, goldenScene.hour, context, &level))
+			{
+				return EXIT_FAILURE;
+			}
+
+			for (int i = 0; i < static_cast<int>(std::size(GoldenPoses)); i++)
+			{
+				const GoldenPose &pose = GoldenPoses[i];
+				const double yawRadians = pose.yawDegrees * Constants::DegToRad;
+				const Double3 forward = Double3(std::sin(yawRadians), pose.pitch, -std::cos(yawRadians)).normalized();
+				renderView(context, level, level.startPosition, forward, colorBuffer.get());
+
+				const std::string imageName = std::string(goldenScene.name) + "_pose" + std::to_string(i);
+				const std::string referenceFilename = settings.goldenPath + imageName + ".bmp";
+				if (settings.updateGolden)
+				{
+					if (!trySaveImage(referenceFilename, colorBuffer.get(), settings.width, settings.height))
+					{
+						return EXIT_FAILURE;
+					}
+
+					std::cout << "Wrote " << referenceFilename << "\n";
+					continue;
+				}
+
+				const Surface reference = Surface::loadBMP(referenceFilename.c_str(), Renderer::DEFAULT_PIXELFORMAT);
+				if (reference.get() == nullptr)
+				{
+					std::cout << "FAIL " << imageName << ": no reference image\n";
+					failureCount++;
+					continue;
+				}
+
+				if ((reference.getWidth() != settings.width) || (reference.getHeight() != settings.height))
+				{
+					std::cout << "FAIL " << imageName << ": reference is " << reference.getWidth() << "x" <<
+						reference.getHeight() << ", render is " << settings.width << "x" << settings.height << "\n";
+					failureCount++;
+					continue;
+				}
+
+				int badPixelCount, maxDifference;
+				compareImages(reference, colorBuffer.get(), settings.tolerance, diffBuffer.get(),
+					&badPixelCount, &maxDifference);
+
+				const bool passed = badPixelCount <= settings.maxBadPixels;
+				std::cout << (passed ? "OK   " : "FAIL ") << imageName << ": " << badPixelCount <<
+					" bad pixels, max difference " << maxDifference << "\n";
+
+				if (!passed)
+				{
+					// Keep the failing render next to its diff so both can be inspected.
+					failureCount++;
+					trySaveImage(settings.goldenPath + imageName + "_diff.bmp", diffBuffer.get(),
+						settings.width, settings.height);
+					trySaveImage(settings.goldenPath + imageName + "_actual.bmp", colorBuffer.get(),
+						settings.width, settings.height);
+				}
+			}
+		}
+
+		if (failureCount > 0)
+		{
+			std::cout << failureCount << " image(s) differ from their references.\n";
+			return EXIT_FAILURE;
+		}
+
+		return EXIT_SUCCESS;
+	}
+
+	int runKernelDiff(const BenchSettings &settings, BenchContext &context)
+	{
+		struct KernelEntry
+		{
+			const char *name;
+			SoftwareRenderer::ColumnKernel kernel;
+		};
+
+		constexpr KernelEntry KernelEntries[] =
+		{
+			{ "sse", SoftwareRenderer::ColumnKernel::SSE },
+			{ "avx", SoftwareRenderer::ColumnKernel::AVX }
+		};
+
+		Buffer<uint32_t> scalarBuffer(settings.width * settings.height);
+		Buffer<uint32_t> colorBuffer(settings.width * settings.height);
+		Buffer<uint32_t> diffBuffer(settings.width * settings.height);
+		int failureCount = 0;
+		int comparedKernelCount = 0;
+
+		// Restored afterwards so the override doesn't outlive the comparison.
+		const SoftwareRenderer::ColumnKernel defaultKernel = SoftwareRenderer::getColumnKernel();
+
+		for (const GoldenScene &goldenScene : GoldenScenes)
+		{
+			BenchLevel level;
+			if (!tryLoadLevel(settings, goldenScene.scene, goldenScene.hour, context, &level))
+			{
+				SoftwareRenderer::trySetColumnKernel(defaultKernel);
+				return EXIT_FAILURE;
+			}
+
+			std::vector<GoldenPose> poses(std::begin(GoldenPoses), std::end(GoldenPoses));
+			poses.insert(poses.end(), std::begin(KernelDiffPoses), std::end(KernelDiffPoses));
+
+			for (int i = 0; i < static_cast<int>(poses.size()); i++)
+			{
+				const GoldenPose &pose = poses[i];
+				const double yawRadians = pose.yawDegrees * Constants::DegToRad;
+				const Double3 forward = Double3(std::sin(yawRadians), pose.pitch, -std::cos(yawRadians)).normalized();
+				const std::string imageName = std::string(goldenScene.name) + "_pose" + std::to_string(i);
+
+				SoftwareRenderer::trySetColumnKernel(SoftwareRenderer::ColumnKernel::Scalar);
+				renderView(context, level, level.startPosition, forward, scalarBuffer.get());
+
+				const Surface scalarSurface = Surface::createWithFormatFrom(scalarBuffer.get(), settings.width,
+					settings.height, Renderer::DEFAULT_BPP, settings.width * sizeof(uint32_t),
+					Renderer::DEFAULT_PIXELFORMAT);
+
+				comparedKernelCount = 0;
+				for (const KernelEntry &kernelEntry : KernelEntries)
+				{
+					if (!SoftwareRenderer::trySetColumnKernel(kernelEntry.kernel))
+					{
+						continue;
+					}
+
+					comparedKernelCount++;
+					renderView(context, level, level.startPosition, forward, colorBuffer.get());
+
+					// Kernels are meant to be bit-identical, so any difference is a mismatch.
+					constexpr int tolerance = 0;
+					int badPixelCount, maxDifference;
+					compareImages(scalarSurface, colorBuffer.get(), tolerance, diffBuffer.get(),
+						&badPixelCount, &maxDifference);
+
+					const bool passed = badPixelCount <= settings.maxBadPixels;
+					std::cout << (passed ? "OK   " : "FAIL ") << imageName << " " << kernelEntry.name <<
+						": " << badPixelCount << " pixels differ from scalar, max difference " <<
+						maxDifference << "\n";
+
+					if (!passed)
+					{
+						failureCount++;
+					}
+				}
+			}
+		}
+
+		SoftwareRenderer::trySetColumnKernel(defaultKernel);
+
+		if (comparedKernelCount == 0)
+		{
+			std::cout << "The CPU only supports the scalar column kernel, nothing to compare.\n";
+		}
+
+		if (failureCount > 0)
+		{
+			std::cout << failureCount << " render(s) differ from the scalar kernel.\n";
+			return EXIT_FAILURE;
+		}
+
+		return EXIT_SUCCESS;
+	}
+
+	bool tryInitChunkMapDefinition(const BenchSettings &settings, BenchContext &context,
+		MapDefinition *outMapDefinition)
+	{
+		MapGeneration::InteriorGenInfo interiorGenInfo;
+		interiorGenInfo.initPrefab(std::string(settings.mifName), ArenaTypes::InteriorType::Dungeon, std::nullopt);
+
+		if (!outMapDefinition->initInterior(interiorGenInfo, context.charClassLibrary, context.entityDefLibrary,
+			context.binaryAssetLibrary, context.textureManager))
+		{
+			DebugLogError("Couldn't init map definition for \"" + settings.mifName + "\".");
+			return false;
+		}
+
+		return true;
+	}
+
+	int runChunkStress(const BenchSettings &settings, BenchContext &context)
+	{
+		// Shared with the chunk manager's populate jobs.
+		const auto mapDefinitionPtr = std::make_shared<MapDefinition>();
+		MapDefinition &mapDefinition = *mapDefinitionPtr;
+		if (!tryInitChunkMapDefinition(settings, context, &mapDefinition))
+		{
+			return EXIT_FAILURE;
+		}
+
+		const int activeLevelIndex = mapDefinition.getStartLevelIndex().value_or(0);
+		const int chunkDistance = context.options.getMisc_ChunkDistance();
+
+		// The center walks back and forth along rows of this many chunks, so every step crosses one
+		// chunk boundary and rows are revisited from both directions.
+		constexpr int rowLength = 16;
+		const int rowCount = (settings.chunkStressSteps / rowLength) + 1;
+		auto getCenterChunk = [chunkDistance](int step)
+		{
+			const int row = step / rowLength;
+			const int column = step % rowLength;
+			const int x = ((row % 2) == 0) ? column : (rowLength - 1 - column);
+			return ChunkInt2(chunkDistance + x, chunkDistance + row);
+		};
+
+		// The entity manager still has a fixed-size grid, so it must cover every chunk on the path.
+		EntityManager entityManager;
+		entityManager.init(rowLength + (chunkDistance * 2), rowCount + (chunkDistance * 2));
+
+		ChunkManager chunkManager;
+		chunkManager.update(0.0, getCenterChunk(0), activeLevelIndex, mapDefinitionPtr, chunkDistance,
+			entityManager);
+		const int initialAllocatedCount = chunkManager.getAllocatedChunkCount();
+
+		using Clock = std::chrono::high_resolution_clock;
+		double updateTime = 0.0;
+		double maxUpdateTime = 0.0;
+		double lookupTime = 0.0;
+		int64_t lookupCount = 0;
+		int64_t pendingLookupCount = 0;
+		int badLookupCount = 0;
+		for (int step = 1; step <= settings.chunkStressSteps; step++)
+		{
+			const ChunkInt2 centerChunk = getCenterChunk(step);
+			const auto updateStartTime = Clock::now();
+			chunkManager.update(0.0, centerChunk, activeLevelIndex, mapDefinitionPtr, chunkDistance, entityManager);
+			const auto updateEndTime = Clock::now();
+			const double stepUpdateTime = std::chrono::duration<double>(updateEndTime - updateStartTime).count();
+			updateTime += stepUpdateTime;
+			maxUpdateTime = std::max(maxUpdateTime, stepUpdateTime);
+
+			// Look up every active chunk plus a ring of inactive ones around them.
+			const int lookupDistance = chunkDistance + 1;
+			for (WEInt y = centerChunk.y - lookupDistance; y <= centerChunk.y + lookupDistance; y++)
+			{
+				for (SNInt x = centerChunk.x - lookupDistance; x <= centerChunk.x + lookupDistance; x++)
+				{
+					const ChunkInt2 coord(x, y);
+					const std::optional<int> index = chunkManager.tryGetChunkIndex(coord);
+					const bool isActive = ChunkUtils::isWithinActiveRange(centerChunk, coord, chunkDistance);
+					if (isActive && !index.has_value() && chunkManager.isChunkPending(coord))
+					{
+						// Still being populated in the background, so drawn as a fogged placeholder.
+						const Chunk *chunk = chunkManager.tryGetChunkOrPlaceholder(coord);
+						if ((chunk == nullptr) || !chunkManager.isPlaceholderChunk(*chunk))
+						{
+							badLookupCount++;
+						}
+
+						pendingLookupCount++;
+					}
+					else if (index.has_value() != isActive)
+					{
+						badLookupCount++;
+					}
+					else if (index.has_value() && (chunkManager.getChunk(*index).getCoord() != coord))
+					{
+						badLookupCount++;
+					}
+
+					lookupCount++;
+				}
+			}
+
+			lookupTime += std::chrono::duration<double>(Clock::now() - updateEndTime).count();
+		}
+
+		const int finalAllocatedCount = chunkManager.getAllocatedChunkCount();
+		const double stepCountReal = static_cast<double>(settings.chunkStressSteps);
+
+		size_t chunkVoxelByteCount = 0;
+		for (int i = 0; i < chunkManager.getChunkCount(); i++)
+		{
+			chunkVoxelByteCount += chunkManager.getChunk(i).getVoxelByteCount();
+		}
+
+		std::cout << "Chunk boundaries crossed: " << settings.chunkStressSteps << "\n" <<
+			"Chunk distance: " << chunkDistance << ", active chunks: " << chunkManager.getChunkCount() << "\n" <<
+			"Average update: " << ((updateTime / stepCountReal) * 1000.0) << " ms, slowest: " <<
+			(maxUpdateTime * 1000.0) << " ms\n" <<
+			"Look-ups per second: " << (static_cast<double>(lookupCount) / std::max(lookupTime, 1e-9)) << "\n" <<
+			"Look-ups of chunks still populating: " << pendingLookupCount << "\n" <<
+			"Active chunk voxel memory: " << (chunkVoxelByteCount / 1024) << " KB\n" <<
+			"Chunks allocated: " << initialAllocatedCount << " initially, " << finalAllocatedCount <<
+			" at the end (" << chunkManager.getPooledChunkCount() << " pooled)\n";
+
+		bool success = true;
+		if (badLookupCount > 0)
+		{
+			std::cout << "FAIL: " << badLookupCount << " look-up(s) returned the wrong chunk.\n";
+			success = false;
+		}
+
+		if (finalAllocatedCount > initialAllocatedCount)
+		{
+			std::cout << "FAIL: chunks were allocated after the first update instead of reused from the pool.\n";
+			success = false;
+		}
+
+		return success ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	int runChunkDelta(const BenchSettings &settings, BenchContext &context)
+	{
+		// Shared with the chunk manager's populate jobs.
+		const auto mapDefinitionPtr = std::make_shared<MapDefinition>();
+		MapDefinition &mapDefinition = *mapDefinitionPtr;
+		if (!tryInitChunkMapDefinition(settings, context, &mapDefinition))
+		{
+			return EXIT_FAILURE;
+		}
+
+		const int activeLevelIndex = mapDefinition.getStartLevelIndex().value_or(0);
+		const int chunkDistance = context.options.getMisc_ChunkDistance();
+
+		// The changed chunk is at the level's origin so it has voxels, and the center stays at
+		// non-negative chunks for the entity manager's grid. The far center is just out of range.
+		const ChunkInt2 changedChunkCoord(0, 0);
+		const ChunkInt2 nearCenterChunk(chunkDistance, chunkDistance);
+		const ChunkInt2 farCenterChunk(nearCenterChunk.x + (chunkDistance * 2) + 1, nearCenterChunk.y);
+
+		EntityManager entityManager;
+		entityManager.init(farCenterChunk.x + chunkDistance + 1, nearCenterChunk.y + chunkDistance + 1);
+
+		// Only the center chunk is waited on, so keep updating until the changed chunk is committed.
+		ChunkManager chunkManager;
+		auto updateUntilPopulated = [&chunkManager, &changedChunkCoord, activeLevelIndex, chunkDistance,
+			&entityManager](const ChunkInt2 &centerChunk, const std::shared_ptr<const MapDefinition> &mapDefPtr)
+		{
+			do
+			{
+				chunkManager.update(0.0, centerChunk, activeLevelIndex, mapDefPtr, chunkDistance, entityManager);
+				std::this_thread::yield();
+			} while (chunkManager.isChunkPending(changedChunkCoord));
+		};
+
+		updateUntilPopulated(nearCenterChunk, mapDefinitionPtr);
+
+		const std::optional<int> chunkIndex = chunkManager.tryGetChunkIndex(changedChunkCoord);
+		if (!chunkIndex.has_value())
+		{
+			std::cout << "FAIL: chunk (" << changedChunkCoord.toString() << ") wasn't populated.\n";
+			return EXIT_FAILURE;
+		}
+
+		// Swap solid and air voxels on the main floor so every change differs from the level. Air
+		// becomes a voxel definition the level doesn't have, added after an unused one so it gets a
+		// different ID when the delta is replayed.
+		Chunk &chunk = chunkManager.getChunk(*chunkIndex);
+		const int voxelY = std::min(1, chunk.getHeight() - 1);
+		Chunk::VoxelID solidID = 0;
+		for (WEInt z = 0; (z < Chunk::DEPTH) && (solidID == 0); z++)
+		{
+			for (SNInt x = 0; (x < Chunk::WIDTH) && (solidID == 0); x++)
+			{
+				solidID = chunk.getVoxel(x, voxelY, z);
+			}
+		}
+
+		if (solidID == 0)
+		{
+			std::cout << "FAIL: chunk (" << changedChunkCoord.toString() << ") has no solid voxels to change.\n";
+			return EXIT_FAILURE;
+		}
+
+		const std::string addedTextureName = "BENCHADD.IMG";
+		auto tryAddWallDef = [&chunk](const std::string &textureName, Chunk::VoxelID *outID)
+		{
+			return chunk.tryAddVoxelDef(VoxelDefinition::makeWall(TextureAssetReference(std::string(textureName)),
+				TextureAssetReference(std::string(textureName)), TextureAssetReference(std::string(textureName))),
+				outID);
+		};
+
+		Chunk::VoxelID unusedID, addedID;
+		if (!tryAddWallDef("BENCHPAD.IMG", &unusedID) || !tryAddWallDef(addedTextureName, &addedID))
+		{
+			std::cout << "FAIL: couldn't add voxel definitions to chunk (" << changedChunkCoord.toString() << ").\n";
+			return EXIT_FAILURE;
+		}
+
+		const int changedVoxelCount = std::min(settings.chunkDeltaVoxels, Chunk::WIDTH * Chunk::DEPTH);
+		std::vector<Chunk::VoxelID> levelIDs(changedVoxelCount);
+		std::vector<bool> expectAdded(changedVoxelCount);
+		for (int i = 0; i < changedVoxelCount; i++)
+		{
+			const SNInt x = i % Chunk::WIDTH;
+			const WEInt z = i / Chunk::WIDTH;
+			levelIDs[i] = chunk.getVoxel(x, voxelY, z);
+			expectAdded[i] = levelIDs[i] == 0;
+			chunk.setVoxel(x, voxelY, z, expectAdded[i] ? addedID : 0);
+		}
+
+		// The chunk's only entity is deleted when the chunk is recycled, and its ID is released when
+		// the chunk is populated again.
+		const EntityID removedEntityID = entityManager.makeEntity(EntityType::Static).getID();
+
+		constexpr double doorSpeed = 1.30;
+		constexpr double doorPercentOpen = 0.75;
+		chunk.addVoxelInst(VoxelInstance::makeDoor(0, voxelY, 0, doorSpeed, doorPercentOpen,
+			VoxelInstance::DoorState::StateType::Opening));
+
+		// Recycle the chunk, then come back so it's populated from the level again.
+		chunkManager.update(0.0, farCenterChunk, activeLevelIndex, mapDefinitionPtr, chunkDistance, entityManager);
+		const int awayDeltaCount = chunkManager.getChunkDeltaCount();
+
+		bool success = true;
+		if (awayDeltaCount != 1)
+		{
+			std::cout << "FAIL: " << awayDeltaCount << " chunk deltas saved after moving away, expected 1.\n";
+			success = false;
+		}
+
+		// Deltas are kept per map, so visiting another map at the same chunk must neither apply nor
+		// drop them.
+		{
+			const auto otherMapDefinitionPtr = std::make_shared<MapDefinition>();
+			if (!tryInitChunkMapDefinition(settings, context, otherMapDefinitionPtr.get()))
+			{
+				return EXIT_FAILURE;
+			}
+
+			updateUntilPopulated(nearCenterChunk, otherMapDefinitionPtr);
+
+			const std::optional<int> otherIndex = chunkManager.tryGetChunkIndex(changedChunkCoord);
+			if (!otherIndex.has_value())
+			{
+				std::cout << "FAIL: chunk (" << changedChunkCoord.toString() << ") wasn't populated in the other map.\n";
+				return EXIT_FAILURE;
+			}
+
+			const Chunk &otherChunk = chunkManager.getChunk(*otherIndex);
+			int otherChangedCount = 0;
+			for (int i = 0; i < changedVoxelCount; i++)
+			{
+				const SNInt x = i % Chunk::WIDTH;
+				const WEInt z = i / Chunk::WIDTH;
+				if (otherChunk.getVoxel(x, voxelY, z) != levelIDs[i])
+				{
+					otherChangedCount++;
+				}
+			}
+
+			if (otherChangedCount > 0)
+			{
+				std::cout << "FAIL: " << otherChangedCount << " voxels changed in the other map.\n";
+				success = false;
+			}
+
+			if (chunkManager.getChunkDeltaCount() != 1)
+			{
+				std::cout << "FAIL: " << chunkManager.getChunkDeltaCount() <<
+					" chunk deltas saved in the other map, expected 1.\n";
+				success = false;
+			}
+		}
+
+		updateUntilPopulated(nearCenterChunk, mapDefinitionPtr);
+
+		if (chunkManager.getChunkDeltaCount() != 0)
+		{
+			std::cout << "FAIL: " << chunkManager.getChunkDeltaCount() <<
+				" chunk deltas still saved after moving back, expected 0.\n";
+			success = false;
+		}
+
+		const std::optional<int> restoredIndex = chunkManager.tryGetChunkIndex(changedChunkCoord);
+		if (!restoredIndex.has_value())
+		{
+			std::cout << "FAIL: chunk (" << changedChunkCoord.toString() << ") wasn't populated again.\n";
+			return EXIT_FAILURE;
+		}
+
+		// Added voxels are checked by definition since their ID is remapped.
+		const Chunk &restoredChunk = chunkManager.getChunk(*restoredIndex);
+		int wrongVoxelCount = 0;
+		int addedVoxelCount = 0;
+		for (int i = 0; i < changedVoxelCount; i++)
+		{
+			const SNInt x = i % Chunk::WIDTH;
+			const WEInt z = i / Chunk::WIDTH;
+			const Chunk::VoxelID restoredID = restoredChunk.getVoxel(x, voxelY, z);
+			bool isRestored = false;
+			if (expectAdded[i])
+			{
+				const VoxelDefinition &voxelDef = restoredChunk.getVoxelDef(restoredID);
+				isRestored = (restoredID != 0) && (voxelDef.type == VoxelType::Wall) &&
+					(voxelDef.wall.sideTextureAssetRef.filename == addedTextureName);
+				addedVoxelCount++;
+			}
+			else
+			{
+				isRestored = restoredID == 0;
+			}
+
+			if (!isRestored)
+			{
+				wrongVoxelCount++;
+			}
+		}
+
+		if (wrongVoxelCount > 0)
+		{
+			std::cout << "FAIL: " << wrongVoxelCount << " of " << changedVoxelCount <<
+				" changed voxels weren't restored.\n";
+			success = false;
+		}
+
+		const bool doorRestored = (restoredChunk.getVoxelInstCount() == 1) && [&restoredChunk]()
+		{
+			const VoxelInstance &voxelInst = restoredChunk.getVoxelInst(0);
+			if (voxelInst.getType() != VoxelInstance::Type::OpenDoor)
+			{
+				return false;
+			}
+
+			const VoxelInstance::DoorState &doorState = voxelInst.getDoorState();
+			return (doorState.getPercentOpen() == doorPercentOpen) &&
+				(doorState.getStateType() == VoxelInstance::DoorState::StateType::Opening);
+		}();
+
+		if (!doorRestored)
+		{
+			std::cout << "FAIL: the opening door wasn't restored.\n";
+			success = false;
+		}
+
+		// The removed entity's ID is the only free one, so the next entity gets it.
+		const bool entityIdReleased = (entityManager.getTotalCountInChunk(changedChunkCoord) == 0) &&
+			(entityManager.makeEntity(EntityType::Static).getID() == removedEntityID);
+		if (!entityIdReleased)
+		{
+			std::cout << "FAIL: the removed entity's ID wasn't released.\n";
+			success = false;
+		}
+
+		std::cout << "Changed voxels: " << changedVoxelCount << " (" << addedVoxelCount <<
+			" with an added definition), restored: " << (changedVoxelCount - wrongVoxelCount) << "\n" <<
+			"Door restored: " << (doorRestored ? "yes" : "no") << "\n" <<
+			"Removed entity ID released: " << (entityIdReleased ? "yes" : "no") << "\n";
+
+		return success ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	int runVoxelStorage(const BenchSettings &settings, BenchContext &context)
+	{
+		using Clock = std::chrono::high_resolution_clock;
+		constexpr BenchScene VoxelScenes[] = { BenchScene::City, BenchScene::Wilderness };
+
+		for (const BenchScene scene : VoxelScenes)
+		{
+			BenchLevel level;
+			if (!tryLoadLevel(settings, scene, 12, context, &level))
+			{
+				return EXIT_FAILURE;
+			}
+
+			const VoxelGrid &voxelGrid = level.level->getVoxelGrid();
+			const SNInt width = voxelGrid.getWidth();
+			const int height = voxelGrid.getHeight();
+			const WEInt depth = voxelGrid.getDepth();
+
+			// Dense copy in the old layout, for comparing memory and read throughput.
+			std::vector<uint16_t> denseVoxels(static_cast<size_t>(width) * height * depth);
+			for (WEInt z = 0; z < depth; z++)
+			{
+				for (int y = 0; y < height; y++)
+				{
+					for (SNInt x = 0; x < width; x++)
+					{
+						denseVoxels[x + (y * width) + (static_cast<size_t>(z) * width * height)] =
+							voxelGrid.getVoxel(x, y, z);
+					}
+				}
+			}
+
+			// Same pseudo-random coordinates for both so only the storage differs.
+			const int64_t readCount = static_cast<int64_t>(settings.voxelReadMillions) * 1000000;
+			auto measureReads = [readCount, width, height, depth](auto &&getVoxel, uint64_t *outChecksum)
+			{
+				uint32_t state = 0x9E3779B9;
+				uint64_t checksum = 0;
+				const auto startTime = Clock::now();
+				for (int64_t i = 0; i < readCount; i++)
+				{
+					state ^= state << 13;
+					state ^= state >> 17;
+					state ^= state << 5;
+					const SNInt x = static_cast<SNInt>(state % width);
+					const int y = static_cast<int>((state >> 8) % height);
+					const WEInt z = static_cast<WEInt>((state >> 16) % depth);
+					checksum += getVoxel(x, y, z);
+				}
+
+				*outChecksum = checksum;
+				const double seconds = std::chrono::duration<double>(Clock::now() - startTime).count();
+				return static_cast<double>(readCount) / std::max(seconds, 1e-9);
+			};
+
+			uint64_t compressedChecksum, denseChecksum;
+			const double compressedReadsPerSecond = measureReads([&voxelGrid](SNInt x, int y, WEInt z)
+			{
+				return voxelGrid.getVoxel(x, y, z);
+			}, &compressedChecksum);
+
+			const double denseReadsPerSecond = measureReads([&denseVoxels, width, height](SNInt x, int y, WEInt z)
+			{
+				return denseVoxels[x + (y * width) + (static_cast<size_t>(z) * width * height)];
+			}, &denseChecksum);
+
+			// Dense column ranges were two ints per column.
+			const size_t denseByteCount = (denseVoxels.size() * sizeof(uint16_t)) +
+				(static_cast<size_t>(width) * depth * sizeof(int) * 2);
+			const size_t compressedByteCount = voxelGrid.getVoxelByteCount();
+			constexpr double bytesPerMB = 1024.0 * 1024.0;
+
+			const char *sceneName = (scene == BenchScene::City) ? "city" : "wild";
+			std::cout << sceneName << ": " << width << "x" << height << "x" << depth << " voxels\n" <<
+				"  Memory: " << (static_cast<double>(compressedByteCount) / bytesPerMB) << " MB compressed, " <<
+				(static_cast<double>(denseByteCount) / bytesPerMB) << " MB dense\n" <<
+				"  getVoxel() reads per second: " << compressedReadsPerSecond << " compressed, " <<
+				denseReadsPerSecond << " dense\n";
+
+			if (compressedChecksum != denseChecksum)
+			{
+				std::cout << "FAIL: compressed and dense voxels differ.\n";
+				return EXIT_FAILURE;
+			}
+		}
+
+		return EXIT_SUCCESS;
+	}
+
+	int runTextureLookups(const BenchSettings &settings, BenchContext &context)
+	{
+		constexpr BenchScene LookupScenes[] = { BenchScene::Interior, BenchScene::City, BenchScene::Wilderness };
+
+		for (const BenchScene scene : LookupScenes)
+		{
+			BenchLevel level;
+			if (!tryLoadLevel(settings, scene, 12, context, &level))
+			{
+				return EXIT_FAILURE;
+			}
+
+			const VoxelGrid &voxelGrid = level.level->getVoxelGrid();
+			const int lookupCount = settings.textureLookupMillions * 1000000;
+			double handleSeconds, assetRefSeconds;
+			int mismatchCount;
+			context.renderer.measureVoxelTextureLookups(voxelGrid, lookupCount, &handleSeconds,
+				&assetRefSeconds, &mismatchCount);
+
+			auto getNanoseconds = [lookupCount](double seconds)
+			{
+				return (seconds * 1000000000.0) / static_cast<double>(lookupCount);
+			};
+
+			const char *sceneName = (scene == BenchScene::Interior) ? "interior" :
+				((scene == BenchScene::City) ? "city" : "wild");
+			std::cout << sceneName << ": " << voxelGrid.getVoxelDefCount() << " voxel definitions\n" <<
+				"  Texture look-up: " << getNanoseconds(handleSeconds) << " ns by handle, " <<
+				getNanoseconds(assetRefSeconds) << " ns by asset reference\n";
+
+			if (mismatchCount > 0)
+			{
+				std::cout << "FAIL: " << mismatchCount << " voxel definition(s) have handles to the wrong texture.\n";
+				return EXIT_FAILURE;
+			}
+		}
+
+		return EXIT_SUCCESS;
+	}
+
+	int runWildWalk(const BenchSettings &settings, BenchContext &context)
+	{
+		// Same wilderness as the wild scene.
+		WorldMapDefinition worldMapDef;
+		worldMapDef.init(context.binaryAssetLibrary);
+		const ProvinceDefinition &provinceDef = worldMapDef.getProvinceDef(LocationUtils::CENTER_PROVINCE_ID);
+		const LocationDefinition *locationDefPtr = findImperialCityLocation(provinceDef);
+		if (locationDefPtr == nullptr)
+		{
+			DebugLogError("Couldn't find Imperial City location.");
+			return EXIT_FAILURE;
+		}
+
+		const LocationDefinition::CityDefinition &cityDef = locationDefPtr->getCityDefinition();
+		const ExeData &exeData = context.binaryAssetLibrary.getExeData();
+		MapGeneration::WildGenInfo wildGenInfo;
+		wildGenInfo.init(ArenaWildUtils::generateWildernessIndices(cityDef.wildSeed, exeData.wild),
+			locationDefPtr, cityDef.type, cityDef.citySeed, cityDef.rulerSeed, cityDef.palaceIsMainQuestDungeon);
+
+		const int starCount = SkyUtils::getStarCountFromDensity(context.options.getMisc_StarDensity());
+		const WeatherType weatherType = WeatherUtils::getFilteredWeatherType(WeatherType::Clear, cityDef.climateType);
+		SkyGeneration::ExteriorSkyGenInfo skyGenInfo;
+		skyGenInfo.init(cityDef.climateType, weatherType, 0, starCount, cityDef.citySeed, cityDef.distantSkySeed,
+			provinceDef.hasAnimatedDistantLand());
+
+		// Shared with the level's populate jobs.
+		const auto mapDefinitionPtr = std::make_shared<MapDefinition>();
+		MapDefinition &mapDefinition = *mapDefinitionPtr;
+		if (!mapDefinition.initWild(wildGenInfo, skyGenInfo, context.charClassLibrary, context.entityDefLibrary,
+			context.binaryAssetLibrary, context.textureManager))
+		{
+			DebugLogError("Couldn't init wild map definition for \"" + locationDefPtr->getName() + "\".");
+			return EXIT_FAILURE;
+		}
+
+		const int chunkDistance = context.options.getMisc_ChunkDistance();
+		SNInt chunkCountX;
+		WEInt chunkCountZ;
+		ChunkUtils::getPotentiallyVisibleChunkCounts(chunkDistance, &chunkCountX, &chunkCountZ);
+		const int maxCachedBlockCount = chunkCountX * chunkCountZ;
+
+		// The center walks back and forth along rows of the wilderness so every step crosses one chunk
+		// boundary, and blocks leaving range behind it have to be freed for the ones ahead of it. The
+		// first row goes through the city so its revised blocks (chunks 31 and 32) are generated early.
+		const int rowLength = std::max(ArenaWildUtils::WILD_WIDTH - (chunkDistance * 2), 1);
+		const int rowCount = std::max(ArenaWildUtils::WILD_HEIGHT - (chunkDistance * 2), 1);
+		constexpr int cityChunkStart = (ArenaWildUtils::WILD_HEIGHT / 2) - 1;
+		const int firstRow = std::clamp(cityChunkStart - chunkDistance, 0, rowCount - 1);
+		auto getCenterChunk = [chunkDistance, rowLength, rowCount, firstRow](int step)
+		{
+			const int row = ((step / rowLength) + firstRow) % rowCount;
+			const int column = step % rowLength;
+			const int x = ((row % 2) == 0) ? column : (rowLength - 1 - column);
+			return ChunkInt2(chunkDistance + x, chunkDistance + row);
+		};
+
+		// Steps where a city block was in range, to show the walk generated them.
+		auto isCityInRange = [chunkDistance](const ChunkInt2 &centerChunk)
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				const ChunkInt2 cityChunk(cityChunkStart + (i % 2), cityChunkStart + (i / 2));
+				if (ChunkUtils::isWithinActiveRange(centerChunk, cityChunk, chunkDistance))
+				{
+					return true;
+				}
+			}
+
+			return false;
+		};
+
+		// Only the level's chunk manager and entity manager are used, so it isn't initialized.
+		LevelInstance levelInst;
+		levelInst.getEntityManager().init(ArenaWildUtils::WILD_WIDTH, ArenaWildUtils::WILD_HEIGHT);
+
+		using Clock = std::chrono::high_resolution_clock;
+		double updateTime = 0.0;
+		double maxUpdateTime = 0.0;
+		int peakCachedBlockCount = 0;
+		size_t peakCachedBlockByteCount = 0;
+		int cityStepCount = 0;
+		for (int step = 0; step <= settings.wildWalkSteps; step++)
+		{
+			const ChunkInt2 centerChunk = getCenterChunk(step);
+			if (isCityInRange(centerChunk))
+			{
+				cityStepCount++;
+			}
+
+			const auto updateStartTime = Clock::now();
+			levelInst.update(0.0, centerChunk, 0, mapDefinitionPtr, chunkDistance, context.charClassLibrary,
+				context.entityDefLibrary, context.binaryAssetLibrary, context.textureManager);
+			const double stepUpdateTime = std::chrono::duration<double>(Clock::now() - updateStartTime).count();
+			updateTime += stepUpdateTime;
+			maxUpdateTime = std::max(maxUpdateTime, stepUpdateTime);
+
+			const MapDefinition::Wild &wild = mapDefinition.getWild();
+			peakCachedBlockCount = std::max(peakCachedBlockCount, wild.getCachedBlockCount());
+			peakCachedBlockByteCount = std::max(peakCachedBlockByteCount, wild.getCachedBlockByteCount());
+		}
+
+		const ChunkManager &chunkManager = levelInst.getChunkManager();
+
+		size_t chunkVoxelByteCount = 0;
+		for (int i = 0; i < chunkManager.getChunkCount(); i++)
+		{
+			chunkVoxelByteCount += chunkManager.getChunk(i).getVoxelByteCount();
+		}
+
+		const double stepCountReal = static_cast<double>(settings.wildWalkSteps + 1);
+		std::cout << "Wild chunk boundaries crossed: " << settings.wildWalkSteps << "\n" <<
+			"Chunk distance: " << chunkDistance << ", active chunks: " << chunkManager.getChunkCount() << "\n" <<
+			"Steps with city blocks in range: " << cityStepCount << "\n" <<
+			"Average update: " << ((updateTime / stepCountReal) * 1000.0) << " ms, slowest: " <<
+			(maxUpdateTime * 1000.0) << " ms\n" <<
+			"Cached wild blocks: " << peakCachedBlockCount << " at most, limit " << maxCachedBlockCount << "\n" <<
+			"Cached wild block voxel memory: " << (peakCachedBlockByteCount / 1024) << " KB at most\n" <<
+			"Active chunk voxel memory: " << (chunkVoxelByteCount / 1024) << " KB\n";
+
+		if (peakCachedBlockCount > maxCachedBlockCount)
+		{
+			std::cout << "FAIL: the wild block cache grew past the chunks in range.\n";
+			return EXIT_FAILURE;
+		}
+
+		// The same walk through the level data the game still streams wild blocks into on the main
+		// thread, with the game's per-tick load limit. The first step is a level load so it has no limit.
+		BenchLevel level;
+		if (!tryLoadLevel(settings, BenchScene::Wilderness, settings.hour, context, &level))
+		{
+			return EXIT_FAILURE;
+		}
+
+		LevelData &levelData = level.gameData->getActiveWorld().getActiveLevel();
+		double levelUpdateTime = 0.0;
+		double maxLevelUpdateTime = 0.0;
+		int pendingStepCount = 0;
+		for (int step = 0; step <= settings.wildWalkSteps; step++)
+		{
+			const int maxLoadCount = (step == 0) ? -1 : LevelData::MAX_WILD_BLOCK_LOADS_PER_TICK;
+			const auto updateStartTime = Clock::now();
+			levelData.updateWildBlocks(getCenterChunk(step), chunkDistance, maxLoadCount, context.binaryAssetLibrary,
+				nullptr);
+			const double stepUpdateTime = std::chrono::duration<double>(Clock::now() - updateStartTime).count();
+
+			if (step > 0)
+			{
+				levelUpdateTime += stepUpdateTime;
+				maxLevelUpdateTime = std::max(maxLevelUpdateTime, stepUpdateTime);
+			}
+
+			const std::vector<ChunkInt2> &loadedChunks = levelData.getLoadedWildChunks();
+			const int loadedInRangeCount = static_cast<int>(std::count_if(loadedChunks.begin(), loadedChunks.end(),
+				[&getCenterChunk, step, chunkDistance](const ChunkInt2 &chunk)
+			{
+				return ChunkUtils::isWithinActiveRange(getCenterChunk(step), chunk, chunkDistance);
+			}));
+
+			if (loadedInRangeCount < maxCachedBlockCount)
+			{
+				pendingStepCount++;
+			}
+		}
+
+		const double levelStepCountReal = static_cast<double>(std::max(settings.wildWalkSteps, 1));
+		std::cout << "Level data block update: " << ((levelUpdateTime / levelStepCountReal) * 1000.0) <<
+			" ms average, slowest: " << (maxLevelUpdateTime * 1000.0) << " ms\n" <<
+			"Steps ending with blocks in range still unloaded: " << pendingStepCount << "\n";
+
+		return EXIT_SUCCESS;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	BenchSettings settings;
+	if (!tryParseSettings(argc, argv, &settings))
+	{
+		printUsage();
+		return EXIT_FAILURE;
+	}
+
+	try
+	{
+		// Heap allocated since the asset libraries and renderer are large.
+		auto context = std::make_unique<BenchContext>();
+		if (!tryInitContext(settings, *context))
+		{
+			return EXIT_FAILURE;
+		}
+
+		if (settings.chunkStressSteps > 0)
+		{
+			return runChunkStress(settings, *context);
+		}
+
+		if (settings.chunkDeltaVoxels > 0)
+		{
+			return runChunkDelta(settings, *context);
+		}
+
+		if (settings.voxelReadMillions > 0)
+		{
+			return runVoxelStorage(settings, *context);
+		}
+
+		if (settings.textureLookupMillions > 0)
+		{
+			return runTextureLookups(settings, *context);
+		}
+
+		if (settings.wildWalkSteps > 0)
+		{
+			return runWildWalk(settings, *context);
+		}
+
+		if (settings.kernelDiff)
+		{
+			return runKernelDiff(settings, *context);
+		}
+
+		return settings.goldenPath.empty() ? runBench(settings, *context) : runGolden(settings, *context);
+	}
+	catch (const std::exception &e)
+	{
+		DebugLogError("Exception! " + std::string(e.what()));
+		return EXIT_FAILURE;
+	}
+}
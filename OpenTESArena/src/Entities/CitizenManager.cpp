@@ -7,6 +7,7 @@
 #include "../Assets/ArenaPaletteName.h"
 #include "../Game/CardinalDirectionName.h"
 #include "../Game/Game.h"
+#include "../World/ChunkUtils.h"
 #include "../World/MapType.h"
 #include "../World/VoxelType.h"
 
@@ -33,8 +34,8 @@ bool CitizenManager::shouldSpawn(Game &game) const
 	return (activeMapType == MapType::City) || (activeMapType == MapType::Wilderness);*/
 }
 
-void CitizenManager::spawnCitizens(int raceID, const VoxelGrid &voxelGrid, EntityManager &entityManager,
-	const LocationDefinition &locationDef, const EntityDefinitionLibrary &entityDefLibrary,
+void CitizenManager::spawnCitizens(int raceID, const VoxelGrid &voxelGrid,
+	const std::vector<ChunkInt2> &spawnChunks, EntityManager &entityManager, const LocationDefinition &locationDef, const EntityDefinitionLibrary &entityDefLibrary,
 	const BinaryAssetLibrary &binaryAssetLibrary, Random &random, TextureManager &textureManager,
 	Renderer &renderer)
 {
@@ -110,14 +111,25 @@ void CitizenManager::spawnCitizens(int raceID, const VoxelGrid &voxelGrid, Entit
 	{
 		// Find suitable spawn position; might not succeed if there is no available spot.
 		bool foundSpawnPosition = false;
-		const NewInt2 spawnPositionXZ = [&voxelGrid, &random, &foundSpawnPosition]()
+		const NewInt2 spawnPositionXZ = [&voxelGrid, &spawnChunks, &random, &foundSpawnPosition]()
 		{
 			constexpr int spawnTriesCount = 50;
 			for (int spawnTry = 0; spawnTry < spawnTriesCount; spawnTry++)
 			{
-				const NewInt2 voxel(
-					random.next() % voxelGrid.getWidth(),
-					random.next() % voxelGrid.getDepth());
+				const NewInt2 voxel = [&voxelGrid, &spawnChunks, &random]()
+				{
+					if (spawnChunks.empty())
+					{
+						return NewInt2(
+							random.next() % voxelGrid.getWidth(),
+							random.next() % voxelGrid.getDepth());
+					}
+
+					const ChunkInt2 &chunk = spawnChunks[random.next() % spawnChunks.size()];
+					return NewInt2(
+						(chunk.x * ChunkUtils::CHUNK_DIM) + (random.next() % ChunkUtils::CHUNK_DIM),
+						(chunk.y * ChunkUtils::CHUNK_DIM) + (random.next() % ChunkUtils::CHUNK_DIM));
+				}();
 
 				const uint16_t voxelID = voxelGrid.getVoxel(voxel.x, 1, voxel.y);
 				const uint16_t groundVoxelID = voxelGrid.getVoxel(voxel.x, 0, voxel.y);
@@ -229,6 +241,7 @@ void CitizenManager::tick(Game &game)
 			auto &worldData = gameData.getActiveWorld();
 			auto &levelData = worldData.getActiveLevel();
 			const auto &voxelGrid = levelData.getVoxelGrid();
+			const auto &loadedWildChunks = levelData.getLoadedWildChunks();
 			auto &entityManager = levelData.getEntityManager();
 			const auto &provinceDef = gameData.getProvinceDefinition();
 			const auto &locationDef = gameData.getLocationDefinition();
@@ -237,8 +250,8 @@ void CitizenManager::tick(Game &game)
 			auto &random = game.getRandom();
 			auto &textureManager = game.getTextureManager();
 			auto &renderer = game.getRenderer();
-			this->spawnCitizens(provinceDef.getRaceID(), voxelGrid, entityManager, locationDef, entityDefLibrary,
-				binaryAssetLibrary, random, textureManager, renderer);
+			this->spawnCitizens(provinceDef.getRaceID(), voxelGrid, loadedWildChunks, entityManager, locationDef,
+				entityDefLibrary, binaryAssetLibrary, random, textureManager, renderer);
 
 			this->stateType = StateType::HasSpawned;
 		}
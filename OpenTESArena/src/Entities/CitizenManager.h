@@ -41,8 +41,10 @@ private:
 public:
 	CitizenManager();
 
-	void spawnCitizens(int raceID, const VoxelGrid &voxelGrid, EntityManager &entityManager,
-		const LocationDefinition &locationDef, const EntityDefinitionLibrary &entityDefLibrary,
+	// Spawns citizens on random floor voxels. If spawn chunks are given (i.e., the loaded wild
+	// blocks), citizens are only spawned in them since the rest of the grid is air.
+	void spawnCitizens(int raceID, const VoxelGrid &voxelGrid, const std::vector<ChunkInt2> &spawnChunks,
+		EntityManager &entityManager, const LocationDefinition &locationDef, const EntityDefinitionLibrary &entityDefLibrary,
 		const BinaryAssetLibrary &binaryAssetLibrary, Random &random, TextureManager &textureManager,
 		Renderer &renderer);
 	void clearCitizens(EntityManager &entityManager);
@@ -716,62 +716,15 @@ void EntityManager::getEntityVisibilityData(const Entity &entity, const CoordDou
 
 	// Get animation angle based on entity direction relative to some camera/eye.
 	const int angleCount = animInstState.getKeyframeListCount();
-	const Radians animAngle = [&entity, &eye2D, angleCount]()
-	{
-		if (entity.getEntityType() == EntityType::Static)
-		{
-			// Static entities always face the camera.
-			return 0.0;
-		}
-		else if (entity.getEntityType() == EntityType::Dynamic)
-		{
-			// Dynamic entities are angle-dependent.
-			const DynamicEntity &dynamicEntity = static_cast<const DynamicEntity&>(entity);
-			const NewDouble2 &entityDir = dynamicEntity.getDirection();
-			const VoxelDouble2 diffDir = (eye2D - dynamicEntity.getPosition()).normalized();
-
-			const Radians entityAngle = MathUtils::fullAtan2(entityDir);
-			const Radians diffAngle = MathUtils::fullAtan2(diffDir);
-
-			// Use the difference of the two angles to get the relative angle.
-			const Radians resultAngle = Constants::TwoPi + (entityAngle - diffAngle);
-
-			// Angle bias so the final direction is centered within its angle range.
-			const Radians angleBias = (Constants::TwoPi / static_cast<double>(angleCount)) * 0.50;
-
-			return std::fmod(resultAngle + angleBias, Constants::TwoPi);
-		}
-		else
-		{
-			DebugUnhandledReturnMsg(double,
-				std::to_string(static_cast<int>(entity.getEntityType())));
-		}
-	}();
-
-	// Index into animation keyframe lists for the state.
-	outVisData.angleIndex = [angleCount, animAngle]()
-	{
-		const double angleCountReal = static_cast<double>(angleCount);
-		const double anglePercent = animAngle / Constants::TwoPi;
-		const int angleIndex = static_cast<int>(angleCountReal * anglePercent);
-		return std::clamp(angleIndex, 0, angleCount - 1);
-	}();
+	outVisData.angleIndex = EntityUtils::getAnimAngleIndex(entity, eye2D, angleCount);
 
 	// Keyframe list for the current state and angle.
 	const EntityAnimationDefinition::KeyframeList &animDefKeyframeList =
 		animDefState.getKeyframeList(outVisData.angleIndex);
 
 	// Progress through current animation.
-	outVisData.keyframeIndex = [&animInst, &animDefState, &animDefKeyframeList]()
-	{
-		const int keyframeCount = animDefKeyframeList.getKeyframeCount();
-		const double keyframeCountReal = static_cast<double>(keyframeCount);
-		const double animCurSeconds = animInst.getCurrentSeconds();
-		const double animTotalSeconds = animDefState.getTotalSeconds();
-		const double animPercent = animCurSeconds / animTotalSeconds;
-		const int keyframeIndex = static_cast<int>(keyframeCountReal * animPercent);
-		return std::clamp(keyframeIndex, 0, keyframeCount - 1);
-	}();
+	outVisData.keyframeIndex = EntityUtils::getAnimKeyframeIndex(animInst.getCurrentSeconds(),
+		animDefState.getTotalSeconds(), animDefKeyframeList.getKeyframeCount());
 
 	// Current animation frame based on everything above.
 	const EntityAnimationDefinition::Keyframe &animDefKeyframe =
@@ -786,24 +739,8 @@ void EntityManager::getEntityVisibilityData(const Entity &entity, const CoordDou
 
 	// If the entity is in a raised platform voxel, they are set on top of it.
 	const CoordDouble2 &entityPosition = entity.getPosition();
-	const double raisedPlatformYOffset = [ceilingHeight, &voxelGrid, &entityPosition]()
-	{
-		const NewDouble2 absoluteEntityPositionXZ = VoxelUtils::coordToNewPoint(entityPosition);
-		const NewInt2 absoluteEntityVoxelPosXZ = VoxelUtils::pointToVoxel(absoluteEntityPositionXZ);
-		const uint16_t voxelID = voxelGrid.getVoxel(absoluteEntityVoxelPosXZ.x, 1, absoluteEntityVoxelPosXZ.y);
-		const VoxelDefinition &voxelDef = voxelGrid.getVoxelDef(voxelID);
-
-		if (voxelDef.type == VoxelType::Raised)
-		{
-			const VoxelDefinition::RaisedData &raised = voxelDef.raised;
-			return (raised.yOffset + raised.ySize) * ceilingHeight;
-		}
-		else
-		{
-			// No raised platform offset.
-			return 0.0;
-		}
-	}();
+	const double raisedPlatformYOffset = EntityUtils::getRaisedPlatformYOffset(entityPosition,
+		ceilingHeight, voxelGrid);
 
 	// Bottom center of flat.
 	const VoxelDouble3 newCoordPoint(
@@ -987,6 +924,13 @@ void EntityManager::clearChunk(const ChunkInt2 &coord)
 	dynamicGroup.clear();
 }
 
+void EntityManager::releaseEntityID(EntityID id)
+{
+	DebugAssert(id != EntityManager::NO_ID);
+	DebugAssert(std::find(this->freeIDs.begin(), this->freeIDs.end(), id) == this->freeIDs.end());
+	this->freeIDs.push_back(id);
+}
+
 void EntityManager::tick(Game &game, double dt)
 {
 	// Only want to tick entities near the player, so get the chunks near the player.
@@ -192,9 +192,13 @@ public:
 	// Deletes all entities and data in the manager.
 	void clear();
 
-	// Deletes all entities in the given chunk.
+	// Deletes all entities in the given chunk. Their IDs aren't reused until given back with
+	// releaseEntityID().
 	void clearChunk(const ChunkInt2 &coord);
 
+	// Makes the ID of an entity deleted by clearChunk() available to new entities.
+	void releaseEntityID(EntityID id);
+
 	// Ticks the entity manager by delta time.
 	void tick(Game &game, double dt);
 };
@@ -1,8 +1,18 @@
+#include <algorithm>
+#include <cmath>
+
 #include "CharacterClassDefinition.h"
 #include "CharacterClassLibrary.h"
+#include "DynamicEntity.h"
 #include "EntityDefinition.h"
 #include "EntityDefinitionLibrary.h"
+#include "EntityType.h"
 #include "EntityUtils.h"
+#include "../Math/Constants.h"
+#include "../Math/MathUtils.h"
+#include "../World/VoxelDefinition.h"
+#include "../World/VoxelGrid.h"
+#include "../World/VoxelType.h"
 
 std::string EntityUtils::defTypeToString(const EntityDefinition &entityDef)
 {
@@ -112,3 +122,71 @@ bool EntityUtils::tryGetDisplayName(const EntityDefinition &entityDef,
 
 	return true;
 }
+
+int EntityUtils::getAnimAngleIndex(const Entity &entity, const CoordDouble2 &eye2D, int angleCount)
+{
+	const Radians animAngle = [&entity, &eye2D, angleCount]()
+	{
+		if (entity.getEntityType() == EntityType::Static)
+		{
+			// Static entities always face the camera.
+			return 0.0;
+		}
+		else if (entity.getEntityType() == EntityType::Dynamic)
+		{
+			// Dynamic entities are angle-dependent.
+			const DynamicEntity &dynamicEntity = static_cast<const DynamicEntity&>(entity);
+			const NewDouble2 &entityDir = dynamicEntity.getDirection();
+			const VoxelDouble2 diffDir = (eye2D - dynamicEntity.getPosition()).normalized();
+
+			const Radians entityAngle = MathUtils::fullAtan2(entityDir);
+			const Radians diffAngle = MathUtils::fullAtan2(diffDir);
+
+			// Use the difference of the two angles to get the relative angle.
+			const Radians resultAngle = Constants::TwoPi + (entityAngle - diffAngle);
+
+			// Angle bias so the final direction is centered within its angle range.
+			const Radians angleBias = (Constants::TwoPi / static_cast<double>(angleCount)) * 0.50;
+
+			return std::fmod(resultAngle + angleBias, Constants::TwoPi);
+		}
+		else
+		{
+			DebugUnhandledReturnMsg(double,
+				std::to_string(static_cast<int>(entity.getEntityType())));
+		}
+	}();
+
+	const double angleCountReal = static_cast<double>(angleCount);
+	const double anglePercent = animAngle / Constants::TwoPi;
+	const int angleIndex = static_cast<int>(angleCountReal * anglePercent);
+	return std::clamp(angleIndex, 0, angleCount - 1);
+}
+
+int EntityUtils::getAnimKeyframeIndex(double currentSeconds, double totalSeconds, int keyframeCount)
+{
+	const double keyframeCountReal = static_cast<double>(keyframeCount);
+	const double animPercent = currentSeconds / totalSeconds;
+	const int keyframeIndex = static_cast<int>(keyframeCountReal * animPercent);
+	return std::clamp(keyframeIndex, 0, keyframeCount - 1);
+}
+
+double EntityUtils::getRaisedPlatformYOffset(const CoordDouble2 &position, double ceilingHeight,
+	const VoxelGrid &voxelGrid)
+{
+	const NewDouble2 absolutePositionXZ = VoxelUtils::coordToNewPoint(position);
+	const NewInt2 absoluteVoxelPosXZ = VoxelUtils::pointToVoxel(absolutePositionXZ);
+	const uint16_t voxelID = voxelGrid.getVoxel(absoluteVoxelPosXZ.x, 1, absoluteVoxelPosXZ.y);
+	const VoxelDefinition &voxelDef = voxelGrid.getVoxelDef(voxelID);
+
+	if (voxelDef.type == VoxelType::Raised)
+	{
+		const VoxelDefinition::RaisedData &raised = voxelDef.raised;
+		return (raised.yOffset + raised.ySize) * ceilingHeight;
+	}
+	else
+	{
+		// No raised platform offset.
+		return 0.0;
+	}
+}
@@ -3,6 +3,8 @@
 
 #include <string>
 
+#include "../World/VoxelUtils.h"
+
 // Entity instance handle.
 using EntityID = int;
 
@@ -13,8 +15,10 @@ using EntityDefID = int;
 using EntityRenderID = int;
 
 class CharacterClassLibrary;
+class Entity;
 class EntityDefinition;
 class EntityDefinitionLibrary;
+class VoxelGrid;
 
 namespace EntityUtils
 {
@@ -33,6 +37,17 @@ namespace EntityUtils
 	// Returns whether the entity definition has a display name.
 	bool tryGetDisplayName(const EntityDefinition &entityDef,
 		const CharacterClassLibrary &charClassLibrary, std::string *outName);
+
+	// Gets the keyframe list (i.e., facing) of an entity's animation state as seen from the eye.
+	// Static entities always use the first one.
+	int getAnimAngleIndex(const Entity &entity, const CoordDouble2 &eye2D, int angleCount);
+
+	// Gets the keyframe to show at the given time in an animation state.
+	int getAnimKeyframeIndex(double currentSeconds, double totalSeconds, int keyframeCount);
+
+	// Gets how far an entity is raised by a platform voxel it's standing in, or zero if none.
+	double getRaisedPlatformYOffset(const CoordDouble2 &position, double ceilingHeight,
+		const VoxelGrid &voxelGrid);
 }
 
 #endif
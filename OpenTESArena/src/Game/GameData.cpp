@@ -23,6 +23,7 @@
 #include "../Media/TextureManager.h"
 #include "../Rendering/Renderer.h"
 #include "../World/ArenaVoxelUtils.h"
+#include "../World/ArenaWildUtils.h"
 #include "../World/LocationDefinition.h"
 #include "../World/LocationInstance.h"
 #include "../World/LocationType.h"
@@ -432,7 +433,7 @@ bool GameData::loadCity(const LocationDefinition &locationDef, const ProvinceDef
 
 bool GameData::loadWilderness(const LocationDefinition &locationDef, const ProvinceDefinition &provinceDef,
 	const NewInt2 &gatePos, const NewInt2 &transitionDir, bool debug_ignoreGatePos, WeatherType weatherType,
-	int starCount, const EntityDefinitionLibrary &entityDefLibrary,
+	int starCount, int chunkDistance, const EntityDefinitionLibrary &entityDefLibrary,
 	const CharacterClassLibrary &charClassLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
 	Random &random, TextureManager &textureManager, Renderer &renderer)
 {
@@ -449,29 +450,17 @@ bool GameData::loadWilderness(const LocationDefinition &locationDef, const Provi
 		return false;
 	}
 
-	// Call wilderness WorldData loader.
-	this->clearWorldDatas();
-	this->worldDatas.push(std::make_unique<WorldData>(WorldData::loadWilderness(
-		locationDef, provinceDef, weatherType, this->date.getDay(), starCount,
-		binaryAssetLibrary, textureManager)));
-
-	// Set initial level active in the renderer.
-	WorldData &worldData = *this->worldDatas.top();
-	LevelData &activeLevel = worldData.getActiveLevel();
-	activeLevel.setActive(this->nightLightsAreActive(), worldData, this->getProvinceDefinition(),
-		this->getLocationDefinition(), entityDefLibrary, charClassLibrary, binaryAssetLibrary,
-		random, this->citizenManager, textureManager, renderer);
-
-	// Get player starting point in the wilderness.
-	const auto &voxelGrid = activeLevel.getVoxelGrid();
-	const NewDouble2 startPoint = [&gatePos, &transitionDir, debug_ignoreGatePos, &voxelGrid]()
+	// Get player starting point in the wilderness. It's needed before loading since only the
+	// blocks around it are generated.
+	const NewDouble2 startPoint = [&gatePos, &transitionDir, debug_ignoreGatePos]()
 	{
 		if (debug_ignoreGatePos)
 		{
 			// Just use center of the wilderness for testing.
+			const int wildVoxelCount = ArenaWildUtils::WILD_WIDTH * RMDFile::WIDTH;
 			return NewDouble2(
-				static_cast<SNDouble>(voxelGrid.getWidth() / 2) - 0.50,
-				static_cast<WEDouble>(voxelGrid.getDepth() / 2) - 0.50);
+				static_cast<SNDouble>(wildVoxelCount / 2) - 0.50,
+				static_cast<WEDouble>(wildVoxelCount / 2) - 0.50);
 		}
 		else
 		{
@@ -486,6 +475,21 @@ bool GameData::loadWilderness(const LocationDefinition &locationDef, const Provi
 		}
 	}();
 
+	const ChunkInt2 startChunk = VoxelUtils::newPointToCoord(startPoint).chunk;
+
+	// Call wilderness WorldData loader.
+	this->clearWorldDatas();
+	this->worldDatas.push(std::make_unique<WorldData>(WorldData::loadWilderness(
+		locationDef, provinceDef, weatherType, this->date.getDay(), starCount, startChunk,
+		chunkDistance, binaryAssetLibrary, textureManager)));
+
+	// Set initial level active in the renderer.
+	WorldData &worldData = *this->worldDatas.top();
+	LevelData &activeLevel = worldData.getActiveLevel();
+	activeLevel.setActive(this->nightLightsAreActive(), worldData, this->getProvinceDefinition(),
+		this->getLocationDefinition(), entityDefLibrary, charClassLibrary, binaryAssetLibrary,
+		random, this->citizenManager, textureManager, renderer);
+
 	this->setTransitionedPlayerPosition(NewDouble3(
 		startPoint.x, activeLevel.getCeilingHeight() + Player::HEIGHT, startPoint.y));
 
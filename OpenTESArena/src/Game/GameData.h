@@ -151,9 +151,10 @@ public:
 	// Reads in data from wilderness and writes it to the game data.
 	bool loadWilderness(const LocationDefinition &locationDef, const ProvinceDefinition &provinceDef,
 		const NewInt2 &gatePos, const NewInt2 &transitionDir, bool debug_ignoreGatePos,
-		WeatherType weatherType, int starCount, const EntityDefinitionLibrary &entityDefLibrary, 
-		const CharacterClassLibrary &charClassLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
-		Random &random, TextureManager &textureManager, Renderer &renderer);
+		WeatherType weatherType, int starCount, int chunkDistance,
+		const EntityDefinitionLibrary &entityDefLibrary, const CharacterClassLibrary &charClassLibrary,
+		const BinaryAssetLibrary &binaryAssetLibrary, Random &random, TextureManager &textureManager,
+		Renderer &renderer);
 
 	const WeatherList &getWeathersArray() const;
 
@@ -147,6 +147,8 @@ void set##section##_##name(const std::string &value) \
 	OPTION_DOUBLE(Graphics, CursorScale)
 	OPTION_BOOL(Graphics, ModernInterface)
 	OPTION_INT(Graphics, RenderThreadsMode)
+	OPTION_BOOL(Graphics, PipelinedRendering)
+	OPTION_BOOL(Graphics, DynamicResolution)
 
 	OPTION_DOUBLE(Audio, MusicVolume)
 	OPTION_DOUBLE(Audio, SoundVolume)
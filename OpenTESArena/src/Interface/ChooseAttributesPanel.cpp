@@ -253,7 +253,9 @@ ChooseAttributesPanel::ChooseAttributesPanel(Game &game)
 						renderer.initializeWorldRendering(
 							options.getGraphics_ResolutionScale(),
 							fullGameWindow,
-							options.getGraphics_RenderThreadsMode());
+							options.getGraphics_RenderThreadsMode(),
+							options.getGraphics_PipelinedRendering(),
+							options.getGraphics_DynamicResolution());
 
 						std::unique_ptr<GameData> gameData = [this, &game, &binaryAssetLibrary]()
 						{
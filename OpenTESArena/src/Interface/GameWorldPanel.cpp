@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <cmath>
+#include <numeric>
 
 #include "SDL.h"
 
@@ -2459,8 +2460,8 @@ void GameWorldPanel::handleWorldTransition(const Physics::Hit &hit, int menuID)
 					const bool ignoreGatePos = false;
 					if (!gameData.loadWilderness(locationDef, provinceDef, gatePos, transitionDir,
 						ignoreGatePos, gameData.getWeatherType(), starCount,
-						game.getEntityDefinitionLibrary(), game.getCharacterClassLibrary(),
-						binaryAssetLibrary, game.getRandom(), textureManager, renderer))
+						game.getOptions().getMisc_ChunkDistance(), game.getEntityDefinitionLibrary(),
+						game.getCharacterClassLibrary(), binaryAssetLibrary, game.getRandom(), textureManager, renderer))
 					{
 						DebugCrash("Couldn't load wilderness \"" + locationDef.getName() + "\".");
 					}
@@ -2817,7 +2818,7 @@ void GameWorldPanel::drawProfiler(int profilerLevel, Renderer &renderer)
 
 		const Renderer::ProfilerData &profilerData = renderer.getProfilerData();
 		const Int2 renderDims(profilerData.width, profilerData.height);
-		const double resolutionScale = options.getGraphics_ResolutionScale();
+		const double resolutionScale = renderer.getResolutionScale();
 
 		auto &gameData = game.getGameData();
 		const auto &player = gameData.getPlayer();
@@ -2982,6 +2983,47 @@ void GameWorldPanel::drawProfiler(int profilerLevel, Renderer &renderer)
 
 		renderer.drawOriginal(textBox.getTexture(), textBox.getX(), textBox.getY());
 		renderer.drawOriginal(frameTimesGraph, textBox.getX(), 94);
+
+		// Render thread load balancing, below the graph.
+		const int threadCount = static_cast<int>(profilerData.threadBusyTimes.size());
+		if (threadCount > 0)
+		{
+			DebugAssert(profilerData.threadIdleTimes.size() == profilerData.threadBusyTimes.size());
+			const auto busyMinMax = std::minmax_element(
+				profilerData.threadBusyTimes.begin(), profilerData.threadBusyTimes.end());
+			const double idleTotal = std::accumulate(
+				profilerData.threadIdleTimes.begin(), profilerData.threadIdleTimes.end(), 0.0);
+			const double idleAverage = idleTotal / static_cast<double>(threadCount);
+			const double flatBinAverage = (profilerData.flatBinCount > 0) ?
+				(static_cast<double>(profilerData.flatBinEntryCount) /
+					static_cast<double>(profilerData.flatBinCount)) : 0.0;
+
+			const std::string threadsText =
+				"Threads: " + std::to_string(threadCount) + ", busy: " +
+				String::fixedPrecision(*busyMinMax.first * 1000.0, 2) + "-" +
+				String::fixedPrecision(*busyMinMax.second * 1000.0, 2) + "ms, idle: " +
+				String::fixedPrecision(idleAverage * 1000.0, 2) + "ms" + "\n" +
+				"Stolen tiles: " + std::to_string(profilerData.stolenTileCount) + "\n" +
+				"Flat bins: " + std::to_string(profilerData.flatBinCount) + ", avg: " +
+				String::fixedPrecision(flatBinAverage, 1) + ", max: " +
+				std::to_string(profilerData.maxFlatBinSize) + "\n" +
+				"Phases: vis " + String::fixedPrecision(profilerData.visibilityTime * 1000.0, 2) +
+				", sky " + String::fixedPrecision(profilerData.skyTime * 1000.0, 2) +
+				", distant " + String::fixedPrecision(profilerData.distantSkyTime * 1000.0, 2) +
+				", voxels " + String::fixedPrecision(profilerData.voxelTime * 1000.0, 2) +
+				", flats " + String::fixedPrecision(profilerData.flatTime * 1000.0, 2) + "ms";
+
+			const RichTextString threadsRichText(
+				threadsText,
+				FontName::D,
+				Color::White,
+				TextAlignment::Left,
+				fontLibrary);
+
+			const int threadsY = 94 + frameTimesGraph.getHeight() + 2;
+			const TextBox threadsTextBox(x, threadsY, threadsRichText, fontLibrary, renderer);
+			renderer.drawOriginal(threadsTextBox.getTexture(), threadsTextBox.getX(), threadsTextBox.getY());
+		}
 	}
 }
 
@@ -3174,7 +3216,7 @@ void GameWorldPanel::render(Renderer &renderer)
 		ambientPercent, gameData.getDaytimePercent(), gameData.getChasmAnimPercent(), latitude,
 		gameData.nightLightsAreActive(), isExterior, options.getMisc_PlayerHasLight(),
 		options.getMisc_ChunkDistance(), level.getCeilingHeight(), level, game.getEntityDefinitionLibrary(),
-		defaultPalette);
+		defaultPalette, options.getGraphics_TargetFPS());
 
 	const TextureBuilderID gameWorldInterfaceTextureBuilderID =
 		GameWorldPanel::getGameWorldInterfaceTextureBuilderID(textureManager);
@@ -332,7 +332,8 @@ MainMenuPanel::MainMenuPanel(Game &game)
 			const auto &options = game.getOptions();
 			const bool fullGameWindow = options.getGraphics_ModernInterface();
 			renderer.initializeWorldRendering(options.getGraphics_ResolutionScale(),
-				fullGameWindow, options.getGraphics_RenderThreadsMode());
+				fullGameWindow, options.getGraphics_RenderThreadsMode(),
+				options.getGraphics_PipelinedRendering(), options.getGraphics_DynamicResolution());
 
 			// Game data instance, to be initialized further by one of the loading methods below.
 			// Create a player with random data for testing.
@@ -583,7 +584,8 @@ MainMenuPanel::MainMenuPanel(Game &game)
 				// Load wilderness into game data. Location data is loaded, too.
 				const bool ignoreGatePos = true;
 				if (!gameData->loadWilderness(locationDef, provinceDef, Int2(), Int2(), ignoreGatePos,
-					filteredWeatherType, starCount, game.getEntityDefinitionLibrary(),
+					filteredWeatherType, starCount, game.getOptions().getMisc_ChunkDistance(),
+					game.getEntityDefinitionLibrary(),
 					game.getCharacterClassLibrary(), binaryAssetLibrary, game.getRandom(),
 					game.getTextureManager(), renderer))
 				{
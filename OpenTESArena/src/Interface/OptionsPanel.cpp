@@ -220,6 +220,7 @@ const std::string OptionsPanel::DEV_TAB_NAME = "Dev";
 
 // Graphics.
 const std::string OptionsPanel::CURSOR_SCALE_NAME = "Cursor Scale";
+const std::string OptionsPanel::DYNAMIC_RESOLUTION_NAME = "Dynamic Resolution";
 const std::string OptionsPanel::FPS_LIMIT_NAME = "FPS Limit";
 const std::string OptionsPanel::WINDOW_MODE_NAME = "Window Mode";
 const std::string OptionsPanel::LETTERBOX_MODE_NAME = "Letterbox Mode";
@@ -419,6 +420,19 @@ OptionsPanel::OptionsPanel(Game &game)
 			value, fullGameWindow);
 	}));
 
+	this->graphicsOptions.push_back(std::make_unique<BoolOption>(
+		OptionsPanel::DYNAMIC_RESOLUTION_NAME,
+		"Lowers the resolution in heavy scenes to keep up with the FPS limit.\nResolution Scale is the highest it will go.",
+		options.getGraphics_DynamicResolution(),
+		[this](bool value)
+	{
+		auto &game = this->getGame();
+		auto &options = game.getOptions();
+		auto &renderer = game.getRenderer();
+		options.setGraphics_DynamicResolution(value);
+		renderer.setDynamicResolution(value);
+	}));
+
 	this->graphicsOptions.push_back(std::make_unique<DoubleOption>(
 		OptionsPanel::VERTICAL_FOV_NAME,
 		"Recommended 60.0 for classic mode.",
@@ -136,6 +136,7 @@ private:
 
 	// Graphics.
 	static const std::string CURSOR_SCALE_NAME;
+	static const std::string DYNAMIC_RESOLUTION_NAME;
 	static const std::string FPS_LIMIT_NAME;
 	static const std::string WINDOW_MODE_NAME;
 	static const std::string LETTERBOX_MODE_NAME;
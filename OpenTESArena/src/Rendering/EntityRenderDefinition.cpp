@@ -1 +1,124 @@
-#include "EntityRenderDefinition.h"
\ No newline at end of file
+#include "EntityRenderDefinition.h"
+#include "../Assets/MIFUtils.h"
+#include "../Entities/EntityDefinition.h"
+#include "../Entities/EntityUtils.h"
+
+#include "components/debug/Debug.h"
+
+EntityRenderDefinition::EntityRenderDefinition()
+{
+	this->yOffset = 0.0;
+	this->lightIntensity = 0;
+	this->streetlight = false;
+}
+
+void EntityRenderDefinition::init(const EntityDefinition &entityDef)
+{
+	this->states.clear();
+	this->keyframeLists.clear();
+	this->keyframeSizes.clear();
+
+	const EntityAnimationDefinition &animDef = entityDef.getAnimDef();
+	for (int i = 0; i < animDef.getStateCount(); i++)
+	{
+		const EntityAnimationDefinition::State &animDefState = animDef.getState(i);
+
+		State state;
+		state.firstKeyframeListIndex = static_cast<int>(this->keyframeLists.size());
+		state.keyframeListCount = animDefState.getKeyframeListCount();
+		state.totalSeconds = animDefState.getTotalSeconds();
+		this->states.push_back(state);
+
+		for (int j = 0; j < animDefState.getKeyframeListCount(); j++)
+		{
+			const EntityAnimationDefinition::KeyframeList &animDefKeyframeList = animDefState.getKeyframeList(j);
+
+			KeyframeList keyframeList;
+			keyframeList.firstKeyframeIndex = static_cast<int>(this->keyframeSizes.size());
+			keyframeList.keyframeCount = animDefKeyframeList.getKeyframeCount();
+			this->keyframeLists.push_back(keyframeList);
+
+			for (int k = 0; k < animDefKeyframeList.getKeyframeCount(); k++)
+			{
+				const EntityAnimationDefinition::Keyframe &animDefKeyframe = animDefKeyframeList.getKeyframe(k);
+				this->keyframeSizes.emplace_back(animDefKeyframe.getWidth(), animDefKeyframe.getHeight());
+			}
+		}
+	}
+
+	const int baseYOffset = EntityUtils::getYOffset(entityDef);
+	this->yOffset = static_cast<double>(-baseYOffset) / MIFUtils::ARENA_UNITS;
+
+	int intensity;
+	if (EntityUtils::tryGetLightIntensity(entityDef, &intensity))
+	{
+		this->lightIntensity = intensity;
+		this->streetlight = false;
+	}
+	else
+	{
+		this->lightIntensity = 0;
+		this->streetlight = (entityDef.getType() == EntityDefinition::Type::Doodad) &&
+			entityDef.getDoodad().streetlight;
+	}
+}
+
+bool EntityRenderDefinition::isValid() const
+{
+	return this->states.size() > 0;
+}
+
+int EntityRenderDefinition::getStateCount() const
+{
+	return static_cast<int>(this->states.size());
+}
+
+int EntityRenderDefinition::getKeyframeListCount(int stateIndex) const
+{
+	DebugAssertIndex(this->states, stateIndex);
+	return this->states[stateIndex].keyframeListCount;
+}
+
+int EntityRenderDefinition::getKeyframeCount(int stateIndex, int angleIndex) const
+{
+	DebugAssertIndex(this->states, stateIndex);
+	const State &state = this->states[stateIndex];
+	DebugAssert(angleIndex >= 0);
+	DebugAssert(angleIndex < state.keyframeListCount);
+	const int keyframeListIndex = state.firstKeyframeListIndex + angleIndex;
+	return this->keyframeLists[keyframeListIndex].keyframeCount;
+}
+
+double EntityRenderDefinition::getTotalSeconds(int stateIndex) const
+{
+	DebugAssertIndex(this->states, stateIndex);
+	return this->states[stateIndex].totalSeconds;
+}
+
+const Double2 &EntityRenderDefinition::getKeyframeSize(int stateIndex, int angleIndex, int keyframeIndex) const
+{
+	DebugAssertIndex(this->states, stateIndex);
+	const State &state = this->states[stateIndex];
+	DebugAssert(angleIndex >= 0);
+	DebugAssert(angleIndex < state.keyframeListCount);
+	const KeyframeList &keyframeList = this->keyframeLists[state.firstKeyframeListIndex + angleIndex];
+	DebugAssert(keyframeIndex >= 0);
+	DebugAssert(keyframeIndex < keyframeList.keyframeCount);
+	return this->keyframeSizes[keyframeList.firstKeyframeIndex + keyframeIndex];
+}
+
+double EntityRenderDefinition::getYOffset() const
+{
+	return this->yOffset;
+}
+
+int EntityRenderDefinition::getLightIntensity(bool nightLightsAreActive) const
+{
+	if (this->streetlight)
+	{
+		constexpr int streetLightIntensity = 4;
+		return nightLightsAreActive ? streetLightIntensity : 0;
+	}
+
+	return this->lightIntensity;
+}
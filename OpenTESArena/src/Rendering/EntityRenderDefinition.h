@@ -1,19 +1,59 @@
 #ifndef ENTITY_RENDER_DEFINITION_H
 #define ENTITY_RENDER_DEFINITION_H
 
+#include <vector>
+
+#include "../Math/Vector2.h"
+
 // Common entity render data usable by all renderers. Can be pointed to by multiple entity
 // render instances.
 
 // Direction is assumed to be -camera.direction XZ.
 
+class EntityDefinition;
+
 class EntityRenderDefinition
 {
 private:
-	// @todo: shared entity render data a renderer would care about
-	// - texture ID
-	// - entity shading type enum
+	// Animation state with a contiguous range of keyframe lists (one per angle).
+	struct State
+	{
+		int firstKeyframeListIndex, keyframeListCount;
+		double totalSeconds;
+	};
+
+	// Keyframe list with a contiguous range of keyframe sizes.
+	struct KeyframeList
+	{
+		int firstKeyframeIndex, keyframeCount;
+	};
+
+	// Flattened copy of the entity's animation definition so render instances can be made
+	// without walking nested state/keyframe list/keyframe vectors.
+	std::vector<State> states;
+	std::vector<KeyframeList> keyframeLists;
+	std::vector<Double2> keyframeSizes; // Flat width and height in world space.
+
+	double yOffset; // Vertical offset from the ceiling height.
+	int lightIntensity; // Zero if not a light.
+	bool streetlight; // Only lit at night.
 public:
+	EntityRenderDefinition();
+
+	void init(const EntityDefinition &entityDef);
+
+	// Whether this definition has been initialized from an entity definition.
+	bool isValid() const;
+
+	int getStateCount() const;
+	int getKeyframeListCount(int stateIndex) const;
+	int getKeyframeCount(int stateIndex, int angleIndex) const;
+	double getTotalSeconds(int stateIndex) const;
+	const Double2 &getKeyframeSize(int stateIndex, int angleIndex, int keyframeIndex) const;
+	double getYOffset() const;
 
+	// Gets the light radius intensity, accounting for streetlights only being on at night.
+	int getLightIntensity(bool nightLightsAreActive) const;
 };
 
 #endif
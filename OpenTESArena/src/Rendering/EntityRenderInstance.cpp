@@ -1 +1,87 @@
-#include "EntityRenderInstance.h"
\ No newline at end of file
+#include "EntityRenderInstance.h"
+
+EntityRenderInstance::EntityRenderInstance()
+{
+	this->entityID = -1;
+	this->renderID = -1;
+	this->defID = -1;
+	this->width = 0.0;
+	this->height = 0.0;
+	this->stateIndex = -1;
+	this->angleIndex = -1;
+	this->keyframeIndex = -1;
+	this->lightIntensity = 0;
+	this->overridePalette = nullptr;
+}
+
+void EntityRenderInstance::init(EntityID entityID, EntityRenderID renderID, EntityDefID defID,
+	const CoordDouble3 &position, double width, double height, int stateIndex, int angleIndex,
+	int keyframeIndex, int lightIntensity, const Palette *overridePalette)
+{
+	this->entityID = entityID;
+	this->renderID = renderID;
+	this->defID = defID;
+	this->position = position;
+	this->width = width;
+	this->height = height;
+	this->stateIndex = stateIndex;
+	this->angleIndex = angleIndex;
+	this->keyframeIndex = keyframeIndex;
+	this->lightIntensity = lightIntensity;
+	this->overridePalette = overridePalette;
+}
+
+EntityID EntityRenderInstance::getEntityID() const
+{
+	return this->entityID;
+}
+
+EntityRenderID EntityRenderInstance::getRenderID() const
+{
+	return this->renderID;
+}
+
+EntityDefID EntityRenderInstance::getDefID() const
+{
+	return this->defID;
+}
+
+const CoordDouble3 &EntityRenderInstance::getPosition() const
+{
+	return this->position;
+}
+
+double EntityRenderInstance::getWidth() const
+{
+	return this->width;
+}
+
+double EntityRenderInstance::getHeight() const
+{
+	return this->height;
+}
+
+int EntityRenderInstance::getStateIndex() const
+{
+	return this->stateIndex;
+}
+
+int EntityRenderInstance::getAngleIndex() const
+{
+	return this->angleIndex;
+}
+
+int EntityRenderInstance::getKeyframeIndex() const
+{
+	return this->keyframeIndex;
+}
+
+int EntityRenderInstance::getLightIntensity() const
+{
+	return this->lightIntensity;
+}
+
+const Palette *EntityRenderInstance::getOverridePalette() const
+{
+	return this->overridePalette;
+}
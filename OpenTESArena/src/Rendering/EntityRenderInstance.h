@@ -1,13 +1,41 @@
 #ifndef ENTITY_RENDER_INSTANCE_H
 #define ENTITY_RENDER_INSTANCE_H
 
+#include "../Entities/EntityUtils.h"
+#include "../Media/Palette.h"
+#include "../World/VoxelUtils.h"
+
+// Per-frame render state of one entity, as seen by the current camera.
+
 class EntityRenderInstance
 {
 private:
-	// @todo: position, unique scale width/height values
-	int defID;
+	EntityID entityID;
+	EntityRenderID renderID;
+	EntityDefID defID; // Index into the render definition group.
+	CoordDouble3 position; // Bottom center of flat.
+	double width, height;
+	int stateIndex, angleIndex, keyframeIndex;
+	int lightIntensity; // Zero if not a light.
+	const Palette *overridePalette; // Citizens have unique colors. Null if not used. Owned by the entity.
 public:
+	EntityRenderInstance();
+
+	void init(EntityID entityID, EntityRenderID renderID, EntityDefID defID, const CoordDouble3 &position,
+		double width, double height, int stateIndex, int angleIndex, int keyframeIndex, int lightIntensity,
+		const Palette *overridePalette);
 
+	EntityID getEntityID() const;
+	EntityRenderID getRenderID() const;
+	EntityDefID getDefID() const;
+	const CoordDouble3 &getPosition() const;
+	double getWidth() const;
+	double getHeight() const;
+	int getStateIndex() const;
+	int getAngleIndex() const;
+	int getKeyframeIndex() const;
+	int getLightIntensity() const;
+	const Palette *getOverridePalette() const;
 };
 
 #endif
@@ -1 +1,24 @@
-#include "RenderCamera.h"
\ No newline at end of file
+#include "RenderCamera.h"
+
+void RenderCamera::init(const CoordDouble3 &eye, const Double3 &direction, double fovY)
+{
+	this->chunk = eye.chunk;
+	this->point = eye.point;
+	this->direction = direction;
+	this->fovY = fovY;
+}
+
+CoordDouble3 RenderCamera::getEye() const
+{
+	return CoordDouble3(this->chunk, this->point);
+}
+
+const Double3 &RenderCamera::getDirection() const
+{
+	return this->direction;
+}
+
+double RenderCamera::getFovY() const
+{
+	return this->fovY;
+}
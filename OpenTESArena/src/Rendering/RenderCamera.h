@@ -10,10 +10,14 @@ class RenderCamera
 {
 private:
 	ChunkInt2 chunk;
-	VoxelDouble3 voxel, direction;
-	double fovX, fovY;
+	VoxelDouble3 point, direction;
+	double fovY; // Horizontal field of view depends on the renderer's aspect ratio.
 public:
-	// @todo
+	void init(const CoordDouble3 &eye, const Double3 &direction, double fovY);
+
+	CoordDouble3 getEye() const;
+	const Double3 &getDirection() const;
+	double getFovY() const;
 };
 
 #endif
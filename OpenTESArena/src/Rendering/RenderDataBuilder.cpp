@@ -1 +1,136 @@
-#include "RenderDataBuilder.h"
\ No newline at end of file
+#include <vector>
+
+#include "RenderDataBuilder.h"
+#include "../Entities/Entity.h"
+#include "../Entities/EntityAnimationInstance.h"
+#include "../Entities/EntityDefinitionLibrary.h"
+#include "../Entities/EntityManager.h"
+#include "../World/ChunkUtils.h"
+#include "../World/LevelData.h"
+#include "../World/VoxelGrid.h"
+
+#include "components/debug/Debug.h"
+
+RenderCamera RenderDataBuilder::makeCamera(const CoordDouble3 &eye, const Double3 &direction, double fovY)
+{
+	RenderCamera camera;
+	camera.init(eye, direction, fovY);
+	return camera;
+}
+
+RenderFrameSettings RenderDataBuilder::makeFrameSettings(double ambient, double daytimePercent,
+	double chasmAnimPercent, double latitude, double ceilingHeight, int chunkDistance,
+	bool nightLightsAreActive, bool isExterior, bool playerHasLight)
+{
+	RenderFrameSettings settings;
+	settings.init(ambient, daytimePercent, chasmAnimPercent, latitude, ceilingHeight, chunkDistance,
+		nightLightsAreActive, isExterior, playerHasLight);
+	return settings;
+}
+
+void RenderDataBuilder::updateInstances(const RenderCamera &camera, const RenderFrameSettings &settings,
+	const LevelData &levelData, const EntityDefinitionLibrary &entityDefLibrary,
+	RenderDefinitionGroup &defGroup, RenderInstanceGroup &instGroup)
+{
+	const EntityManager &entityManager = levelData.getEntityManager();
+	const VoxelGrid &voxelGrid = levelData.getVoxelGrid();
+	instGroup.beginUpdate(voxelGrid.getID());
+
+	const double ceilingHeight = settings.getCeilingHeight();
+	const bool nightLightsAreActive = settings.areNightLightsActive();
+
+	const CoordDouble3 eye = camera.getEye();
+	const CoordDouble2 eyeXZ(eye.chunk, VoxelDouble2(eye.point.x, eye.point.z));
+
+	ChunkInt2 minChunk, maxChunk;
+	ChunkUtils::getSurroundingChunks(eye.chunk, settings.getChunkDistance(), &minChunk, &maxChunk);
+
+	std::vector<const Entity*> &entities = instGroup.getEntityBuffer();
+	for (WEInt chunkZ = minChunk.y; chunkZ <= maxChunk.y; chunkZ++)
+	{
+		for (SNInt chunkX = minChunk.x; chunkX <= maxChunk.x; chunkX++)
+		{
+			const ChunkInt2 chunk(chunkX, chunkZ);
+			const int entityCount = entityManager.getTotalCountInChunk(chunk);
+			entities.resize(entityCount);
+
+			const int writtenCount = entityManager.getTotalEntitiesInChunk(chunk, entities.data(), entityCount);
+			DebugAssert(writtenCount <= entityCount);
+
+			for (int i = 0; i < writtenCount; i++)
+			{
+				const Entity *entity = entities[i];
+
+				// Entities can currently be null because of EntityGroup implementation details.
+				if (entity == nullptr)
+				{
+					continue;
+				}
+
+				const EntityDefID defID = entity->getDefinitionID();
+				if (!defGroup.hasEntityDef(defID))
+				{
+					const EntityDefinition &entityDef = entityManager.getEntityDef(defID, entityDefLibrary);
+					EntityRenderDefinition renderDef;
+					renderDef.init(entityDef);
+					defGroup.setEntityDef(defID, std::move(renderDef));
+				}
+
+				const EntityRenderDefinition &renderDef = defGroup.getEntityDef(defID);
+				const EntityAnimationInstance &animInst = entity->getAnimInstance();
+
+				// Pick the keyframe facing the camera at the animation's current time.
+				const int stateIndex = animInst.getStateIndex();
+				const int angleCount = renderDef.getKeyframeListCount(stateIndex);
+				const int angleIndex = EntityUtils::getAnimAngleIndex(*entity, eyeXZ, angleCount);
+				const int keyframeCount = renderDef.getKeyframeCount(stateIndex, angleIndex);
+				const int keyframeIndex = EntityUtils::getAnimKeyframeIndex(animInst.getCurrentSeconds(),
+					renderDef.getTotalSeconds(stateIndex), keyframeCount);
+				const Double2 &keyframeSize = renderDef.getKeyframeSize(stateIndex, angleIndex, keyframeIndex);
+
+				// An entity that hasn't moved keeps its flat height from the previous frame unless a voxel
+				// in the grid chunk it stands in has changed since.
+				const int renderInstIndex = instGroup.getOrAddEntityInstIndex(entity->getID());
+				EntityRenderInstance &renderInst = instGroup.getEntityInst(renderInstIndex);
+				const CoordDouble2 &entityPosition = entity->getPosition();
+				const NewInt2 entityVoxel = VoxelUtils::pointToVoxel(VoxelUtils::coordToNewPoint(entityPosition));
+				const ChunkInt2 entityGridChunk(entityVoxel.x / ChunkUtils::CHUNK_DIM,
+					entityVoxel.y / ChunkUtils::CHUNK_DIM);
+				const uint32_t voxelRevision = voxelGrid.getChunkRevision(entityGridChunk);
+				const CoordDouble3 &prevFlatPosition = renderInst.getPosition();
+				const bool isUnmoved = (renderInst.getEntityID() == entity->getID()) &&
+					(renderInst.getDefID() == defID) && (prevFlatPosition.chunk == entityPosition.chunk) &&
+					(prevFlatPosition.point.x == entityPosition.point.x) &&
+					(prevFlatPosition.point.z == entityPosition.point.y) &&
+					(instGroup.getEntityInstVoxelRevision(renderInstIndex) == voxelRevision);
+
+				// Bottom center of flat, set on top of any raised platform the entity is in.
+				double flatY;
+				if (isUnmoved)
+				{
+					flatY = prevFlatPosition.point.y;
+				}
+				else
+				{
+					const double raisedPlatformYOffset = EntityUtils::getRaisedPlatformYOffset(entityPosition,
+						ceilingHeight, voxelGrid);
+					flatY = ceilingHeight + renderDef.getYOffset() + raisedPlatformYOffset;
+					instGroup.setEntityInstVoxelRevision(renderInstIndex, voxelRevision);
+				}
+
+				const VoxelDouble3 flatPoint(entityPosition.point.x, flatY, entityPosition.point.y);
+
+				// Citizens have their own palette.
+				const EntityAnimationInstance::CitizenParams *citizenParams = animInst.getCitizenParams();
+				const Palette *overridePalette = (citizenParams != nullptr) ? &citizenParams->palette : nullptr;
+
+				renderInst.init(entity->getID(), entity->getRenderID(), defID,
+					CoordDouble3(entityPosition.chunk, flatPoint), keyframeSize.x, keyframeSize.y,
+					stateIndex, angleIndex, keyframeIndex, renderDef.getLightIntensity(nightLightsAreActive),
+					overridePalette);
+			}
+		}
+	}
+
+	instGroup.endUpdate();
+}
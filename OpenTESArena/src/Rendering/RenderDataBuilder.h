@@ -3,16 +3,31 @@
 
 #include "RenderCamera.h"
 #include "RenderDefinitionGroup.h"
+#include "RenderFrameSettings.h"
 #include "RenderInstanceGroup.h"
+#include "../Math/Vector3.h"
+#include "../World/VoxelUtils.h"
 
 // Generates bulk render data from gameplay data to be passed to a renderer.
 
+class EntityDefinitionLibrary;
+class LevelData;
+
 namespace RenderDataBuilder
 {
-	// @todo: pass gameplay data as parameters
-	RenderCamera makeCamera();
-	RenderDefinitionGroup makeDefinitions();
-	RenderInstanceGroup makeInstances();
+	RenderCamera makeCamera(const CoordDouble3 &eye, const Double3 &direction, double fovY);
+
+	RenderFrameSettings makeFrameSettings(double ambient, double daytimePercent, double chasmAnimPercent,
+		double latitude, double ceilingHeight, int chunkDistance, bool nightLightsAreActive, bool isExterior,
+		bool playerHasLight);
+
+	// Refreshes the entity instances in the chunks around the camera. Render definitions are added
+	// the first time their entity definition is seen and are reused until the group is cleared.
+	// Entities keep their instances between frames, and ones that left the range are removed.
+	// @todo: voxel and sky-object instances.
+	void updateInstances(const RenderCamera &camera, const RenderFrameSettings &settings,
+		const LevelData &levelData, const EntityDefinitionLibrary &entityDefLibrary,
+		RenderDefinitionGroup &defGroup, RenderInstanceGroup &instGroup);
 }
 
 #endif
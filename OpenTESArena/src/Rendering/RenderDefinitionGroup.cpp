@@ -1 +1,31 @@
-#include "RenderDefinitionGroup.h"
\ No newline at end of file
+#include "RenderDefinitionGroup.h"
+
+#include "components/debug/Debug.h"
+
+bool RenderDefinitionGroup::hasEntityDef(EntityDefID defID) const
+{
+	return (defID >= 0) && (defID < static_cast<int>(this->entityDefs.size())) &&
+		this->entityDefs[defID].isValid();
+}
+
+const EntityRenderDefinition &RenderDefinitionGroup::getEntityDef(EntityDefID defID) const
+{
+	DebugAssertIndex(this->entityDefs, defID);
+	return this->entityDefs[defID];
+}
+
+void RenderDefinitionGroup::setEntityDef(EntityDefID defID, EntityRenderDefinition &&def)
+{
+	DebugAssert(defID >= 0);
+	if (defID >= static_cast<int>(this->entityDefs.size()))
+	{
+		this->entityDefs.resize(defID + 1);
+	}
+
+	this->entityDefs[defID] = std::move(def);
+}
+
+void RenderDefinitionGroup::clear()
+{
+	this->entityDefs.clear();
+}
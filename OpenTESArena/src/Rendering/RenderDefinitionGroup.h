@@ -1,23 +1,34 @@
 #ifndef RENDER_DEFINITION_GROUP_H
 #define RENDER_DEFINITION_GROUP_H
 
+#include <vector>
+
 #include "EntityRenderDefinition.h"
 #include "SkyObjectRenderDefinition.h"
 #include "VoxelRenderDefinition.h"
+#include "../Entities/EntityUtils.h"
 
 // Contains render definition data for shared voxel/entity/sky-object data.
 
 // It's useful to generate more data than may seem useful in case of render features like shadows
 // that frequently need off-screen data.
 
+// Definitions are made once and kept until the level changes, so they aren't rebuilt every frame.
+
 class RenderDefinitionGroup
 {
 private:
-	// @todo: collections of voxel/entity/sky-object render definitions
+	std::vector<EntityRenderDefinition> entityDefs; // Indexed by entity definition ID.
+
+	// @todo: collections of voxel/sky-object render definitions
 	// - might have ChunkRenderDefinition for voxels, or not if an array is fine (indexable by
 	//   voxel render instances).
 public:
+	bool hasEntityDef(EntityDefID defID) const;
+	const EntityRenderDefinition &getEntityDef(EntityDefID defID) const;
 
+	void setEntityDef(EntityDefID defID, EntityRenderDefinition &&def);
+	void clear();
 };
 
 #endif
@@ -1 +1,61 @@
-#include "RenderFrameSettings.h"
\ No newline at end of file
+#include "RenderFrameSettings.h"
+
+void RenderFrameSettings::init(double ambient, double daytimePercent, double chasmAnimPercent,
+	double latitude, double ceilingHeight, int chunkDistance, bool nightLightsAreActive, bool isExterior,
+	bool playerHasLight)
+{
+	this->ambient = ambient;
+	this->daytimePercent = daytimePercent;
+	this->chasmAnimPercent = chasmAnimPercent;
+	this->latitude = latitude;
+	this->ceilingHeight = ceilingHeight;
+	this->chunkDistance = chunkDistance;
+	this->nightLightsActive = nightLightsAreActive;
+	this->exterior = isExterior;
+	this->playerLight = playerHasLight;
+}
+
+double RenderFrameSettings::getAmbient() const
+{
+	return this->ambient;
+}
+
+double RenderFrameSettings::getDaytimePercent() const
+{
+	return this->daytimePercent;
+}
+
+double RenderFrameSettings::getChasmAnimPercent() const
+{
+	return this->chasmAnimPercent;
+}
+
+double RenderFrameSettings::getLatitude() const
+{
+	return this->latitude;
+}
+
+double RenderFrameSettings::getCeilingHeight() const
+{
+	return this->ceilingHeight;
+}
+
+int RenderFrameSettings::getChunkDistance() const
+{
+	return this->chunkDistance;
+}
+
+bool RenderFrameSettings::areNightLightsActive() const
+{
+	return this->nightLightsActive;
+}
+
+bool RenderFrameSettings::isExterior() const
+{
+	return this->exterior;
+}
+
+bool RenderFrameSettings::hasPlayerLight() const
+{
+	return this->playerLight;
+}
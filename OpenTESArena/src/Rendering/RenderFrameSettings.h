@@ -1,15 +1,35 @@
 #ifndef RENDER_FRAME_SETTINGS_H
 #define RENDER_FRAME_SETTINGS_H
 
+// Shader variables for a given frame that don't fit into the camera or the bulk
+// voxel/entity/sky-object data.
+
 class RenderFrameSettings
 {
 private:
-	// @todo: shader variables for a given frame, time of day, delta time, etc.
-	// - things that don't fit into camera or bulk voxel/entity/sky-object data.
-	// - ceiling height
-	double resolutionScale;
+	double ambient;
+	double daytimePercent;
+	double chasmAnimPercent;
+	double latitude;
+	double ceilingHeight;
+	int chunkDistance;
+	bool nightLightsActive;
+	bool exterior;
+	bool playerLight;
 public:
-	void init();
+	void init(double ambient, double daytimePercent, double chasmAnimPercent, double latitude,
+		double ceilingHeight, int chunkDistance, bool nightLightsAreActive, bool isExterior,
+		bool playerHasLight);
+
+	double getAmbient() const;
+	double getDaytimePercent() const;
+	double getChasmAnimPercent() const;
+	double getLatitude() const;
+	double getCeilingHeight() const;
+	int getChunkDistance() const;
+	bool areNightLightsActive() const;
+	bool isExterior() const;
+	bool hasPlayerLight() const;
 };
 
 #endif
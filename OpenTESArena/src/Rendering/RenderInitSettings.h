@@ -13,12 +13,14 @@ private:
 
 	int width, height;
 	int renderThreadsMode;
+	bool pipelinedRendering;
 public:
-	void init(int width, int height, int renderThreadsMode);
+	void init(int width, int height, int renderThreadsMode, bool pipelinedRendering);
 
 	int getWidth() const;
 	int getHeight() const;
 	int getRenderThreadsMode() const;
+	bool isPipelinedRendering() const;
 };
 
 #endif
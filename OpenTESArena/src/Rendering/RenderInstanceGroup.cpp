@@ -1 +1,125 @@
-#include "RenderInstanceGroup.h"
\ No newline at end of file
+#include "RenderInstanceGroup.h"
+
+#include "components/debug/Debug.h"
+
+RenderInstanceGroup::RenderInstanceGroup()
+{
+	this->updateIndex = 0;
+	this->nextEntityInstIndex = 0;
+	this->voxelGridID = -1;
+}
+
+int RenderInstanceGroup::getEntityInstCount() const
+{
+	return static_cast<int>(this->entityInsts.size());
+}
+
+EntityRenderInstance &RenderInstanceGroup::getEntityInst(int index)
+{
+	DebugAssertIndex(this->entityInsts, index);
+	return this->entityInsts[index];
+}
+
+const EntityRenderInstance &RenderInstanceGroup::getEntityInst(int index) const
+{
+	DebugAssertIndex(this->entityInsts, index);
+	return this->entityInsts[index];
+}
+
+uint32_t RenderInstanceGroup::getEntityInstVoxelRevision(int index) const
+{
+	DebugAssertIndex(this->entityInstVoxelRevisions, index);
+	return this->entityInstVoxelRevisions[index];
+}
+
+void RenderInstanceGroup::setEntityInstVoxelRevision(int index, uint32_t revision)
+{
+	DebugAssertIndex(this->entityInstVoxelRevisions, index);
+	this->entityInstVoxelRevisions[index] = revision;
+}
+
+std::vector<const Entity*> &RenderInstanceGroup::getEntityBuffer()
+{
+	return this->entityBuffer;
+}
+
+void RenderInstanceGroup::beginUpdate(int voxelGridID)
+{
+	if (voxelGridID != this->voxelGridID)
+	{
+		// Flat heights from another level's voxels can't be reused.
+		this->clear();
+		this->voxelGridID = voxelGridID;
+	}
+
+	this->updateIndex++;
+	this->nextEntityInstIndex = 0;
+}
+
+void RenderInstanceGroup::endUpdate()
+{
+	// Remove stale instances without reordering the rest, so the next update finds them in the
+	// same order.
+	int writeIndex = 0;
+	for (int i = 0; i < static_cast<int>(this->entityInsts.size()); i++)
+	{
+		if (this->entityInstUpdates[i] != this->updateIndex)
+		{
+			this->entityInstIndices.erase(this->entityInsts[i].getEntityID());
+			continue;
+		}
+
+		if (writeIndex != i)
+		{
+			this->entityInsts[writeIndex] = this->entityInsts[i];
+			this->entityInstUpdates[writeIndex] = this->entityInstUpdates[i];
+			this->entityInstVoxelRevisions[writeIndex] = this->entityInstVoxelRevisions[i];
+			this->entityInstIndices[this->entityInsts[writeIndex].getEntityID()] = writeIndex;
+		}
+
+		writeIndex++;
+	}
+
+	this->entityInsts.resize(writeIndex);
+	this->entityInstUpdates.resize(writeIndex);
+	this->entityInstVoxelRevisions.resize(writeIndex);
+}
+
+int RenderInstanceGroup::getOrAddEntityInstIndex(EntityID entityID)
+{
+	// Fast path: the entity is in the same place in the order as last update.
+	int index = this->nextEntityInstIndex;
+	const bool isNextInst = (index < static_cast<int>(this->entityInsts.size())) &&
+		(this->entityInsts[index].getEntityID() == entityID) && (this->entityInstUpdates[index] != this->updateIndex);
+
+	if (!isNextInst)
+	{
+		const auto iter = this->entityInstIndices.find(entityID);
+		if (iter != this->entityInstIndices.end())
+		{
+			index = iter->second;
+		}
+		else
+		{
+			index = static_cast<int>(this->entityInsts.size());
+			this->entityInsts.emplace_back();
+			this->entityInstUpdates.emplace_back(this->updateIndex);
+			this->entityInstVoxelRevisions.emplace_back(0);
+			this->entityInstIndices.emplace(entityID, index);
+		}
+	}
+
+	DebugAssertIndex(this->entityInsts, index);
+	this->entityInstUpdates[index] = this->updateIndex;
+	this->nextEntityInstIndex = index + 1;
+	return index;
+}
+
+void RenderInstanceGroup::clear()
+{
+	this->entityInsts.clear();
+	this->entityInstUpdates.clear();
+	this->entityInstVoxelRevisions.clear();
+	this->entityInstIndices.clear();
+	this->nextEntityInstIndex = 0;
+}
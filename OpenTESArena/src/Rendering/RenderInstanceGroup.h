@@ -1,6 +1,10 @@
 #ifndef RENDER_INSTANCE_GROUP_H
 #define RENDER_INSTANCE_GROUP_H
 
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
 #include "EntityRenderInstance.h"
 #include "SkyObjectRenderInstance.h"
 #include "VoxelRenderInstance.h"
@@ -8,13 +12,51 @@
 // All unique instances of voxels/entities/sky-objects in the game world that have positions,
 // shader variables, etc. for their current state.
 
+// The group is reused between frames. An entity keeps its instance while it stays in range, and
+// instances of entities that weren't seen during an update are removed at the end of it. Entities
+// are usually gathered in the same order every update, so instances stay in that order and the
+// hash table is only needed when an entity isn't where it was last time.
+
+class Entity;
+
 class RenderInstanceGroup
 {
 private:
-	// @todo: all voxel/entity/sky-object render instances, with whatever references into
+	std::vector<EntityRenderInstance> entityInsts;
+	std::vector<int> entityInstUpdates; // Last update each entity instance was seen in.
+	std::vector<uint32_t> entityInstVoxelRevisions; // Voxel chunk revision each flat height is from.
+	std::unordered_map<EntityID, int> entityInstIndices; // Entity ID to index in entity instances.
+	std::vector<const Entity*> entityBuffer; // Scratch storage for one chunk's entities.
+	int updateIndex;
+	int nextEntityInstIndex; // Instance expected to be requested next.
+	int voxelGridID; // Grid the voxel revisions are from.
+
+	// @todo: all voxel/sky-object render instances, with whatever references into
 	// render definition group entries needed.
 public:
+	RenderInstanceGroup();
+
+	int getEntityInstCount() const;
+	EntityRenderInstance &getEntityInst(int index);
+	const EntityRenderInstance &getEntityInst(int index) const;
+
+	// Revision of the voxel chunk an instance's flat height was calculated from.
+	uint32_t getEntityInstVoxelRevision(int index) const;
+	void setEntityInstVoxelRevision(int index, uint32_t revision);
+
+	// Storage for gathering entities so it isn't reallocated every frame.
+	std::vector<const Entity*> &getEntityBuffer();
+
+	// Instances not requested by getOrAddEntityInstIndex() between these calls are removed by
+	// endUpdate(). All instances are removed if the voxel grid isn't the one from the last update.
+	void beginUpdate(int voxelGridID);
+	void endUpdate();
+
+	// Returns the index of the entity's instance from the previous update, or of a new
+	// default-constructed one if the entity doesn't have one yet.
+	int getOrAddEntityInstIndex(EntityID entityID);
 
+	void clear();
 };
 
 #endif
@@ -6,6 +6,7 @@
 #include "SDL.h"
 
 #include "ArenaRenderUtils.h"
+#include "RenderDataBuilder.h"
 #include "Renderer.h"
 #include "RenderInitSettings.h"
 #include "SdlUiRenderer.h"
@@ -38,6 +39,18 @@ Renderer::ProfilerData::ProfilerData()
 	this->potentiallyVisFlatCount = 0;
 	this->visFlatCount = 0;
 	this->visLightCount = 0;
+	this->stolenTileCount = 0;
+	this->flatBinCount = 0;
+	this->flatBinEntryCount = 0;
+	this->maxFlatBinSize = 0;
+	this->flatShadingHitCount = 0;
+	this->flatShadingMissCount = 0;
+	this->visibilityTime = 0.0;
+	this->skyTime = 0.0;
+	this->distantSkyTime = 0.0;
+	this->voxelTime = 0.0;
+	this->flatTime = 0.0;
+	this->renderTime = 0.0;
 	this->frameTime = 0.0;
 }
 
@@ -61,16 +74,67 @@ Renderer::Renderer()
 	this->renderer = nullptr;
 	this->letterboxMode = 0;
 	this->fullGameWindow = false;
+	this->requestedResolutionScale = 1.0;
+	this->resolutionScale = 1.0;
+	this->dynamicResolutionFrameTime = 0.0;
+	this->dynamicResolutionFrameCount = 0;
+	this->dynamicResolution = false;
 }
 
 Renderer::~Renderer()
 {
 	DebugLog("Closing.");
 
-	SDL_DestroyWindow(this->window);
+	// Headless renderers have no window or SDL renderer.
+	if (this->window != nullptr)
+	{
+		SDL_DestroyWindow(this->window);
+	}
+
+	if (this->renderer != nullptr)
+	{
+		// This also destroys the frame buffer textures.
+		SDL_DestroyRenderer(this->renderer);
+	}
+}
+
+std::unique_ptr<RendererSystem3D> Renderer::createRendererSystem3D(RendererSystemType3D systemType3D)
+{
+	if (systemType3D == RendererSystemType3D::SoftwareClassic)
+	{
+		return std::make_unique<SoftwareRenderer>();
+	}
+	else
+	{
+		DebugLogError("Unrecognized 3D renderer system type \"" +
+			std::to_string(static_cast<int>(systemType3D)) + "\".");
+		return nullptr;
+	}
+}
 
-	// This also destroys the frame buffer textures.
-	SDL_DestroyRenderer(this->renderer);
+void Renderer::updateProfilerData(double frameTime)
+{
+	RendererSystem3D::ProfilerData swProfilerData = this->renderer3D->getProfilerData();
+	this->profilerData.width = swProfilerData.width;
+	this->profilerData.height = swProfilerData.height;
+	this->profilerData.potentiallyVisFlatCount = swProfilerData.potentiallyVisFlatCount;
+	this->profilerData.visFlatCount = swProfilerData.visFlatCount;
+	this->profilerData.visLightCount = swProfilerData.visLightCount;
+	this->profilerData.threadBusyTimes = std::move(swProfilerData.threadBusyTimes);
+	this->profilerData.threadIdleTimes = std::move(swProfilerData.threadIdleTimes);
+	this->profilerData.stolenTileCount = swProfilerData.stolenTileCount;
+	this->profilerData.flatBinCount = swProfilerData.flatBinCount;
+	this->profilerData.flatBinEntryCount = swProfilerData.flatBinEntryCount;
+	this->profilerData.maxFlatBinSize = swProfilerData.maxFlatBinSize;
+	this->profilerData.flatShadingHitCount = swProfilerData.flatShadingHitCount;
+	this->profilerData.flatShadingMissCount = swProfilerData.flatShadingMissCount;
+	this->profilerData.visibilityTime = swProfilerData.visibilityTime;
+	this->profilerData.skyTime = swProfilerData.skyTime;
+	this->profilerData.distantSkyTime = swProfilerData.distantSkyTime;
+	this->profilerData.voxelTime = swProfilerData.voxelTime;
+	this->profilerData.flatTime = swProfilerData.flatTime;
+	this->profilerData.renderTime = swProfilerData.renderTime;
+	this->profilerData.frameTime = frameTime;
 }
 
 SDL_Renderer *Renderer::createRenderer(SDL_Window *window)
@@ -142,6 +206,74 @@ int Renderer::makeRendererDimension(int value, double resolutionScale)
 		std::round(static_cast<double>(value) * resolutionScale)), 1);
 }
 
+void Renderer::resizeGameWorld()
+{
+	const int screenWidth = this->getWindowDimensions().x;
+	const int viewHeight = this->getViewHeight();
+	const int renderWidth = Renderer::makeRendererDimension(screenWidth, this->resolutionScale);
+	const int renderHeight = Renderer::makeRendererDimension(viewHeight, this->resolutionScale);
+
+	int textureWidth, textureHeight;
+	const int status = SDL_QueryTexture(this->gameWorldTexture.get(), nullptr, nullptr,
+		&textureWidth, &textureHeight);
+	DebugAssertMsg(status == 0, "Couldn't query game world texture, " + std::string(SDL_GetError()));
+
+	if ((textureWidth == renderWidth) && (textureHeight == renderHeight))
+	{
+		return;
+	}
+
+	// Reinitialize the game world frame buffer. It's stretched to the view when drawn.
+	this->gameWorldTexture = this->createTexture(Renderer::DEFAULT_PIXELFORMAT,
+		SDL_TEXTUREACCESS_STREAMING, renderWidth, renderHeight);
+	DebugAssertMsg(this->gameWorldTexture.get() != nullptr,
+		"Couldn't recreate game world texture, " + std::string(SDL_GetError()));
+
+	this->renderer3D->resize(renderWidth, renderHeight);
+}
+
+void Renderer::updateDynamicResolution(double frameTime, int targetFps)
+{
+	this->dynamicResolutionFrameTime += frameTime;
+	this->dynamicResolutionFrameCount++;
+
+	// Average over several frames so one slow frame (i.e., a chunk loading) doesn't drop the scale.
+	if (this->dynamicResolutionFrameCount < Renderer::DYNAMIC_RESOLUTION_SAMPLE_FRAMES)
+	{
+		return;
+	}
+
+	const double averageFrameTime = this->dynamicResolutionFrameTime /
+		static_cast<double>(this->dynamicResolutionFrameCount);
+	this->dynamicResolutionFrameTime = 0.0;
+	this->dynamicResolutionFrameCount = 0;
+
+	DebugAssert(targetFps > 0);
+	const double frameBudget = Renderer::DYNAMIC_RESOLUTION_BUDGET_PERCENT / static_cast<double>(targetFps);
+
+	double newScale = this->resolutionScale;
+	if (averageFrameTime > frameBudget)
+	{
+		// Render time is roughly proportional to pixel count, so the scale goes by the square root.
+		// Limit the drop per adjustment to avoid overshooting on a spike.
+		const double ratio = std::sqrt(frameBudget / averageFrameTime);
+		newScale *= std::max(ratio, 0.75);
+	}
+	else if (averageFrameTime < (frameBudget * Renderer::DYNAMIC_RESOLUTION_RAISE_PERCENT))
+	{
+		newScale *= Renderer::DYNAMIC_RESOLUTION_RAISE_STEP;
+	}
+
+	newScale = std::clamp(newScale, std::min(Renderer::DYNAMIC_RESOLUTION_MIN_SCALE,
+		this->requestedResolutionScale), this->requestedResolutionScale);
+
+	if (newScale != this->resolutionScale)
+	{
+		this->resolutionScale = newScale;
+		this->resizeGameWorld();
+	}
+}
+
 std::optional<int> Renderer::tryGetTextureInstanceIndex(TextureBuilderID textureBuilderID, PaletteID paletteID) const
 {
 	const auto iter = std::find_if(this->textureInstances.begin(), this->textureInstances.end(),
@@ -312,6 +444,11 @@ int Renderer::getViewHeight() const
 	return viewHeight;
 }
 
+double Renderer::getResolutionScale() const
+{
+	return this->resolutionScale;
+}
+
 SDL_Rect Renderer::getLetterboxDimensions() const
 {
 	const Int2 windowDims = this->getWindowDimensions();
@@ -629,19 +766,7 @@ bool Renderer::init(int width, int height, WindowMode windowMode, int letterboxM
 	}();
 
 	// Initialize 3D renderer resources.
-	this->renderer3D = [systemType3D]() -> std::unique_ptr<RendererSystem3D>
-	{
-		if (systemType3D == RendererSystemType3D::SoftwareClassic)
-		{
-			return std::make_unique<SoftwareRenderer>();
-		}
-		else
-		{
-			DebugLogError("Unrecognized 3D renderer system type \"" +
-				std::to_string(static_cast<int>(systemType3D)) + "\".");
-			return nullptr;
-		}
-	}();
+	this->renderer3D = Renderer::createRendererSystem3D(systemType3D);
 
 	// Don't initialize the game world buffer until the 3D renderer is initialized.
 	DebugAssert(this->gameWorldTexture.get() == nullptr);
@@ -650,6 +775,32 @@ bool Renderer::init(int width, int height, WindowMode windowMode, int letterboxM
 	return true;
 }
 
+bool Renderer::initHeadless(int width, int height, RendererSystemType3D systemType3D, int renderThreadsMode)
+{
+	DebugLog("Initializing headless.");
+
+	if ((width <= 0) || (height <= 0))
+	{
+		DebugLogError("Invalid headless dimensions \"" + std::to_string(width) + "x" + std::to_string(height) + "\"");
+		return false;
+	}
+
+	// No window, SDL renderer, or 2D renderer. Only the 3D renderer is needed for drawing the game
+	// world into a caller-owned buffer.
+	this->renderer3D = Renderer::createRendererSystem3D(systemType3D);
+	if (this->renderer3D == nullptr)
+	{
+		return false;
+	}
+
+	// Frames are measured one at a time, so they aren't pipelined.
+	RenderInitSettings initSettings;
+	initSettings.init(width, height, renderThreadsMode, false);
+	this->renderer3D->init(initSettings);
+
+	return true;
+}
+
 void Renderer::resize(int width, int height, double resolutionScale, bool fullGameWindow)
 {
 	// The window's dimensions are resized automatically by SDL. The renderer's are not.
@@ -667,6 +818,12 @@ void Renderer::resize(int width, int height, double resolutionScale, bool fullGa
 
 	this->fullGameWindow = fullGameWindow;
 
+	// A new requested scale resets any dynamic resolution adjustment.
+	this->requestedResolutionScale = resolutionScale;
+	this->resolutionScale = resolutionScale;
+	this->dynamicResolutionFrameTime = 0.0;
+	this->dynamicResolutionFrameCount = 0;
+
 	// Rebuild the 3D renderer if initialized.
 	if (this->renderer3D->isInited())
 	{
@@ -736,9 +893,14 @@ void Renderer::setClipRect(const SDL_Rect *rect)
 }
 
 void Renderer::initializeWorldRendering(double resolutionScale, bool fullGameWindow,
-	int renderThreadsMode)
+	int renderThreadsMode, bool pipelinedRendering, bool dynamicResolution)
 {
 	this->fullGameWindow = fullGameWindow;
+	this->requestedResolutionScale = resolutionScale;
+	this->resolutionScale = resolutionScale;
+	this->dynamicResolutionFrameTime = 0.0;
+	this->dynamicResolutionFrameCount = 0;
+	this->dynamicResolution = dynamicResolution;
 
 	const int screenWidth = this->getWindowDimensions().x;
 
@@ -758,7 +920,7 @@ void Renderer::initializeWorldRendering(double resolutionScale, bool fullGameWin
 
 	// Initialize 3D rendering.
 	RenderInitSettings initSettings;
-	initSettings.init(renderWidth, renderHeight, renderThreadsMode);
+	initSettings.init(renderWidth, renderHeight, renderThreadsMode, pipelinedRendering);
 	this->renderer3D->init(initSettings);
 }
 
@@ -768,6 +930,22 @@ void Renderer::setRenderThreadsMode(int mode)
 	this->renderer3D->setRenderThreadsMode(mode);
 }
 
+void Renderer::setDynamicResolution(bool enabled)
+{
+	this->dynamicResolution = enabled;
+	this->dynamicResolutionFrameTime = 0.0;
+	this->dynamicResolutionFrameCount = 0;
+
+	if (!enabled && (this->resolutionScale != this->requestedResolutionScale))
+	{
+		this->resolutionScale = this->requestedResolutionScale;
+		if (this->renderer3D->isInited())
+		{
+			this->resizeGameWorld();
+		}
+	}
+}
+
 bool Renderer::tryCreateVoxelTexture(const TextureAssetReference &textureAssetRef, TextureManager &textureManager)
 {
 	return this->renderer3D->tryCreateVoxelTexture(textureAssetRef, textureManager);
@@ -852,10 +1030,28 @@ void Renderer::setNightLightsActive(bool active, const Palette &palette)
 	this->renderer3D->setNightLightsActive(active, palette);
 }
 
+void Renderer::updateVoxelTextureHandles(const VoxelGrid &voxelGrid)
+{
+	DebugAssert(this->renderer3D->isInited());
+	this->renderer3D->updateVoxelTextureHandles(voxelGrid);
+}
+
+void Renderer::measureVoxelTextureLookups(const VoxelGrid &voxelGrid, int lookupCount,
+	double *outHandleSeconds, double *outAssetRefSeconds, int *outMismatchCount)
+{
+	DebugAssert(this->renderer3D->isInited());
+	this->renderer3D->measureVoxelTextureLookups(voxelGrid, lookupCount, outHandleSeconds,
+		outAssetRefSeconds, outMismatchCount);
+}
+
 void Renderer::clearTexturesAndEntityRenderIDs()
 {
 	DebugAssert(this->renderer3D->isInited());
 	this->renderer3D->clearTexturesAndEntityRenderIDs();
+
+	// Entity definition IDs are only unique within a level.
+	this->renderDefGroup.clear();
+	this->renderInstGroup.clear();
 }
 
 void Renderer::clearDistantSky()
@@ -944,7 +1140,7 @@ void Renderer::fillOriginalRect(const Color &color, int x, int y, int w, int h)
 void Renderer::renderWorld(const CoordDouble3 &eye, const Double3 &forward, double fovY, double ambient,
 	double daytimePercent, double chasmAnimPercent, double latitude, bool nightLightsAreActive, bool isExterior,
 	bool playerHasLight, int chunkDistance, double ceilingHeight, const LevelData &levelData,
-	const EntityDefinitionLibrary &entityDefLibrary, const Palette &palette)
+	const EntityDefinitionLibrary &entityDefLibrary, const Palette &palette, int targetFps)
 {
 	// The 3D renderer must be initialized.
 	DebugAssert(this->renderer3D->isInited());
@@ -959,21 +1155,9 @@ void Renderer::renderWorld(const CoordDouble3 &eye, const Double3 &forward, doub
 	DebugAssertMsg(status == 0, "Couldn't lock game world texture, " + std::string(SDL_GetError()));
 
 	// Render the game world to the game world frame buffer.
-	const auto startTime = std::chrono::high_resolution_clock::now();
-	this->renderer3D->render(eye, forward, fovY, ambient, daytimePercent, chasmAnimPercent, latitude,
+	this->renderWorldToBuffer(eye, forward, fovY, ambient, daytimePercent, chasmAnimPercent, latitude,
 		nightLightsAreActive, isExterior, playerHasLight, chunkDistance, ceilingHeight, levelData,
 		entityDefLibrary, palette, gameWorldPixels);
-	const auto endTime = std::chrono::high_resolution_clock::now();
-
-	// Update profiler stats.
-	const RendererSystem3D::ProfilerData swProfilerData = this->renderer3D->getProfilerData();
-	this->profilerData.width = swProfilerData.width;
-	this->profilerData.height = swProfilerData.height;
-	this->profilerData.potentiallyVisFlatCount = swProfilerData.potentiallyVisFlatCount;
-	this->profilerData.visFlatCount = swProfilerData.visFlatCount;
-	this->profilerData.visLightCount = swProfilerData.visLightCount;
-	this->profilerData.frameTime = static_cast<double>((endTime - startTime).count()) /
-		static_cast<double>(std::nano::den);
 
 	// Update the game world texture with the new ARGB8888 pixels.
 	SDL_UnlockTexture(this->gameWorldTexture.get());
@@ -982,6 +1166,48 @@ void Renderer::renderWorld(const CoordDouble3 &eye, const Double3 &forward, doub
 	const int screenWidth = this->getWindowDimensions().x;
 	const int viewHeight = this->getViewHeight();
 	this->draw(this->gameWorldTexture, 0, 0, screenWidth, viewHeight);
+
+	// Resizing takes effect next frame, after this frame's texture has been drawn. The render
+	// threads' time is used since frameTime only covers the main thread when frames are pipelined.
+	if (this->dynamicResolution)
+	{
+		this->updateDynamicResolution(this->profilerData.renderTime, targetFps);
+	}
+}
+
+void Renderer::renderWorldOffscreen(const CoordDouble3 &eye, const Double3 &forward, double fovY,
+	double ambient, double daytimePercent, double chasmAnimPercent, double latitude, bool nightLightsAreActive,
+	bool isExterior, bool playerHasLight, int chunkDistance, double ceilingHeight, const LevelData &levelData,
+	const EntityDefinitionLibrary &entityDefLibrary, const Palette &palette, uint32_t *colorBuffer)
+{
+	// The 3D renderer must be initialized.
+	DebugAssert(this->renderer3D->isInited());
+	DebugAssert(colorBuffer != nullptr);
+
+	this->renderWorldToBuffer(eye, forward, fovY, ambient, daytimePercent, chasmAnimPercent, latitude,
+		nightLightsAreActive, isExterior, playerHasLight, chunkDistance, ceilingHeight, levelData,
+		entityDefLibrary, palette, colorBuffer);
+}
+
+void Renderer::renderWorldToBuffer(const CoordDouble3 &eye, const Double3 &forward, double fovY,
+	double ambient, double daytimePercent, double chasmAnimPercent, double latitude, bool nightLightsAreActive,
+	bool isExterior, bool playerHasLight, int chunkDistance, double ceilingHeight, const LevelData &levelData,
+	const EntityDefinitionLibrary &entityDefLibrary, const Palette &palette, uint32_t *colorBuffer)
+{
+	const auto startTime = std::chrono::high_resolution_clock::now();
+	const RenderCamera camera = RenderDataBuilder::makeCamera(eye, forward, fovY);
+	const RenderFrameSettings settings = RenderDataBuilder::makeFrameSettings(ambient, daytimePercent,
+		chasmAnimPercent, latitude, ceilingHeight, chunkDistance, nightLightsAreActive, isExterior,
+		playerHasLight);
+	RenderDataBuilder::updateInstances(camera, settings, levelData, entityDefLibrary, this->renderDefGroup,
+		this->renderInstGroup);
+
+	this->renderer3D->render(camera, settings, this->renderInstGroup, levelData, palette, colorBuffer);
+	const auto endTime = std::chrono::high_resolution_clock::now();
+
+	// Update profiler stats.
+	this->updateProfilerData(static_cast<double>((endTime - startTime).count()) /
+		static_cast<double>(std::nano::den));
 }
 
 void Renderer::drawCursor(TextureBuilderID textureBuilderID, PaletteID paletteID, CursorAlignment alignment,
@@ -6,6 +6,8 @@
 #include <optional>
 #include <vector>
 
+#include "RenderDefinitionGroup.h"
+#include "RenderInstanceGroup.h"
 #include "RendererSystem2D.h"
 #include "RendererSystem3D.h"
 #include "RendererSystemType.h"
@@ -61,6 +63,23 @@ public:
 		// Visible flats and lights.
 		int potentiallyVisFlatCount, visFlatCount, visLightCount;
 
+		// Render thread load balancing (per-thread seconds and voxel column tiles stolen).
+		std::vector<double> threadBusyTimes, threadIdleTimes;
+		int stolenTileCount;
+
+		// Screen column binning of visible flats.
+		int flatBinCount, flatBinEntryCount, maxFlatBinSize;
+
+		// Flat shading table cache look-ups.
+		int flatShadingHitCount, flatShadingMissCount;
+
+		// Seconds per render phase (main thread visibility, then slowest render thread per phase).
+		double visibilityTime, skyTime, distantSkyTime, voxelTime, flatTime;
+
+		// Seconds from the start of the last finished frame until its render threads were done. When
+		// pipelined, this is longer than frameTime since render threads keep drawing after it.
+		double renderTime;
+
 		double frameTime;
 
 		ProfilerData();
@@ -80,6 +99,8 @@ private:
 
 	std::unique_ptr<RendererSystem2D> renderer2D;
 	std::unique_ptr<RendererSystem3D> renderer3D;
+	RenderDefinitionGroup renderDefGroup; // Cached until the level changes.
+	RenderInstanceGroup renderInstGroup; // Updated every frame, cleared with the render definitions.
 	std::vector<DisplayMode> displayModes;
 	std::vector<TextureInstance> textureInstances; // @temp placeholder until the renderer returns allocated texture handles.
 	SDL_Window *window;
@@ -89,12 +110,48 @@ private:
 	int letterboxMode; // Determines aspect ratio of the original UI (16:10, 4:3, etc.).
 	bool fullGameWindow; // Determines height of 3D frame buffer.
 
+	// Game world resolution. With dynamic resolution, the requested scale is the upper limit and
+	// the current scale follows the measured 3D render time.
+	double requestedResolutionScale, resolutionScale;
+	double dynamicResolutionFrameTime; // Total 3D render time since the last adjustment.
+	int dynamicResolutionFrameCount;
+	bool dynamicResolution;
+
+	// Dynamic resolution tuning. The 3D render gets a share of each target frame, and the scale
+	// only goes back up once frames are comfortably under that so it doesn't oscillate.
+	static constexpr int DYNAMIC_RESOLUTION_SAMPLE_FRAMES = 8;
+	static constexpr double DYNAMIC_RESOLUTION_BUDGET_PERCENT = 0.75;
+	static constexpr double DYNAMIC_RESOLUTION_RAISE_PERCENT = 0.70;
+	static constexpr double DYNAMIC_RESOLUTION_RAISE_STEP = 1.05;
+	static constexpr double DYNAMIC_RESOLUTION_MIN_SCALE = 0.10;
+
 	// Helper method for making a renderer context.
 	static SDL_Renderer *createRenderer(SDL_Window *window);
 
+	// Helper method for making the 3D renderer of the given type.
+	static std::unique_ptr<RendererSystem3D> createRendererSystem3D(RendererSystemType3D systemType3D);
+
+	// Builds this frame's render data from the game world and has the 3D renderer draw it into the
+	// given color buffer. The render data builder is included in the profiled frame time.
+	void renderWorldToBuffer(const CoordDouble3 &eye, const Double3 &forward, double fovY, double ambient,
+		double daytimePercent, double chasmAnimPercent, double latitude, bool nightLightsAreActive,
+		bool isExterior, bool playerHasLight, int chunkDistance, double ceilingHeight,
+		const LevelData &levelData, const EntityDefinitionLibrary &entityDefLibrary, const Palette &palette,
+		uint32_t *colorBuffer);
+
+	// Copies the 3D renderer's profiler data from the most recent frame.
+	void updateProfilerData(double frameTime);
+
 	// Generates a renderer dimension while avoiding pitfalls of numeric imprecision.
 	static int makeRendererDimension(int value, double resolutionScale);
 
+	// Recreates the game world frame buffer and resizes the 3D renderer if the current
+	// resolution scale gives different dimensions.
+	void resizeGameWorld();
+
+	// Adjusts the resolution scale from the average 3D render time of recent frames.
+	void updateDynamicResolution(double frameTime, int targetFps);
+
 	std::optional<int> tryGetTextureInstanceIndex(TextureBuilderID textureBuilderID, PaletteID paletteID) const;
 	void addTextureInstance(TextureBuilderID textureBuilderID, PaletteID paletteID, const TextureManager &textureManager);
 	const Texture *getOrAddTextureInstance(TextureBuilderID textureBuilderID, PaletteID paletteID,
@@ -127,6 +184,10 @@ public:
 	// the interface. The game interface is 53 pixels tall in 320x200.
 	int getViewHeight() const;
 
+	// Gets the current game world resolution scale, which might be lower than requested if
+	// dynamic resolution is enabled.
+	double getResolutionScale() const;
+
 	// This is for the "letterbox" part of the screen, scaled to fit the window 
 	// using the given letterbox aspect.
 	SDL_Rect getLetterboxDimensions() const;
@@ -171,6 +232,10 @@ public:
 	bool init(int width, int height, WindowMode windowMode, int letterboxMode,
 		RendererSystemType2D systemType2D, RendererSystemType3D systemType3D);
 
+	// Initializes only the 3D renderer with a fixed frame size and no window, for rendering the
+	// game world offscreen (i.e., benchmarking on a machine without a display).
+	bool initHeadless(int width, int height, RendererSystemType3D systemType3D, int renderThreadsMode);
+
 	// Resizes the renderer dimensions.
 	void resize(int width, int height, double resolutionScale, bool fullGameWindow);
 
@@ -198,11 +263,15 @@ public:
 	// the game interface. If there is an existing renderer in memory, it will be 
 	// overwritten with the new one.
 	void initializeWorldRendering(double resolutionScale, bool fullGameWindow,
-		int renderThreadsMode);
+		int renderThreadsMode, bool pipelinedRendering, bool dynamicResolution);
 
 	// Sets which mode to use for software render threads (low, medium, high, etc.).
 	void setRenderThreadsMode(int mode);
 
+	// Sets whether the game world resolution is lowered to keep up with the target FPS. Turning it
+	// off goes back to the requested resolution scale.
+	void setDynamicResolution(bool enabled);
+
 	// Texture handle allocation functions.
 	// @todo: see RendererSystem3D -- these should take TextureBuilders instead and return optional handles.
 	bool tryCreateVoxelTexture(const TextureAssetReference &textureAssetRef, TextureManager &textureManager);
@@ -228,6 +297,9 @@ public:
 		TextureManager &textureManager);
 	void setSkyPalette(const uint32_t *colors, int count);
 	void setNightLightsActive(bool active, const Palette &palette);
+	void updateVoxelTextureHandles(const VoxelGrid &voxelGrid);
+	void measureVoxelTextureLookups(const VoxelGrid &voxelGrid, int lookupCount, double *outHandleSeconds,
+		double *outAssetRefSeconds, int *outMismatchCount);
 	void clearTexturesAndEntityRenderIDs();
 	void clearDistantSky();
 
@@ -251,7 +323,15 @@ public:
 	void renderWorld(const CoordDouble3 &eye, const Double3 &forward, double fovY, double ambient, double daytimePercent,
 		double chasmAnimPercent, double latitude, bool nightLightsAreActive, bool isExterior, bool playerHasLight,
 		int chunkDistance, double ceilingHeight, const LevelData &levelData,
-		const EntityDefinitionLibrary &entityDefLibrary, const Palette &palette);
+		const EntityDefinitionLibrary &entityDefLibrary, const Palette &palette, int targetFps);
+
+	// Renders the game world into the given color buffer instead of the game world texture. The
+	// buffer must be the size given to initHeadless().
+	void renderWorldOffscreen(const CoordDouble3 &eye, const Double3 &forward, double fovY, double ambient,
+		double daytimePercent, double chasmAnimPercent, double latitude, bool nightLightsAreActive,
+		bool isExterior, bool playerHasLight, int chunkDistance, double ceilingHeight,
+		const LevelData &levelData, const EntityDefinitionLibrary &entityDefLibrary, const Palette &palette,
+		uint32_t *colorBuffer);
 
 	// Draws the given cursor texture to the native frame buffer. The exact position 
 	// of the cursor is modified by the cursor alignment.
@@ -1,13 +1,29 @@
 #include "RendererSystem3D.h"
 
 RendererSystem3D::ProfilerData::ProfilerData(int width, int height, int potentiallyVisFlatCount,
-	int visFlatCount, int visLightCount)
+	int visFlatCount, int visLightCount, std::vector<double> &&threadBusyTimes,
+	std::vector<double> &&threadIdleTimes, int stolenTileCount, int flatBinCount, int flatBinEntryCount,
+	int maxFlatBinSize, int flatShadingHitCount, int flatShadingMissCount, double visibilityTime,
+	double skyTime, double distantSkyTime, double voxelTime, double flatTime, double renderTime)
+	: threadBusyTimes(std::move(threadBusyTimes)), threadIdleTimes(std::move(threadIdleTimes))
 {
 	this->width = width;
 	this->height = height;
 	this->potentiallyVisFlatCount = potentiallyVisFlatCount;
 	this->visFlatCount = visFlatCount;
 	this->visLightCount = visLightCount;
+	this->stolenTileCount = stolenTileCount;
+	this->flatBinCount = flatBinCount;
+	this->flatBinEntryCount = flatBinEntryCount;
+	this->maxFlatBinSize = maxFlatBinSize;
+	this->flatShadingHitCount = flatShadingHitCount;
+	this->flatShadingMissCount = flatShadingMissCount;
+	this->visibilityTime = visibilityTime;
+	this->skyTime = skyTime;
+	this->distantSkyTime = distantSkyTime;
+	this->voxelTime = voxelTime;
+	this->flatTime = flatTime;
+	this->renderTime = renderTime;
 }
 
 RendererSystem3D::~RendererSystem3D()
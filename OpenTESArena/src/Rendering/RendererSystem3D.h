@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <optional>
+#include <vector>
 
 #include "RenderTextureUtils.h"
 #include "../Entities/EntityUtils.h" // @todo: remove dependency on this
@@ -27,6 +28,7 @@ class RenderInitSettings;
 class RenderInstanceGroup;
 class TextureBuilder;
 class TextureManager;
+class VoxelGrid;
 
 struct TextureAssetReference;
 
@@ -39,7 +41,29 @@ public:
 		int width, height;
 		int potentiallyVisFlatCount, visFlatCount, visLightCount;
 
-		ProfilerData(int width, int height, int potentiallyVisFlatCount, int visFlatCount, int visLightCount);
+		// Seconds each render thread spent working and waiting on other threads last frame.
+		std::vector<double> threadBusyTimes, threadIdleTimes;
+		int stolenTileCount;
+
+		// Screen column bins of visible flats, and how many flat references they hold in total.
+		int flatBinCount, flatBinEntryCount, maxFlatBinSize;
+
+		// Flat shading table look-ups over all render threads that found a cached table or had to
+		// make one.
+		int flatShadingHitCount, flatShadingMissCount;
+
+		// Seconds spent in each phase last frame. Visibility is main thread work; the others are
+		// the slowest render thread's drawing time.
+		double visibilityTime, skyTime, distantSkyTime, voxelTime, flatTime;
+
+		// Seconds from the start of the last finished frame until its render threads were done.
+		double renderTime;
+
+		ProfilerData(int width, int height, int potentiallyVisFlatCount, int visFlatCount, int visLightCount,
+			std::vector<double> &&threadBusyTimes, std::vector<double> &&threadIdleTimes, int stolenTileCount,
+			int flatBinCount, int flatBinEntryCount, int maxFlatBinSize, int flatShadingHitCount,
+			int flatShadingMissCount, double visibilityTime, double skyTime, double distantSkyTime,
+			double voxelTime, double flatTime, double renderTime);
 	};
 
 	virtual ~RendererSystem3D();
@@ -93,12 +117,14 @@ public:
 		TextureManager &textureManager) = 0;
 	virtual void setSkyPalette(const uint32_t *colors, int count) = 0;
 	virtual void setNightLightsActive(bool active, const Palette &palette) = 0;
+	virtual void updateVoxelTextureHandles(const VoxelGrid &voxelGrid) = 0;
+	virtual void measureVoxelTextureLookups(const VoxelGrid &voxelGrid, int lookupCount,
+		double *outHandleSeconds, double *outAssetRefSeconds, int *outMismatchCount) = 0;
 	virtual void clearTexturesAndEntityRenderIDs() = 0;
 	virtual void clearDistantSky() = 0;
-	virtual void render(const CoordDouble3 &eye, const Double3 &forward, double fovY, double ambient,
-		double daytimePercent, double chasmAnimPercent, double latitude, bool nightLightsAreActive,
-		bool isExterior, bool playerHasLight, int chunkDistance, double ceilingHeight, const LevelData &levelData,
-		const EntityDefinitionLibrary &entityDefLibrary, const Palette &palette, uint32_t *colorBuffer) = 0;
+	virtual void render(const RenderCamera &camera, const RenderFrameSettings &settings,
+		const RenderInstanceGroup &instGroup, const LevelData &levelData, const Palette &palette,
+		uint32_t *colorBuffer) = 0;
 	
 	// Begins rendering a frame. Currently this is a blocking call and it should be safe to present the frame
 	// upon returning from this.
@@ -5,7 +5,6 @@
 #include "../Game/CardinalDirection.h"
 #include "../Math/Constants.h"
 #include "../Utilities/Platform.h"
-#include "../World/LevelData.h"
 
 #include "components/debug/Debug.h"
 
@@ -108,36 +107,6 @@ void RendererUtils::getDiag2Points2D(SNInt voxelX, WEInt voxelZ, NewDouble2 *out
 	*outEnd = *outStart + (diff * Constants::JustBelowOne);
 }
 
-double RendererUtils::getDoorPercentOpen(SNInt voxelX, WEInt voxelZ, const LevelData &levelData)
-{
-	const NewInt3 voxel(voxelX, 1, voxelZ);
-	const VoxelInstance *voxelInst = levelData.tryGetVoxelInstance(voxel, VoxelInstance::Type::OpenDoor);
-	if (voxelInst != nullptr)
-	{
-		const VoxelInstance::DoorState &doorState = voxelInst->getDoorState();
-		return doorState.getPercentOpen();
-	}
-	else
-	{
-		return 0.0;
-	}
-}
-
-double RendererUtils::getFadingVoxelPercent(SNInt voxelX, int voxelY, WEInt voxelZ, const LevelData &levelData)
-{
-	const NewInt3 voxel(voxelX, voxelY, voxelZ);
-	const VoxelInstance *voxelInst = levelData.tryGetVoxelInstance(voxel, VoxelInstance::Type::Fading);
-	if (voxelInst != nullptr)
-	{
-		const VoxelInstance::FadeState &fadeState = voxelInst->getFadeState();
-		return std::clamp(1.0 - fadeState.getPercentFaded(), 0.0, 1.0);
-	}
-	else
-	{
-		return 1.0;
-	}
-}
-
 double RendererUtils::getYShear(Radians angleRadians, double zoom)
 {
 	return std::tan(angleRadians) * zoom;
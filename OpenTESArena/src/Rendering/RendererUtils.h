@@ -11,8 +11,6 @@
 
 #include "components/utilities/BufferView.h"
 
-class LevelData;
-
 namespace RendererUtils
 {
 	// Gets the number of render threads to use based on the given mode.
@@ -36,12 +34,6 @@ namespace RendererUtils
 	void getDiag2Points2D(SNInt voxelX, WEInt voxelZ, NewDouble2 *outStart,
 		NewDouble2 *outMiddle, NewDouble2 *outEnd);
 
-	// Gets the percent open of a door, or zero if there's no open door at the given voxel.
-	double getDoorPercentOpen(SNInt voxelX, WEInt voxelZ, const LevelData &levelData);
-
-	// Gets the percent fade of a voxel, or 1 if the given voxel is not fading.
-	double getFadingVoxelPercent(SNInt voxelX, int voxelY, WEInt voxelZ, const LevelData &levelData);
-
 	// Gets the y-shear value of the camera based on the Y angle relative to the horizon
 	// and the zoom of the camera (dependent on vertical field of view).
 	double getYShear(Radians angleRadians, double zoom);
@@ -1,13 +1,20 @@
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstring>
 #include <emmintrin.h>
 #include <immintrin.h>
 #include <limits>
 #include <smmintrin.h>
+#include <tuple>
+#include <type_traits>
 
 #include "ArenaRenderUtils.h"
+#include "RenderCamera.h"
 #include "RendererUtils.h"
+#include "RenderFrameSettings.h"
 #include "RenderInitSettings.h"
+#include "RenderInstanceGroup.h"
 #include "SoftwareRenderer.h"
 #include "../Assets/ArenaPaletteName.h"
 #include "../Entities/EntityAnimationInstance.h"
@@ -34,11 +41,66 @@ namespace
 	// Hardcoded graphics options (will be loaded at runtime at some point).
 	constexpr int TextureFilterMode = 0;
 	constexpr bool LightContributionCap = true;
+	constexpr bool CoherentRayBundles = true; // Step adjacent screen columns' rays together.
+	constexpr int SkyCacheDaytimeSteps = 4096; // Time of day resolution of the reusable sky.
+	constexpr bool Mipmapping = true; // Sample smaller copies of voxel and flat textures when distant.
 
 	constexpr double DEPTH_BUFFER_INFINITY = std::numeric_limits<double>::infinity();
+
+	// Column shader kernel chosen at startup from the CPU's features, unless overridden.
+	SoftwareRenderer::ColumnKernel ActiveColumnKernel = SoftwareRenderer::ColumnKernel::Scalar;
+
+	// Order-dependent hash combining for sky cache column hashes.
+	uint64_t CombineHash(uint64_t seed, uint64_t value)
+	{
+		return (seed ^ value) * 1099511628211ULL;
+	}
+
+	// Mip level with at most about two texels per pixel when the given texel span is drawn over
+	// the given number of pixels. Rounding down keeps textures sharp at the cost of a little
+	// aliasing.
+	int GetMipmapLevel(double texelCount, double pixelCount, int levelCount)
+	{
+		if (!Mipmapping || (pixelCount <= 0.0) || (texelCount <= pixelCount))
+		{
+			return 0;
+		}
+
+		// Exponent of the power of two at or below the ratio.
+		const int level = std::ilogb(texelCount / pixelCount);
+		return std::min(level, levelCount - 1);
+	}
+
+	uint64_t HashDouble(double value)
+	{
+		uint64_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+
+	// Voxel instances in a level snapshot are sorted by voxel for binary searching.
+	NewInt3 GetVoxelInstanceVoxel(const VoxelInstance &voxelInst)
+	{
+		return NewInt3(voxelInst.getX(), voxelInst.getY(), voxelInst.getZ());
+	}
+
+	bool VoxelLess(const NewInt3 &a, const NewInt3 &b)
+	{
+		return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+	}
 }
 
-void SoftwareRenderer::VoxelTexel::init(double r, double g, double b, double emission,
+// GCC and Clang only allow SSE4.1 and AVX2 intrinsics in functions compiled for them. The SSE
+// kernels are only chosen on CPUs with SSE4.2.
+#if defined(__GNUC__)
+#define SSE41_TARGET __attribute__((target("sse4.1")))
+#define AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define SSE41_TARGET
+#define AVX2_TARGET
+#endif
+
+void SoftwareRenderer::VoxelTexel::init(uint8_t r, uint8_t g, uint8_t b, uint8_t emission,
 	bool transparent)
 {
 	this->r = r;
@@ -61,7 +123,7 @@ void SoftwareRenderer::SkyTexel::init(double r, double g, double b, double a)
 	this->a = a;
 }
 
-void SoftwareRenderer::ChasmTexel::init(double r, double g, double b)
+void SoftwareRenderer::ChasmTexel::init(uint8_t r, uint8_t g, uint8_t b)
 {
 	this->r = r;
 	this->g = g;
@@ -96,16 +158,11 @@ void SoftwareRenderer::VoxelTexture::init(int width, int height, const uint8_t *
 			const int index = x + (y * width);
 			const uint8_t srcTexel = srcTexels[index];
 			const Color &srcColor = palette[srcTexel];
-
-			const Double4 dstColor = Double4::fromARGB(srcColor.toARGB());
-			const double r = dstColor.x;
-			const double g = dstColor.y;
-			const double b = dstColor.z;
-			constexpr double emission = 0.0;
-			const bool transparent = dstColor.w == 0.0;
+			constexpr uint8_t emission = 0;
+			const bool transparent = srcColor.a == 0;
 
 			VoxelTexel &dstTexel = this->texels[index];
-			dstTexel.init(r, g, b, emission, transparent);
+			dstTexel.init(srcColor.r, srcColor.g, srcColor.b, emission, transparent);
 
 			// Check if the texel is used with night lights (yellow at night).
 			if (srcTexel == ArenaRenderUtils::PALETTE_INDEX_NIGHT_LIGHT)
@@ -114,6 +171,8 @@ void SoftwareRenderer::VoxelTexture::init(int width, int height, const uint8_t *
 			}
 		}
 	}
+
+	this->initMipmaps();
 }
 
 void SoftwareRenderer::VoxelTexture::setLightTexelsActive(bool active, const Palette &palette)
@@ -124,8 +183,8 @@ void SoftwareRenderer::VoxelTexture::setLightTexelsActive(bool active, const Pal
 	const Color &inactiveColor = palette[inactivePaletteIndex];
 
 	// Change voxel texels based on whether it's night.
-	const Double4 texelColor = Double4::fromARGB((active ? activeColor : inactiveColor).toARGB());
-	const double texelEmission = active ? 1.0 : 0.0;
+	const Color &texelColor = active ? activeColor : inactiveColor;
+	const uint8_t texelEmission = active ? 255 : 0;
 
 	for (const Int2 &lightTexel : this->lightTexels)
 	{
@@ -133,12 +192,96 @@ void SoftwareRenderer::VoxelTexture::setLightTexelsActive(bool active, const Pal
 
 		DebugAssertIndex(this->texels, index);
 		VoxelTexel &texel = this->texels[index];
-		const double r = texelColor.x;
-		const double g = texelColor.y;
-		const double b = texelColor.z;
-		const double emission = texelEmission;
-		const bool transparent = texelColor.w == 0.0;
-		texel.init(r, g, b, emission, transparent);
+		const bool transparent = texelColor.a == 0;
+		texel.init(texelColor.r, texelColor.g, texelColor.b, texelEmission, transparent);
+	}
+
+	if (this->lightTexels.size() > 0)
+	{
+		this->initMipmaps();
+	}
+}
+
+int SoftwareRenderer::VoxelTexture::getMipmapLevelCount() const
+{
+	return static_cast<int>(this->mipmaps.size()) + 1;
+}
+
+const SoftwareRenderer::VoxelTexture &SoftwareRenderer::VoxelTexture::getMipmap(int level) const
+{
+	DebugAssert(level >= 0);
+	if ((level == 0) || (this->mipmaps.size() == 0))
+	{
+		return *this;
+	}
+
+	const int index = std::min(level, static_cast<int>(this->mipmaps.size())) - 1;
+	return this->mipmaps[index];
+}
+
+void SoftwareRenderer::VoxelTexture::initMipmaps()
+{
+	this->mipmaps.clear();
+
+	// Box filter each 2x2 block of the previous level. Transparent texels are left out of the
+	// color average, and a block stays opaque if at least half of it was opaque so walls with
+	// holes keep about the same coverage at a distance. Non-square textures keep halving the
+	// longer side after the shorter one reaches 1, reusing the last row or column like flats.
+	const VoxelTexture *prevLevel = this;
+	while ((prevLevel->width > 1) || (prevLevel->height > 1))
+	{
+		const int prevWidth = prevLevel->width;
+		const int prevHeight = prevLevel->height;
+		VoxelTexture mipmap;
+		mipmap.width = std::max(prevWidth / 2, 1);
+		mipmap.height = std::max(prevHeight / 2, 1);
+		mipmap.texels.resize(mipmap.width * mipmap.height);
+
+		for (int y = 0; y < mipmap.height; y++)
+		{
+			const int prevY0 = std::min(y * 2, prevHeight - 1);
+			const int prevY1 = std::min(prevY0 + 1, prevHeight - 1);
+
+			for (int x = 0; x < mipmap.width; x++)
+			{
+				const int prevX0 = std::min(x * 2, prevWidth - 1);
+				const int prevX1 = std::min(prevX0 + 1, prevWidth - 1);
+				const VoxelTexel *srcTexels[4] =
+				{
+					&prevLevel->texels[prevX0 + (prevY0 * prevWidth)],
+					&prevLevel->texels[prevX1 + (prevY0 * prevWidth)],
+					&prevLevel->texels[prevX0 + (prevY1 * prevWidth)],
+					&prevLevel->texels[prevX1 + (prevY1 * prevWidth)]
+				};
+
+				int r = 0, g = 0, b = 0, emission = 0, opaqueCount = 0;
+				for (const VoxelTexel *srcTexel : srcTexels)
+				{
+					if (!srcTexel->transparent)
+					{
+						r += srcTexel->r;
+						g += srcTexel->g;
+						b += srcTexel->b;
+						emission += srcTexel->emission;
+						opaqueCount++;
+					}
+				}
+
+				VoxelTexel &dstTexel = mipmap.texels[x + (y * mipmap.width)];
+				if (opaqueCount >= 2)
+				{
+					dstTexel.init(static_cast<uint8_t>(r / opaqueCount), static_cast<uint8_t>(g / opaqueCount),
+						static_cast<uint8_t>(b / opaqueCount), static_cast<uint8_t>(emission / opaqueCount), false);
+				}
+				else
+				{
+					dstTexel.init(0, 0, 0, 0, true);
+				}
+			}
+		}
+
+		this->mipmaps.emplace_back(std::move(mipmap));
+		prevLevel = &this->mipmaps.back();
 	}
 }
 
@@ -173,6 +316,82 @@ void SoftwareRenderer::FlatTexture::init(int width, int height, const uint8_t *s
 			dstTexel.init(srcTexel);
 		}
 	}
+
+	this->initMipmaps();
+}
+
+int SoftwareRenderer::FlatTexture::getMipmapLevelCount() const
+{
+	return static_cast<int>(this->mipmaps.size()) + 1;
+}
+
+const SoftwareRenderer::FlatTexture &SoftwareRenderer::FlatTexture::getMipmap(int level) const
+{
+	DebugAssert(level >= 0);
+	if ((level == 0) || (this->mipmaps.size() == 0))
+	{
+		return *this;
+	}
+
+	const int index = std::min(level, static_cast<int>(this->mipmaps.size())) - 1;
+	return this->mipmaps[index];
+}
+
+void SoftwareRenderer::FlatTexture::initMipmaps()
+{
+	this->mipmaps.clear();
+
+	// Flat texels are palette indices with special meanings (ghosts, puddles, etc.), so they
+	// can't be averaged. Instead, each texel takes the first opaque texel of its 2x2 block if at
+	// least half of the block is opaque. Flats aren't always power-of-two, so odd edges reuse
+	// the last row or column.
+	const FlatTexture *prevLevel = this;
+	while ((prevLevel->width > 1) || (prevLevel->height > 1))
+	{
+		const int prevWidth = prevLevel->width;
+		const int prevHeight = prevLevel->height;
+		FlatTexture mipmap;
+		mipmap.width = std::max(prevWidth / 2, 1);
+		mipmap.height = std::max(prevHeight / 2, 1);
+		mipmap.reflective = this->reflective;
+		mipmap.texels.resize(mipmap.width * mipmap.height);
+
+		for (int y = 0; y < mipmap.height; y++)
+		{
+			const int prevY0 = std::min(y * 2, prevHeight - 1);
+			const int prevY1 = std::min(prevY0 + 1, prevHeight - 1);
+
+			for (int x = 0; x < mipmap.width; x++)
+			{
+				const int prevX0 = std::min(x * 2, prevWidth - 1);
+				const int prevX1 = std::min(prevX0 + 1, prevWidth - 1);
+				const uint8_t srcValues[4] =
+				{
+					prevLevel->texels[prevX0 + (prevY0 * prevWidth)].value,
+					prevLevel->texels[prevX1 + (prevY0 * prevWidth)].value,
+					prevLevel->texels[prevX0 + (prevY1 * prevWidth)].value,
+					prevLevel->texels[prevX1 + (prevY1 * prevWidth)].value
+				};
+
+				uint8_t dstValue = 0;
+				int opaqueCount = 0;
+				for (const uint8_t srcValue : srcValues)
+				{
+					if (srcValue != 0)
+					{
+						dstValue = (opaqueCount == 0) ? srcValue : dstValue;
+						opaqueCount++;
+					}
+				}
+
+				FlatTexel &dstTexel = mipmap.texels[x + (y * mipmap.width)];
+				dstTexel.init((opaqueCount >= 2) ? dstValue : 0);
+			}
+		}
+
+		this->mipmaps.emplace_back(std::move(mipmap));
+		prevLevel = &this->mipmaps.back();
+	}
 }
 
 SoftwareRenderer::SkyTexture::SkyTexture()
@@ -251,13 +470,8 @@ void SoftwareRenderer::ChasmTexture::init(int width, int height, const uint8_t *
 			const uint8_t srcTexel = srcTexels[index];
 			const Color &srcColor = palette[srcTexel];
 
-			const Double4 dstColor = Double4::fromARGB(srcColor.toARGB());
-			const double r = dstColor.x;
-			const double g = dstColor.y;
-			const double b = dstColor.z;
-
 			ChasmTexel &dstTexel = this->texels[index];
-			dstTexel.init(r, g, b);
+			dstTexel.init(srcColor.r, srcColor.g, srcColor.b);
 		}
 	}
 }
@@ -268,6 +482,13 @@ SoftwareRenderer::VoxelTextureMapping::VoxelTextureMapping(TextureAssetReference
 	this->textureIndex = textureIndex;
 }
 
+SoftwareRenderer::VoxelTextureHandles::VoxelTextureHandles()
+{
+	this->primary = VoxelTextureHandles::NO_TEXTURE;
+	this->floor = VoxelTextureHandles::NO_TEXTURE;
+	this->ceiling = VoxelTextureHandles::NO_TEXTURE;
+}
+
 void SoftwareRenderer::VoxelTextures::addTexture(VoxelTexture &&texture, TextureAssetReference &&textureAssetRef)
 {
 	this->textures.emplace_back(std::move(texture));
@@ -276,28 +497,77 @@ void SoftwareRenderer::VoxelTextures::addTexture(VoxelTexture &&texture, Texture
 	this->mappings.emplace_back(VoxelTextureMapping(std::move(textureAssetRef), index));
 }
 
-const SoftwareRenderer::VoxelTexture &SoftwareRenderer::VoxelTextures::getTexture(
+std::optional<int> SoftwareRenderer::VoxelTextures::tryGetTextureIndex(
 	const TextureAssetReference &textureAssetRef) const
 {
-	int index = -1;
-	for (int i = 0; i < static_cast<int>(this->mappings.size()); i++)
+	for (const VoxelTextureMapping &mapping : this->mappings)
 	{
-		const VoxelTextureMapping &mapping = this->mappings[i];
 		if (mapping.textureAssetRef == textureAssetRef)
 		{
-			index = mapping.textureIndex;
-			break;
+			return mapping.textureIndex;
+		}
+	}
+
+	return std::nullopt;
+}
+
+void SoftwareRenderer::VoxelTextures::updateHandles(const VoxelGrid &voxelGrid)
+{
+	auto getTextureIndex = [this](const TextureAssetReference &textureAssetRef)
+	{
+		const std::optional<int> textureIndex = this->tryGetTextureIndex(textureAssetRef);
+		if (!textureIndex.has_value())
+		{
+			DebugLogWarning("No voxel texture loaded for \"" + textureAssetRef.filename + "\".");
+			return VoxelTextureHandles::NO_TEXTURE;
+		}
+
+		return *textureIndex;
+	};
+
+	// Voxel definitions are only ever appended (i.e., new chasm definitions when floors fade away),
+	// so only the new ones need resolving.
+	const int voxelDefCount = voxelGrid.getVoxelDefCount();
+	for (int i = static_cast<int>(this->handles.size()); i < voxelDefCount; i++)
+	{
+		const VoxelDefinition &voxelDef = voxelGrid.getVoxelDef(i);
+		const Buffer<TextureAssetReference> textureAssetRefs = voxelDef.getTextureAssetReferences();
+		const int textureAssetRefCount = textureAssetRefs.getCount();
+
+		VoxelTextureHandles voxelHandles;
+		if (textureAssetRefCount > 0)
+		{
+			voxelHandles.primary = getTextureIndex(textureAssetRefs.get(0));
+		}
+
+		// Walls and raised platforms are ordered side, floor, ceiling.
+		if (textureAssetRefCount == 3)
+		{
+			voxelHandles.floor = getTextureIndex(textureAssetRefs.get(1));
+			voxelHandles.ceiling = getTextureIndex(textureAssetRefs.get(2));
 		}
+
+		this->handles.emplace_back(std::move(voxelHandles));
 	}
+}
 
-	DebugAssertIndex(this->textures, index);
-	return this->textures[index];
+const SoftwareRenderer::VoxelTextureHandles &SoftwareRenderer::VoxelTextures::getHandles(uint16_t voxelID) const
+{
+	DebugAssertIndex(this->handles, voxelID);
+	return this->handles[voxelID];
+}
+
+const SoftwareRenderer::VoxelTexture &SoftwareRenderer::VoxelTextures::getTexture(int textureIndex) const
+{
+	DebugAssertIndex(this->textures, textureIndex);
+	return this->textures[textureIndex];
 }
 
 void SoftwareRenderer::VoxelTextures::clear()
 {
 	this->textures.clear();
 	this->mappings.clear();
+	this->handles.clear();
 }
 
 bool SoftwareRenderer::FlatTextureGroup::isValidLookup(int stateID, int angleID, int textureID) const
@@ -512,6 +782,89 @@ SoftwareRenderer::Ray::Ray(SNDouble dirX, WEDouble dirZ)
 	this->dirZ = dirZ;
 }
 
+SoftwareRenderer::Ray::Ray()
+	: Ray(0.0, 0.0) { }
+
+template <bool NonNegativeDirX, bool NonNegativeDirZ>
+void SoftwareRenderer::RayTraversal::init(const NewDouble3 &absoluteEye,
+	const NewDouble3 &absoluteEyeVoxelReal, const NewInt3 &absoluteEyeVoxel, const Ray &ray,
+	SNInt gridWidth, int gridHeight, WEInt gridDepth)
+{
+	constexpr SNDouble axisLenX = 1.0;
+	constexpr WEDouble axisLenZ = 1.0;
+
+	// Delta distance is how far the ray has to go to step one voxel's worth along a certain axis.
+	this->deltaDistX = (NonNegativeDirX ? axisLenX : -axisLenX) / ray.dirX;
+	this->deltaDistZ = (NonNegativeDirZ ? axisLenZ : -axisLenZ) / ray.dirZ;
+
+	// The initial delta distances are percentages of the delta distances, dependent on the ray
+	// start position inside the voxel.
+	const SNDouble initialDeltaDistPercentX = NonNegativeDirX ?
+		(1.0 - ((absoluteEye.x - absoluteEyeVoxelReal.x) / axisLenX)) :
+		((absoluteEye.x - absoluteEyeVoxelReal.x) / axisLenX);
+	const WEDouble initialDeltaDistPercentZ = NonNegativeDirZ ?
+		(1.0 - ((absoluteEye.z - absoluteEyeVoxelReal.z) / axisLenZ)) :
+		((absoluteEye.z - absoluteEyeVoxelReal.z) / axisLenZ);
+
+	// Initial delta distance is a fraction of delta distance based on the ray's position in
+	// the initial voxel. Delta distance sums start at the initial wall hit, and the lowest
+	// component is the candidate for the next DDA step.
+	this->deltaDistSumX = this->deltaDistX * initialDeltaDistPercentX;
+	this->deltaDistSumZ = this->deltaDistZ * initialDeltaDistPercentZ;
+
+	// Decide how far the first wall is, and which voxel face was hit.
+	if (this->deltaDistSumX < this->deltaDistSumZ)
+	{
+		this->zDistance = this->deltaDistSumX;
+		this->facing = NonNegativeDirX ? VoxelFacing2D::NegativeX : VoxelFacing2D::PositiveX;
+	}
+	else
+	{
+		this->zDistance = this->deltaDistSumZ;
+		this->facing = NonNegativeDirZ ? VoxelFacing2D::NegativeZ : VoxelFacing2D::PositiveZ;
+	}
+
+	this->cell = absoluteEyeVoxel;
+
+	// Verify that the initial voxel coordinate is within the world bounds.
+	this->voxelIsValid =
+		(absoluteEyeVoxel.x >= 0) &&
+		(absoluteEyeVoxel.y >= 0) &&
+		(absoluteEyeVoxel.z >= 0) &&
+		(absoluteEyeVoxel.x < gridWidth) &&
+		(absoluteEyeVoxel.y < gridHeight) &&
+		(absoluteEyeVoxel.z < gridDepth);
+}
+
+template <bool NonNegativeDirX, bool NonNegativeDirZ>
+void SoftwareRenderer::RayTraversal::step(const NewDouble3 &absoluteEye, const Ray &ray,
+	SNInt gridWidth, WEInt gridDepth)
+{
+	constexpr SNInt stepX = NonNegativeDirX ? 1 : -1;
+	constexpr WEInt stepZ = NonNegativeDirZ ? 1 : -1;
+
+	// Helper values for Z distance calculation per step.
+	constexpr SNDouble halfOneMinusStepXReal = static_cast<double>((1 - stepX) / 2);
+	constexpr WEDouble halfOneMinusStepZReal = static_cast<double>((1 - stepZ) / 2);
+
+	if (this->deltaDistSumX < this->deltaDistSumZ)
+	{
+		this->deltaDistSumX += this->deltaDistX;
+		this->cell.x += stepX;
+		this->facing = NonNegativeDirX ? VoxelFacing2D::NegativeX : VoxelFacing2D::PositiveX;
+		this->voxelIsValid &= (this->cell.x >= 0) && (this->cell.x < gridWidth);
+		this->zDistance = (((static_cast<double>(this->cell.x) - absoluteEye.x) + halfOneMinusStepXReal) / ray.dirX);
+	}
+	else
+	{
+		this->deltaDistSumZ += this->deltaDistZ;
+		this->cell.z += stepZ;
+		this->facing = NonNegativeDirZ ? VoxelFacing2D::NegativeZ : VoxelFacing2D::PositiveZ;
+		this->voxelIsValid &= (this->cell.z >= 0) && (this->cell.z < gridDepth);
+		this->zDistance = (((static_cast<double>(this->cell.z) - absoluteEye.z) + halfOneMinusStepZReal) / ray.dirZ);
+	}
+}
+
 SoftwareRenderer::DrawRange::DrawRange(double yProjStart, double yProjEnd, int yStart, int yEnd)
 {
 	this->yProjStart = yProjStart;
@@ -599,8 +952,8 @@ const Double3 &SoftwareRenderer::ShadingInfo::getFogColor() const
 	return this->skyColors.front();
 }
 
-SoftwareRenderer::FrameView::FrameView(uint32_t *colorBuffer, double *depthBuffer, 
-	int width, int height)
+SoftwareRenderer::FrameView::FrameView(uint32_t *colorBuffer, DepthTexel *depthBuffer, 
+	int width, int height, double maxDepth)
 {
 	this->colorBuffer = colorBuffer;
 	this->depthBuffer = depthBuffer;
@@ -608,6 +961,163 @@ SoftwareRenderer::FrameView::FrameView(uint32_t *colorBuffer, double *depthBuffe
 	this->height = height;
 	this->widthReal = static_cast<double>(width);
 	this->heightReal = static_cast<double>(height);
+
+	if constexpr (std::is_integral_v<DepthTexel>)
+	{
+		// The highest integer value is reserved for infinity.
+		const double maxEncodedDepth = static_cast<double>(DEPTH_TEXEL_INFINITY - 1);
+		this->depthEncodeScale = maxEncodedDepth / maxDepth;
+		this->depthDecodeScale = maxDepth / maxEncodedDepth;
+	}
+	else
+	{
+		this->depthEncodeScale = 1.0;
+		this->depthDecodeScale = 1.0;
+	}
+}
+
+SoftwareRenderer::DepthTexel SoftwareRenderer::FrameView::encodeDepth(double depth) const
+{
+	if constexpr (std::is_integral_v<DepthTexel>)
+	{
+		if (depth == DEPTH_BUFFER_INFINITY)
+		{
+			return DEPTH_TEXEL_INFINITY;
+		}
+
+		// Depths past the max all become the farthest finite value, which is fully fogged.
+		const double maxEncodedDepth = static_cast<double>(DEPTH_TEXEL_INFINITY - 1);
+		return static_cast<DepthTexel>(std::min((depth * this->depthEncodeScale) + 0.50, maxEncodedDepth));
+	}
+	else
+	{
+		return static_cast<DepthTexel>(depth);
+	}
+}
+
+double SoftwareRenderer::FrameView::decodeDepth(DepthTexel texel) const
+{
+	if constexpr (std::is_integral_v<DepthTexel>)
+	{
+		return (texel == DEPTH_TEXEL_INFINITY) ? DEPTH_BUFFER_INFINITY :
+			(static_cast<double>(texel) * this->depthDecodeScale);
+	}
+	else
+	{
+		return static_cast<double>(texel);
+	}
+}
+
+double SoftwareRenderer::FrameView::getDepth(int index) const
+{
+	return this->decodeDepth(this->depthBuffer[index]);
+}
+
+void SoftwareRenderer::FrameView::setDepth(int index, double depth) const
+{
+	this->depthBuffer[index] = this->encodeDepth(depth);
+}
+
+SoftwareRenderer::FlatShadingTable::FlatShadingTable()
+{
+	this->palette = nullptr;
+	this->light = 0.0;
+	this->fogPercent = 0.0;
+	this->lightLevel = -1;
+	this->fogLevel = -1;
+}
+
+bool SoftwareRenderer::FlatShadingTable::matches(const Palette &palette, int lightLevel, int fogLevel) const
+{
+	return (this->palette == &palette) && (this->lightLevel == lightLevel) && (this->fogLevel == fogLevel);
+}
+
+void SoftwareRenderer::FlatShadingTable::init(const Palette &palette, int lightLevel, int fogLevel)
+{
+	constexpr double maxLevelReal = static_cast<double>(FlatShadingTable::LEVEL_COUNT - 1);
+
+	this->colors.fill(FlatShadingTable::UNSET_COLOR);
+	this->palette = &palette;
+	this->light = static_cast<double>(lightLevel) / maxLevelReal;
+	this->fogPercent = static_cast<double>(fogLevel) / maxLevelReal;
+	this->lightLevel = lightLevel;
+	this->fogLevel = fogLevel;
+}
+
+uint32_t SoftwareRenderer::FlatShadingTable::getColor(uint8_t texelValue, const Double3 &fogColor)
+{
+	uint32_t &color = this->colors[texelValue];
+	if (color == FlatShadingTable::UNSET_COLOR)
+	{
+		// Some red texels are swapped for other palette colors.
+		const bool isRedSrc1 = (texelValue == ArenaRenderUtils::PALETTE_INDEX_RED_SRC1);
+		const bool isRedSrc2 = (texelValue == ArenaRenderUtils::PALETTE_INDEX_RED_SRC2);
+		const int paletteIndex = isRedSrc1 ? ArenaRenderUtils::PALETTE_INDEX_RED_DST1 :
+			(isRedSrc2 ? ArenaRenderUtils::PALETTE_INDEX_RED_DST2 : texelValue);
+		const Double4 texelColor = Double4::fromARGB((*this->palette)[paletteIndex].toARGB());
+
+		double colorR = texelColor.x * this->light;
+		double colorG = texelColor.y * this->light;
+		double colorB = texelColor.z * this->light;
+
+		// Linearly interpolate with fog.
+		colorR += (fogColor.x - colorR) * this->fogPercent;
+		colorG += (fogColor.y - colorG) * this->fogPercent;
+		colorB += (fogColor.z - colorB) * this->fogPercent;
+
+		// Clamp maximum (don't worry about negative values).
+		const double high = 1.0;
+		colorR = (colorR > high) ? high : colorR;
+		colorG = (colorG > high) ? high : colorG;
+		colorB = (colorB > high) ? high : colorB;
+
+		color = static_cast<uint32_t>(
+			((static_cast<uint8_t>(colorR * 255.0)) << 16) |
+			((static_cast<uint8_t>(colorG * 255.0)) << 8) |
+			((static_cast<uint8_t>(colorB * 255.0))));
+	}
+
+	return color;
+}
+
+SoftwareRenderer::FlatShadingCache::FlatShadingCache()
+{
+	this->nextTableIndex = 0;
+	this->hitCount = 0;
+	this->missCount = 0;
+}
+
+int SoftwareRenderer::FlatShadingCache::getHitCount() const
+{
+	return this->hitCount;
+}
+
+int SoftwareRenderer::FlatShadingCache::getMissCount() const
+{
+	return this->missCount;
+}
+
+SoftwareRenderer::FlatShadingTable &SoftwareRenderer::FlatShadingCache::getTable(const Palette &palette,
+	double light, double fogPercent)
+{
+	constexpr double maxLevelReal = static_cast<double>(FlatShadingTable::LEVEL_COUNT - 1);
+	const int lightLevel = static_cast<int>(std::round(std::clamp(light, 0.0, 1.0) * maxLevelReal));
+	const int fogLevel = static_cast<int>(std::round(std::clamp(fogPercent, 0.0, 1.0) * maxLevelReal));
+
+	for (FlatShadingTable &table : this->tables)
+	{
+		if (table.matches(palette, lightLevel, fogLevel))
+		{
+			this->hitCount++;
+			return table;
+		}
+	}
+
+	this->missCount++;
+	FlatShadingTable &table = this->tables[this->nextTableIndex];
+	table.init(palette, lightLevel, fogLevel);
+	this->nextTableIndex = (this->nextTableIndex + 1) % FlatShadingCache::TABLE_COUNT;
+	return table;
 }
 
 template <typename T>
@@ -801,31 +1311,125 @@ void SoftwareRenderer::DistantObjects::init(const DistantSky &distantSky,
 
 		this->sunTextureIndex = addSkyTexture(*textureBuilderID);
 	}
-}
 
-void SoftwareRenderer::DistantObjects::clear()
-{
-	this->lands.clear();
-	this->animLands.clear();
-	this->airs.clear();
-	this->moons.clear();
-	this->stars.clear();
-	this->sunTextureIndex = DistantObjects::NO_SUN;
+	this->initStarCells(skyTextures);
 }
 
-SoftwareRenderer::VisDistantObject::VisDistantObject(const SkyTexture &texture, DrawRange &&drawRange,
-	double xProjStart, double xProjEnd, int xStart, int xEnd, bool emissive)
-	: drawRange(std::move(drawRange))
+void SoftwareRenderer::DistantObjects::initStarCells(const std::vector<SkyTexture> &skyTextures)
 {
-	this->texture = &texture;
-	this->xProjStart = xProjStart;
-	this->xProjEnd = xProjEnd;
-	this->xStart = xStart;
-	this->xEnd = xEnd;
-	this->emissive = emissive;
-}
+	this->starCells.clear();
 
-SoftwareRenderer::VisDistantObjects::VisDistantObjects()
+	constexpr int cellCount = STAR_CELL_ELEVATION_COUNT * STAR_CELL_AZIMUTH_COUNT;
+	std::vector<StarCell> cells(cellCount);
+
+	for (int i = 0; i < static_cast<int>(this->stars.size()); i++)
+	{
+		const Double3 direction = this->stars[i].obj.getDirection().normalized();
+		const double elevationPercent = (std::asin(direction.y) + Constants::HalfPi) / Constants::Pi;
+		const double azimuthPercent = (std::atan2(direction.x, direction.z) + Constants::Pi) / Constants::TwoPi;
+		const int elevationIndex = std::clamp(static_cast<int>(elevationPercent * STAR_CELL_ELEVATION_COUNT),
+			0, STAR_CELL_ELEVATION_COUNT - 1);
+		const int azimuthIndex = std::clamp(static_cast<int>(azimuthPercent * STAR_CELL_AZIMUTH_COUNT),
+			0, STAR_CELL_AZIMUTH_COUNT - 1);
+
+		StarCell &cell = cells[azimuthIndex + (elevationIndex * STAR_CELL_AZIMUTH_COUNT)];
+		cell.starIndices.push_back(i);
+	}
+
+	for (StarCell &cell : cells)
+	{
+		if (cell.starIndices.size() == 0)
+		{
+			continue;
+		}
+
+		Double3 directionSum = Double3::Zero;
+		cell.maxWidth = 0.0;
+		for (const int starIndex : cell.starIndices)
+		{
+			const DistantObject<DistantSky::StarObject> &star = this->stars[starIndex];
+			directionSum = directionSum + star.obj.getDirection().normalized();
+
+			const SkyTexture &texture = skyTextures.at(star.textureIndex);
+			const double width = static_cast<double>(texture.width) / DistantSky::IDENTITY_DIM;
+			cell.maxWidth = std::max(cell.maxWidth, width);
+		}
+
+		cell.direction = directionSum.normalized();
+
+		double minCosAngle = 1.0;
+		for (const int starIndex : cell.starIndices)
+		{
+			const Double3 direction = this->stars[starIndex].obj.getDirection().normalized();
+			minCosAngle = std::min(minCosAngle, cell.direction.dot(direction));
+		}
+
+		// Culling bounds how far a star's horizontal direction can be from the cell's, and dropping
+		// the Y component never lengthens the chord between two unit directions. Cells are much
+		// smaller than a hemisphere, but one that isn't has an unreliable average direction.
+		cell.chordRadius = std::sqrt(std::max(2.0 - (2.0 * minCosAngle), 0.0));
+		cell.isWide = minCosAngle <= 0.0;
+
+		this->starCells.push_back(std::move(cell));
+	}
+}
+
+int SoftwareRenderer::DistantObjects::getAnimLandTextureIndex(
+	const DistantObject<DistantSky::AnimatedLandObject> &animLand) const
+{
+	// Need to see how many frames the animated land has.
+	const DistantSky::AnimatedLandObject &animLandObj = animLand.obj;
+	const std::string &animLandFilename = this->distantSky->getTextureSetFilename(animLandObj.getTextureSetEntryIndex());
+	const std::optional<TextureBuilderIdGroup> textureBuilderIDs =
+		this->textureManager->tryGetTextureBuilderIDs(animLandFilename.c_str());
+	if (!textureBuilderIDs.has_value())
+	{
+		DebugLogError("Couldn't get texture builder IDs for \"" + animLandFilename + "\".");
+		return -1;
+	}
+
+	const int animTextureCount = textureBuilderIDs->getCount();
+	const double animPercent = animLandObj.getAnimPercent();
+	const int curAnimTextureIndex = std::clamp(
+		static_cast<int>(static_cast<double>(animTextureCount) * animPercent), 0, animTextureCount - 1);
+	return animLand.textureIndex + curAnimTextureIndex;
+}
+
+uint64_t SoftwareRenderer::DistantObjects::getAnimLandFrameHash() const
+{
+	uint64_t hash = 0;
+	for (const auto &animLand : this->animLands)
+	{
+		hash = CombineHash(hash, static_cast<uint64_t>(this->getAnimLandTextureIndex(animLand)));
+	}
+
+	return hash;
+}
+
+void SoftwareRenderer::DistantObjects::clear()
+{
+	this->lands.clear();
+	this->animLands.clear();
+	this->airs.clear();
+	this->moons.clear();
+	this->stars.clear();
+	this->starCells.clear();
+	this->sunTextureIndex = DistantObjects::NO_SUN;
+}
+
+SoftwareRenderer::VisDistantObject::VisDistantObject(const SkyTexture &texture, DrawRange &&drawRange,
+	double xProjStart, double xProjEnd, int xStart, int xEnd, bool emissive)
+	: drawRange(std::move(drawRange))
+{
+	this->texture = &texture;
+	this->xProjStart = xProjStart;
+	this->xProjEnd = xProjEnd;
+	this->xStart = xStart;
+	this->xEnd = xEnd;
+	this->emissive = emissive;
+}
+
+SoftwareRenderer::VisDistantObjects::VisDistantObjects()
 {
 	this->landStart = 0;
 	this->landEnd = 0;
@@ -858,6 +1462,72 @@ void SoftwareRenderer::VisDistantObjects::clear()
 	this->starEnd = 0;
 }
 
+SoftwareRenderer::SkyCache::SkyCache()
+{
+	this->fovY = 0.0;
+	this->aspect = 0.0;
+	this->distantAmbient = 0.0;
+	this->animLandFrameHash = 0;
+	this->daytimeStep = 0;
+	this->starsVisible = false;
+	this->valid = false;
+	this->mode = Mode::Redraw;
+	this->gradientChanged = false;
+}
+
+void SoftwareRenderer::SkyCache::init(int width, int height)
+{
+	this->colors.init(width, height);
+	this->rowColors.init(height);
+	this->rowColors.fill(Double3::Zero);
+	this->columnHashes.init(width);
+	this->columnHashes.fill(0);
+	this->nextColumnHashes.init(width);
+	this->dirtyColumns.init(width);
+	this->dirtyColumns.fill(true);
+	this->invalidate();
+}
+
+void SoftwareRenderer::SkyCache::beginFrame(const Camera &camera, int daytimeStep, double distantAmbient,
+	uint64_t animLandFrameHash)
+{
+	// Distant objects are infinitely far away, so the camera position doesn't matter.
+	const bool isSameView = this->valid && (camera.direction == this->direction) &&
+		(camera.fovY == this->fovY) && (camera.aspect == this->aspect);
+
+	if (!isSameView)
+	{
+		this->mode = Mode::Redraw;
+	}
+	else if ((daytimeStep == this->daytimeStep) && (animLandFrameHash == this->animLandFrameHash))
+	{
+		this->mode = Mode::Reuse;
+	}
+	else if (distantAmbient == this->distantAmbient)
+	{
+		this->mode = Mode::Update;
+	}
+	else
+	{
+		// Every non-emissive distant object's shading changed.
+		this->mode = Mode::Redraw;
+	}
+
+	this->direction = camera.direction;
+	this->fovY = camera.fovY;
+	this->aspect = camera.aspect;
+	this->distantAmbient = distantAmbient;
+	this->animLandFrameHash = animLandFrameHash;
+	this->daytimeStep = daytimeStep;
+	this->valid = true;
+	this->gradientChanged = false;
+}
+
+void SoftwareRenderer::SkyCache::invalidate()
+{
+	this->valid = false;
+}
+
 void SoftwareRenderer::VisibleLight::init(const Double3 &position, double radius)
 {
 	this->position = position;
@@ -892,35 +1562,339 @@ void SoftwareRenderer::VisibleLightList::add(LightID lightID)
 void SoftwareRenderer::VisibleLightList::clear()
 {
 	this->count = 0;
+	this->poolStart = 0;
+}
+
+int SoftwareRenderer::VisibleLightPool::getCount() const
+{
+	return static_cast<int>(this->xs.size());
+}
+
+void SoftwareRenderer::VisibleLightPool::add(const VisibleLight &light)
+{
+	this->xs.push_back(light.position.x);
+	this->zs.push_back(light.position.z);
+	this->invRadii.push_back(1.0 / light.radius);
+}
+
+void SoftwareRenderer::VisibleLightPool::addPadding()
+{
+	// Far enough away that its contribution is always clamped to zero.
+	constexpr double farCoord = 1.0e9;
+	while ((this->getCount() % VisibleLightPool::LIGHT_STRIDE) != 0)
+	{
+		this->xs.push_back(farCoord);
+		this->zs.push_back(farCoord);
+		this->invRadii.push_back(1.0);
+	}
+}
+
+void SoftwareRenderer::VisibleLightPool::clear()
+{
+	this->xs.clear();
+	this->zs.clear();
+	this->invRadii.clear();
+}
+
+SoftwareRenderer::LevelSnapshot::LevelSnapshot()
+{
+	this->levelData = nullptr;
+}
+
+void SoftwareRenderer::LevelSnapshot::initLive(const LevelData &levelData)
+{
+	this->levelData = &levelData;
+}
+
+void SoftwareRenderer::LevelSnapshot::initCopy(const LevelData &levelData, const ChunkInt2 &cameraChunk,
+	int chunkDistance)
+{
+	this->levelData = nullptr;
+
+	// A different level needs a full copy. Otherwise only chunks changed since the last copy are
+	// copied, which for a level nobody is editing is none of them.
+	const VoxelGrid &levelVoxelGrid = levelData.getVoxelGrid();
+	if (!this->voxelGrid.has_value() || (this->voxelGrid->getID() != levelVoxelGrid.getID()))
+	{
+		this->voxelGrid.emplace(levelVoxelGrid);
+	}
+	else
+	{
+		VoxelGrid &voxelGrid = *this->voxelGrid;
+
+		// Voxel definitions are only ever added to a level.
+		for (int i = voxelGrid.getVoxelDefCount(); i < levelVoxelGrid.getVoxelDefCount(); i++)
+		{
+			voxelGrid.addVoxelDef(levelVoxelGrid.getVoxelDef(i));
+		}
+
+		bool anyChunkCopied = false;
+		for (WEInt z = 0; z < voxelGrid.getChunkCountZ(); z++)
+		{
+			for (SNInt x = 0; x < voxelGrid.getChunkCountX(); x++)
+			{
+				const ChunkInt2 chunk(x, z);
+				if (voxelGrid.getChunkRevision(chunk) != levelVoxelGrid.getChunkRevision(chunk))
+				{
+					voxelGrid.copyChunk(levelVoxelGrid, chunk);
+					anyChunkCopied = true;
+				}
+			}
+		}
+
+		if (anyChunkCopied)
+		{
+			voxelGrid.compact();
+		}
+	}
+
+	// Only voxel instances in chunks that can be ray cast are needed.
+	this->voxelInsts.clear();
+
+	ChunkInt2 minChunk, maxChunk;
+	ChunkUtils::getSurroundingChunks(cameraChunk, chunkDistance, &minChunk, &maxChunk);
+
+	for (WEInt z = minChunk.y; z <= maxChunk.y; z++)
+	{
+		for (SNInt x = minChunk.x; x <= maxChunk.x; x++)
+		{
+			const LevelData::VoxelInstanceGroup *voxelInstGroup = levelData.tryGetVoxelInstances(ChunkInt2(x, z));
+			if (voxelInstGroup != nullptr)
+			{
+				for (const auto &pair : *voxelInstGroup)
+				{
+					const std::vector<VoxelInstance> &voxelInstList = pair.second;
+					this->voxelInsts.insert(this->voxelInsts.end(), voxelInstList.begin(), voxelInstList.end());
+				}
+			}
+		}
+	}
+
+	std::sort(this->voxelInsts.begin(), this->voxelInsts.end(),
+		[](const VoxelInstance &a, const VoxelInstance &b)
+	{
+		return VoxelLess(GetVoxelInstanceVoxel(a), GetVoxelInstanceVoxel(b));
+	});
 }
 
-void SoftwareRenderer::VisibleLightList::sortByNearest(const Double3 &point,
-	const BufferView<const VisibleLight> &visLights)
+const VoxelGrid &SoftwareRenderer::LevelSnapshot::getVoxelGrid() const
 {
-	// @todo: can only do this if we know the lightID index when sorting.
-	// Cache distance calculations for less redundant work.
-	/*std::array<bool, std::tuple_size<decltype(this->lightIDs)>::value> validCacheDists;
-	std::array<double, std::tuple_size<decltype(this->lightIDs)>::value> cachedDists;
-	validCacheDists.fill(false);*/
+	if (this->levelData != nullptr)
+	{
+		return this->levelData->getVoxelGrid();
+	}
+	else
+	{
+		DebugAssert(this->voxelGrid.has_value());
+		return *this->voxelGrid;
+	}
+}
 
-	const auto startIter = this->lightIDs.begin();
-	const auto endIter = startIter + this->count;
+const VoxelInstance *SoftwareRenderer::LevelSnapshot::tryGetVoxelInstance(const NewInt3 &voxel,
+	VoxelInstance::Type type) const
+{
+	if (this->levelData != nullptr)
+	{
+		return this->levelData->tryGetVoxelInstance(voxel, type);
+	}
 
-	std::sort(startIter, endIter, [&point, &visLights](LightID a, LightID b)
+	auto iter = std::lower_bound(this->voxelInsts.begin(), this->voxelInsts.end(), voxel,
+		[](const VoxelInstance &voxelInst, const NewInt3 &voxel)
 	{
-		const VisibleLight &aLight = SoftwareRenderer::getVisibleLightByID(visLights, a);
-		const VisibleLight &bLight = SoftwareRenderer::getVisibleLightByID(visLights, b);
-		const double aDistSqr = (point - aLight.position).lengthSquared();
-		const double bDistSqr = (point - bLight.position).lengthSquared();
-		return aDistSqr < bDistSqr;
+		return VoxelLess(GetVoxelInstanceVoxel(voxelInst), voxel);
 	});
+
+	for (; (iter != this->voxelInsts.end()) && (GetVoxelInstanceVoxel(*iter) == voxel); ++iter)
+	{
+		if (iter->getType() == type)
+		{
+			return &(*iter);
+		}
+	}
+
+	return nullptr;
+}
+
+double SoftwareRenderer::LevelSnapshot::getDoorPercentOpen(SNInt voxelX, WEInt voxelZ) const
+{
+	const NewInt3 voxel(voxelX, 1, voxelZ);
+	const VoxelInstance *voxelInst = this->tryGetVoxelInstance(voxel, VoxelInstance::Type::OpenDoor);
+	if (voxelInst != nullptr)
+	{
+		const VoxelInstance::DoorState &doorState = voxelInst->getDoorState();
+		return doorState.getPercentOpen();
+	}
+	else
+	{
+		return 0.0;
+	}
+}
+
+double SoftwareRenderer::LevelSnapshot::getFadingVoxelPercent(SNInt voxelX, int voxelY, WEInt voxelZ) const
+{
+	const NewInt3 voxel(voxelX, voxelY, voxelZ);
+	const VoxelInstance *voxelInst = this->tryGetVoxelInstance(voxel, VoxelInstance::Type::Fading);
+	if (voxelInst != nullptr)
+	{
+		const VoxelInstance::FadeState &fadeState = voxelInst->getFadeState();
+		return std::clamp(1.0 - fadeState.getPercentFaded(), 0.0, 1.0);
+	}
+	else
+	{
+		return 1.0;
+	}
+}
+
+void SoftwareRenderer::LevelSnapshot::clear()
+{
+	this->levelData = nullptr;
+	this->voxelGrid = std::nullopt;
+	this->voxelInsts.clear();
+}
+
+void SoftwareRenderer::VoxelColumn::init(SNInt x, WEInt z, const VoxelGrid &voxelGrid)
+{
+	this->x = x;
+	this->z = z;
+
+	if (!voxelGrid.tryGetColumnRange(x, z, &this->minY, &this->maxY))
+	{
+		this->isCached = false;
+		return;
+	}
+
+	const int voxelCount = (this->maxY - this->minY) + 1;
+	this->isCached = voxelCount <= VoxelColumn::MAX_HEIGHT;
+	if (this->isCached)
+	{
+		for (int i = 0; i < voxelCount; i++)
+		{
+			this->voxelIDs[i] = voxelGrid.getVoxel(x, this->minY + i, z);
+			this->fadePercents[i] = -1.0;
+		}
+	}
+}
+
+bool SoftwareRenderer::VoxelColumn::isEmpty() const
+{
+	return this->minY > this->maxY;
+}
+
+uint16_t SoftwareRenderer::VoxelColumn::getVoxelID(int y, const VoxelGrid &voxelGrid) const
+{
+	if (!this->isCached)
+	{
+		return voxelGrid.getVoxel(this->x, y, this->z);
+	}
+
+	DebugAssert(y >= this->minY);
+	DebugAssert(y <= this->maxY);
+	return this->voxelIDs[y - this->minY];
+}
+
+double SoftwareRenderer::VoxelColumn::getFadePercent(int y, const LevelSnapshot &levelSnapshot)
+{
+	if (!this->isCached)
+	{
+		return levelSnapshot.getFadingVoxelPercent(this->x, y, this->z);
+	}
+
+	DebugAssert(y >= this->minY);
+	DebugAssert(y <= this->maxY);
+	double &fadePercent = this->fadePercents[y - this->minY];
+	if (fadePercent < 0.0)
+	{
+		fadePercent = levelSnapshot.getFadingVoxelPercent(this->x, y, this->z);
+	}
+
+	return fadePercent;
+}
+
+SoftwareRenderer::ColumnTileQueue::ColumnTileQueue()
+{
+	this->range = 0;
+}
+
+void SoftwareRenderer::ColumnTileQueue::init(int startTile, int endTile)
+{
+	DebugAssert(startTile >= 0);
+	DebugAssert(endTile >= startTile);
+
+	// Relaxed is enough here since render threads only read the queues after an acquiring load of
+	// the voxels phase flag.
+	const uint64_t newRange = static_cast<uint64_t>(startTile) | (static_cast<uint64_t>(endTile) << 32);
+	this->range.store(newRange, std::memory_order_relaxed);
+}
+
+bool SoftwareRenderer::ColumnTileQueue::tryPopFront(int *outTile)
+{
+	uint64_t oldRange = this->range.load(std::memory_order_acquire);
+	while (true)
+	{
+		const uint32_t startTile = static_cast<uint32_t>(oldRange);
+		const uint32_t endTile = static_cast<uint32_t>(oldRange >> 32);
+		if (startTile >= endTile)
+		{
+			return false;
+		}
+
+		const uint64_t newRange = static_cast<uint64_t>(startTile + 1) | (static_cast<uint64_t>(endTile) << 32);
+		if (this->range.compare_exchange_weak(oldRange, newRange, std::memory_order_acq_rel,
+			std::memory_order_acquire))
+		{
+			*outTile = static_cast<int>(startTile);
+			return true;
+		}
+	}
+}
+
+bool SoftwareRenderer::ColumnTileQueue::tryPopBack(int *outTile)
+{
+	uint64_t oldRange = this->range.load(std::memory_order_acquire);
+	while (true)
+	{
+		const uint32_t startTile = static_cast<uint32_t>(oldRange);
+		const uint32_t endTile = static_cast<uint32_t>(oldRange >> 32);
+		if (startTile >= endTile)
+		{
+			return false;
+		}
+
+		const uint64_t newRange = static_cast<uint64_t>(startTile) | (static_cast<uint64_t>(endTile - 1) << 32);
+		if (this->range.compare_exchange_weak(oldRange, newRange, std::memory_order_acq_rel,
+			std::memory_order_acquire))
+		{
+			*outTile = static_cast<int>(endTile - 1);
+			return true;
+		}
+	}
+}
+
+SoftwareRenderer::RenderThreadStats::RenderThreadStats()
+{
+	this->clear();
+}
+
+void SoftwareRenderer::RenderThreadStats::clear()
+{
+	this->busyTime = 0.0;
+	this->idleTime = 0.0;
+	this->skyTime = 0.0;
+	this->distantSkyTime = 0.0;
+	this->voxelTime = 0.0;
+	this->flatTime = 0.0;
+	this->stolenTileCount = 0;
+	this->flatShadingHitCount = 0;
+	this->flatShadingMissCount = 0;
+	this->endTime = std::chrono::high_resolution_clock::time_point();
 }
 
 void SoftwareRenderer::RenderThreadData::SkyGradient::init(double projectedYTop,
-	double projectedYBottom, Buffer<Double3> &rowCache)
+	double projectedYBottom, Buffer<Double3> &rowCache, SkyCache &skyCache)
 {
 	this->threadsDone = 0;
 	this->rowCache = &rowCache;
+	this->skyCache = &skyCache;
 	this->projectedYTop = projectedYTop;
 	this->projectedYBottom = projectedYBottom;
 	this->shouldDrawStars = false;
@@ -936,14 +1910,27 @@ void SoftwareRenderer::RenderThreadData::DistantSky::init(const VisDistantObject
 }
 
 void SoftwareRenderer::RenderThreadData::Voxels::init(int chunkDistance, double ceilingHeight,
-	const LevelData &levelData, const std::vector<VisibleLight> &visLights,
+	const LevelSnapshot &levelSnapshot, const VisibleLightPool &visLights,
 	const Buffer2D<VisibleLightList> &visLightLists, const VoxelTextures &voxelTextures,
-	const ChasmTextureGroups &chasmTextureGroups, Buffer<OcclusionData> &occlusion)
+	const ChasmTextureGroups &chasmTextureGroups, Buffer<OcclusionData> &occlusion, int frameWidth,
+	int threadCount)
 {
 	this->threadsDone = 0;
+	this->tileCount = (frameWidth + SoftwareRenderer::VOXEL_COLUMN_TILE_WIDTH - 1) /
+		SoftwareRenderer::VOXEL_COLUMN_TILE_WIDTH;
+
+	// Give each thread a contiguous run of tiles so its columns are likely to share voxel data.
+	DebugAssert(threadCount <= this->tileQueues.getCount());
+	for (int i = 0; i < threadCount; i++)
+	{
+		const int startTile = (this->tileCount * i) / threadCount;
+		const int endTile = (this->tileCount * (i + 1)) / threadCount;
+		this->tileQueues.get(i).init(startTile, endTile);
+	}
+
 	this->chunkDistance = chunkDistance;
 	this->ceilingHeight = ceilingHeight;
-	this->levelData = &levelData;
+	this->levelSnapshot = &levelSnapshot;
 	this->visLights = &visLights;
 	this->visLightLists = &visLightLists;
 	this->voxelTextures = &voxelTextures;
@@ -953,12 +1940,14 @@ void SoftwareRenderer::RenderThreadData::Voxels::init(int chunkDistance, double
 }
 
 void SoftwareRenderer::RenderThreadData::Flats::init(const Double3 &flatNormal,
-	const std::vector<VisibleFlat> &visibleFlats, const std::vector<VisibleLight> &visLights,
-	const Buffer2D<VisibleLightList> &visLightLists, const FlatTextureGroups &flatTextureGroups)
+	const std::vector<VisibleFlat> &visibleFlats, const std::vector<std::vector<int>> &visibleFlatBins,
+	const VisibleLightPool &visLights, const Buffer2D<VisibleLightList> &visLightLists,
+	const FlatTextureGroups &flatTextureGroups)
 {
 	this->threadsDone = 0;
 	this->flatNormal = &flatNormal;
 	this->visibleFlats = &visibleFlats;
+	this->visibleFlatBins = &visibleFlatBins;
 	this->visLights = &visLights;
 	this->visLightLists = &visLightLists;
 	this->flatTextureGroups = &flatTextureGroups;
@@ -993,7 +1982,14 @@ SoftwareRenderer::SoftwareRenderer()
 	this->width = 0;
 	this->height = 0;
 	this->renderThreadsMode = 0;
+	this->renderThreadCount = 0;
 	this->fogDistance = 0.0;
+	this->backColorBufferIndex = 0;
+	this->pipelined = false;
+	this->frameInFlight = false;
+	this->visibilityTime = 0.0;
+	this->renderTime = 0.0;
+	this->potentiallyVisFlatCount = 0;
 }
 
 SoftwareRenderer::~SoftwareRenderer()
@@ -1001,6 +1997,23 @@ SoftwareRenderer::~SoftwareRenderer()
 	this->resetRenderThreads();
 }
 
+SoftwareRenderer::ColumnKernel SoftwareRenderer::getColumnKernel()
+{
+	return ActiveColumnKernel;
+}
+
+bool SoftwareRenderer::trySetColumnKernel(ColumnKernel kernel)
+{
+	if (((kernel == ColumnKernel::AVX) && !Platform::hasAVX()) ||
+		((kernel == ColumnKernel::SSE) && !Platform::hasSSE()))
+	{
+		return false;
+	}
+
+	ActiveColumnKernel = kernel;
+	return true;
+}
+
 bool SoftwareRenderer::isInited() const
 {
 	// Frame buffer area must be positive.
@@ -1011,8 +2024,48 @@ SoftwareRenderer::ProfilerData SoftwareRenderer::getProfilerData() const
 {
 	// @todo: make this a member of SoftwareRenderer eventually when it is capturing more
 	// information in render(), etc..
-	return ProfilerData(this->width, this->height, static_cast<int>(this->potentiallyVisibleFlats.size()), 
-		static_cast<int>(this->visibleFlats.size()), static_cast<int>(this->visibleLights.size()));
+	// Render threads might be writing stats for the in-flight frame, so use the last finished one.
+	const int threadCount = static_cast<int>(this->frameThreadStats.size());
+	std::vector<double> threadBusyTimes(threadCount);
+	std::vector<double> threadIdleTimes(threadCount);
+	int stolenTileCount = 0;
+	int flatShadingHitCount = 0;
+	int flatShadingMissCount = 0;
+
+	// Threads draw each phase in parallel, so the slowest thread is the phase's time.
+	double skyTime = 0.0;
+	double distantSkyTime = 0.0;
+	double voxelTime = 0.0;
+	double flatTime = 0.0;
+	for (int i = 0; i < threadCount; i++)
+	{
+		const RenderThreadStats &stats = this->frameThreadStats[i];
+		threadBusyTimes[i] = stats.busyTime;
+		threadIdleTimes[i] = stats.idleTime;
+		stolenTileCount += stats.stolenTileCount;
+		flatShadingHitCount += stats.flatShadingHitCount;
+		flatShadingMissCount += stats.flatShadingMissCount;
+		skyTime = std::max(skyTime, stats.skyTime);
+		distantSkyTime = std::max(distantSkyTime, stats.distantSkyTime);
+		voxelTime = std::max(voxelTime, stats.voxelTime);
+		flatTime = std::max(flatTime, stats.flatTime);
+	}
+
+	const int flatBinCount = static_cast<int>(this->visibleFlatBins.size());
+	int flatBinEntryCount = 0;
+	int maxFlatBinSize = 0;
+	for (const std::vector<int> &bin : this->visibleFlatBins)
+	{
+		const int binSize = static_cast<int>(bin.size());
+		flatBinEntryCount += binSize;
+		maxFlatBinSize = std::max(maxFlatBinSize, binSize);
+	}
+
+	return ProfilerData(this->width, this->height, this->potentiallyVisFlatCount,
+		static_cast<int>(this->visibleFlats.size()), static_cast<int>(this->visibleLights.size()),
+		std::move(threadBusyTimes), std::move(threadIdleTimes), stolenTileCount, flatBinCount,
+		flatBinEntryCount, maxFlatBinSize, flatShadingHitCount, flatShadingMissCount, this->visibilityTime, skyTime, distantSkyTime, voxelTime,
+		flatTime, this->renderTime);
 }
 
 bool SoftwareRenderer::isValidEntityRenderID(EntityRenderID id) const
@@ -1089,9 +2142,11 @@ Double3 SoftwareRenderer::screenPointToRay(double xPercent, double yPercent,
 
 void SoftwareRenderer::init(const RenderInitSettings &settings)
 {
+	this->finishFrame();
+
 	// Initialize frame buffer.
 	this->depthBuffer.init(settings.getWidth(), settings.getHeight());
-	this->depthBuffer.fill(DEPTH_BUFFER_INFINITY);
+	this->depthBuffer.fill(DEPTH_TEXEL_INFINITY);
 
 	// Initialize occlusion columns.
 	this->occlusion.init(settings.getWidth());
@@ -1100,6 +2155,7 @@ void SoftwareRenderer::init(const RenderInitSettings &settings)
 	// Initialize sky gradient cache.
 	this->skyGradientRowCache.init(settings.getHeight());
 	this->skyGradientRowCache.fill(Double3::Zero);
+	this->skyCache.init(settings.getWidth(), settings.getHeight());
 
 	// Initialize texture containers.
 	this->voxelTextures = VoxelTextures();
@@ -1108,31 +2164,57 @@ void SoftwareRenderer::init(const RenderInitSettings &settings)
 	this->width = settings.getWidth();
 	this->height = settings.getHeight();
 	this->renderThreadsMode = settings.getRenderThreadsMode();
+	this->pipelined = settings.isPipelinedRendering();
+
+	if (this->pipelined)
+	{
+		this->initColorBuffers(settings.getWidth(), settings.getHeight());
+	}
+
+	// Pick the widest column shader kernel the CPU supports.
+	if (Platform::hasAVX())
+	{
+		ActiveColumnKernel = ColumnKernel::AVX;
+	}
+	else if (Platform::hasSSE())
+	{
+		ActiveColumnKernel = ColumnKernel::SSE;
+	}
+	else
+	{
+		ActiveColumnKernel = ColumnKernel::Scalar;
+	}
 
 	// Fog distance is zero by default.
 	this->fogDistance = 0.0;
 
 	// Initialize render threads.
 	const int threadCount = RendererUtils::getRenderThreadsFromMode(settings.getRenderThreadsMode());
-	this->initRenderThreads(settings.getWidth(), settings.getHeight(), threadCount);
+	this->setRenderThreadCount(threadCount);
 }
 
 void SoftwareRenderer::shutdown()
 {
+	this->finishFrame();
+
 	// Don't need to free anything manually.
 }
 
 void SoftwareRenderer::setRenderThreadsMode(int mode)
 {
+	this->finishFrame();
+
 	this->renderThreadsMode = mode;
 
-	// Re-initialize render threads.
+	// Takes effect next frame. Existing threads are kept.
 	const int threadCount = RendererUtils::getRenderThreadsFromMode(renderThreadsMode);
-	this->initRenderThreads(this->width, this->height, threadCount);
+	this->setRenderThreadCount(threadCount);
 }
 
 EntityRenderID SoftwareRenderer::makeEntityRenderID()
 {
+	this->finishFrame();
+
 	this->flatTextureGroups.push_back(FlatTextureGroup());
 	return static_cast<EntityRenderID>(this->flatTextureGroups.size()) - 1;
 }
@@ -1141,6 +2223,8 @@ void SoftwareRenderer::setFlatTextures(EntityRenderID entityRenderID,
 	const EntityAnimationDefinition &animDef, const EntityAnimationInstance &animInst,
 	bool isPuddle, TextureManager &textureManager)
 {
+	this->finishFrame();
+
 	DebugAssert(this->isValidEntityRenderID(entityRenderID));
 	FlatTextureGroup &flatTextureGroup = this->flatTextureGroups[entityRenderID];
 	flatTextureGroup.init(animInst);
@@ -1182,12 +2266,17 @@ void SoftwareRenderer::setFlatTextures(EntityRenderID entityRenderID,
 
 void SoftwareRenderer::setFogDistance(double fogDistance)
 {
+	this->finishFrame();
+
 	this->fogDistance = fogDistance;
 }
 
 void SoftwareRenderer::setDistantSky(const DistantSky &distantSky, const Palette &palette,
 	TextureManager &textureManager)
 {
+	this->finishFrame();
+	this->skyCache.invalidate();
+
 	// Clear old distant sky data.
 	this->distantObjects.clear();
 	this->skyTextures.clear();
@@ -1198,6 +2287,9 @@ void SoftwareRenderer::setDistantSky(const DistantSky &distantSky, const Palette
 
 void SoftwareRenderer::setSkyPalette(const uint32_t *colors, int count)
 {
+	this->finishFrame();
+	this->skyCache.invalidate();
+
 	this->skyPalette = std::vector<Double3>(count);
 
 	for (size_t i = 0; i < this->skyPalette.size(); i++)
@@ -1209,6 +2301,8 @@ void SoftwareRenderer::setSkyPalette(const uint32_t *colors, int count)
 void SoftwareRenderer::addChasmTexture(VoxelDefinition::ChasmData::Type chasmType,
 	const uint8_t *colors, int width, int height, const Palette &palette)
 {
+	this->finishFrame();
+
 	const int chasmID = RendererUtils::getChasmIdFromType(chasmType);
 
 	auto iter = this->chasmTextureGroups.find(chasmID);
@@ -1225,6 +2319,8 @@ void SoftwareRenderer::addChasmTexture(VoxelDefinition::ChasmData::Type chasmTyp
 
 void SoftwareRenderer::setNightLightsActive(bool active, const Palette &palette)
 {
+	this->finishFrame();
+
 	// @todo: activate lights (don't worry about textures).
 
 	for (VoxelTexture &voxelTexture : this->voxelTextures.textures)
@@ -1233,8 +2329,114 @@ void SoftwareRenderer::setNightLightsActive(bool active, const Palette &palette)
 	}
 }
 
+void SoftwareRenderer::updateVoxelTextureHandles(const VoxelGrid &voxelGrid)
+{
+	this->finishFrame();
+
+	this->voxelTextures.updateHandles(voxelGrid);
+}
+
+void SoftwareRenderer::measureVoxelTextureLookups(const VoxelGrid &voxelGrid, int lookupCount,
+	double *outHandleSeconds, double *outAssetRefSeconds, int *outMismatchCount)
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	this->finishFrame();
+
+	VoxelTextures &textures = this->voxelTextures;
+	textures.updateHandles(voxelGrid);
+
+	*outHandleSeconds = 0.0;
+	*outAssetRefSeconds = 0.0;
+	*outMismatchCount = 0;
+
+	// Each voxel definition's primary texture reference, if it has one.
+	const int voxelDefCount = voxelGrid.getVoxelDefCount();
+	std::vector<std::optional<TextureAssetReference>> primaryAssetRefs(voxelDefCount);
+	for (int i = 0; i < voxelDefCount; i++)
+	{
+		const Buffer<TextureAssetReference> textureAssetRefs = voxelGrid.getVoxelDef(i).getTextureAssetReferences();
+		if (textureAssetRefs.getCount() == 0)
+		{
+			continue;
+		}
+
+		primaryAssetRefs[i] = textureAssetRefs.get(0);
+
+		const std::optional<int> textureIndex = textures.tryGetTextureIndex(*primaryAssetRefs[i]);
+		const int expectedIndex = textureIndex.has_value() ? *textureIndex : VoxelTextureHandles::NO_TEXTURE;
+		if (textures.getHandles(static_cast<uint16_t>(i)).primary != expectedIndex)
+		{
+			(*outMismatchCount)++;
+		}
+	}
+
+	// Textured voxels in grid order, so the look-ups follow the level's mix of voxels.
+	std::vector<uint16_t> voxelIDs;
+	for (int y = 0; (y < voxelGrid.getHeight()) && (static_cast<int>(voxelIDs.size()) < lookupCount); y++)
+	{
+		for (WEInt z = 0; z < voxelGrid.getDepth(); z++)
+		{
+			for (SNInt x = 0; x < voxelGrid.getWidth(); x++)
+			{
+				const uint16_t voxelID = voxelGrid.getVoxel(x, y, z);
+				if (primaryAssetRefs[voxelID].has_value())
+				{
+					voxelIDs.emplace_back(voxelID);
+				}
+			}
+		}
+	}
+
+	if (voxelIDs.empty())
+	{
+		return;
+	}
+
+	// Both loops sum the texture indices they find so the look-ups aren't optimized away, and so
+	// they can be checked against each other.
+	auto measureLookups = [lookupCount, &voxelIDs](auto &&getTextureIndex, int64_t *outIndexSum)
+	{
+		int64_t indexSum = 0;
+		size_t voxelIndex = 0;
+		const auto startTime = Clock::now();
+		for (int i = 0; i < lookupCount; i++)
+		{
+			indexSum += getTextureIndex(voxelIDs[voxelIndex]);
+			voxelIndex++;
+			if (voxelIndex == voxelIDs.size())
+			{
+				voxelIndex = 0;
+			}
+		}
+
+		*outIndexSum = indexSum;
+		return std::chrono::duration<double>(Clock::now() - startTime).count();
+	};
+
+	int64_t handleIndexSum, assetRefIndexSum;
+	*outHandleSeconds = measureLookups([&textures](uint16_t voxelID)
+	{
+		return textures.getHandles(voxelID).primary;
+	}, &handleIndexSum);
+
+	*outAssetRefSeconds = measureLookups([&textures, &primaryAssetRefs](uint16_t voxelID)
+	{
+		const std::optional<int> textureIndex = textures.tryGetTextureIndex(*primaryAssetRefs[voxelID]);
+		return textureIndex.has_value() ? *textureIndex : VoxelTextureHandles::NO_TEXTURE;
+	}, &assetRefIndexSum);
+
+	if ((*outMismatchCount == 0) && (handleIndexSum != assetRefIndexSum))
+	{
+		DebugLogWarning("Voxel texture look-ups found different textures.");
+		*outMismatchCount = 1;
+	}
+}
+
 void SoftwareRenderer::clearTexturesAndEntityRenderIDs()
 {
+	this->finishFrame();
+
 	this->voxelTextures.clear();
 	this->flatTextureGroups.clear();
 
@@ -1247,31 +2449,62 @@ void SoftwareRenderer::clearTexturesAndEntityRenderIDs()
 
 void SoftwareRenderer::clearDistantSky()
 {
+	this->finishFrame();
+	this->skyCache.invalidate();
+
 	this->distantObjects.clear();
 }
 
 void SoftwareRenderer::resize(int width, int height)
 {
+	this->finishFrame();
+
 	this->depthBuffer.init(width, height);
-	this->depthBuffer.fill(DEPTH_BUFFER_INFINITY);
+	this->depthBuffer.fill(DEPTH_TEXEL_INFINITY);
 
 	this->occlusion.init(width);
 	this->occlusion.fill(OcclusionData(0, height));
 
 	this->skyGradientRowCache.init(height);
 	this->skyGradientRowCache.fill(Double3::Zero);
+	this->skyCache.init(width, height);
+
+	if (this->pipelined)
+	{
+		// The next render() presents the front buffer before anything is drawn at the new size, so
+		// the last finished frame is stretched into it instead of presenting a black frame.
+		const Buffer<uint32_t> oldFrontColorBuffer = std::move(this->colorBuffers[this->backColorBufferIndex ^ 1]);
+		const int oldWidth = this->width;
+		const int oldHeight = this->height;
+		this->initColorBuffers(width, height);
+
+		if (oldFrontColorBuffer.isValid() && (oldWidth > 0) && (oldHeight > 0))
+		{
+			Buffer<uint32_t> &frontColorBuffer = this->colorBuffers[this->backColorBufferIndex ^ 1];
+			for (int y = 0; y < height; y++)
+			{
+				const int oldY = (y * oldHeight) / height;
+				const uint32_t *oldRow = oldFrontColorBuffer.get() + (oldY * oldWidth);
+				uint32_t *newRow = frontColorBuffer.get() + (y * width);
+				for (int x = 0; x < width; x++)
+				{
+					newRow[x] = oldRow[(x * oldWidth) / width];
+				}
+			}
+		}
+	}
 
 	this->width = width;
 	this->height = height;
 
-	// Restart render threads with new dimensions.
-	const int threadCount = RendererUtils::getRenderThreadsFromMode(this->renderThreadsMode);
-	this->initRenderThreads(width, height, threadCount);
+	// Render threads don't need restarting; they read the new dimensions from the next frame.
 }
 
 bool SoftwareRenderer::tryCreateVoxelTexture(const TextureAssetReference &textureAssetRef,
 	TextureManager &textureManager)
 {
+	this->finishFrame();
+
 	// @todo: protect against duplicate textures.
 
 	const std::optional<TextureBuilderID> textureBuilderID = textureManager.tryGetTextureBuilderID(textureAssetRef);
@@ -1318,6 +2551,8 @@ bool SoftwareRenderer::tryCreateVoxelTexture(const TextureAssetReference &textur
 bool SoftwareRenderer::tryCreateEntityTexture(const TextureAssetReference &textureAssetRef,
 	TextureManager &textureManager)
 {
+	this->finishFrame();
+
 	const std::optional<TextureBuilderID> textureBuilderID = textureManager.tryGetTextureBuilderID(textureAssetRef);
 	if (!textureBuilderID.has_value())
 	{
@@ -1346,6 +2581,8 @@ bool SoftwareRenderer::tryCreateEntityTexture(const TextureAssetReference &textu
 bool SoftwareRenderer::tryCreateSkyTexture(const TextureAssetReference &textureAssetRef,
 	TextureManager &textureManager)
 {
+	this->finishFrame();
+
 	const std::optional<TextureBuilderID> textureBuilderID = textureManager.tryGetTextureBuilderID(textureAssetRef);
 	if (!textureBuilderID.has_value())
 	{
@@ -1386,47 +2623,44 @@ void SoftwareRenderer::freeSkyTexture(const TextureAssetReference &textureAssetR
 	DebugNotImplemented();
 }
 
-void SoftwareRenderer::initRenderThreads(int width, int height, int threadCount)
+void SoftwareRenderer::setRenderThreadCount(int threadCount)
 {
-	// If there are existing threads, reset them.
-	if (this->renderThreads.getCount() > 0)
+	DebugAssert(threadCount > 0);
+	this->finishFrame();
+
+	this->renderThreadCount = threadCount;
+
+	const int oldThreadCount = this->renderThreads.getCount();
+	if (threadCount <= oldThreadCount)
 	{
-		this->resetRenderThreads();
+		// Enough threads are already running.
+		return;
 	}
 
-	// If more or fewer threads are requested, re-allocate the render thread list.
-	if (this->renderThreads.getCount() != threadCount)
+	// Grow the pool. Existing threads are idle at their initial wait condition and look up their
+	// per-thread data by index each frame, so the per-thread buffers can be reallocated here.
+	Buffer<std::thread> newRenderThreads(threadCount);
+	for (int i = 0; i < oldThreadCount; i++)
 	{
-		this->renderThreads.init(threadCount);
+		newRenderThreads.set(i, std::move(this->renderThreads.get(i)));
 	}
 
-	// Block width and height are the approximate number of columns and rows per thread,
-	// respectively.
-	const double blockWidth = static_cast<double>(width) / static_cast<double>(threadCount);
-	const double blockHeight = static_cast<double>(height) / static_cast<double>(threadCount);
+	this->renderThreads = std::move(newRenderThreads);
+	this->threadData.voxels.tileQueues.init(threadCount);
+	this->threadData.threadStats.init(threadCount);
 
-	// Start thread loop for each render thread. Rounding is involved so the start and stop
-	// coordinates are correct for all resolutions.
-	for (int i = 0; i < this->renderThreads.getCount(); i++)
+	// Start thread loop for each new render thread.
+	for (int i = oldThreadCount; i < threadCount; i++)
 	{
-		const int startX = static_cast<int>(std::round(static_cast<double>(i) * blockWidth));
-		const int endX = static_cast<int>(std::round(static_cast<double>(i + 1) * blockWidth));
-		const int startY = static_cast<int>(std::round(static_cast<double>(i) * blockHeight));
-		const int endY = static_cast<int>(std::round(static_cast<double>(i + 1) * blockHeight));
-
-		// Make sure the rounding is correct.
-		DebugAssert(startX >= 0);
-		DebugAssert(endX <= width);
-		DebugAssert(startY >= 0);
-		DebugAssert(endY <= height);
-
 		this->renderThreads.set(i, std::thread(SoftwareRenderer::renderThreadLoop,
-			std::ref(this->threadData), i, startX, endX, startY, endY));
+			std::ref(this->threadData), i));
 	}
 }
 
 void SoftwareRenderer::resetRenderThreads()
 {
+	this->finishFrame();
+
 	// Tell each render thread it needs to terminate.
 	std::unique_lock<std::mutex> lk(this->threadData.mutex);
 	this->threadData.go = true;
@@ -1448,6 +2682,50 @@ void SoftwareRenderer::resetRenderThreads()
 	this->threadData.isDestructing = false;
 }
 
+void SoftwareRenderer::finishFrame()
+{
+	if (!this->frameInFlight)
+	{
+		return;
+	}
+
+	SoftwareRenderer::waitForThreads(this->threadData.flats.threadsDone, this->threadData.totalThreads);
+
+	const Buffer<RenderThreadStats> &threadStats = this->threadData.threadStats;
+	this->frameThreadStats.assign(threadStats.get(), threadStats.get() + this->threadData.totalThreads);
+
+	// The frame took until its last render thread was done, which when pipelined can be well after
+	// render() returned.
+	auto frameEndTime = this->frameStartTime;
+	for (const RenderThreadStats &stats : this->frameThreadStats)
+	{
+		frameEndTime = std::max(frameEndTime, stats.endTime);
+	}
+
+	this->renderTime = std::chrono::duration<double>(frameEndTime - this->frameStartTime).count();
+
+	// Star visibility is only known once the sky gradient is drawn.
+	if (this->skyCache.mode != SkyCache::Mode::Reuse)
+	{
+		this->skyCache.starsVisible = this->threadData.skyGradient.shouldDrawStars;
+	}
+
+	this->frameInFlight = false;
+}
+
+void SoftwareRenderer::initColorBuffers(int width, int height)
+{
+	// The front buffer is presented before anything is drawn into it, so start it out black unless
+	// the caller has a previous frame to put there.
+	for (Buffer<uint32_t> &colorBuffer : this->colorBuffers)
+	{
+		colorBuffer.init(width * height);
+		colorBuffer.fill(0);
+	}
+
+	this->backColorBufferIndex = 0;
+}
+
 void SoftwareRenderer::updateVisibleDistantObjects(const ShadingInfo &shadingInfo,
 	const Camera &camera, const FrameView &frame)
 {
@@ -1571,25 +2849,15 @@ void SoftwareRenderer::updateVisibleDistantObjects(const ShadingInfo &shadingInf
 	{
 		const DistantSky::AnimatedLandObject &animLandObj = animLand.obj;
 
-		// Need to see how many frames the animated land has.
-		const std::string &animLandFilename =
-			this->distantObjects.distantSky->getTextureSetFilename(animLandObj.getTextureSetEntryIndex());
-		const std::optional<TextureBuilderIdGroup> textureBuilderIDs =
-			this->distantObjects.textureManager->tryGetTextureBuilderIDs(animLandFilename.c_str());
-		if (!textureBuilderIDs.has_value())
+		const int animTextureIndex = this->distantObjects.getAnimLandTextureIndex(animLand);
+		if (animTextureIndex < 0)
 		{
-			DebugLogError("Couldn't get texture builder IDs for \"" + animLandFilename + "\".");
 			continue;
 		}
 
-		const int animTextureCount = textureBuilderIDs->getCount();
-		const double animPercent = animLandObj.getAnimPercent();
-		const int curAnimTextureIndex = std::clamp(
-			static_cast<int>(static_cast<double>(animTextureCount) * animPercent), 0, animTextureCount - 1);
-
-		const int skyTextureIndex = DebugMakeIndex(this->skyTextures, animLand.textureIndex + curAnimTextureIndex);
+		const int skyTextureIndex = DebugMakeIndex(this->skyTextures, animTextureIndex);
 		const SkyTexture &texture = this->skyTextures[skyTextureIndex];
-		const Radians xAngleRadians = animLand.obj.getAngle();
+		const Radians xAngleRadians = animLandObj.getAngle();
 		const Radians yAngleRadians = 0.0;
 		const bool emissive = true;
 		const Orientation orientation = Orientation::Bottom;
@@ -1717,8 +2985,60 @@ void SoftwareRenderer::updateVisibleDistantObjects(const ShadingInfo &shadingInf
 	this->visDistantObjs.sunEnd = static_cast<int>(this->visDistantObjs.objs.size());
 	this->visDistantObjs.starStart = this->visDistantObjs.sunEnd;
 
-	for (const auto &star : this->distantObjects.stars)
+	// Only stars in cells that might overlap the screen horizontally need to be projected. A
+	// horizontal direction v is on-screen when clip(v).x is within +/-(1 + 2 * halfWidth) of
+	// clip(v).w, and both clip values are linear in v, so each bound is a plane through the eye.
+	// Stars are visited in their original order so the draw order is unchanged.
+	this->potentiallyVisibleStars.clear();
+	{
+		const Matrix4d starRotation = latitudeRotation * timeRotation;
+		const Double4 clipX = camera.transform * Double4(1.0, 0.0, 0.0, 0.0);
+		const Double4 clipZ = camera.transform * Double4(0.0, 0.0, 1.0, 0.0);
+		const Double3 forwardNormal = Double3(camera.forwardX, 0.0, camera.forwardZ).normalized();
+		const double projWidthScale = camera.zoom / (camera.aspect * ArenaRenderUtils::TALL_PIXEL_RATIO);
+
+		// Allows for precision differences between this test and the per-star projection.
+		constexpr double epsilon = 1.0e-6;
+
+		// Returns whether any direction within the cell's bounds might be on the inside of the plane.
+		auto cellTouchesPlane = [epsilon](const Double3 &cellDir, const DistantObjects::StarCell &cell, const Double3 &normal)
+		{
+			const double normalLength = normal.length();
+			if (normalLength < epsilon)
+			{
+				return true;
+			}
+
+			return (cellDir.dot(normal) / normalLength) >= -(cell.chordRadius + epsilon);
+		};
+
+		for (const DistantObjects::StarCell &cell : this->distantObjects.starCells)
+		{
+			// Stars are placed in the opposite horizontal direction of their rotated direction.
+			const Double4 rotatedDir = starRotation * Double4(cell.direction, 0.0);
+			const Double3 cellDir(-rotatedDir.x, 0.0, -rotatedDir.z);
+
+			const double clipBound = 1.0 + (cell.maxWidth * projWidthScale);
+			const Double3 rightNormal(
+				(clipBound * clipX.w) - clipX.x, 0.0, (clipBound * clipZ.w) - clipZ.x);
+			const Double3 leftNormal(
+				clipX.x + (clipBound * clipX.w), 0.0, clipZ.x + (clipBound * clipZ.w));
+
+			const bool cellIsVisible = cell.isWide || (cellTouchesPlane(cellDir, cell, forwardNormal) &&
+				cellTouchesPlane(cellDir, cell, rightNormal) && cellTouchesPlane(cellDir, cell, leftNormal));
+			if (cellIsVisible)
+			{
+				this->potentiallyVisibleStars.insert(this->potentiallyVisibleStars.end(),
+					cell.starIndices.begin(), cell.starIndices.end());
+			}
+		}
+
+		std::sort(this->potentiallyVisibleStars.begin(), this->potentiallyVisibleStars.end());
+	}
+
+	for (const int starIndex : this->potentiallyVisibleStars)
 	{
+		const auto &star = this->distantObjects.stars[starIndex];
 		const SkyTexture &texture = skyTextures.at(star.textureIndex);
 
 		const Double3 &direction = star.obj.getDirection();
@@ -1737,100 +3057,64 @@ void SoftwareRenderer::updateVisibleDistantObjects(const ShadingInfo &shadingInf
 	this->visDistantObjs.starEnd = static_cast<int>(this->visDistantObjs.objs.size());
 }
 
-void SoftwareRenderer::updatePotentiallyVisibleFlats(const Camera &camera,
-	SNInt gridWidth, WEInt gridDepth, int chunkDistance, const EntityManager &entityManager,
-	std::vector<const Entity*> *outPotentiallyVisFlats, int *outEntityCount)
+void SoftwareRenderer::updateSkyCacheColumns()
 {
-	const ChunkInt2 &cameraChunk = camera.eye.chunk;
-
-	// Get the min and max chunk coordinates to loop over.
-	ChunkInt2 minChunk, maxChunk;
-	ChunkUtils::getSurroundingChunks(cameraChunk, chunkDistance, &minChunk, &maxChunk);
-
-	// Number of potentially visible chunks along each axis (i.e. 3x3).
-	SNInt potentiallyVisChunkCountX;
-	WEInt potentiallyVisChunkCountZ;
-	ChunkUtils::getPotentiallyVisibleChunkCounts(chunkDistance,
-		&potentiallyVisChunkCountX, &potentiallyVisChunkCountZ);
-
-	auto getChunkPotentiallyVisFlatCount = [&entityManager](SNInt chunkX, WEInt chunkZ)
-	{
-		return entityManager.getTotalCountInChunk(ChunkInt2(chunkX, chunkZ));
-	};
+	SkyCache &skyCache = this->skyCache;
+	Buffer<uint64_t> &hashes = skyCache.nextColumnHashes;
+	hashes.fill(0);
 
-	auto getTotalPotentiallyVisFlatCount = [](const BufferView2D<const int> &chunkPotentiallyVisFlatCounts)
+	// Hash objects in the same order they're drawn so overlaps are accounted for.
+	auto hashObjRange = [this, &hashes](int start, int end, uint64_t renderType)
 	{
-		int count = 0;
-		for (WEInt z = 0; z < chunkPotentiallyVisFlatCounts.getHeight(); z++)
+		const VisDistantObject *objs = this->visDistantObjs.objs.data();
+		for (int i = end - 1; i >= start; i--)
 		{
-			for (SNInt x = 0; x < chunkPotentiallyVisFlatCounts.getWidth(); x++)
+			const VisDistantObject &obj = objs[i];
+			uint64_t objHash = CombineHash(renderType, reinterpret_cast<uintptr_t>(obj.texture));
+			objHash = CombineHash(objHash, HashDouble(obj.xProjStart));
+			objHash = CombineHash(objHash, HashDouble(obj.xProjEnd));
+			objHash = CombineHash(objHash, HashDouble(obj.drawRange.yProjStart));
+			objHash = CombineHash(objHash, HashDouble(obj.drawRange.yProjEnd));
+			objHash = CombineHash(objHash, obj.emissive ? 1 : 0);
+
+			const int xStart = std::max(obj.xStart, 0);
+			const int xEnd = std::min(obj.xEnd, hashes.getCount());
+			for (int x = xStart; x < xEnd; x++)
 			{
-				count += chunkPotentiallyVisFlatCounts.get(x, z);
+				hashes.set(x, CombineHash(hashes.get(x), objHash));
 			}
 		}
-
-		return count;
 	};
 
-	// Get potentially visible flat counts for each chunk.
-	Buffer2D<int> chunkPotentiallyVisFlatCounts(potentiallyVisChunkCountX, potentiallyVisChunkCountZ);
-	for (WEInt z = 0; z < chunkPotentiallyVisFlatCounts.getHeight(); z++)
-	{
-		for (SNInt x = 0; x < chunkPotentiallyVisFlatCounts.getWidth(); x++)
-		{
-			const SNInt chunkX = minChunk.x + x;
-			const WEInt chunkZ = minChunk.y + z;
-			const int count = getChunkPotentiallyVisFlatCount(chunkX, chunkZ);
-			chunkPotentiallyVisFlatCounts.set(x, z, count);
-		}
-	}
-
-	// Total potentially visible flat count (in the chunks surrounding the player).
-	const int potentiallyVisFlatCount = getTotalPotentiallyVisFlatCount(BufferView2D<const int>(
-		chunkPotentiallyVisFlatCounts.get(), chunkPotentiallyVisFlatCounts.getWidth(),
-		chunkPotentiallyVisFlatCounts.getHeight()));
-
-	auto addPotentiallyVisFlatsInChunk = [&entityManager, outPotentiallyVisFlats, &minChunk,
-		&chunkPotentiallyVisFlatCounts](SNInt chunkX, WEInt chunkZ, int insertIndex)
-	{
-		const Entity **entitiesPtr = outPotentiallyVisFlats->data() + insertIndex;
-		const SNInt visChunkX = chunkX - minChunk.x;
-		const WEInt visChunkZ = chunkZ - minChunk.y;
-		const int count = chunkPotentiallyVisFlatCounts.get(visChunkX, visChunkZ);
-		const int writtenCount = entityManager.getTotalEntitiesInChunk(
-			ChunkInt2(chunkX, chunkZ), entitiesPtr, count);
-		DebugAssert(writtenCount <= count);
-	};
+	const VisDistantObjects &objs = this->visDistantObjs;
+	hashObjRange(objs.starStart, objs.starEnd, 1);
+	hashObjRange(objs.sunStart, objs.sunEnd, 2);
+	hashObjRange(objs.moonStart, objs.moonEnd, 3);
+	hashObjRange(objs.airStart, objs.airEnd, 4);
+	hashObjRange(objs.animLandStart, objs.animLandEnd, 5);
+	hashObjRange(objs.landStart, objs.landEnd, 6);
 
-	outPotentiallyVisFlats->resize(potentiallyVisFlatCount);
-
-	int potentiallyVisFlatInsertIndex = 0;
-	for (WEInt z = 0; z < potentiallyVisChunkCountZ; z++)
+	for (int x = 0; x < hashes.getCount(); x++)
 	{
-		for (SNInt x = 0; x < potentiallyVisChunkCountX; x++)
-		{
-			const int chunkPotentiallyVisFlatCount = chunkPotentiallyVisFlatCounts.get(x, z);
-			const SNInt chunkX = minChunk.x + x;
-			const WEInt chunkZ = minChunk.y + z;
-			addPotentiallyVisFlatsInChunk(chunkX, chunkZ, potentiallyVisFlatInsertIndex);
-			potentiallyVisFlatInsertIndex += chunkPotentiallyVisFlatCount;
-		}
+		const uint64_t hash = hashes.get(x);
+		skyCache.dirtyColumns.set(x, hash != skyCache.columnHashes.get(x));
+		skyCache.columnHashes.set(x, hash);
 	}
-
-	*outEntityCount = potentiallyVisFlatInsertIndex;
 }
 
 void SoftwareRenderer::updateVisibleFlats(const Camera &camera, const ShadingInfo &shadingInfo,
-	int chunkDistance, double ceilingHeight, const VoxelGrid &voxelGrid,
-	const EntityManager &entityManager, const EntityDefinitionLibrary &entityDefLibrary)
+	const RenderInstanceGroup &instGroup)
 {
 	this->visibleFlats.clear();
 	this->visibleLights.clear();
 
-	// Update potentially visible flats so this method knows what to work with.
-	int potentiallyVisFlatCount;
-	SoftwareRenderer::updatePotentiallyVisibleFlats(camera, voxelGrid.getWidth(), voxelGrid.getDepth(),
-		chunkDistance, entityManager, &this->potentiallyVisibleFlats, &potentiallyVisFlatCount);
+	// Every entity instance in the chunks around the camera is potentially visible.
+	this->potentiallyVisFlatCount = instGroup.getEntityInstCount();
+
+	// Reserving one palette per potentially visible flat keeps pointers into the list valid while
+	// it's filled.
+	this->visibleFlatPalettes.clear();
+	this->visibleFlatPalettes.reserve(this->potentiallyVisFlatCount);
 
 	// Each flat shares the same axes. The forward direction always faces opposite to 
 	// the camera direction.
@@ -1838,9 +3122,6 @@ void SoftwareRenderer::updateVisibleFlats(const Camera &camera, const ShadingInf
 	const Double3 flatUp = Double3::UnitY;
 	const Double3 flatRight = flatForward.cross(flatUp).normalized();
 
-	const CoordDouble2 eyeXZ(
-		camera.eye.chunk,
-		VoxelDouble2(camera.eye.point.x, camera.eye.point.z));
 	const NewDouble3 absoluteEye = VoxelUtils::coordToNewPoint(camera.eye);
 	const NewDouble2 absoluteEyeXZ(absoluteEye.x, absoluteEye.z);
 	const NewDouble2 cameraDir(camera.forwardX, camera.forwardZ);
@@ -1855,46 +3136,17 @@ void SoftwareRenderer::updateVisibleFlats(const Camera &camera, const ShadingInf
 
 	// Potentially visible flat determination algorithm, given the current camera.
 	// Also calculates visible lights.
-	for (int i = 0; i < potentiallyVisFlatCount; i++)
+	for (int i = 0; i < this->potentiallyVisFlatCount; i++)
 	{
-		const Entity *entity = this->potentiallyVisibleFlats[i];
-
-		// Entities can currently be null because of EntityGroup implementation details.
-		if (entity == nullptr)
-		{
-			continue;
-		}
-
-		const EntityDefinition &entityDef = entityManager.getEntityDef(
-			entity->getDefinitionID(), entityDefLibrary);
-
-		EntityManager::EntityVisibilityData visData;
-		entityManager.getEntityVisibilityData(*entity, eyeXZ, ceilingHeight, voxelGrid,
-			entityDefLibrary, visData);
-
-		// Get entity animation state to determine render properties.
-		const EntityAnimationDefinition &animDef = entityDef.getAnimDef();
-		const EntityAnimationDefinition::State &animDefState = animDef.getState(visData.stateIndex);
-		const EntityAnimationDefinition::KeyframeList &animDefKeyframeList =
-			animDefState.getKeyframeList(visData.angleIndex);
-		const EntityAnimationDefinition::Keyframe &animDefKeyframe =
-			animDefKeyframeList.getKeyframe(visData.keyframeIndex);
-
-		const double flatWidth = animDefKeyframe.getWidth();
-		const double flatHeight = animDefKeyframe.getHeight();
+		const EntityRenderInstance &renderInst = instGroup.getEntityInst(i);
+		const double flatWidth = renderInst.getWidth();
+		const double flatHeight = renderInst.getHeight();
 		const double flatHalfWidth = flatWidth * 0.50;
 
 		// See if the entity is a light.
-		int lightIntensity;
-		if (!EntityUtils::tryGetLightIntensity(entityDef, &lightIntensity))
-		{
-			constexpr int streetLightIntensity = 4;
-			const bool isActiveStreetLight = ((entityDef.getType() == EntityDefinition::Type::Doodad) &&
-				entityDef.getDoodad().streetlight) && shadingInfo.nightLightsAreActive;
-			lightIntensity = isActiveStreetLight ? streetLightIntensity : 0;
-		}
+		const int lightIntensity = renderInst.getLightIntensity();
 
-		const NewDouble3 absoluteFlatPosition = VoxelUtils::coordToNewPoint(visData.flatPosition);
+		const NewDouble3 absoluteFlatPosition = VoxelUtils::coordToNewPoint(renderInst.getPosition());
 		const bool isLight = lightIntensity > 0;
 		if (isLight)
 		{
@@ -1935,10 +3187,11 @@ void SoftwareRenderer::updateVisibleFlats(const Camera &camera, const ShadingInf
 
 			// Determine if the flat is potentially visible to the camera.
 			VisibleFlat visFlat;
-			visFlat.entityRenderID = entity->getRenderID();
-			visFlat.animStateID = visData.stateIndex;
-			visFlat.animAngleID = visData.angleIndex;
-			visFlat.animTextureID = visData.keyframeIndex;
+			visFlat.entityID = renderInst.getEntityID();
+			visFlat.entityRenderID = renderInst.getRenderID();
+			visFlat.animStateID = renderInst.getStateIndex();
+			visFlat.animAngleID = renderInst.getAngleIndex();
+			visFlat.animTextureID = renderInst.getKeyframeIndex();
 
 			// Calculate each corner of the flat in world space.
 			visFlat.bottomLeft = absoluteFlatPosition + flatRightScaled;
@@ -1946,10 +3199,9 @@ void SoftwareRenderer::updateVisibleFlats(const Camera &camera, const ShadingInf
 			visFlat.topLeft = visFlat.bottomLeft + flatUpScaled;
 			visFlat.topRight = visFlat.bottomRight + flatUpScaled;
 
-			// Add palette override if it is a citizen entity.
-			const EntityAnimationInstance &animInst = entity->getAnimInstance();
-			const EntityAnimationInstance::CitizenParams *citizenParams = animInst.getCitizenParams();
-			visFlat.overridePalette = (citizenParams != nullptr) ? &citizenParams->palette : nullptr;
+			// Add palette override if it is a citizen entity. It's set once the flat is known to be
+			// visible.
+			visFlat.overridePalette = nullptr;
 
 			// Now project two of the flat's opposing corner points into camera space.
 			// The Z value is used with flat sorting (not rendering), and the X and Y values 
@@ -1977,6 +3229,16 @@ void SoftwareRenderer::updateVisibleFlats(const Camera &camera, const ShadingInf
 
 			if (inScreenX && inScreenY && inPlanes)
 			{
+				// Copy the palette so drawing doesn't depend on the entity, which the game might
+				// remove while a pipelined frame is still being drawn.
+				const Palette *overridePalette = renderInst.getOverridePalette();
+				if (overridePalette != nullptr)
+				{
+					DebugAssert(this->visibleFlatPalettes.size() < this->visibleFlatPalettes.capacity());
+					this->visibleFlatPalettes.push_back(*overridePalette);
+					visFlat.overridePalette = &this->visibleFlatPalettes.back();
+				}
+
 				// Add the flat data to the draw list.
 				this->visibleFlats.push_back(std::move(visFlat));
 			}
@@ -1984,8 +3246,131 @@ void SoftwareRenderer::updateVisibleFlats(const Camera &camera, const ShadingInf
 	}
 
 	// Sort the visible flats farthest to nearest (relevant for transparencies).
-	std::sort(this->visibleFlats.begin(), this->visibleFlats.end(),
-		[](const VisibleFlat &a, const VisibleFlat &b) { return a.z > b.z; });
+	this->sortVisibleFlats();
+}
+
+void SoftwareRenderer::sortVisibleFlats()
+{
+	auto isFarther = [](const VisibleFlat &a, const VisibleFlat &b) { return a.z > b.z; };
+
+	// Find where each flat was in last frame's order. Flats that weren't visible then go at the end.
+	const int flatCount = static_cast<int>(this->visibleFlats.size());
+	const int prevFlatCount = static_cast<int>(this->prevVisibleFlatOrder.size());
+	this->visibleFlatSlots.assign(prevFlatCount, -1);
+
+	int carriedFlatCount = 0;
+	for (int i = 0; i < flatCount; i++)
+	{
+		const EntityID entityID = this->visibleFlats[i].entityID;
+		const bool hasRank = (entityID >= 0) && (entityID < static_cast<int>(this->visibleFlatRanks.size()));
+		const int rank = hasRank ? this->visibleFlatRanks[entityID] : -1;
+		const bool wasVisible = (rank >= 0) && (rank < prevFlatCount) &&
+			(this->prevVisibleFlatOrder[rank] == entityID) && (this->visibleFlatSlots[rank] == -1);
+
+		if (wasVisible)
+		{
+			this->visibleFlatSlots[rank] = i;
+			carriedFlatCount++;
+		}
+		else
+		{
+			this->visibleFlatSlots.push_back(i);
+		}
+	}
+
+	// Re-order the flats into last frame's order with new ones after them.
+	std::vector<VisibleFlat> &sortedFlats = this->sortedVisibleFlats;
+	sortedFlats.clear();
+	sortedFlats.reserve(flatCount);
+	for (const int flatIndex : this->visibleFlatSlots)
+	{
+		if (flatIndex >= 0)
+		{
+			sortedFlats.push_back(std::move(this->visibleFlats[flatIndex]));
+		}
+	}
+
+	DebugAssert(static_cast<int>(sortedFlats.size()) == flatCount);
+	std::swap(this->visibleFlats, sortedFlats);
+
+	// Flats from last frame are usually only a few swaps out of order, so insertion sort them.
+	// Fall back to a full sort if the camera turned enough to scramble them.
+	const auto carriedEnd = this->visibleFlats.begin() + carriedFlatCount;
+	const int maxShiftCount = carriedFlatCount * 4;
+	int shiftCount = 0;
+	for (int i = 1; i < carriedFlatCount; i++)
+	{
+		VisibleFlat flat = std::move(this->visibleFlats[i]);
+		int j = i;
+		while ((j > 0) && isFarther(flat, this->visibleFlats[j - 1]))
+		{
+			this->visibleFlats[j] = std::move(this->visibleFlats[j - 1]);
+			j--;
+		}
+
+		this->visibleFlats[j] = std::move(flat);
+		shiftCount += i - j;
+
+		if (shiftCount > maxShiftCount)
+		{
+			std::sort(this->visibleFlats.begin(), carriedEnd, isFarther);
+			break;
+		}
+	}
+
+	// Sort the new flats on their own and merge them in.
+	std::sort(carriedEnd, this->visibleFlats.end(), isFarther);
+	std::inplace_merge(this->visibleFlats.begin(), carriedEnd, this->visibleFlats.end(), isFarther);
+
+	// Remember this frame's order for the next one.
+	this->prevVisibleFlatOrder.resize(flatCount);
+	for (int i = 0; i < flatCount; i++)
+	{
+		const EntityID entityID = this->visibleFlats[i].entityID;
+		this->prevVisibleFlatOrder[i] = entityID;
+
+		if (entityID >= static_cast<int>(this->visibleFlatRanks.size()))
+		{
+			this->visibleFlatRanks.resize(entityID + 1, -1);
+		}
+
+		if (entityID >= 0)
+		{
+			this->visibleFlatRanks[entityID] = i;
+		}
+	}
+}
+
+void SoftwareRenderer::updateVisibleFlatBins()
+{
+	const int binCount = (this->width + SoftwareRenderer::FLAT_BIN_WIDTH - 1) / SoftwareRenderer::FLAT_BIN_WIDTH;
+	this->visibleFlatBins.resize(binCount);
+	for (std::vector<int> &bin : this->visibleFlatBins)
+	{
+		bin.clear();
+	}
+
+	// Visible flats are already sorted, so appending them in order keeps each bin farthest to nearest.
+	const double widthReal = static_cast<double>(this->width);
+	for (int i = 0; i < static_cast<int>(this->visibleFlats.size()); i++)
+	{
+		const VisibleFlat &flat = this->visibleFlats[i];
+		const int xStart = RendererUtils::getLowerBoundedPixel(flat.startX * widthReal, this->width);
+		const int xEnd = RendererUtils::getUpperBoundedPixel(flat.endX * widthReal, this->width);
+		if (xStart >= xEnd)
+		{
+			continue;
+		}
+
+		// Pad by a column on each side so rounding differences with drawFlat() can't leave a
+		// column out. Extra bins are harmless since drawFlat() culls by X range anyway.
+		const int firstBin = std::max(xStart - 1, 0) / SoftwareRenderer::FLAT_BIN_WIDTH;
+		const int lastBin = std::min(xEnd, this->width - 1) / SoftwareRenderer::FLAT_BIN_WIDTH;
+		for (int bin = firstBin; bin <= lastBin; bin++)
+		{
+			this->visibleFlatBins[bin].push_back(i);
+		}
+	}
 }
 
 void SoftwareRenderer::updateVisibleLightLists(const Camera &camera, int chunkDistance,
@@ -2073,26 +3458,23 @@ void SoftwareRenderer::updateVisibleLightLists(const Camera &camera, int chunkDi
 		}
 	}
 
-	// Sort all of the touched voxel columns' light references by distance (shading optimization).
-	const BufferView<const VisibleLight> visLightsView(this->visibleLights.data(),
-		static_cast<int>(this->visibleLights.size()));
-
+	// Flatten each list's lights into the pool for the render threads.
+	this->visLightPool.clear();
 	for (WEInt z = 0; z < this->visLightLists.getHeight(); z++)
 	{
 		for (SNInt x = 0; x < this->visLightLists.getWidth(); x++)
 		{
 			VisibleLightList &visLightList = this->visLightLists.get(x, z);
-			if (visLightList.count >= 2)
+			if (visLightList.count > 0)
 			{
-				const NewInt2 voxel(x + minAbsoluteChunkVoxel.x, z + minAbsoluteChunkVoxel.y);
-
-				// Default to the middle of the main floor for now (voxel columns aren't really in 3D).
-				const Double3 voxelColumnPoint(
-					static_cast<SNDouble>(voxel.x) + 0.50,
-					ceilingHeight * 1.50,
-					static_cast<WEDouble>(voxel.y) + 0.50);
+				visLightList.poolStart = this->visLightPool.getCount();
+				for (int i = 0; i < visLightList.count; i++)
+				{
+					const VisibleLightList::LightID lightID = visLightList.lightIDs[i];
+					this->visLightPool.add(this->visibleLights[lightID]);
+				}
 
-				visLightList.sortByNearest(voxelColumnPoint, visLightsView);
+				this->visLightPool.addPadding();
 			}
 		}
 	}
@@ -2365,12 +3747,6 @@ void SoftwareRenderer::getChasmTextureGroupTexture(const ChasmTextureGroups &tex
 	*outTexture = &textureGroup[animIndex];
 }
 
-const SoftwareRenderer::VisibleLight &SoftwareRenderer::getVisibleLightByID(
-	const BufferView<const VisibleLight> &visLights, VisibleLightList::LightID lightID)
-{
-	return visLights.get(lightID);
-}
-
 const SoftwareRenderer::VisibleLightList &SoftwareRenderer::getVisibleLightList(
 	const BufferView2D<const VisibleLightList> &visLightLists, SNInt voxelX, WEInt voxelZ,
 	SNInt cameraVoxelX, WEInt cameraVoxelZ, SNInt gridWidth, WEInt gridDepth, int chunkDistance)
@@ -3357,38 +4733,51 @@ void SoftwareRenderer::getLightVisibilityData(const NewDouble3 &flatPosition, do
 
 template <bool CappedSum>
 double SoftwareRenderer::getLightContributionAtPoint(const NewDouble2 &point,
-	const BufferView<const VisibleLight> &visLights, const VisibleLightList &visLightList)
+	const VisibleLightPool &visLights, const VisibleLightList &visLightList)
 {
-	double lightContributionPercent = 0.0;
-	for (int i = 0; i < visLightList.count; i++)
-	{
-		const VisibleLightList::LightID lightID = visLightList.lightIDs[i];
-		const VisibleLight &light = SoftwareRenderer::getVisibleLightByID(visLights, lightID);
-		const double lightDistSqr =
-			((light.position.x - point.x) * (light.position.x - point.x)) +
-			((light.position.z - point.y) * (light.position.z - point.y));
-		const double lightDist = std::sqrt(lightDistSqr);
+	static_assert(VisibleLightPool::LIGHT_STRIDE == (sizeof(__m128d) / sizeof(double)));
 
-		const double val = (light.radius - lightDist) / light.radius;
-		lightContributionPercent += std::clamp(val, 0.0, 1.0);
+	const double *lightXs = visLights.xs.data() + visLightList.poolStart;
+	const double *lightZs = visLights.zs.data() + visLightList.poolStart;
+	const double *lightInvRadii = visLights.invRadii.data() + visLightList.poolStart;
 
-		if constexpr (CappedSum)
-		{
-			if (lightContributionPercent >= 1.0)
-			{
-				lightContributionPercent = 1.0;
-				break;
-			}
-		}
+	const __m128d pointXs = _mm_set1_pd(point.x);
+	const __m128d pointZs = _mm_set1_pd(point.y);
+	const __m128d zeroes = _mm_setzero_pd();
+	const __m128d ones = _mm_set1_pd(1.0);
+
+	// The list's pool range is padded, so the last group never reads past it.
+	__m128d lightContributionPercents = _mm_setzero_pd();
+	for (int i = 0; i < visLightList.count; i += VisibleLightPool::LIGHT_STRIDE)
+	{
+		const __m128d diffXs = _mm_sub_pd(_mm_loadu_pd(lightXs + i), pointXs);
+		const __m128d diffZs = _mm_sub_pd(_mm_loadu_pd(lightZs + i), pointZs);
+		const __m128d lightDists = _mm_sqrt_pd(
+			_mm_add_pd(_mm_mul_pd(diffXs, diffXs), _mm_mul_pd(diffZs, diffZs)));
+		const __m128d vals = _mm_sub_pd(ones, _mm_mul_pd(lightDists, _mm_loadu_pd(lightInvRadii + i)));
+		lightContributionPercents = _mm_add_pd(lightContributionPercents,
+			_mm_min_pd(_mm_max_pd(vals, zeroes), ones));
 	}
 
-	return lightContributionPercent;
+	alignas(16) double lightContributionParts[VisibleLightPool::LIGHT_STRIDE];
+	_mm_store_pd(lightContributionParts, lightContributionPercents);
+	const double lightContributionPercent = lightContributionParts[0] + lightContributionParts[1];
+
+	if constexpr (CappedSum)
+	{
+		// Every term is non-negative, so capping the total matches capping a running sum.
+		return std::min(lightContributionPercent, 1.0);
+	}
+	else
+	{
+		return lightContributionPercent;
+	}
 }
 
 // @todo: might be better as a macro so there's no chance of a function call in the pixel loop.
 template <int FilterMode, bool Transparency>
 void SoftwareRenderer::sampleVoxelTexture(const VoxelTexture &texture, double u, double v,
-	double *r, double *g, double *b, double *emission, bool *transparent)
+	ShadingReal *r, ShadingReal *g, ShadingReal *b, ShadingReal *emission, bool *transparent)
 {
 	const double textureWidthReal = static_cast<double>(texture.width);
 	const double textureHeightReal = static_cast<double>(texture.height);
@@ -3401,10 +4790,10 @@ void SoftwareRenderer::sampleVoxelTexture(const VoxelTexture &texture, double u,
 		const int textureIndex = textureX + (textureY * texture.width);
 
 		const VoxelTexel &texel = texture.texels[textureIndex];
-		*r = texel.r;
-		*g = texel.g;
-		*b = texel.b;
-		*emission = texel.emission;
+		*r = static_cast<ShadingReal>(texel.r) * TEXEL_CHANNEL_RECIP;
+		*g = static_cast<ShadingReal>(texel.g) * TEXEL_CHANNEL_RECIP;
+		*b = static_cast<ShadingReal>(texel.b) * TEXEL_CHANNEL_RECIP;
+		*emission = static_cast<ShadingReal>(texel.emission) * TEXEL_CHANNEL_RECIP;
 		
 		if constexpr (Transparency)
 		{
@@ -3428,10 +4817,10 @@ void SoftwareRenderer::sampleVoxelTexture(const VoxelTexture &texture, double u,
 		const double uRPercent = 1.0 - uLPercent;
 		const double vTPercent = 1.0 - (vTHeight - std::floor(vTHeight));
 		const double vBPercent = 1.0 - vTPercent;
-		const double tlPercent = uLPercent * vTPercent;
-		const double trPercent = uRPercent * vTPercent;
-		const double blPercent = uLPercent * vBPercent;
-		const double brPercent = uRPercent * vBPercent;
+		const ShadingReal tlPercent = static_cast<ShadingReal>(uLPercent * vTPercent) * TEXEL_CHANNEL_RECIP;
+		const ShadingReal trPercent = static_cast<ShadingReal>(uRPercent * vTPercent) * TEXEL_CHANNEL_RECIP;
+		const ShadingReal blPercent = static_cast<ShadingReal>(uLPercent * vBPercent) * TEXEL_CHANNEL_RECIP;
+		const ShadingReal brPercent = static_cast<ShadingReal>(uRPercent * vBPercent) * TEXEL_CHANNEL_RECIP;
 		const int textureXL = static_cast<int>(uL * textureWidthReal);
 		const int textureXR = static_cast<int>(uR * textureWidthReal);
 		const int textureYT = static_cast<int>(vT * textureHeightReal);
@@ -3445,6 +4834,8 @@ void SoftwareRenderer::sampleVoxelTexture(const VoxelTexture &texture, double u,
 		const VoxelTexel &texelTR = texture.texels[textureIndexTR];
 		const VoxelTexel &texelBL = texture.texels[textureIndexBL];
 		const VoxelTexel &texelBR = texture.texels[textureIndexBR];
+
+		// The channel normalization is folded into the bilinear weights.
 		*r = (texelTL.r * tlPercent) + (texelTR.r * trPercent) + (texelBL.r * blPercent) + (texelBR.r * brPercent);
 		*g = (texelTL.g * tlPercent) + (texelTR.g * trPercent) + (texelBL.g * blPercent) + (texelBR.g * brPercent);
 		*b = (texelTL.b * tlPercent) + (texelTR.b * trPercent) + (texelBL.b * blPercent) + (texelBR.b * brPercent);
@@ -3465,7 +4856,7 @@ void SoftwareRenderer::sampleVoxelTexture(const VoxelTexture &texture, double u,
 }
 
 void SoftwareRenderer::sampleChasmTexture(const ChasmTexture &texture, double screenXPercent,
-	double screenYPercent, double *r, double *g, double *b)
+	double screenYPercent, ShadingReal *r, ShadingReal *g, ShadingReal *b)
 {
 	const double textureWidthReal = static_cast<double>(texture.width);
 	const double textureHeightReal = static_cast<double>(texture.height);
@@ -3478,9 +4869,337 @@ void SoftwareRenderer::sampleChasmTexture(const ChasmTexture &texture, double sc
 	const int textureIndex = textureX + (textureY * texture.width);
 
 	const ChasmTexel &texel = texture.texels[textureIndex];
-	*r = texel.r;
-	*g = texel.g;
-	*b = texel.b;
+	*r = static_cast<ShadingReal>(texel.r) * TEXEL_CHANNEL_RECIP;
+	*g = static_cast<ShadingReal>(texel.g) * TEXEL_CHANNEL_RECIP;
+	*b = static_cast<ShadingReal>(texel.b) * TEXEL_CHANNEL_RECIP;
+}
+
+template <bool Fading, bool Transparency, typename TransparentTexelFunc>
+void SoftwareRenderer::drawPixelsSSE(int x, int yStart, int yEnd, const DrawRange &drawRange,
+	double depth, double u, double vStart, double vEnd, const VoxelTexture &texture,
+	double fadePercent, double lightContributionPercent, const ShadingInfo &shadingInfo,
+	const FrameView &frame, const TransparentTexelFunc &transparentTexelFunc)
+{
+	constexpr int stride = sizeof(__m128) / sizeof(float);
+
+	// Nearest filtering only, so the texture column is the same for every pixel.
+	const int textureX = static_cast<int>(u * static_cast<double>(texture.width));
+
+	// Vertical texture coordinates are stepped in double precision with the same operations as
+	// the scalar shader so texel look-ups are identical.
+	const __m128d yProjStarts = _mm_set1_pd(drawRange.yProjStart);
+	const __m128d yProjDiffs = _mm_set1_pd(drawRange.yProjEnd - drawRange.yProjStart);
+	const __m128d vStarts = _mm_set1_pd(vStart);
+	const __m128d vDiffs = _mm_set1_pd(vEnd - vStart);
+	const __m128d halfReals = _mm_set1_pd(0.50);
+	const __m128d textureHeightReals = _mm_set1_pd(static_cast<double>(texture.height));
+	const __m128d depths = _mm_set1_pd(depth);
+	const __m128d epsilons = _mm_set1_pd(Constants::Epsilon);
+
+	// Shading values.
+	const Double3 &fogColor = shadingInfo.getFogColor();
+	const __m128 fogRs = _mm_set1_ps(static_cast<float>(fogColor.x));
+	const __m128 fogGs = _mm_set1_ps(static_cast<float>(fogColor.y));
+	const __m128 fogBs = _mm_set1_ps(static_cast<float>(fogColor.z));
+	const __m128 fogPercents = _mm_set1_ps(static_cast<float>(
+		std::min(depth / shadingInfo.fogDistance, 1.0)));
+	const __m128 shadings = _mm_set1_ps(static_cast<float>(shadingInfo.ambient));
+	const __m128 lightPercents = _mm_set1_ps(static_cast<float>(lightContributionPercent));
+	const __m128 fades = _mm_set1_ps(static_cast<float>(fadePercent));
+	const __m128 ones = _mm_set1_ps(1.0f);
+	const __m128 channelRecips = _mm_set1_ps(static_cast<float>(TEXEL_CHANNEL_RECIP));
+	const __m128 channelMaxes = _mm_set1_ps(static_cast<float>(TEXEL_CHANNEL_MAX));
+
+	const int lastY = yEnd - 1;
+	for (int y = yStart; y < yEnd; y += stride)
+	{
+		// Lanes past the end of the range re-use the last row and are masked off.
+		const int y0 = y;
+		const int y1 = std::min(y + 1, lastY);
+		const int y2 = std::min(y + 2, lastY);
+		const int y3 = std::min(y + 3, lastY);
+		const int laneCount = std::min(stride, yEnd - y);
+		int writeMask = (1 << laneCount) - 1;
+
+		alignas(16) int indices[stride];
+		indices[0] = x + (y0 * frame.width);
+		indices[1] = x + (y1 * frame.width);
+		indices[2] = x + (y2 * frame.width);
+		indices[3] = x + (y3 * frame.width);
+
+		// Depth test.
+		const __m128d depthBuffers01 = _mm_setr_pd(
+			frame.getDepth(indices[0]), frame.getDepth(indices[1]));
+		const __m128d depthBuffers23 = _mm_setr_pd(
+			frame.getDepth(indices[2]), frame.getDepth(indices[3]));
+		const int depthMask =
+			_mm_movemask_pd(_mm_cmple_pd(depths, _mm_sub_pd(depthBuffers01, epsilons))) |
+			(_mm_movemask_pd(_mm_cmple_pd(depths, _mm_sub_pd(depthBuffers23, epsilons))) << 2);
+		writeMask &= depthMask;
+		if (writeMask == 0)
+		{
+			continue;
+		}
+
+		// Texture rows.
+		const __m128d ys01 = _mm_setr_pd(static_cast<double>(y0), static_cast<double>(y1));
+		const __m128d ys23 = _mm_setr_pd(static_cast<double>(y2), static_cast<double>(y3));
+		const __m128d yPercents01 = _mm_div_pd(
+			_mm_sub_pd(_mm_add_pd(ys01, halfReals), yProjStarts), yProjDiffs);
+		const __m128d yPercents23 = _mm_div_pd(
+			_mm_sub_pd(_mm_add_pd(ys23, halfReals), yProjStarts), yProjDiffs);
+		const __m128d vs01 = _mm_add_pd(vStarts, _mm_mul_pd(vDiffs, yPercents01));
+		const __m128d vs23 = _mm_add_pd(vStarts, _mm_mul_pd(vDiffs, yPercents23));
+		alignas(16) int textureYs[stride];
+		_mm_store_si128(reinterpret_cast<__m128i*>(textureYs), _mm_unpacklo_epi64(
+			_mm_cvttpd_epi32(_mm_mul_pd(vs01, textureHeightReals)),
+			_mm_cvttpd_epi32(_mm_mul_pd(vs23, textureHeightReals))));
+
+		// Gather texels.
+		alignas(16) int texelRs[stride];
+		alignas(16) int texelGs[stride];
+		alignas(16) int texelBs[stride];
+		alignas(16) int texelEmissions[stride];
+		for (int i = 0; i < stride; i++)
+		{
+			const int textureIndex = textureX + (textureYs[i] * texture.width);
+			const VoxelTexel &texel = texture.texels[textureIndex];
+			texelRs[i] = texel.r;
+			texelGs[i] = texel.g;
+			texelBs[i] = texel.b;
+			texelEmissions[i] = texel.emission;
+
+			if constexpr (Transparency)
+			{
+				if (texel.transparent && ((writeMask & (1 << i)) != 0))
+				{
+					transparentTexelFunc(indices[i], y + i);
+					writeMask &= ~(1 << i);
+				}
+			}
+		}
+
+		if constexpr (Transparency)
+		{
+			if (writeMask == 0)
+			{
+				continue;
+			}
+		}
+
+		__m128 colorRs = _mm_mul_ps(_mm_cvtepi32_ps(
+			_mm_load_si128(reinterpret_cast<const __m128i*>(texelRs))), channelRecips);
+		__m128 colorGs = _mm_mul_ps(_mm_cvtepi32_ps(
+			_mm_load_si128(reinterpret_cast<const __m128i*>(texelGs))), channelRecips);
+		__m128 colorBs = _mm_mul_ps(_mm_cvtepi32_ps(
+			_mm_load_si128(reinterpret_cast<const __m128i*>(texelBs))), channelRecips);
+		const __m128 colorEmissions = _mm_mul_ps(_mm_cvtepi32_ps(
+			_mm_load_si128(reinterpret_cast<const __m128i*>(texelEmissions))), channelRecips);
+
+		// Shading from light.
+		const __m128 combinedEmissions = _mm_add_ps(colorEmissions, lightPercents);
+		const __m128 lights = _mm_min_ps(_mm_add_ps(shadings, combinedEmissions), ones);
+		colorRs = _mm_mul_ps(colorRs, lights);
+		colorGs = _mm_mul_ps(colorGs, lights);
+		colorBs = _mm_mul_ps(colorBs, lights);
+
+		if constexpr (Fading)
+		{
+			colorRs = _mm_mul_ps(colorRs, fades);
+			colorGs = _mm_mul_ps(colorGs, fades);
+			colorBs = _mm_mul_ps(colorBs, fades);
+		}
+
+		// Linearly interpolate with fog.
+		colorRs = _mm_add_ps(colorRs, _mm_mul_ps(_mm_sub_ps(fogRs, colorRs), fogPercents));
+		colorGs = _mm_add_ps(colorGs, _mm_mul_ps(_mm_sub_ps(fogGs, colorGs), fogPercents));
+		colorBs = _mm_add_ps(colorBs, _mm_mul_ps(_mm_sub_ps(fogBs, colorBs), fogPercents));
+
+		// Clamp maximum and pack into RGB.
+		colorRs = _mm_min_ps(colorRs, ones);
+		colorGs = _mm_min_ps(colorGs, ones);
+		colorBs = _mm_min_ps(colorBs, ones);
+		const __m128i colorRGBs = _mm_or_si128(_mm_or_si128(
+			_mm_slli_epi32(_mm_cvttps_epi32(_mm_mul_ps(colorRs, channelMaxes)), 16),
+			_mm_slli_epi32(_mm_cvttps_epi32(_mm_mul_ps(colorGs, channelMaxes)), 8)),
+			_mm_cvttps_epi32(_mm_mul_ps(colorBs, channelMaxes)));
+
+		alignas(16) uint32_t colors[stride];
+		_mm_store_si128(reinterpret_cast<__m128i*>(colors), colorRGBs);
+
+		for (int i = 0; i < stride; i++)
+		{
+			if ((writeMask & (1 << i)) != 0)
+			{
+				frame.colorBuffer[indices[i]] = colors[i];
+				frame.setDepth(indices[i], depth);
+			}
+		}
+	}
+}
+
+template <bool Fading, bool Transparency, typename TransparentTexelFunc>
+AVX2_TARGET void SoftwareRenderer::drawPixelsAVX(int x, int yStart, int yEnd,
+	const DrawRange &drawRange, double depth, double u, double vStart, double vEnd,
+	const VoxelTexture &texture, double fadePercent, double lightContributionPercent,
+	const ShadingInfo &shadingInfo, const FrameView &frame, const TransparentTexelFunc &transparentTexelFunc)
+{
+	constexpr int stride = sizeof(__m256) / sizeof(float);
+	constexpr int halfStride = stride / 2;
+
+	// Nearest filtering only, so the texture column is the same for every pixel.
+	const int textureX = static_cast<int>(u * static_cast<double>(texture.width));
+
+	// Vertical texture coordinates are stepped in double precision with the same operations as
+	// the scalar shader so texel look-ups are identical.
+	const __m256d yProjStarts = _mm256_set1_pd(drawRange.yProjStart);
+	const __m256d yProjDiffs = _mm256_set1_pd(drawRange.yProjEnd - drawRange.yProjStart);
+	const __m256d vStarts = _mm256_set1_pd(vStart);
+	const __m256d vDiffs = _mm256_set1_pd(vEnd - vStart);
+	const __m256d halfReals = _mm256_set1_pd(0.50);
+	const __m256d textureHeightReals = _mm256_set1_pd(static_cast<double>(texture.height));
+	const __m256d depths = _mm256_set1_pd(depth);
+	const __m256d epsilons = _mm256_set1_pd(Constants::Epsilon);
+
+	// Shading values.
+	const Double3 &fogColor = shadingInfo.getFogColor();
+	const __m256 fogRs = _mm256_set1_ps(static_cast<float>(fogColor.x));
+	const __m256 fogGs = _mm256_set1_ps(static_cast<float>(fogColor.y));
+	const __m256 fogBs = _mm256_set1_ps(static_cast<float>(fogColor.z));
+	const __m256 fogPercents = _mm256_set1_ps(static_cast<float>(
+		std::min(depth / shadingInfo.fogDistance, 1.0)));
+	const __m256 shadings = _mm256_set1_ps(static_cast<float>(shadingInfo.ambient));
+	const __m256 lightPercents = _mm256_set1_ps(static_cast<float>(lightContributionPercent));
+	const __m256 fades = _mm256_set1_ps(static_cast<float>(fadePercent));
+	const __m256 ones = _mm256_set1_ps(1.0f);
+	const __m256 channelRecips = _mm256_set1_ps(static_cast<float>(TEXEL_CHANNEL_RECIP));
+	const __m256 channelMaxes = _mm256_set1_ps(static_cast<float>(TEXEL_CHANNEL_MAX));
+
+	const int lastY = yEnd - 1;
+	for (int y = yStart; y < yEnd; y += stride)
+	{
+		// Lanes past the end of the range re-use the last row and are masked off.
+		alignas(32) double ys[stride];
+		alignas(32) int indices[stride];
+		alignas(32) double depthBuffers[stride];
+		for (int i = 0; i < stride; i++)
+		{
+			const int laneY = std::min(y + i, lastY);
+			ys[i] = static_cast<double>(laneY);
+			indices[i] = x + (laneY * frame.width);
+			depthBuffers[i] = frame.getDepth(indices[i]);
+		}
+
+		const int laneCount = std::min(stride, yEnd - y);
+		int writeMask = (1 << laneCount) - 1;
+
+		// Depth test.
+		const __m256d depthBuffersLo = _mm256_load_pd(depthBuffers);
+		const __m256d depthBuffersHi = _mm256_load_pd(depthBuffers + halfStride);
+		const int depthMask =
+			_mm256_movemask_pd(_mm256_cmp_pd(depths, _mm256_sub_pd(depthBuffersLo, epsilons), _CMP_LE_OQ)) |
+			(_mm256_movemask_pd(_mm256_cmp_pd(depths, _mm256_sub_pd(depthBuffersHi, epsilons), _CMP_LE_OQ)) << halfStride);
+		writeMask &= depthMask;
+		if (writeMask == 0)
+		{
+			continue;
+		}
+
+		// Texture rows.
+		const __m256d ysLo = _mm256_load_pd(ys);
+		const __m256d ysHi = _mm256_load_pd(ys + halfStride);
+		const __m256d yPercentsLo = _mm256_div_pd(
+			_mm256_sub_pd(_mm256_add_pd(ysLo, halfReals), yProjStarts), yProjDiffs);
+		const __m256d yPercentsHi = _mm256_div_pd(
+			_mm256_sub_pd(_mm256_add_pd(ysHi, halfReals), yProjStarts), yProjDiffs);
+		const __m256d vsLo = _mm256_add_pd(vStarts, _mm256_mul_pd(vDiffs, yPercentsLo));
+		const __m256d vsHi = _mm256_add_pd(vStarts, _mm256_mul_pd(vDiffs, yPercentsHi));
+		alignas(32) int textureYs[stride];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(textureYs), _mm256_insertf128_si256(
+			_mm256_castsi128_si256(_mm256_cvttpd_epi32(_mm256_mul_pd(vsLo, textureHeightReals))),
+			_mm256_cvttpd_epi32(_mm256_mul_pd(vsHi, textureHeightReals)), 1));
+
+		// Gather texels.
+		alignas(32) int texelRs[stride];
+		alignas(32) int texelGs[stride];
+		alignas(32) int texelBs[stride];
+		alignas(32) int texelEmissions[stride];
+		for (int i = 0; i < stride; i++)
+		{
+			const int textureIndex = textureX + (textureYs[i] * texture.width);
+			const VoxelTexel &texel = texture.texels[textureIndex];
+			texelRs[i] = texel.r;
+			texelGs[i] = texel.g;
+			texelBs[i] = texel.b;
+			texelEmissions[i] = texel.emission;
+
+			if constexpr (Transparency)
+			{
+				if (texel.transparent && ((writeMask & (1 << i)) != 0))
+				{
+					transparentTexelFunc(indices[i], y + i);
+					writeMask &= ~(1 << i);
+				}
+			}
+		}
+
+		if constexpr (Transparency)
+		{
+			if (writeMask == 0)
+			{
+				continue;
+			}
+		}
+
+		__m256 colorRs = _mm256_mul_ps(_mm256_cvtepi32_ps(
+			_mm256_load_si256(reinterpret_cast<const __m256i*>(texelRs))), channelRecips);
+		__m256 colorGs = _mm256_mul_ps(_mm256_cvtepi32_ps(
+			_mm256_load_si256(reinterpret_cast<const __m256i*>(texelGs))), channelRecips);
+		__m256 colorBs = _mm256_mul_ps(_mm256_cvtepi32_ps(
+			_mm256_load_si256(reinterpret_cast<const __m256i*>(texelBs))), channelRecips);
+		const __m256 colorEmissions = _mm256_mul_ps(_mm256_cvtepi32_ps(
+			_mm256_load_si256(reinterpret_cast<const __m256i*>(texelEmissions))), channelRecips);
+
+		// Shading from light.
+		const __m256 combinedEmissions = _mm256_add_ps(colorEmissions, lightPercents);
+		const __m256 lights = _mm256_min_ps(_mm256_add_ps(shadings, combinedEmissions), ones);
+		colorRs = _mm256_mul_ps(colorRs, lights);
+		colorGs = _mm256_mul_ps(colorGs, lights);
+		colorBs = _mm256_mul_ps(colorBs, lights);
+
+		if constexpr (Fading)
+		{
+			colorRs = _mm256_mul_ps(colorRs, fades);
+			colorGs = _mm256_mul_ps(colorGs, fades);
+			colorBs = _mm256_mul_ps(colorBs, fades);
+		}
+
+		// Linearly interpolate with fog.
+		colorRs = _mm256_add_ps(colorRs, _mm256_mul_ps(_mm256_sub_ps(fogRs, colorRs), fogPercents));
+		colorGs = _mm256_add_ps(colorGs, _mm256_mul_ps(_mm256_sub_ps(fogGs, colorGs), fogPercents));
+		colorBs = _mm256_add_ps(colorBs, _mm256_mul_ps(_mm256_sub_ps(fogBs, colorBs), fogPercents));
+
+		// Clamp maximum and pack into RGB.
+		colorRs = _mm256_min_ps(colorRs, ones);
+		colorGs = _mm256_min_ps(colorGs, ones);
+		colorBs = _mm256_min_ps(colorBs, ones);
+		const __m256i colorRGBs = _mm256_or_si256(_mm256_or_si256(
+			_mm256_slli_epi32(_mm256_cvttps_epi32(_mm256_mul_ps(colorRs, channelMaxes)), 16),
+			_mm256_slli_epi32(_mm256_cvttps_epi32(_mm256_mul_ps(colorGs, channelMaxes)), 8)),
+			_mm256_cvttps_epi32(_mm256_mul_ps(colorBs, channelMaxes)));
+
+		alignas(32) uint32_t colors[stride];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(colors), colorRGBs);
+
+		for (int i = 0; i < stride; i++)
+		{
+			if ((writeMask & (1 << i)) != 0)
+			{
+				frame.colorBuffer[indices[i]] = colors[i];
+				frame.setDepth(indices[i], depth);
+			}
+		}
+	}
 }
 
 template <bool Fading>
@@ -3501,15 +5220,42 @@ void SoftwareRenderer::drawPixelsShader(int x, const DrawRange &drawRange, doubl
 
 	// Linearly interpolated fog.
 	const Double3 &fogColor = shadingInfo.getFogColor();
-	const double fogPercent = std::min(depth / shadingInfo.fogDistance, 1.0);
+	const ShadingReal fogR = static_cast<ShadingReal>(fogColor.x);
+	const ShadingReal fogG = static_cast<ShadingReal>(fogColor.y);
+	const ShadingReal fogB = static_cast<ShadingReal>(fogColor.z);
+	const ShadingReal fogPercent = static_cast<ShadingReal>(
+		std::min(depth / shadingInfo.fogDistance, 1.0));
 
 	// Shading on the texture.
-	const Double3 shading(shadingInfo.ambient, shadingInfo.ambient, shadingInfo.ambient);
+	const ShadingReal shading = static_cast<ShadingReal>(shadingInfo.ambient);
+	const ShadingReal lightPercent = static_cast<ShadingReal>(lightContributionPercent);
+	const ShadingReal fade = static_cast<ShadingReal>(fadePercent);
 
 	// Clip the Y start and end coordinates as needed, and refresh the occlusion buffer.
 	occlusion.clipRange(&yStart, &yEnd);
 	occlusion.update(yStart, yEnd);
 
+	// SIMD kernels only cover the single-precision, nearest-filtered path.
+	if constexpr ((TextureFilterMode == 0) && std::is_same_v<ShadingReal, float>)
+	{
+		constexpr bool transparency = false;
+		auto transparentTexelFunc = [](int index, int y) { };
+		if (ActiveColumnKernel == ColumnKernel::AVX)
+		{
+			SoftwareRenderer::drawPixelsAVX<Fading, transparency>(x, yStart, yEnd, drawRange, depth,
+				u, vStart, vEnd, texture, fadePercent, lightContributionPercent, shadingInfo, frame,
+				transparentTexelFunc);
+			return;
+		}
+		else if (ActiveColumnKernel == ColumnKernel::SSE)
+		{
+			SoftwareRenderer::drawPixelsSSE<Fading, transparency>(x, yStart, yEnd, drawRange, depth,
+				u, vStart, vEnd, texture, fadePercent, lightContributionPercent, shadingInfo, frame,
+				transparentTexelFunc);
+			return;
+		}
+	}
+
 	// Draw the column to the output buffer.
 	for (int y = yStart; y < yEnd; y++)
 	{
@@ -3518,7 +5264,7 @@ void SoftwareRenderer::drawPixelsShader(int x, const DrawRange &drawRange, doubl
 		// Check depth of the pixel before rendering.
 		// - @todo: implement occlusion culling and back-to-front transparent rendering so
 		//   this depth check isn't needed.
-		if (depth <= (frame.depthBuffer[index] - Constants::Epsilon))
+		if (depth <= (frame.getDepth(index) - Constants::Epsilon))
 		{
 			// Percent stepped from beginning to end on the column.
 			const double yPercent =
@@ -3529,75 +5275,492 @@ void SoftwareRenderer::drawPixelsShader(int x, const DrawRange &drawRange, doubl
 
 			// Texture color. Alpha is ignored in this loop, so transparent texels will appear black.
 			constexpr bool TextureTransparency = false;
-			double colorR, colorG, colorB, colorEmission;
+			ShadingReal colorR, colorG, colorB, colorEmission;
 			SoftwareRenderer::sampleVoxelTexture<TextureFilterMode, TextureTransparency>(
 				texture, u, v, &colorR, &colorG, &colorB, &colorEmission, nullptr);
 
 			// Shading from light.
-			constexpr double shadingMax = 1.0;
-			const double combinedEmission = colorEmission + lightContributionPercent;
-			const double lightR = shading.x + combinedEmission;
-			const double lightG = shading.y + combinedEmission;
-			const double lightB = shading.z + combinedEmission;
-			colorR *= (lightR < shadingMax) ? lightR : shadingMax;
-			colorG *= (lightG < shadingMax) ? lightG : shadingMax;
-			colorB *= (lightB < shadingMax) ? lightB : shadingMax;
+			constexpr ShadingReal shadingMax = 1.0;
+			const ShadingReal combinedEmission = colorEmission + lightPercent;
+			const ShadingReal light = std::min(shading + combinedEmission, shadingMax);
+			colorR *= light;
+			colorG *= light;
+			colorB *= light;
 
 			if constexpr (Fading)
 			{
 				// Apply voxel fade percent.
-				colorR *= fadePercent;
-				colorG *= fadePercent;
-				colorB *= fadePercent;
+				colorR *= fade;
+				colorG *= fade;
+				colorB *= fade;
 			}
 
 			// Linearly interpolate with fog.
-			colorR += (fogColor.x - colorR) * fogPercent;
-			colorG += (fogColor.y - colorG) * fogPercent;
-			colorB += (fogColor.z - colorB) * fogPercent;
+			colorR += (fogR - colorR) * fogPercent;
+			colorG += (fogG - colorG) * fogPercent;
+			colorB += (fogB - colorB) * fogPercent;
 
 			// Clamp maximum (don't worry about negative values).
-			constexpr double high = 1.0;
+			constexpr ShadingReal high = 1.0;
 			colorR = (colorR > high) ? high : colorR;
 			colorG = (colorG > high) ? high : colorG;
 			colorB = (colorB > high) ? high : colorB;
 
 			// Convert floats to integers.
 			const uint32_t colorRGB = static_cast<uint32_t>(
-				((static_cast<uint8_t>(colorR * 255.0)) << 16) |
-				((static_cast<uint8_t>(colorG * 255.0)) << 8) |
-				((static_cast<uint8_t>(colorB * 255.0))));
+				((static_cast<uint8_t>(colorR * TEXEL_CHANNEL_MAX)) << 16) |
+				((static_cast<uint8_t>(colorG * TEXEL_CHANNEL_MAX)) << 8) |
+				((static_cast<uint8_t>(colorB * TEXEL_CHANNEL_MAX))));
 
 			frame.colorBuffer[index] = colorRGB;
-			frame.depthBuffer[index] = depth;
+			frame.setDepth(index, depth);
 		}
 	}
 }
 
+const SoftwareRenderer::VoxelTexture &SoftwareRenderer::getVoxelMipmap(const VoxelTexture &texture,
+	const DrawRange &drawRange, double vStart, double vEnd)
+{
+	// The projected height already accounts for the wall's distance and the field of view. Only the
+	// vertical span is known per column; walls seen at a grazing angle step through u faster than
+	// this, so they can still alias horizontally.
+	const double texelCount = std::abs(vEnd - vStart) * static_cast<double>(texture.height);
+	const double pixelCount = drawRange.yProjEnd - drawRange.yProjStart;
+	const int level = GetMipmapLevel(texelCount, pixelCount, texture.getMipmapLevelCount());
+	return texture.getMipmap(level);
+}
+
 void SoftwareRenderer::drawPixels(int x, const DrawRange &drawRange, double depth, double u,
 	double vStart, double vEnd, const Double3 &normal, const VoxelTexture &texture,
 	double fadePercent, double lightContributionPercent, const ShadingInfo &shadingInfo,
 	OcclusionData &occlusion, const FrameView &frame)
 {
+	const VoxelTexture &mipmap = SoftwareRenderer::getVoxelMipmap(texture, drawRange, vStart, vEnd);
+
 	if (fadePercent == 1.0)
 	{
 		constexpr bool fading = false;
-		SoftwareRenderer::drawPixelsShader<fading>(x, drawRange, depth, u, vStart, vEnd, normal, texture,
+		SoftwareRenderer::drawPixelsShader<fading>(x, drawRange, depth, u, vStart, vEnd, normal, mipmap,
 			fadePercent, lightContributionPercent, shadingInfo, occlusion, frame);
 	}
 	else
 	{
 		constexpr bool fading = true;
-		SoftwareRenderer::drawPixelsShader<fading>(x, drawRange, depth, u, vStart, vEnd, normal, texture,
+		SoftwareRenderer::drawPixelsShader<fading>(x, drawRange, depth, u, vStart, vEnd, normal, mipmap,
 			fadePercent, lightContributionPercent, shadingInfo, occlusion, frame);
 	}
 }
 
+template <bool Fading>
+SSE41_TARGET void SoftwareRenderer::drawPerspectivePixelsSSE(int x, int yStart, int yEnd,
+	const DrawRange &drawRange, const NewDouble2 &startPoint, const NewDouble2 &endPoint,
+	double depthStart, double depthEnd, const VoxelTexture &texture, double fadePercent,
+	const VisibleLightPool &visLights, const VisibleLightList &visLightList,
+	const ShadingInfo &shadingInfo, const FrameView &frame)
+{
+	constexpr int stride = sizeof(__m128) / sizeof(float);
+	constexpr int halfStride = stride / 2;
+
+	// Values for perspective-correct interpolation, computed with the same operations as the scalar
+	// shader so depths and texel look-ups are identical.
+	const double depthStartRecip = 1.0 / depthStart;
+	const double depthEndRecip = 1.0 / depthEnd;
+	const NewDouble2 startPointDiv = startPoint * depthStartRecip;
+	const NewDouble2 endPointDiv = endPoint * depthEndRecip;
+	const NewDouble2 pointDivDiff = endPointDiv - startPointDiv;
+
+	const __m128d yProjStarts = _mm_set1_pd(drawRange.yProjStart);
+	const __m128d yProjDiffs = _mm_set1_pd(drawRange.yProjEnd - drawRange.yProjStart);
+	const __m128d halfReals = _mm_set1_pd(0.50);
+	const __m128d oneReals = _mm_set1_pd(1.0);
+	const __m128d zeroReals = _mm_setzero_pd();
+	const __m128d justBelowOnes = _mm_set1_pd(Constants::JustBelowOne);
+	const __m128d depthStartRecips = _mm_set1_pd(depthStartRecip);
+	const __m128d depthRecipDiffs = _mm_set1_pd(depthEndRecip - depthStartRecip);
+	const __m128d startPointDivXs = _mm_set1_pd(startPointDiv.x);
+	const __m128d startPointDivYs = _mm_set1_pd(startPointDiv.y);
+	const __m128d pointDivDiffXs = _mm_set1_pd(pointDivDiff.x);
+	const __m128d pointDivDiffYs = _mm_set1_pd(pointDivDiff.y);
+	const __m128d fogDistances = _mm_set1_pd(shadingInfo.fogDistance);
+	const __m128d textureWidthReals = _mm_set1_pd(static_cast<double>(texture.width));
+	const __m128d textureHeightReals = _mm_set1_pd(static_cast<double>(texture.height));
+
+	// Shading values.
+	const Double3 &fogColor = shadingInfo.getFogColor();
+	const __m128 fogRs = _mm_set1_ps(static_cast<float>(fogColor.x));
+	const __m128 fogGs = _mm_set1_ps(static_cast<float>(fogColor.y));
+	const __m128 fogBs = _mm_set1_ps(static_cast<float>(fogColor.z));
+	const __m128 shadings = _mm_set1_ps(static_cast<float>(shadingInfo.ambient));
+	const __m128 fades = _mm_set1_ps(static_cast<float>(fadePercent));
+	const __m128 ones = _mm_set1_ps(1.0f);
+	const __m128 channelRecips = _mm_set1_ps(static_cast<float>(TEXEL_CHANNEL_RECIP));
+	const __m128 channelMaxes = _mm_set1_ps(static_cast<float>(TEXEL_CHANNEL_MAX));
+
+	const int lastY = yEnd - 1;
+	for (int y = yStart; y < yEnd; y += stride)
+	{
+		// Lanes past the end of the range re-use the last row and are masked off.
+		alignas(16) double ys[stride];
+		alignas(16) int indices[stride];
+		alignas(16) double depthBuffers[stride];
+		for (int i = 0; i < stride; i++)
+		{
+			const int laneY = std::min(y + i, lastY);
+			ys[i] = static_cast<double>(laneY);
+			indices[i] = x + (laneY * frame.width);
+			depthBuffers[i] = frame.getDepth(indices[i]);
+		}
+
+		const int laneCount = std::min(stride, yEnd - y);
+		int writeMask = (1 << laneCount) - 1;
+
+		// Interpolate between the near and far depth, then depth test.
+		const __m128d yPercentsLo = _mm_div_pd(
+			_mm_sub_pd(_mm_add_pd(_mm_load_pd(ys), halfReals), yProjStarts), yProjDiffs);
+		const __m128d yPercentsHi = _mm_div_pd(
+			_mm_sub_pd(_mm_add_pd(_mm_load_pd(ys + halfStride), halfReals), yProjStarts), yProjDiffs);
+		const __m128d depthsLo = _mm_div_pd(oneReals,
+			_mm_add_pd(depthStartRecips, _mm_mul_pd(depthRecipDiffs, yPercentsLo)));
+		const __m128d depthsHi = _mm_div_pd(oneReals,
+			_mm_add_pd(depthStartRecips, _mm_mul_pd(depthRecipDiffs, yPercentsHi)));
+		const int depthMask =
+			_mm_movemask_pd(_mm_cmple_pd(depthsLo, _mm_load_pd(depthBuffers))) |
+			(_mm_movemask_pd(_mm_cmple_pd(depthsHi, _mm_load_pd(depthBuffers + halfStride))) << halfStride);
+		writeMask &= depthMask;
+		if (writeMask == 0)
+		{
+			continue;
+		}
+
+		// Linearly interpolated fog.
+		const __m128 fogPercents = _mm_movelh_ps(
+			_mm_cvtpd_ps(_mm_min_pd(_mm_div_pd(depthsLo, fogDistances), oneReals)),
+			_mm_cvtpd_ps(_mm_min_pd(_mm_div_pd(depthsHi, fogDistances), oneReals)));
+
+		// Interpolate between start and end points.
+		alignas(16) double depths[stride];
+		alignas(16) double pointXs[stride];
+		alignas(16) double pointYs[stride];
+		_mm_store_pd(depths, depthsLo);
+		_mm_store_pd(depths + halfStride, depthsHi);
+		const __m128d pointXsLo = _mm_mul_pd(
+			_mm_add_pd(startPointDivXs, _mm_mul_pd(pointDivDiffXs, yPercentsLo)), depthsLo);
+		const __m128d pointXsHi = _mm_mul_pd(
+			_mm_add_pd(startPointDivXs, _mm_mul_pd(pointDivDiffXs, yPercentsHi)), depthsHi);
+		const __m128d pointYsLo = _mm_mul_pd(
+			_mm_add_pd(startPointDivYs, _mm_mul_pd(pointDivDiffYs, yPercentsLo)), depthsLo);
+		const __m128d pointYsHi = _mm_mul_pd(
+			_mm_add_pd(startPointDivYs, _mm_mul_pd(pointDivDiffYs, yPercentsHi)), depthsHi);
+		_mm_store_pd(pointXs, pointXsLo);
+		_mm_store_pd(pointXs + halfStride, pointXsHi);
+		_mm_store_pd(pointYs, pointYsLo);
+		_mm_store_pd(pointYs + halfStride, pointYsHi);
+
+		// Texture coordinates.
+		const __m128d usLo = _mm_min_pd(_mm_max_pd(
+			_mm_sub_pd(pointXsLo, _mm_floor_pd(pointXsLo)), zeroReals), justBelowOnes);
+		const __m128d usHi = _mm_min_pd(_mm_max_pd(
+			_mm_sub_pd(pointXsHi, _mm_floor_pd(pointXsHi)), zeroReals), justBelowOnes);
+		const __m128d vsLo = _mm_min_pd(_mm_max_pd(
+			_mm_sub_pd(pointYsLo, _mm_floor_pd(pointYsLo)), zeroReals), justBelowOnes);
+		const __m128d vsHi = _mm_min_pd(_mm_max_pd(
+			_mm_sub_pd(pointYsHi, _mm_floor_pd(pointYsHi)), zeroReals), justBelowOnes);
+		alignas(16) int textureXs[stride];
+		alignas(16) int textureYs[stride];
+		_mm_store_si128(reinterpret_cast<__m128i*>(textureXs), _mm_unpacklo_epi64(
+			_mm_cvttpd_epi32(_mm_mul_pd(usLo, textureWidthReals)),
+			_mm_cvttpd_epi32(_mm_mul_pd(usHi, textureWidthReals))));
+		_mm_store_si128(reinterpret_cast<__m128i*>(textureYs), _mm_unpacklo_epi64(
+			_mm_cvttpd_epi32(_mm_mul_pd(vsLo, textureHeightReals)),
+			_mm_cvttpd_epi32(_mm_mul_pd(vsHi, textureHeightReals))));
+
+		// Gather texels and light contributions.
+		alignas(16) int texelRs[stride];
+		alignas(16) int texelGs[stride];
+		alignas(16) int texelBs[stride];
+		alignas(16) int texelEmissions[stride];
+		alignas(16) float lightPercentArray[stride];
+		for (int i = 0; i < stride; i++)
+		{
+			const int textureIndex = textureXs[i] + (textureYs[i] * texture.width);
+			const VoxelTexel &texel = texture.texels[textureIndex];
+			texelRs[i] = texel.r;
+			texelGs[i] = texel.g;
+			texelBs[i] = texel.b;
+			texelEmissions[i] = texel.emission;
+
+			if ((writeMask & (1 << i)) != 0)
+			{
+				const NewDouble2 currentPoint(pointXs[i], pointYs[i]);
+				lightPercentArray[i] = static_cast<float>(
+					SoftwareRenderer::getLightContributionAtPoint<LightContributionCap>(
+						currentPoint, visLights, visLightList));
+			}
+			else
+			{
+				lightPercentArray[i] = 0.0f;
+			}
+		}
+
+		__m128 colorRs = _mm_mul_ps(_mm_cvtepi32_ps(
+			_mm_load_si128(reinterpret_cast<const __m128i*>(texelRs))), channelRecips);
+		__m128 colorGs = _mm_mul_ps(_mm_cvtepi32_ps(
+			_mm_load_si128(reinterpret_cast<const __m128i*>(texelGs))), channelRecips);
+		__m128 colorBs = _mm_mul_ps(_mm_cvtepi32_ps(
+			_mm_load_si128(reinterpret_cast<const __m128i*>(texelBs))), channelRecips);
+		const __m128 colorEmissions = _mm_mul_ps(_mm_cvtepi32_ps(
+			_mm_load_si128(reinterpret_cast<const __m128i*>(texelEmissions))), channelRecips);
+
+		// Shading from light.
+		const __m128 combinedEmissions = _mm_add_ps(colorEmissions, _mm_load_ps(lightPercentArray));
+		const __m128 lights = _mm_min_ps(_mm_add_ps(shadings, combinedEmissions), ones);
+		colorRs = _mm_mul_ps(colorRs, lights);
+		colorGs = _mm_mul_ps(colorGs, lights);
+		colorBs = _mm_mul_ps(colorBs, lights);
+
+		if constexpr (Fading)
+		{
+			colorRs = _mm_mul_ps(colorRs, fades);
+			colorGs = _mm_mul_ps(colorGs, fades);
+			colorBs = _mm_mul_ps(colorBs, fades);
+		}
+
+		// Linearly interpolate with fog.
+		colorRs = _mm_add_ps(colorRs, _mm_mul_ps(_mm_sub_ps(fogRs, colorRs), fogPercents));
+		colorGs = _mm_add_ps(colorGs, _mm_mul_ps(_mm_sub_ps(fogGs, colorGs), fogPercents));
+		colorBs = _mm_add_ps(colorBs, _mm_mul_ps(_mm_sub_ps(fogBs, colorBs), fogPercents));
+
+		// Clamp maximum and pack into RGB.
+		colorRs = _mm_min_ps(colorRs, ones);
+		colorGs = _mm_min_ps(colorGs, ones);
+		colorBs = _mm_min_ps(colorBs, ones);
+		const __m128i colorRGBs = _mm_or_si128(_mm_or_si128(
+			_mm_slli_epi32(_mm_cvttps_epi32(_mm_mul_ps(colorRs, channelMaxes)), 16),
+			_mm_slli_epi32(_mm_cvttps_epi32(_mm_mul_ps(colorGs, channelMaxes)), 8)),
+			_mm_cvttps_epi32(_mm_mul_ps(colorBs, channelMaxes)));
+
+		alignas(16) uint32_t colors[stride];
+		_mm_store_si128(reinterpret_cast<__m128i*>(colors), colorRGBs);
+
+		for (int i = 0; i < stride; i++)
+		{
+			if ((writeMask & (1 << i)) != 0)
+			{
+				frame.colorBuffer[indices[i]] = colors[i];
+				frame.setDepth(indices[i], depths[i]);
+			}
+		}
+	}
+}
+
+template <bool Fading>
+AVX2_TARGET void SoftwareRenderer::drawPerspectivePixelsAVX(int x, int yStart, int yEnd,
+	const DrawRange &drawRange, const NewDouble2 &startPoint, const NewDouble2 &endPoint,
+	double depthStart, double depthEnd, const VoxelTexture &texture, double fadePercent,
+	const VisibleLightPool &visLights, const VisibleLightList &visLightList,
+	const ShadingInfo &shadingInfo, const FrameView &frame)
+{
+	constexpr int stride = sizeof(__m256) / sizeof(float);
+	constexpr int halfStride = stride / 2;
+
+	// Values for perspective-correct interpolation, computed with the same operations as the scalar
+	// shader so depths and texel look-ups are identical.
+	const double depthStartRecip = 1.0 / depthStart;
+	const double depthEndRecip = 1.0 / depthEnd;
+	const NewDouble2 startPointDiv = startPoint * depthStartRecip;
+	const NewDouble2 endPointDiv = endPoint * depthEndRecip;
+	const NewDouble2 pointDivDiff = endPointDiv - startPointDiv;
+
+	const __m256d yProjStarts = _mm256_set1_pd(drawRange.yProjStart);
+	const __m256d yProjDiffs = _mm256_set1_pd(drawRange.yProjEnd - drawRange.yProjStart);
+	const __m256d halfReals = _mm256_set1_pd(0.50);
+	const __m256d oneReals = _mm256_set1_pd(1.0);
+	const __m256d zeroReals = _mm256_setzero_pd();
+	const __m256d justBelowOnes = _mm256_set1_pd(Constants::JustBelowOne);
+	const __m256d depthStartRecips = _mm256_set1_pd(depthStartRecip);
+	const __m256d depthRecipDiffs = _mm256_set1_pd(depthEndRecip - depthStartRecip);
+	const __m256d startPointDivXs = _mm256_set1_pd(startPointDiv.x);
+	const __m256d startPointDivYs = _mm256_set1_pd(startPointDiv.y);
+	const __m256d pointDivDiffXs = _mm256_set1_pd(pointDivDiff.x);
+	const __m256d pointDivDiffYs = _mm256_set1_pd(pointDivDiff.y);
+	const __m256d fogDistances = _mm256_set1_pd(shadingInfo.fogDistance);
+	const __m256d textureWidthReals = _mm256_set1_pd(static_cast<double>(texture.width));
+	const __m256d textureHeightReals = _mm256_set1_pd(static_cast<double>(texture.height));
+
+	// Shading values.
+	const Double3 &fogColor = shadingInfo.getFogColor();
+	const __m256 fogRs = _mm256_set1_ps(static_cast<float>(fogColor.x));
+	const __m256 fogGs = _mm256_set1_ps(static_cast<float>(fogColor.y));
+	const __m256 fogBs = _mm256_set1_ps(static_cast<float>(fogColor.z));
+	const __m256 shadings = _mm256_set1_ps(static_cast<float>(shadingInfo.ambient));
+	const __m256 fades = _mm256_set1_ps(static_cast<float>(fadePercent));
+	const __m256 ones = _mm256_set1_ps(1.0f);
+	const __m256 channelRecips = _mm256_set1_ps(static_cast<float>(TEXEL_CHANNEL_RECIP));
+	const __m256 channelMaxes = _mm256_set1_ps(static_cast<float>(TEXEL_CHANNEL_MAX));
+
+	const int lastY = yEnd - 1;
+	for (int y = yStart; y < yEnd; y += stride)
+	{
+		// Lanes past the end of the range re-use the last row and are masked off.
+		alignas(32) double ys[stride];
+		alignas(32) int indices[stride];
+		alignas(32) double depthBuffers[stride];
+		for (int i = 0; i < stride; i++)
+		{
+			const int laneY = std::min(y + i, lastY);
+			ys[i] = static_cast<double>(laneY);
+			indices[i] = x + (laneY * frame.width);
+			depthBuffers[i] = frame.getDepth(indices[i]);
+		}
+
+		const int laneCount = std::min(stride, yEnd - y);
+		int writeMask = (1 << laneCount) - 1;
+
+		// Interpolate between the near and far depth, then depth test.
+		const __m256d yPercentsLo = _mm256_div_pd(
+			_mm256_sub_pd(_mm256_add_pd(_mm256_load_pd(ys), halfReals), yProjStarts), yProjDiffs);
+		const __m256d yPercentsHi = _mm256_div_pd(_mm256_sub_pd(
+			_mm256_add_pd(_mm256_load_pd(ys + halfStride), halfReals), yProjStarts), yProjDiffs);
+		const __m256d depthsLo = _mm256_div_pd(oneReals,
+			_mm256_add_pd(depthStartRecips, _mm256_mul_pd(depthRecipDiffs, yPercentsLo)));
+		const __m256d depthsHi = _mm256_div_pd(oneReals,
+			_mm256_add_pd(depthStartRecips, _mm256_mul_pd(depthRecipDiffs, yPercentsHi)));
+		const int depthMask =
+			_mm256_movemask_pd(_mm256_cmp_pd(depthsLo, _mm256_load_pd(depthBuffers), _CMP_LE_OQ)) |
+			(_mm256_movemask_pd(_mm256_cmp_pd(depthsHi, _mm256_load_pd(depthBuffers + halfStride),
+				_CMP_LE_OQ)) << halfStride);
+		writeMask &= depthMask;
+		if (writeMask == 0)
+		{
+			continue;
+		}
+
+		// Linearly interpolated fog.
+		const __m256 fogPercents = _mm256_insertf128_ps(_mm256_castps128_ps256(
+			_mm256_cvtpd_ps(_mm256_min_pd(_mm256_div_pd(depthsLo, fogDistances), oneReals))),
+			_mm256_cvtpd_ps(_mm256_min_pd(_mm256_div_pd(depthsHi, fogDistances), oneReals)), 1);
+
+		// Interpolate between start and end points.
+		alignas(32) double depths[stride];
+		alignas(32) double pointXs[stride];
+		alignas(32) double pointYs[stride];
+		_mm256_store_pd(depths, depthsLo);
+		_mm256_store_pd(depths + halfStride, depthsHi);
+		const __m256d pointXsLo = _mm256_mul_pd(
+			_mm256_add_pd(startPointDivXs, _mm256_mul_pd(pointDivDiffXs, yPercentsLo)), depthsLo);
+		const __m256d pointXsHi = _mm256_mul_pd(
+			_mm256_add_pd(startPointDivXs, _mm256_mul_pd(pointDivDiffXs, yPercentsHi)), depthsHi);
+		const __m256d pointYsLo = _mm256_mul_pd(
+			_mm256_add_pd(startPointDivYs, _mm256_mul_pd(pointDivDiffYs, yPercentsLo)), depthsLo);
+		const __m256d pointYsHi = _mm256_mul_pd(
+			_mm256_add_pd(startPointDivYs, _mm256_mul_pd(pointDivDiffYs, yPercentsHi)), depthsHi);
+		_mm256_store_pd(pointXs, pointXsLo);
+		_mm256_store_pd(pointXs + halfStride, pointXsHi);
+		_mm256_store_pd(pointYs, pointYsLo);
+		_mm256_store_pd(pointYs + halfStride, pointYsHi);
+
+		// Texture coordinates.
+		const __m256d usLo = _mm256_min_pd(_mm256_max_pd(
+			_mm256_sub_pd(pointXsLo, _mm256_floor_pd(pointXsLo)), zeroReals), justBelowOnes);
+		const __m256d usHi = _mm256_min_pd(_mm256_max_pd(
+			_mm256_sub_pd(pointXsHi, _mm256_floor_pd(pointXsHi)), zeroReals), justBelowOnes);
+		const __m256d vsLo = _mm256_min_pd(_mm256_max_pd(
+			_mm256_sub_pd(pointYsLo, _mm256_floor_pd(pointYsLo)), zeroReals), justBelowOnes);
+		const __m256d vsHi = _mm256_min_pd(_mm256_max_pd(
+			_mm256_sub_pd(pointYsHi, _mm256_floor_pd(pointYsHi)), zeroReals), justBelowOnes);
+		alignas(32) int textureXs[stride];
+		alignas(32) int textureYs[stride];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(textureXs), _mm256_insertf128_si256(
+			_mm256_castsi128_si256(_mm256_cvttpd_epi32(_mm256_mul_pd(usLo, textureWidthReals))),
+			_mm256_cvttpd_epi32(_mm256_mul_pd(usHi, textureWidthReals)), 1));
+		_mm256_store_si256(reinterpret_cast<__m256i*>(textureYs), _mm256_insertf128_si256(
+			_mm256_castsi128_si256(_mm256_cvttpd_epi32(_mm256_mul_pd(vsLo, textureHeightReals))),
+			_mm256_cvttpd_epi32(_mm256_mul_pd(vsHi, textureHeightReals)), 1));
+
+		// Gather texels and light contributions.
+		alignas(32) int texelRs[stride];
+		alignas(32) int texelGs[stride];
+		alignas(32) int texelBs[stride];
+		alignas(32) int texelEmissions[stride];
+		alignas(32) float lightPercentArray[stride];
+		for (int i = 0; i < stride; i++)
+		{
+			const int textureIndex = textureXs[i] + (textureYs[i] * texture.width);
+			const VoxelTexel &texel = texture.texels[textureIndex];
+			texelRs[i] = texel.r;
+			texelGs[i] = texel.g;
+			texelBs[i] = texel.b;
+			texelEmissions[i] = texel.emission;
+
+			if ((writeMask & (1 << i)) != 0)
+			{
+				const NewDouble2 currentPoint(pointXs[i], pointYs[i]);
+				lightPercentArray[i] = static_cast<float>(
+					SoftwareRenderer::getLightContributionAtPoint<LightContributionCap>(
+						currentPoint, visLights, visLightList));
+			}
+			else
+			{
+				lightPercentArray[i] = 0.0f;
+			}
+		}
+
+		__m256 colorRs = _mm256_mul_ps(_mm256_cvtepi32_ps(
+			_mm256_load_si256(reinterpret_cast<const __m256i*>(texelRs))), channelRecips);
+		__m256 colorGs = _mm256_mul_ps(_mm256_cvtepi32_ps(
+			_mm256_load_si256(reinterpret_cast<const __m256i*>(texelGs))), channelRecips);
+		__m256 colorBs = _mm256_mul_ps(_mm256_cvtepi32_ps(
+			_mm256_load_si256(reinterpret_cast<const __m256i*>(texelBs))), channelRecips);
+		const __m256 colorEmissions = _mm256_mul_ps(_mm256_cvtepi32_ps(
+			_mm256_load_si256(reinterpret_cast<const __m256i*>(texelEmissions))), channelRecips);
+
+		// Shading from light.
+		const __m256 combinedEmissions = _mm256_add_ps(colorEmissions, _mm256_load_ps(lightPercentArray));
+		const __m256 lights = _mm256_min_ps(_mm256_add_ps(shadings, combinedEmissions), ones);
+		colorRs = _mm256_mul_ps(colorRs, lights);
+		colorGs = _mm256_mul_ps(colorGs, lights);
+		colorBs = _mm256_mul_ps(colorBs, lights);
+
+		if constexpr (Fading)
+		{
+			colorRs = _mm256_mul_ps(colorRs, fades);
+			colorGs = _mm256_mul_ps(colorGs, fades);
+			colorBs = _mm256_mul_ps(colorBs, fades);
+		}
+
+		// Linearly interpolate with fog.
+		colorRs = _mm256_add_ps(colorRs, _mm256_mul_ps(_mm256_sub_ps(fogRs, colorRs), fogPercents));
+		colorGs = _mm256_add_ps(colorGs, _mm256_mul_ps(_mm256_sub_ps(fogGs, colorGs), fogPercents));
+		colorBs = _mm256_add_ps(colorBs, _mm256_mul_ps(_mm256_sub_ps(fogBs, colorBs), fogPercents));
+
+		// Clamp maximum and pack into RGB.
+		colorRs = _mm256_min_ps(colorRs, ones);
+		colorGs = _mm256_min_ps(colorGs, ones);
+		colorBs = _mm256_min_ps(colorBs, ones);
+		const __m256i colorRGBs = _mm256_or_si256(_mm256_or_si256(
+			_mm256_slli_epi32(_mm256_cvttps_epi32(_mm256_mul_ps(colorRs, channelMaxes)), 16),
+			_mm256_slli_epi32(_mm256_cvttps_epi32(_mm256_mul_ps(colorGs, channelMaxes)), 8)),
+			_mm256_cvttps_epi32(_mm256_mul_ps(colorBs, channelMaxes)));
+
+		alignas(32) uint32_t colors[stride];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(colors), colorRGBs);
+
+		for (int i = 0; i < stride; i++)
+		{
+			if ((writeMask & (1 << i)) != 0)
+			{
+				frame.colorBuffer[indices[i]] = colors[i];
+				frame.setDepth(indices[i], depths[i]);
+			}
+		}
+	}
+}
+
 template <bool Fading>
 void SoftwareRenderer::drawPerspectivePixelsShader(int x, const DrawRange &drawRange,
 	const NewDouble2 &startPoint, const NewDouble2 &endPoint, double depthStart, double depthEnd,
 	const Double3 &normal, const VoxelTexture &texture, double fadePercent,
-	const BufferView<const VisibleLight> &visLights, const VisibleLightList &visLightList,
+	const VisibleLightPool &visLights, const VisibleLightList &visLightList,
 	const ShadingInfo &shadingInfo, OcclusionData &occlusion, const FrameView &frame)
 {
 	// Draw range values.
@@ -3608,9 +5771,13 @@ void SoftwareRenderer::drawPerspectivePixelsShader(int x, const DrawRange &drawR
 
 	// Fog color to interpolate with.
 	const Double3 &fogColor = shadingInfo.getFogColor();
+	const ShadingReal fogR = static_cast<ShadingReal>(fogColor.x);
+	const ShadingReal fogG = static_cast<ShadingReal>(fogColor.y);
+	const ShadingReal fogB = static_cast<ShadingReal>(fogColor.z);
 
 	// Base shading on the texture.
-	const Double3 shading(shadingInfo.ambient, shadingInfo.ambient, shadingInfo.ambient);
+	const ShadingReal shading = static_cast<ShadingReal>(shadingInfo.ambient);
+	const ShadingReal fade = static_cast<ShadingReal>(fadePercent);
 
 	// Values for perspective-correct interpolation.
 	const double depthStartRecip = 1.0 / depthStart;
@@ -3623,6 +5790,25 @@ void SoftwareRenderer::drawPerspectivePixelsShader(int x, const DrawRange &drawR
 	occlusion.clipRange(&yStart, &yEnd);
 	occlusion.update(yStart, yEnd);
 
+	// SIMD kernels only cover the single-precision, nearest-filtered path.
+	if constexpr ((TextureFilterMode == 0) && std::is_same_v<ShadingReal, float>)
+	{
+		if (ActiveColumnKernel == ColumnKernel::AVX)
+		{
+			SoftwareRenderer::drawPerspectivePixelsAVX<Fading>(x, yStart, yEnd, drawRange, startPoint,
+				endPoint, depthStart, depthEnd, texture, fadePercent, visLights, visLightList, shadingInfo,
+				frame);
+			return;
+		}
+		else if (ActiveColumnKernel == ColumnKernel::SSE)
+		{
+			SoftwareRenderer::drawPerspectivePixelsSSE<Fading>(x, yStart, yEnd, drawRange, startPoint,
+				endPoint, depthStart, depthEnd, texture, fadePercent, visLights, visLightList, shadingInfo,
+				frame);
+			return;
+		}
+	}
+
 	// Draw the column to the output buffer.
 	for (int y = yStart; y < yEnd; y++)
 	{
@@ -3639,10 +5825,11 @@ void SoftwareRenderer::drawPerspectivePixelsShader(int x, const DrawRange &drawR
 		// Check depth of the pixel before rendering.
 		// - @todo: implement occlusion culling and back-to-front transparent rendering so
 		//   this depth check isn't needed.
-		if (depth <= frame.depthBuffer[index])
+		if (depth <= frame.getDepth(index))
 		{
 			// Linearly interpolated fog.
-			const double fogPercent = std::min(depth / shadingInfo.fogDistance, 1.0);
+			const ShadingReal fogPercent = static_cast<ShadingReal>(
+				std::min(depth / shadingInfo.fogDistance, 1.0));
 
 			// Interpolate between start and end points.
 			const SNDouble currentPointX = (startPointDiv.x + (pointDivDiff.x * yPercent)) * depth;
@@ -3654,52 +5841,51 @@ void SoftwareRenderer::drawPerspectivePixelsShader(int x, const DrawRange &drawR
 
 			// Texture color. Alpha is ignored in this loop, so transparent texels will appear black.
 			constexpr bool TextureTransparency = false;
-			double colorR, colorG, colorB, colorEmission;
+			ShadingReal colorR, colorG, colorB, colorEmission;
 			SoftwareRenderer::sampleVoxelTexture<TextureFilterMode, TextureTransparency>(
 				texture, u, v, &colorR, &colorG, &colorB, &colorEmission, nullptr);
 
 			// Light contribution.
 			const NewDouble2 currentPoint(currentPointX, currentPointY);
-			const double lightContributionPercent = SoftwareRenderer::getLightContributionAtPoint<
-				LightContributionCap>(currentPoint, visLights, visLightList);
+			const ShadingReal lightPercent = static_cast<ShadingReal>(
+				SoftwareRenderer::getLightContributionAtPoint<LightContributionCap>(
+					currentPoint, visLights, visLightList));
 
 			// Shading from light.
-			constexpr double shadingMax = 1.0;
-			const double combinedEmission = colorEmission + lightContributionPercent;
-			const double lightR = shading.x + combinedEmission;
-			const double lightG = shading.y + combinedEmission;
-			const double lightB = shading.z + combinedEmission;
-			colorR *= (lightR < shadingMax) ? lightR : shadingMax;
-			colorG *= (lightG < shadingMax) ? lightG : shadingMax;
-			colorB *= (lightB < shadingMax) ? lightB : shadingMax;
+			constexpr ShadingReal shadingMax = 1.0;
+			const ShadingReal combinedEmission = colorEmission + lightPercent;
+			const ShadingReal light = std::min(shading + combinedEmission, shadingMax);
+			colorR *= light;
+			colorG *= light;
+			colorB *= light;
 
 			if constexpr (Fading)
 			{
 				// Apply voxel fade percent.
-				colorR *= fadePercent;
-				colorG *= fadePercent;
-				colorB *= fadePercent;
+				colorR *= fade;
+				colorG *= fade;
+				colorB *= fade;
 			}
 
 			// Linearly interpolate with fog.
-			colorR += (fogColor.x - colorR) * fogPercent;
-			colorG += (fogColor.y - colorG) * fogPercent;
-			colorB += (fogColor.z - colorB) * fogPercent;
+			colorR += (fogR - colorR) * fogPercent;
+			colorG += (fogG - colorG) * fogPercent;
+			colorB += (fogB - colorB) * fogPercent;
 
 			// Clamp maximum (don't worry about negative values).
-			constexpr double high = 1.0;
+			constexpr ShadingReal high = 1.0;
 			colorR = (colorR > high) ? high : colorR;
 			colorG = (colorG > high) ? high : colorG;
 			colorB = (colorB > high) ? high : colorB;
 
 			// Convert floats to integers.
 			const uint32_t colorRGB = static_cast<uint32_t>(
-				((static_cast<uint8_t>(colorR * 255.0)) << 16) |
-				((static_cast<uint8_t>(colorG * 255.0)) << 8) |
-				((static_cast<uint8_t>(colorB * 255.0))));
+				((static_cast<uint8_t>(colorR * TEXEL_CHANNEL_MAX)) << 16) |
+				((static_cast<uint8_t>(colorG * TEXEL_CHANNEL_MAX)) << 8) |
+				((static_cast<uint8_t>(colorB * TEXEL_CHANNEL_MAX))));
 
 			frame.colorBuffer[index] = colorRGB;
-			frame.depthBuffer[index] = depth;
+			frame.setDepth(index, depth);
 		}
 	}
 }
@@ -3707,9 +5893,12 @@ void SoftwareRenderer::drawPerspectivePixelsShader(int x, const DrawRange &drawR
 void SoftwareRenderer::drawPerspectivePixels(int x, const DrawRange &drawRange,
 	const NewDouble2 &startPoint, const NewDouble2 &endPoint, double depthStart, double depthEnd,
 	const Double3 &normal, const VoxelTexture &texture, double fadePercent,
-	const BufferView<const VisibleLight> &visLights, const VisibleLightList &visLightList,
+	const VisibleLightPool &visLights, const VisibleLightList &visLightList,
 	const ShadingInfo &shadingInfo, OcclusionData &occlusion, const FrameView &frame)
 {
+	// Floors and ceilings always use the full-size texture. Their texel footprint changes with
+	// depth down the column, so one mipmap per column would either blur the near end or alias the
+	// far end; that needs a per-pixel level, which isn't done yet.
 	if (fadePercent == 1.0)
 	{
 		constexpr bool fading = false;
@@ -3737,28 +5926,60 @@ void SoftwareRenderer::drawTransparentPixels(int x, const DrawRange &drawRange,
 	int yStart = drawRange.yStart;
 	int yEnd = drawRange.yEnd;
 
+	const VoxelTexture &mipmap = SoftwareRenderer::getVoxelMipmap(texture, drawRange, vStart, vEnd);
+
 	// Horizontal offset in texture.
 	// - Taken care of in texture sampling function (redundant calculation, though).
 	//const int textureX = static_cast<int>(u * static_cast<double>(texture.width));
 
 	// Linearly interpolated fog.
 	const Double3 &fogColor = shadingInfo.getFogColor();
-	const double fogPercent = std::min(depth / shadingInfo.fogDistance, 1.0);
+	const ShadingReal fogR = static_cast<ShadingReal>(fogColor.x);
+	const ShadingReal fogG = static_cast<ShadingReal>(fogColor.y);
+	const ShadingReal fogB = static_cast<ShadingReal>(fogColor.z);
+	const ShadingReal fogPercent = static_cast<ShadingReal>(
+		std::min(depth / shadingInfo.fogDistance, 1.0));
 
 	// Shading on the texture.
-	const Double3 shading(shadingInfo.ambient, shadingInfo.ambient, shadingInfo.ambient);
+	const ShadingReal shading = static_cast<ShadingReal>(shadingInfo.ambient);
+	const ShadingReal lightPercent = static_cast<ShadingReal>(lightContributionPercent);
 
 	// Clip the Y start and end coordinates as needed, but do not refresh the occlusion buffer,
 	// because transparent ranges do not occlude as simply as opaque ranges.
 	occlusion.clipRange(&yStart, &yEnd);
 
+	// SIMD kernels only cover the single-precision, nearest-filtered path.
+	if constexpr ((TextureFilterMode == 0) && std::is_same_v<ShadingReal, float>)
+	{
+		constexpr bool fading = false;
+		constexpr bool transparency = true;
+		constexpr double fadePercent = 1.0;
+
+		// Transparent texels are skipped.
+		auto transparentTexelFunc = [](int index, int y) { };
+		if (ActiveColumnKernel == ColumnKernel::AVX)
+		{
+			SoftwareRenderer::drawPixelsAVX<fading, transparency>(x, yStart, yEnd, drawRange, depth,
+				u, vStart, vEnd, mipmap, fadePercent, lightContributionPercent, shadingInfo, frame,
+				transparentTexelFunc);
+			return;
+		}
+		else if (ActiveColumnKernel == ColumnKernel::SSE)
+		{
+			SoftwareRenderer::drawPixelsSSE<fading, transparency>(x, yStart, yEnd, drawRange, depth,
+				u, vStart, vEnd, mipmap, fadePercent, lightContributionPercent, shadingInfo, frame,
+				transparentTexelFunc);
+			return;
+		}
+	}
+
 	// Draw the column to the output buffer.
 	for (int y = yStart; y < yEnd; y++)
 	{
 		const int index = x + (y * frame.width);
 
 		// Check depth of the pixel before rendering.
-		if (depth <= (frame.depthBuffer[index] - Constants::Epsilon))
+		if (depth <= (frame.getDepth(index) - Constants::Epsilon))
 		{
 			// Percent stepped from beginning to end on the column.
 			const double yPercent =
@@ -3769,42 +5990,40 @@ void SoftwareRenderer::drawTransparentPixels(int x, const DrawRange &drawRange,
 
 			// Texture color. Alpha is checked in this loop, and transparent texels are not drawn.
 			constexpr bool TextureTransparency = true;
-			double colorR, colorG, colorB, colorEmission;
+			ShadingReal colorR, colorG, colorB, colorEmission;
 			bool colorTransparent;
 			SoftwareRenderer::sampleVoxelTexture<TextureFilterMode, TextureTransparency>(
-				texture, u, v, &colorR, &colorG, &colorB, &colorEmission, &colorTransparent);
+				mipmap, u, v, &colorR, &colorG, &colorB, &colorEmission, &colorTransparent);
 			
 			if (!colorTransparent)
 			{
 				// Shading from light.
-				constexpr double shadingMax = 1.0;
-				const double combinedEmission = colorEmission + lightContributionPercent;
-				const double lightR = shading.x + combinedEmission;
-				const double lightG = shading.y + combinedEmission;
-				const double lightB = shading.z + combinedEmission;
-				colorR *= (lightR < shadingMax) ? lightR : shadingMax;
-				colorG *= (lightG < shadingMax) ? lightG : shadingMax;
-				colorB *= (lightB < shadingMax) ? lightB : shadingMax;
+				constexpr ShadingReal shadingMax = 1.0;
+				const ShadingReal combinedEmission = colorEmission + lightPercent;
+				const ShadingReal light = std::min(shading + combinedEmission, shadingMax);
+				colorR *= light;
+				colorG *= light;
+				colorB *= light;
 
 				// Linearly interpolate with fog.
-				colorR += (fogColor.x - colorR) * fogPercent;
-				colorG += (fogColor.y - colorG) * fogPercent;
-				colorB += (fogColor.z - colorB) * fogPercent;
+				colorR += (fogR - colorR) * fogPercent;
+				colorG += (fogG - colorG) * fogPercent;
+				colorB += (fogB - colorB) * fogPercent;
 				
 				// Clamp maximum (don't worry about negative values).
-				constexpr double high = 1.0;
+				constexpr ShadingReal high = 1.0;
 				colorR = (colorR > high) ? high : colorR;
 				colorG = (colorG > high) ? high : colorG;
 				colorB = (colorB > high) ? high : colorB;
 
 				// Convert floats to integers.
 				const uint32_t colorRGB = static_cast<uint32_t>(
-					((static_cast<uint8_t>(colorR * 255.0)) << 16) |
-					((static_cast<uint8_t>(colorG * 255.0)) << 8) |
-					((static_cast<uint8_t>(colorB * 255.0))));
+					((static_cast<uint8_t>(colorR * TEXEL_CHANNEL_MAX)) << 16) |
+					((static_cast<uint8_t>(colorG * TEXEL_CHANNEL_MAX)) << 8) |
+					((static_cast<uint8_t>(colorB * TEXEL_CHANNEL_MAX))));
 
 				frame.colorBuffer[index] = colorRGB;
-				frame.depthBuffer[index] = depth;
+				frame.setDepth(index, depth);
 			}
 		}
 	}
@@ -3828,22 +6047,83 @@ void SoftwareRenderer::drawChasmPixelsShader(int x, const DrawRange &drawRange,
 
 	// Linearly interpolated fog.
 	const Double3 &fogColor = shadingInfo.getFogColor();
-	const double fogPercent = std::min(depth / shadingInfo.fogDistance, 1.0);
+	const ShadingReal fogR = static_cast<ShadingReal>(fogColor.x);
+	const ShadingReal fogG = static_cast<ShadingReal>(fogColor.y);
+	const ShadingReal fogB = static_cast<ShadingReal>(fogColor.z);
+	const ShadingReal fogPercent = static_cast<ShadingReal>(
+		std::min(depth / shadingInfo.fogDistance, 1.0));
 
 	// Shading on the texture.
-	const Double3 shading(shadingInfo.ambient, shadingInfo.ambient, shadingInfo.ambient);
+	const ShadingReal shading = static_cast<ShadingReal>(shadingInfo.ambient);
+	const ShadingReal lightPercent = static_cast<ShadingReal>(lightContributionPercent);
+	const ShadingReal distantAmbient = static_cast<ShadingReal>(shadingInfo.distantAmbient);
 
 	// Clip the Y start and end coordinates as needed, and refresh the occlusion buffer.
 	occlusion.clipRange(&yStart, &yEnd);
 	occlusion.update(yStart, yEnd);
 
+	// Screen-space chasm texel drawn where the wall texture is transparent.
+	auto drawChasmTexel = [x, depth, &chasmTexture, distantAmbient, &frame](int index, int y)
+	{
+		const double screenXPercent = static_cast<double>(x) / frame.widthReal;
+		const double screenYPercent = static_cast<double>(y) / frame.heightReal;
+		ShadingReal chasmR, chasmG, chasmB;
+		SoftwareRenderer::sampleChasmTexture(chasmTexture, screenXPercent, screenYPercent,
+			&chasmR, &chasmG, &chasmB);
+
+		if constexpr (AmbientShading)
+		{
+			chasmR *= distantAmbient;
+			chasmG *= distantAmbient;
+			chasmB *= distantAmbient;
+		}
+
+		const uint32_t colorRGB = static_cast<uint32_t>(
+			((static_cast<uint8_t>(chasmR * TEXEL_CHANNEL_MAX)) << 16) |
+			((static_cast<uint8_t>(chasmG * TEXEL_CHANNEL_MAX)) << 8) |
+			((static_cast<uint8_t>(chasmB * TEXEL_CHANNEL_MAX))));
+
+		frame.colorBuffer[index] = colorRGB;
+
+		if constexpr (TrueDepth)
+		{
+			frame.setDepth(index, depth);
+		}
+		else
+		{
+			frame.setDepth(index, DEPTH_BUFFER_INFINITY);
+		}
+	};
+
+	// SIMD kernels shade the wall texels and hand transparent ones back for the chasm texture.
+	if constexpr ((TextureFilterMode == 0) && std::is_same_v<ShadingReal, float>)
+	{
+		constexpr bool fading = false;
+		constexpr bool transparency = true;
+		constexpr double fadePercent = 1.0;
+		if (ActiveColumnKernel == ColumnKernel::AVX)
+		{
+			SoftwareRenderer::drawPixelsAVX<fading, transparency>(x, yStart, yEnd, drawRange, depth,
+				u, vStart, vEnd, texture, fadePercent, lightContributionPercent, shadingInfo, frame,
+				drawChasmTexel);
+			return;
+		}
+		else if (ActiveColumnKernel == ColumnKernel::SSE)
+		{
+			SoftwareRenderer::drawPixelsSSE<fading, transparency>(x, yStart, yEnd, drawRange, depth,
+				u, vStart, vEnd, texture, fadePercent, lightContributionPercent, shadingInfo, frame,
+				drawChasmTexel);
+			return;
+		}
+	}
+
 	// Draw the column to the output buffer.
 	for (int y = yStart; y < yEnd; y++)
 	{
 		const int index = x + (y * frame.width);
 
 		// Check depth of the pixel before rendering.
-		if (depth <= (frame.depthBuffer[index] - Constants::Epsilon))
+		if (depth <= (frame.getDepth(index) - Constants::Epsilon))
 		{
 			// Percent stepped from beginning to end on the column.
 			const double yPercent =
@@ -3856,7 +6136,7 @@ void SoftwareRenderer::drawChasmPixelsShader(int x, const DrawRange &drawRange,
 			// @todo: maybe this could be optimized to a 'transparent-texel-only' look-up, that
 			// then branches to determine whether to sample the voxel or chasm texture?
 			constexpr bool TextureTransparency = true;
-			double colorR, colorG, colorB, colorEmission;
+			ShadingReal colorR, colorG, colorB, colorEmission;
 			bool colorTransparent;
 			SoftwareRenderer::sampleVoxelTexture<TextureFilterMode, TextureTransparency>(
 				texture, u, v, &colorR, &colorG, &colorB, &colorEmission, &colorTransparent);
@@ -3865,66 +6145,37 @@ void SoftwareRenderer::drawChasmPixelsShader(int x, const DrawRange &drawRange,
 			{
 				// Voxel texture.
 				// Shading from light.
-				constexpr double shadingMax = 1.0;
-				const double combinedEmission = colorEmission + lightContributionPercent;
-				const double lightR = shading.x + combinedEmission;
-				const double lightG = shading.y + combinedEmission;
-				const double lightB = shading.z + combinedEmission;
-				colorR *= (lightR < shadingMax) ? lightR : shadingMax;
-				colorG *= (lightG < shadingMax) ? lightG : shadingMax;
-				colorB *= (lightB < shadingMax) ? lightB : shadingMax;
+				constexpr ShadingReal shadingMax = 1.0;
+				const ShadingReal combinedEmission = colorEmission + lightPercent;
+				const ShadingReal light = std::min(shading + combinedEmission, shadingMax);
+				colorR *= light;
+				colorG *= light;
+				colorB *= light;
 
 				// Linearly interpolate with fog.
-				colorR += (fogColor.x - colorR) * fogPercent;
-				colorG += (fogColor.y - colorG) * fogPercent;
-				colorB += (fogColor.z - colorB) * fogPercent;
+				colorR += (fogR - colorR) * fogPercent;
+				colorG += (fogG - colorG) * fogPercent;
+				colorB += (fogB - colorB) * fogPercent;
 
 				// Clamp maximum (don't worry about negative values).
-				constexpr double high = 1.0;
+				constexpr ShadingReal high = 1.0;
 				colorR = (colorR > high) ? high : colorR;
 				colorG = (colorG > high) ? high : colorG;
 				colorB = (colorB > high) ? high : colorB;
 
 				// Convert floats to integers.
 				const uint32_t colorRGB = static_cast<uint32_t>(
-					((static_cast<uint8_t>(colorR * 255.0)) << 16) |
-					((static_cast<uint8_t>(colorG * 255.0)) << 8) |
-					((static_cast<uint8_t>(colorB * 255.0))));
-
-				frame.colorBuffer[index] = colorRGB;
-				frame.depthBuffer[index] = depth;
-			}
-			else
-			{
-				// Chasm texture.
-				const double screenXPercent = static_cast<double>(x) / frame.widthReal;
-				const double screenYPercent = static_cast<double>(y) / frame.heightReal;
-				double chasmR, chasmG, chasmB;
-				SoftwareRenderer::sampleChasmTexture(chasmTexture, screenXPercent, screenYPercent,
-					&chasmR, &chasmG, &chasmB);
-
-				if constexpr (AmbientShading)
-				{
-					chasmR *= shadingInfo.distantAmbient;
-					chasmG *= shadingInfo.distantAmbient;
-					chasmB *= shadingInfo.distantAmbient;
-				}
-
-				const uint32_t colorRGB = static_cast<uint32_t>(
-					((static_cast<uint8_t>(chasmR * 255.0)) << 16) |
-					((static_cast<uint8_t>(chasmG * 255.0)) << 8) |
-					((static_cast<uint8_t>(chasmB * 255.0))));
-
-				frame.colorBuffer[index] = colorRGB;
+					((static_cast<uint8_t>(colorR * TEXEL_CHANNEL_MAX)) << 16) |
+					((static_cast<uint8_t>(colorG * TEXEL_CHANNEL_MAX)) << 8) |
+					((static_cast<uint8_t>(colorB * TEXEL_CHANNEL_MAX))));
 
-				if constexpr (TrueDepth)
-				{
-					frame.depthBuffer[index] = depth;
-				}
-				else
-				{
-					frame.depthBuffer[index] = DEPTH_BUFFER_INFINITY;
-				}
+				frame.colorBuffer[index] = colorRGB;
+				frame.setDepth(index, depth);
+			}
+			else
+			{
+				// Chasm texture.
+				drawChasmTexel(index, y);
 			}
 		}
 	}
@@ -3935,6 +6186,7 @@ void SoftwareRenderer::drawChasmPixels(int x, const DrawRange &drawRange, double
 	const ChasmTexture &chasmTexture, double lightContributionPercent, const ShadingInfo &shadingInfo,
 	OcclusionData &occlusion, const FrameView &frame)
 {
+	const VoxelTexture &mipmap = SoftwareRenderer::getVoxelMipmap(texture, drawRange, vStart, vEnd);
 	const bool useAmbientChasmShading = shadingInfo.isExterior && !emissive;
 	const bool useTrueChasmDepth = true;
 
@@ -3945,14 +6197,14 @@ void SoftwareRenderer::drawChasmPixels(int x, const DrawRange &drawRange, double
 		{
 			constexpr bool trueDepth = true;
 			SoftwareRenderer::drawChasmPixelsShader<ambientShading, trueDepth>(x, drawRange, depth,
-				u, vStart, vEnd, normal, texture, chasmTexture, lightContributionPercent, shadingInfo,
+				u, vStart, vEnd, normal, mipmap, chasmTexture, lightContributionPercent, shadingInfo,
 				occlusion, frame);
 		}
 		else
 		{
 			constexpr bool trueDepth = false;
 			SoftwareRenderer::drawChasmPixelsShader<ambientShading, trueDepth>(x, drawRange, depth,
-				u, vStart, vEnd, normal, texture, chasmTexture, lightContributionPercent, shadingInfo,
+				u, vStart, vEnd, normal, mipmap, chasmTexture, lightContributionPercent, shadingInfo,
 				occlusion, frame);
 		}
 	}
@@ -3963,14 +6215,14 @@ void SoftwareRenderer::drawChasmPixels(int x, const DrawRange &drawRange, double
 		{
 			constexpr bool trueDepth = true;
 			SoftwareRenderer::drawChasmPixelsShader<ambientShading, trueDepth>(x, drawRange, depth,
-				u, vStart, vEnd, normal, texture, chasmTexture, lightContributionPercent, shadingInfo,
+				u, vStart, vEnd, normal, mipmap, chasmTexture, lightContributionPercent, shadingInfo,
 				occlusion, frame);
 		}
 		else
 		{
 			constexpr bool trueDepth = false;
 			SoftwareRenderer::drawChasmPixelsShader<ambientShading, trueDepth>(x, drawRange, depth,
-				u, vStart, vEnd, normal, texture, chasmTexture, lightContributionPercent, shadingInfo,
+				u, vStart, vEnd, normal, mipmap, chasmTexture, lightContributionPercent, shadingInfo,
 				occlusion, frame);
 		}
 	}
@@ -3993,6 +6245,7 @@ void SoftwareRenderer::drawPerspectiveChasmPixelsShader(int x, const DrawRange &
 
 	// Shading on the texture.
 	const Double3 shading(shadingInfo.ambient, shadingInfo.ambient, shadingInfo.ambient);
+	const ShadingReal distantAmbient = static_cast<ShadingReal>(shadingInfo.distantAmbient);
 
 	// Values for perspective-correct interpolation.
 	const double depthStartRecip = 1.0 / depthStart;
@@ -4021,7 +6274,7 @@ void SoftwareRenderer::drawPerspectiveChasmPixelsShader(int x, const DrawRange &
 		// Check depth of the pixel before rendering.
 		// - @todo: implement occlusion culling and back-to-front transparent rendering so
 		//   this depth check isn't needed.
-		if (depth <= frame.depthBuffer[index])
+		if (depth <= frame.getDepth(index))
 		{
 			// Linearly interpolated fog.
 			const double fogPercent = std::min(depth / shadingInfo.fogDistance, 1.0);
@@ -4037,31 +6290,31 @@ void SoftwareRenderer::drawPerspectiveChasmPixelsShader(int x, const DrawRange &
 			// Chasm texture color.
 			const double screenXPercent = static_cast<double>(x) / frame.widthReal;
 			const double screenYPercent = static_cast<double>(y) / frame.heightReal;
-			double colorR, colorG, colorB;
+			ShadingReal colorR, colorG, colorB;
 			SoftwareRenderer::sampleChasmTexture(texture, screenXPercent, screenYPercent,
 				&colorR, &colorG, &colorB);
 
 			if constexpr (AmbientShading)
 			{
-				colorR *= shadingInfo.distantAmbient;
-				colorG *= shadingInfo.distantAmbient;
-				colorB *= shadingInfo.distantAmbient;
+				colorR *= distantAmbient;
+				colorG *= distantAmbient;
+				colorB *= distantAmbient;
 			}
 
 			const uint32_t colorRGB = static_cast<uint32_t>(
-				((static_cast<uint8_t>(colorR * 255.0)) << 16) |
-				((static_cast<uint8_t>(colorG * 255.0)) << 8) |
-				((static_cast<uint8_t>(colorB * 255.0))));
+				((static_cast<uint8_t>(colorR * TEXEL_CHANNEL_MAX)) << 16) |
+				((static_cast<uint8_t>(colorG * TEXEL_CHANNEL_MAX)) << 8) |
+				((static_cast<uint8_t>(colorB * TEXEL_CHANNEL_MAX))));
 
 			frame.colorBuffer[index] = colorRGB;
 
 			if constexpr (TrueDepth)
 			{
-				frame.depthBuffer[index] = depth;
+				frame.setDepth(index, depth);
 			}
 			else
 			{
-				frame.depthBuffer[index] = DEPTH_BUFFER_INFINITY;
+				frame.setDepth(index, DEPTH_BUFFER_INFINITY);
 			}
 		}
 	}
@@ -4663,28 +6916,23 @@ void SoftwareRenderer::drawStarPixels(int x, const DrawRange &drawRange, double
 void SoftwareRenderer::drawInitialVoxelSameFloor(int x, SNInt voxelX, int voxelY, WEInt voxelZ,
 	const Camera &camera, const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint,
 	const NewDouble2 &farPoint, double nearZ, double farZ, double wallU, const Double3 &wallNormal,
-	const ShadingInfo &shadingInfo, int chunkDistance, double ceilingHeight, const LevelData &levelData,
-	const BufferView<const VisibleLight> &visLights, const BufferView2D<const VisibleLightList> &visLightLists,
+	const ShadingInfo &shadingInfo, int chunkDistance, double ceilingHeight, const LevelSnapshot &levelSnapshot,
+	const VisibleLightPool &visLights, const VisibleLightList &visLightList,
 	const VoxelTextures &textures, const ChasmTextureGroups &chasmTextureGroups,
 	OcclusionData &occlusion, const FrameView &frame)
 {
-	const auto &voxelGrid = levelData.getVoxelGrid();
+	const auto &voxelGrid = levelSnapshot.getVoxelGrid();
 	const uint16_t voxelID = voxelGrid.getVoxel(voxelX, voxelY, voxelZ);
 	const VoxelDefinition &voxelDef = voxelGrid.getVoxelDef(voxelID);
+	const VoxelTextureHandles &textureHandles = textures.getHandles(voxelID);
 	const double voxelHeight = ceilingHeight;
 	const double voxelYReal = static_cast<double>(voxelY) * voxelHeight;
 
 	const NewDouble3 absoluteEye = VoxelUtils::coordToNewPoint(camera.eye);
-	const NewInt3 absoluteEyeVoxel = VoxelUtils::coordToNewVoxel(camera.eyeVoxel);
-	const VisibleLightList &visLightList = SoftwareRenderer::getVisibleLightList(
-		visLightLists, voxelX, voxelZ, absoluteEyeVoxel.x, absoluteEyeVoxel.z,
-		voxelGrid.getWidth(), voxelGrid.getDepth(), chunkDistance);
 
 	if (voxelDef.type == VoxelType::Wall)
 	{
 		// Draw inner ceiling, wall, and floor.
-		const VoxelDefinition::WallData &wallData = voxelDef.wall;
-
 		const NewDouble3 farCeilingPoint(
 			farPoint.x,
 			voxelYReal + voxelHeight,
@@ -4704,24 +6952,24 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, SNInt voxelX, int voxelY
 
 		const auto drawRanges = SoftwareRenderer::makeDrawRangeThreePart(
 			nearCeilingPoint, farCeilingPoint, farFloorPoint, nearFloorPoint, camera, frame);
-		const double fadePercent = RendererUtils::getFadingVoxelPercent(
-			voxelX, voxelY, voxelZ, levelData);
+		const double fadePercent = levelSnapshot.getFadingVoxelPercent(
+			voxelX, voxelY, voxelZ);
 
 		// Ceiling.
 		SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), nearPoint, farPoint,
-			nearZ, farZ, -Double3::UnitY, textures.getTexture(wallData.ceilingTextureAssetRef),
+			nearZ, farZ, -Double3::UnitY, textures.getTexture(textureHandles.ceiling),
 			fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 
 		// Wall.
 		const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 			LightContributionCap>(farPoint, visLights, visLightList);
 		SoftwareRenderer::drawPixels(x, drawRanges.at(1), farZ, wallU, 0.0,
-			Constants::JustBelowOne, wallNormal, textures.getTexture(wallData.sideTextureAssetRef),
+			Constants::JustBelowOne, wallNormal, textures.getTexture(textureHandles.primary),
 			fadePercent, wallLightPercent, shadingInfo, occlusion, frame);
 
 		// Floor.
 		SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(2), farPoint, nearPoint,
-			farZ, nearZ, Double3::UnitY, textures.getTexture(wallData.floorTextureAssetRef),
+			farZ, nearZ, Double3::UnitY, textures.getTexture(textureHandles.floor),
 			fadePercent, visLights, visLightList, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == VoxelType::Floor)
@@ -4733,8 +6981,6 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, SNInt voxelX, int voxelY
 		// Draw bottom of ceiling voxel if the camera is below it.
 		if (absoluteEye.y < voxelYReal)
 		{
-			const VoxelDefinition::CeilingData &ceilingData = voxelDef.ceiling;
-
 			const NewDouble3 nearFloorPoint(
 				nearPoint.x,
 				voxelYReal,
@@ -4746,11 +6992,11 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, SNInt voxelX, int voxelY
 
 			const auto drawRange = SoftwareRenderer::makeDrawRange(
 				nearFloorPoint, farFloorPoint, camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = levelSnapshot.getFadingVoxelPercent(
+				voxelX, voxelY, voxelZ);
 
 			SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ,
-				farZ, -Double3::UnitY, textures.getTexture(ceilingData.textureAssetRef), fadePercent,
+				farZ, -Double3::UnitY, textures.getTexture(textureHandles.primary), fadePercent,
 				visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 	}
@@ -4778,12 +7024,12 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, SNInt voxelX, int voxelY
 
 			const auto drawRange = SoftwareRenderer::makeDrawRange(
 				farCeilingPoint, nearCeilingPoint, camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = levelSnapshot.getFadingVoxelPercent(
+				voxelX, voxelY, voxelZ);
 
 			// Ceiling.
 			SoftwareRenderer::drawPerspectivePixels(x, drawRange, farPoint, nearPoint, farZ,
-				nearZ, Double3::UnitY, textures.getTexture(raisedData.ceilingTextureAssetRef), fadePercent,
+				nearZ, Double3::UnitY, textures.getTexture(textureHandles.ceiling), fadePercent,
 				visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 		else if (absoluteEye.y < nearFloorPoint.y)
@@ -4796,12 +7042,12 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, SNInt voxelX, int voxelY
 
 			const auto drawRange = SoftwareRenderer::makeDrawRange(
 				nearFloorPoint, farFloorPoint, camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = levelSnapshot.getFadingVoxelPercent(
+				voxelX, voxelY, voxelZ);
 
 			// Floor.
 			SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ,
-				farZ, -Double3::UnitY, textures.getTexture(raisedData.floorTextureAssetRef), fadePercent,
+				farZ, -Double3::UnitY, textures.getTexture(textureHandles.floor), fadePercent,
 				visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 		else
@@ -4819,24 +7065,24 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, SNInt voxelX, int voxelY
 			const auto drawRanges = SoftwareRenderer::makeDrawRangeThreePart(
 				nearCeilingPoint, farCeilingPoint, farFloorPoint, nearFloorPoint,
 				camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = levelSnapshot.getFadingVoxelPercent(
+				voxelX, voxelY, voxelZ);
 
 			// Ceiling.
 			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), nearPoint, farPoint,
-				nearZ, farZ, -Double3::UnitY, textures.getTexture(raisedData.ceilingTextureAssetRef), fadePercent,
+				nearZ, farZ, -Double3::UnitY, textures.getTexture(textureHandles.ceiling), fadePercent,
 				visLights, visLightList, shadingInfo, occlusion, frame);
 
 			// Wall.
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(farPoint, visLights, visLightList);
 			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(1), farZ, wallU,
-				raisedData.vTop, raisedData.vBottom, wallNormal, textures.getTexture(raisedData.sideTextureAssetRef),
+				raisedData.vTop, raisedData.vBottom, wallNormal, textures.getTexture(textureHandles.primary),
 				wallLightPercent, shadingInfo, occlusion, frame);
 
 			// Floor.
 			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(2), farPoint, nearPoint,
-				farZ, nearZ, Double3::UnitY, textures.getTexture(raisedData.floorTextureAssetRef), fadePercent,
+				farZ, nearZ, Double3::UnitY, textures.getTexture(textureHandles.floor), fadePercent,
 				visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 	}
@@ -4863,13 +7109,13 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, SNInt voxelX, int voxelY
 
 			const auto drawRange = SoftwareRenderer::makeDrawRange(
 				diagTopPoint, diagBottomPoint, camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = levelSnapshot.getFadingVoxelPercent(
+				voxelX, voxelY, voxelZ);
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(hit.point, visLights, visLightList);
 
 			SoftwareRenderer::drawPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
-				Constants::JustBelowOne, hit.normal, textures.getTexture(diagData.textureAssetRef), fadePercent,
+				Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary), fadePercent,
 				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
@@ -4904,7 +7150,7 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, SNInt voxelX, int voxelY
 				LightContributionCap>(hit.point, visLights, visLightList);
 
 			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u,
-				0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(edgeData.textureAssetRef),
+				0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
@@ -4914,7 +7160,7 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, SNInt voxelX, int voxelY
 		const VoxelDefinition::ChasmData &chasmData = voxelDef.chasm;
 
 		const NewInt3 voxel(voxelX, 0, voxelZ);
-		const VoxelInstance *chasmVoxelInst = levelData.tryGetVoxelInstance(voxel, VoxelInstance::Type::Chasm);
+		const VoxelInstance *chasmVoxelInst = levelSnapshot.tryGetVoxelInstance(voxel, VoxelInstance::Type::Chasm);
 		const VoxelInstance::ChasmState *chasmState = (chasmVoxelInst != nullptr) ?
 			&chasmVoxelInst->getChasmState() : nullptr;
 
@@ -4986,13 +7232,13 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, SNInt voxelX, int voxelY
 			const Double3 farNormal = -VoxelUtils::getNormal(farFacing);
 			SoftwareRenderer::drawChasmPixels(x, drawRanges.at(0), farZ, farU, 0.0,
 				Constants::JustBelowOne, farNormal, RendererUtils::isChasmEmissive(chasmData.type),
-				textures.getTexture(chasmData.textureAssetRef), *chasmTexture, wallLightPercent, shadingInfo, occlusion, frame);
+				textures.getTexture(textureHandles.primary), *chasmTexture, wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == VoxelType::Door)
 	{
 		const VoxelDefinition::DoorData &doorData = voxelDef.door;
-		const double percentOpen = RendererUtils::getDoorPercentOpen(voxelX, voxelZ, levelData);
+		const double percentOpen = levelSnapshot.getDoorPercentOpen(voxelX, voxelZ);
 
 		RayHit hit;
 		const bool success = SoftwareRenderer::findInitialDoorIntersection(voxelX, voxelZ,
@@ -5017,7 +7263,7 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, SNInt voxelX, int voxelY
 					LightContributionCap>(hit.point, visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == VoxelDefinition::DoorData::Type::Sliding)
@@ -5037,7 +7283,7 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, SNInt voxelX, int voxelY
 					LightContributionCap>(hit.point, visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == VoxelDefinition::DoorData::Type::Raising)
@@ -5066,7 +7312,7 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, SNInt voxelX, int voxelY
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
 					hit.u, vStart, Constants::JustBelowOne, hit.normal,
-					textures.getTexture(doorData.textureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+					textures.getTexture(textureHandles.primary), wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == VoxelDefinition::DoorData::Type::Splitting)
 			{
@@ -5085,7 +7331,7 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, SNInt voxelX, int voxelY
 					LightContributionCap>(hit.point, visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 		}
@@ -5095,27 +7341,22 @@ void SoftwareRenderer::drawInitialVoxelSameFloor(int x, SNInt voxelX, int voxelY
 void SoftwareRenderer::drawInitialVoxelAbove(int x, SNInt voxelX, int voxelY, WEInt voxelZ,
 	const Camera &camera, const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint,
 	const NewDouble2 &farPoint, double nearZ, double farZ, double wallU, const Double3 &wallNormal,
-	const ShadingInfo &shadingInfo, int chunkDistance, double ceilingHeight, const LevelData &levelData,
-	const BufferView<const VisibleLight> &visLights, const BufferView2D<const VisibleLightList> &visLightLists,
+	const ShadingInfo &shadingInfo, int chunkDistance, double ceilingHeight, const LevelSnapshot &levelSnapshot,
+	const VisibleLightPool &visLights, const VisibleLightList &visLightList,
 	const VoxelTextures &textures, const ChasmTextureGroups &chasmTextureGroups,
 	OcclusionData &occlusion, const FrameView &frame)
 {
-	const auto &voxelGrid = levelData.getVoxelGrid();
+	const auto &voxelGrid = levelSnapshot.getVoxelGrid();
 	const uint16_t voxelID = voxelGrid.getVoxel(voxelX, voxelY, voxelZ);
 	const VoxelDefinition &voxelDef = voxelGrid.getVoxelDef(voxelID);
+	const VoxelTextureHandles &textureHandles = textures.getHandles(voxelID);
 	const double voxelHeight = ceilingHeight;
 	const double voxelYReal = static_cast<double>(voxelY) * voxelHeight;
 
 	const NewDouble3 absoluteEye = VoxelUtils::coordToNewPoint(camera.eye);
-	const NewInt3 absoluteEyeVoxel = VoxelUtils::coordToNewVoxel(camera.eyeVoxel);
-	const VisibleLightList &visLightList = SoftwareRenderer::getVisibleLightList(
-		visLightLists, voxelX, voxelZ, absoluteEyeVoxel.x, absoluteEyeVoxel.z,
-		voxelGrid.getWidth(), voxelGrid.getDepth(), chunkDistance);
 
 	if (voxelDef.type == VoxelType::Wall)
 	{
-		const VoxelDefinition::WallData &wallData = voxelDef.wall;
-
 		const NewDouble3 nearFloorPoint(
 			nearPoint.x,
 			voxelYReal,
@@ -5127,12 +7368,12 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, SNInt voxelX, int voxelY, WE
 
 		const auto drawRange = SoftwareRenderer::makeDrawRange(
 			nearFloorPoint, farFloorPoint, camera, frame);
-		const double fadePercent = RendererUtils::getFadingVoxelPercent(
-			voxelX, voxelY, voxelZ, levelData);
+		const double fadePercent = levelSnapshot.getFadingVoxelPercent(
+			voxelX, voxelY, voxelZ);
 
 		// Floor.
 		SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ,
-			farZ, -Double3::UnitY, textures.getTexture(wallData.floorTextureAssetRef), fadePercent,
+			farZ, -Double3::UnitY, textures.getTexture(textureHandles.floor), fadePercent,
 			visLights, visLightList, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == VoxelType::Floor)
@@ -5142,8 +7383,6 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, SNInt voxelX, int voxelY, WE
 	else if (voxelDef.type == VoxelType::Ceiling)
 	{
 		// Draw bottom of ceiling voxel.
-		const VoxelDefinition::CeilingData &ceilingData = voxelDef.ceiling;
-
 		const NewDouble3 nearFloorPoint(
 			nearPoint.x,
 			voxelYReal,
@@ -5155,11 +7394,11 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, SNInt voxelX, int voxelY, WE
 
 		const auto drawRange = SoftwareRenderer::makeDrawRange(
 			nearFloorPoint, farFloorPoint, camera, frame);
-		const double fadePercent = RendererUtils::getFadingVoxelPercent(
-			voxelX, voxelY, voxelZ, levelData);
+		const double fadePercent = levelSnapshot.getFadingVoxelPercent(
+			voxelX, voxelY, voxelZ);
 
 		SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ,
-			farZ, -Double3::UnitY, textures.getTexture(ceilingData.textureAssetRef), fadePercent,
+			farZ, -Double3::UnitY, textures.getTexture(textureHandles.primary), fadePercent,
 			visLights, visLightList, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == VoxelType::Raised)
@@ -5186,12 +7425,12 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, SNInt voxelX, int voxelY, WE
 
 			const auto drawRange = SoftwareRenderer::makeDrawRange(
 				farCeilingPoint, nearCeilingPoint, camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = levelSnapshot.getFadingVoxelPercent(
+				voxelX, voxelY, voxelZ);
 
 			// Ceiling.
 			SoftwareRenderer::drawPerspectivePixels(x, drawRange, farPoint, nearPoint, farZ,
-				nearZ, Double3::UnitY, textures.getTexture(raisedData.ceilingTextureAssetRef), fadePercent,
+				nearZ, Double3::UnitY, textures.getTexture(textureHandles.ceiling), fadePercent,
 				visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 		else if (absoluteEye.y < nearFloorPoint.y)
@@ -5204,12 +7443,12 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, SNInt voxelX, int voxelY, WE
 
 			const auto drawRange = SoftwareRenderer::makeDrawRange(
 				nearFloorPoint, farFloorPoint, camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = levelSnapshot.getFadingVoxelPercent(
+				voxelX, voxelY, voxelZ);
 
 			// Floor.
 			SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ,
-				farZ, -Double3::UnitY, textures.getTexture(raisedData.floorTextureAssetRef), fadePercent,
+				farZ, -Double3::UnitY, textures.getTexture(textureHandles.floor), fadePercent,
 				visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 		else
@@ -5227,12 +7466,12 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, SNInt voxelX, int voxelY, WE
 			const auto drawRanges = SoftwareRenderer::makeDrawRangeThreePart(
 				nearCeilingPoint, farCeilingPoint, farFloorPoint, nearFloorPoint,
 				camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = levelSnapshot.getFadingVoxelPercent(
+				voxelX, voxelY, voxelZ);
 
 			// Ceiling.
 			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), nearPoint, farPoint,
-				nearZ, farZ, -Double3::UnitY, textures.getTexture(raisedData.ceilingTextureAssetRef), fadePercent,
+				nearZ, farZ, -Double3::UnitY, textures.getTexture(textureHandles.ceiling), fadePercent,
 				visLights, visLightList, shadingInfo, occlusion, frame);
 
 			// Wall.
@@ -5240,11 +7479,11 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, SNInt voxelX, int voxelY, WE
 				LightContributionCap>(farPoint, visLights, visLightList);
 			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(1), farZ, wallU,
 				raisedData.vTop, raisedData.vBottom, wallNormal,
-				textures.getTexture(raisedData.sideTextureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+				textures.getTexture(textureHandles.primary), wallLightPercent, shadingInfo, occlusion, frame);
 
 			// Floor.
 			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(2), farPoint, nearPoint,
-				farZ, nearZ, Double3::UnitY, textures.getTexture(raisedData.floorTextureAssetRef), fadePercent,
+				farZ, nearZ, Double3::UnitY, textures.getTexture(textureHandles.floor), fadePercent,
 				visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 	}
@@ -5271,13 +7510,13 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, SNInt voxelX, int voxelY, WE
 
 			const auto drawRange = SoftwareRenderer::makeDrawRange(
 				diagTopPoint, diagBottomPoint, camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = levelSnapshot.getFadingVoxelPercent(
+				voxelX, voxelY, voxelZ);
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(hit.point, visLights, visLightList);
 
 			SoftwareRenderer::drawPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
-				Constants::JustBelowOne, hit.normal, textures.getTexture(diagData.textureAssetRef), fadePercent,
+				Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary), fadePercent,
 				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
@@ -5312,7 +7551,7 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, SNInt voxelX, int voxelY, WE
 				LightContributionCap>(hit.point, visLights, visLightList);
 
 			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u,
-				0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(edgeData.textureAssetRef),
+				0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
@@ -5323,7 +7562,7 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, SNInt voxelX, int voxelY, WE
 	else if (voxelDef.type == VoxelType::Door)
 	{
 		const VoxelDefinition::DoorData &doorData = voxelDef.door;
-		const double percentOpen = RendererUtils::getDoorPercentOpen(voxelX, voxelZ, levelData);
+		const double percentOpen = levelSnapshot.getDoorPercentOpen(voxelX, voxelZ);
 
 		RayHit hit;
 		const bool success = SoftwareRenderer::findInitialDoorIntersection(voxelX, voxelZ,
@@ -5348,7 +7587,7 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, SNInt voxelX, int voxelY, WE
 					LightContributionCap>(hit.point, visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == VoxelDefinition::DoorData::Type::Sliding)
@@ -5368,7 +7607,7 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, SNInt voxelX, int voxelY, WE
 					LightContributionCap>(hit.point, visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == VoxelDefinition::DoorData::Type::Raising)
@@ -5397,7 +7636,7 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, SNInt voxelX, int voxelY, WE
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
 					hit.u, vStart, Constants::JustBelowOne, hit.normal,
-					textures.getTexture(doorData.textureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+					textures.getTexture(textureHandles.primary), wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == VoxelDefinition::DoorData::Type::Splitting)
 			{
@@ -5416,7 +7655,7 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, SNInt voxelX, int voxelY, WE
 					LightContributionCap>(hit.point, visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 		}
@@ -5426,27 +7665,22 @@ void SoftwareRenderer::drawInitialVoxelAbove(int x, SNInt voxelX, int voxelY, WE
 void SoftwareRenderer::drawInitialVoxelBelow(int x, SNInt voxelX, int voxelY, WEInt voxelZ,
 	const Camera &camera, const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint,
 	const NewDouble2 &farPoint, double nearZ, double farZ, double wallU, const Double3 &wallNormal,
-	const ShadingInfo &shadingInfo, int chunkDistance, double ceilingHeight, const LevelData &levelData,
-	const BufferView<const VisibleLight> &visLights, const BufferView2D<const VisibleLightList> &visLightLists,
+	const ShadingInfo &shadingInfo, int chunkDistance, double ceilingHeight, const LevelSnapshot &levelSnapshot,
+	const VisibleLightPool &visLights, const VisibleLightList &visLightList,
 	const VoxelTextures &textures, const ChasmTextureGroups &chasmTextureGroups,
 	OcclusionData &occlusion, const FrameView &frame)
 {
-	const auto &voxelGrid = levelData.getVoxelGrid();
+	const auto &voxelGrid = levelSnapshot.getVoxelGrid();
 	const uint16_t voxelID = voxelGrid.getVoxel(voxelX, voxelY, voxelZ);
 	const VoxelDefinition &voxelDef = voxelGrid.getVoxelDef(voxelID);
+	const VoxelTextureHandles &textureHandles = textures.getHandles(voxelID);
 	const double voxelHeight = ceilingHeight;
 	const double voxelYReal = static_cast<double>(voxelY) * voxelHeight;
 
 	const NewDouble3 absoluteEye = VoxelUtils::coordToNewPoint(camera.eye);
-	const NewInt3 absoluteEyeVoxel = VoxelUtils::coordToNewVoxel(camera.eyeVoxel);
-	const VisibleLightList &visLightList = SoftwareRenderer::getVisibleLightList(
-		visLightLists, voxelX, voxelZ, absoluteEyeVoxel.x, absoluteEyeVoxel.z,
-		voxelGrid.getWidth(), voxelGrid.getDepth(), chunkDistance);
 
 	if (voxelDef.type == VoxelType::Wall)
 	{
-		const VoxelDefinition::WallData &wallData = voxelDef.wall;
-
 		const NewDouble3 farCeilingPoint(
 			farPoint.x,
 			voxelYReal + voxelHeight,
@@ -5458,19 +7692,17 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, SNInt voxelX, int voxelY, WE
 
 		const auto drawRange = SoftwareRenderer::makeDrawRange(
 			farCeilingPoint, nearCeilingPoint, camera, frame);
-		const double fadePercent = RendererUtils::getFadingVoxelPercent(
-			voxelX, voxelY, voxelZ, levelData);
+		const double fadePercent = levelSnapshot.getFadingVoxelPercent(
+			voxelX, voxelY, voxelZ);
 
 		// Ceiling.
 		SoftwareRenderer::drawPerspectivePixels(x, drawRange, farPoint, nearPoint, farZ,
-			nearZ, Double3::UnitY, textures.getTexture(wallData.ceilingTextureAssetRef), fadePercent,
+			nearZ, Double3::UnitY, textures.getTexture(textureHandles.ceiling), fadePercent,
 			visLights, visLightList, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == VoxelType::Floor)
 	{
 		// Draw top of floor voxel.
-		const VoxelDefinition::FloorData &floorData = voxelDef.floor;
-
 		const NewDouble3 farCeilingPoint(
 			farPoint.x,
 			voxelYReal + voxelHeight,
@@ -5482,12 +7714,12 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, SNInt voxelX, int voxelY, WE
 
 		const auto drawRange = SoftwareRenderer::makeDrawRange(
 			farCeilingPoint, nearCeilingPoint, camera, frame);
-		const double fadePercent = RendererUtils::getFadingVoxelPercent(
-			voxelX, voxelY, voxelZ, levelData);
+		const double fadePercent = levelSnapshot.getFadingVoxelPercent(
+			voxelX, voxelY, voxelZ);
 
 		// Ceiling.
 		SoftwareRenderer::drawPerspectivePixels(x, drawRange, farPoint, nearPoint, farZ,
-			nearZ, Double3::UnitY, textures.getTexture(floorData.textureAssetRef), fadePercent,
+			nearZ, Double3::UnitY, textures.getTexture(textureHandles.primary), fadePercent,
 			visLights, visLightList, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == VoxelType::Ceiling)
@@ -5518,12 +7750,12 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, SNInt voxelX, int voxelY, WE
 
 			const auto drawRange = SoftwareRenderer::makeDrawRange(
 				farCeilingPoint, nearCeilingPoint, camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = levelSnapshot.getFadingVoxelPercent(
+				voxelX, voxelY, voxelZ);
 
 			// Ceiling.
 			SoftwareRenderer::drawPerspectivePixels(x, drawRange, farPoint, nearPoint, farZ,
-				nearZ, Double3::UnitY, textures.getTexture(raisedData.ceilingTextureAssetRef), fadePercent,
+				nearZ, Double3::UnitY, textures.getTexture(textureHandles.ceiling), fadePercent,
 				visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 		else if (absoluteEye.y < nearFloorPoint.y)
@@ -5536,12 +7768,12 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, SNInt voxelX, int voxelY, WE
 
 			const auto drawRange = SoftwareRenderer::makeDrawRange(
 				nearFloorPoint, farFloorPoint, camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = levelSnapshot.getFadingVoxelPercent(
+				voxelX, voxelY, voxelZ);
 
 			// Floor.
 			SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ,
-				farZ, -Double3::UnitY, textures.getTexture(raisedData.floorTextureAssetRef), fadePercent,
+				farZ, -Double3::UnitY, textures.getTexture(textureHandles.floor), fadePercent,
 				visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 		else
@@ -5559,12 +7791,12 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, SNInt voxelX, int voxelY, WE
 			const auto drawRanges = SoftwareRenderer::makeDrawRangeThreePart(
 				nearCeilingPoint, farCeilingPoint, farFloorPoint, nearFloorPoint,
 				camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = levelSnapshot.getFadingVoxelPercent(
+				voxelX, voxelY, voxelZ);
 
 			// Ceiling.
 			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), nearPoint, farPoint,
-				nearZ, farZ, -Double3::UnitY, textures.getTexture(raisedData.ceilingTextureAssetRef), fadePercent,
+				nearZ, farZ, -Double3::UnitY, textures.getTexture(textureHandles.ceiling), fadePercent,
 				visLights, visLightList, shadingInfo, occlusion, frame);
 
 			// Wall.
@@ -5572,11 +7804,11 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, SNInt voxelX, int voxelY, WE
 				LightContributionCap>(farPoint, visLights, visLightList);
 			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(1), farZ, wallU,
 				raisedData.vTop, raisedData.vBottom, wallNormal,
-				textures.getTexture(raisedData.sideTextureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+				textures.getTexture(textureHandles.primary), wallLightPercent, shadingInfo, occlusion, frame);
 
 			// Floor.
 			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(2), farPoint, nearPoint,
-				farZ, nearZ, Double3::UnitY, textures.getTexture(raisedData.floorTextureAssetRef), fadePercent,
+				farZ, nearZ, Double3::UnitY, textures.getTexture(textureHandles.floor), fadePercent,
 				visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 	}
@@ -5603,13 +7835,13 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, SNInt voxelX, int voxelY, WE
 
 			const auto drawRange = SoftwareRenderer::makeDrawRange(
 				diagTopPoint, diagBottomPoint, camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = levelSnapshot.getFadingVoxelPercent(
+				voxelX, voxelY, voxelZ);
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(hit.point, visLights, visLightList);
 
 			SoftwareRenderer::drawPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
-				Constants::JustBelowOne, hit.normal, textures.getTexture(diagData.textureAssetRef), fadePercent,
+				Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary), fadePercent,
 				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
@@ -5644,7 +7876,7 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, SNInt voxelX, int voxelY, WE
 				LightContributionCap>(hit.point, visLights, visLightList);
 
 			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u,
-				0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(edgeData.textureAssetRef),
+				0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
@@ -5654,7 +7886,7 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, SNInt voxelX, int voxelY, WE
 		const VoxelDefinition::ChasmData &chasmData = voxelDef.chasm;
 
 		const NewInt3 voxel(voxelX, 0, voxelZ);
-		const VoxelInstance *chasmVoxelInst = levelData.tryGetVoxelInstance(voxel, VoxelInstance::Type::Chasm);
+		const VoxelInstance *chasmVoxelInst = levelSnapshot.tryGetVoxelInstance(voxel, VoxelInstance::Type::Chasm);
 		const VoxelInstance::ChasmState *chasmState = (chasmVoxelInst != nullptr) ?
 			&chasmVoxelInst->getChasmState() : nullptr;
 
@@ -5726,13 +7958,13 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, SNInt voxelX, int voxelY, WE
 			const Double3 farNormal = -VoxelUtils::getNormal(farFacing);
 			SoftwareRenderer::drawChasmPixels(x, drawRanges.at(0), farZ, farU, 0.0,
 				Constants::JustBelowOne, farNormal, RendererUtils::isChasmEmissive(chasmData.type),
-				textures.getTexture(chasmData.textureAssetRef), *chasmTexture, wallLightPercent, shadingInfo, occlusion, frame);
+				textures.getTexture(textureHandles.primary), *chasmTexture, wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == VoxelType::Door)
 	{
 		const VoxelDefinition::DoorData &doorData = voxelDef.door;
-		const double percentOpen = RendererUtils::getDoorPercentOpen(voxelX, voxelZ, levelData);
+		const double percentOpen = levelSnapshot.getDoorPercentOpen(voxelX, voxelZ);
 
 		RayHit hit;
 		const bool success = SoftwareRenderer::findInitialDoorIntersection(voxelX, voxelZ,
@@ -5757,7 +7989,7 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, SNInt voxelX, int voxelY, WE
 					LightContributionCap>(hit.point, visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == VoxelDefinition::DoorData::Type::Sliding)
@@ -5777,7 +8009,7 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, SNInt voxelX, int voxelY, WE
 					LightContributionCap>(hit.point, visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == VoxelDefinition::DoorData::Type::Raising)
@@ -5806,7 +8038,7 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, SNInt voxelX, int voxelY, WE
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
 					hit.u, vStart, Constants::JustBelowOne, hit.normal,
-					textures.getTexture(doorData.textureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+					textures.getTexture(textureHandles.primary), wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == VoxelDefinition::DoorData::Type::Splitting)
 			{
@@ -5825,7 +8057,7 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, SNInt voxelX, int voxelY, WE
 					LightContributionCap>(hit.point, visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 		}
@@ -5835,8 +8067,8 @@ void SoftwareRenderer::drawInitialVoxelBelow(int x, SNInt voxelX, int voxelY, WE
 void SoftwareRenderer::drawInitialVoxelColumn(int x, SNInt voxelX, WEInt voxelZ, const Camera &camera,
 	const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint,
 	double nearZ, double farZ, const ShadingInfo &shadingInfo, int chunkDistance, double ceilingHeight,
-	const LevelData &levelData, const BufferView<const VisibleLight> &visLights,
-	const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &textures,
+	const LevelSnapshot &levelSnapshot, const VisibleLightPool &visLights,
+	const VisibleLightList &visLightList, const VoxelTextures &textures,
 	const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame)
 {
 	// This method handles some special cases such as drawing the back-faces of wall sides.
@@ -5882,50 +8114,47 @@ void SoftwareRenderer::drawInitialVoxelColumn(int x, SNInt voxelX, WEInt voxelZ,
 	// Draw the player's current voxel first.
 	SoftwareRenderer::drawInitialVoxelSameFloor(x, voxelX, adjustedVoxelY, voxelZ, camera, ray, facing,
 		nearPoint, farPoint, nearZ, farZ, wallU, wallNormal, shadingInfo, chunkDistance, ceilingHeight,
-		levelData, visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
+		levelSnapshot, visLights, visLightList, textures, chasmTextureGroups, occlusion, frame);
 
 	// Draw voxels below the player's voxel.
 	for (int voxelY = (adjustedVoxelY - 1); voxelY >= 0; voxelY--)
 	{
 		SoftwareRenderer::drawInitialVoxelBelow(x, voxelX, voxelY, voxelZ, camera, ray, facing, nearPoint,
-			farPoint, nearZ, farZ, wallU, wallNormal, shadingInfo, chunkDistance, ceilingHeight, levelData,
-			visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
+			farPoint, nearZ, farZ, wallU, wallNormal, shadingInfo, chunkDistance, ceilingHeight, levelSnapshot,
+			visLights, visLightList, textures, chasmTextureGroups, occlusion, frame);
 	}
 
 	// Draw voxels above the player's voxel.
-	const auto &voxelGrid = levelData.getVoxelGrid();
+	const auto &voxelGrid = levelSnapshot.getVoxelGrid();
 	for (int voxelY = (adjustedVoxelY + 1); voxelY < voxelGrid.getHeight(); voxelY++)
 	{
 		SoftwareRenderer::drawInitialVoxelAbove(x, voxelX, voxelY, voxelZ, camera, ray, facing, nearPoint,
-			farPoint, nearZ, farZ, wallU, wallNormal, shadingInfo, chunkDistance, ceilingHeight, levelData,
-			visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
+			farPoint, nearZ, farZ, wallU, wallNormal, shadingInfo, chunkDistance, ceilingHeight, levelSnapshot,
+			visLights, visLightList, textures, chasmTextureGroups, occlusion, frame);
 	}
 }
 
-void SoftwareRenderer::drawVoxelSameFloor(int x, SNInt voxelX, int voxelY, WEInt voxelZ, const Camera &camera,
+void SoftwareRenderer::drawVoxelSameFloor(int x, VoxelColumn &column, int voxelY, const Camera &camera,
 	const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint, double nearZ,
 	double farZ, double wallU, const Double3 &wallNormal, const ShadingInfo &shadingInfo, int chunkDistance,
-	double ceilingHeight, const LevelData &levelData, const BufferView<const VisibleLight> &visLights,
-	const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &textures,
+	double ceilingHeight, const LevelSnapshot &levelSnapshot, const VisibleLightPool &visLights,
+	const VisibleLightList &visLightList, const VoxelTextures &textures,
 	const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame)
 {
-	const auto &voxelGrid = levelData.getVoxelGrid();
-	const uint16_t voxelID = voxelGrid.getVoxel(voxelX, voxelY, voxelZ);
+	const auto &voxelGrid = levelSnapshot.getVoxelGrid();
+	const SNInt voxelX = column.x;
+	const WEInt voxelZ = column.z;
+	const uint16_t voxelID = column.getVoxelID(voxelY, voxelGrid);
 	const VoxelDefinition &voxelDef = voxelGrid.getVoxelDef(voxelID);
+	const VoxelTextureHandles &textureHandles = textures.getHandles(voxelID);
 	const double voxelHeight = ceilingHeight;
 	const double voxelYReal = static_cast<double>(voxelY) * voxelHeight;
 	
 	const NewDouble3 absoluteEye = VoxelUtils::coordToNewPoint(camera.eye);
-	const NewInt3 absoluteEyeVoxel = VoxelUtils::coordToNewVoxel(camera.eyeVoxel);
-	const VisibleLightList &visLightList = SoftwareRenderer::getVisibleLightList(
-		visLightLists, voxelX, voxelZ, absoluteEyeVoxel.x, absoluteEyeVoxel.z,
-		voxelGrid.getWidth(), voxelGrid.getDepth(), chunkDistance);
 
 	if (voxelDef.type == VoxelType::Wall)
 	{
 		// Draw side.
-		const VoxelDefinition::WallData &wallData = voxelDef.wall;
-
 		const NewDouble3 nearCeilingPoint(
 			nearPoint.x,
 			voxelYReal + voxelHeight,
@@ -5937,13 +8166,12 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, SNInt voxelX, int voxelY, WEInt
 
 		const auto drawRange = SoftwareRenderer::makeDrawRange(
 			nearCeilingPoint, nearFloorPoint, camera, frame);
-		const double fadePercent = RendererUtils::getFadingVoxelPercent(
-			voxelX, voxelY, voxelZ, levelData);
+		const double fadePercent = column.getFadePercent(voxelY, levelSnapshot);
 		const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 			LightContributionCap>(nearPoint, visLights, visLightList);
 
 		SoftwareRenderer::drawPixels(x, drawRange, nearZ, wallU, 0.0,
-			Constants::JustBelowOne, wallNormal, textures.getTexture(wallData.sideTextureAssetRef), fadePercent,
+			Constants::JustBelowOne, wallNormal, textures.getTexture(textureHandles.primary), fadePercent,
 			wallLightPercent, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == VoxelType::Floor)
@@ -5955,8 +8183,6 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, SNInt voxelX, int voxelY, WEInt
 		// Draw bottom of ceiling voxel if the camera is below it.
 		if (absoluteEye.y < voxelYReal)
 		{
-			const VoxelDefinition::CeilingData &ceilingData = voxelDef.ceiling;
-
 			const NewDouble3 nearFloorPoint(
 				nearPoint.x,
 				voxelYReal,
@@ -5968,11 +8194,10 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, SNInt voxelX, int voxelY, WEInt
 
 			const auto drawRange = SoftwareRenderer::makeDrawRange(
 				nearFloorPoint, farFloorPoint, camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = column.getFadePercent(voxelY, levelSnapshot);
 
 			SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ,
-				farZ, -Double3::UnitY, textures.getTexture(ceilingData.textureAssetRef), fadePercent,
+				farZ, -Double3::UnitY, textures.getTexture(textureHandles.primary), fadePercent,
 				visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 	}
@@ -6000,12 +8225,11 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, SNInt voxelX, int voxelY, WEInt
 
 			const auto drawRanges = SoftwareRenderer::makeDrawRangeTwoPart(
 				farCeilingPoint, nearCeilingPoint, nearFloorPoint, camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = column.getFadePercent(voxelY, levelSnapshot);
 
 			// Ceiling.
 			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), farPoint, nearPoint,
-				farZ, nearZ, Double3::UnitY, textures.getTexture(raisedData.ceilingTextureAssetRef), fadePercent,
+				farZ, nearZ, Double3::UnitY, textures.getTexture(textureHandles.ceiling), fadePercent,
 				visLights, visLightList, shadingInfo, occlusion, frame);
 
 			// Wall.
@@ -6013,7 +8237,7 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, SNInt voxelX, int voxelY, WEInt
 				LightContributionCap>(nearPoint, visLights, visLightList);
 			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(1), nearZ, wallU,
 				raisedData.vTop, raisedData.vBottom, wallNormal,
-				textures.getTexture(raisedData.sideTextureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+				textures.getTexture(textureHandles.primary), wallLightPercent, shadingInfo, occlusion, frame);
 		}
 		else if (absoluteEye.y < nearFloorPoint.y)
 		{
@@ -6025,19 +8249,18 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, SNInt voxelX, int voxelY, WEInt
 
 			const auto drawRanges = SoftwareRenderer::makeDrawRangeTwoPart(
 				nearCeilingPoint, nearFloorPoint, farFloorPoint, camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = column.getFadePercent(voxelY, levelSnapshot);
 
 			// Wall.
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(nearPoint, visLights, visLightList);
 			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(0), nearZ, wallU,
 				raisedData.vTop, raisedData.vBottom, wallNormal,
-				textures.getTexture(raisedData.sideTextureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+				textures.getTexture(textureHandles.primary), wallLightPercent, shadingInfo, occlusion, frame);
 
 			// Floor.
 			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(1), nearPoint, farPoint,
-				nearZ, farZ, -Double3::UnitY, textures.getTexture(raisedData.floorTextureAssetRef), fadePercent,
+				nearZ, farZ, -Double3::UnitY, textures.getTexture(textureHandles.floor), fadePercent,
 				visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 		else
@@ -6050,7 +8273,7 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, SNInt voxelX, int voxelY, WEInt
 
 			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, wallU,
 				raisedData.vTop, raisedData.vBottom, wallNormal,
-				textures.getTexture(raisedData.sideTextureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+				textures.getTexture(textureHandles.primary), wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == VoxelType::Diagonal)
@@ -6076,21 +8299,18 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, SNInt voxelX, int voxelY, WEInt
 
 			const auto drawRange = SoftwareRenderer::makeDrawRange(
 				diagTopPoint, diagBottomPoint, camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = column.getFadePercent(voxelY, levelSnapshot);
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(hit.point, visLights, visLightList);
 
 			SoftwareRenderer::drawPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
-				Constants::JustBelowOne, hit.normal, textures.getTexture(diagData.textureAssetRef), fadePercent,
+				Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary), fadePercent,
 				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == VoxelType::TransparentWall)
 	{
 		// Draw transparent side.
-		const VoxelDefinition::TransparentWallData &transparentWallData = voxelDef.transparentWall;
-
 		const NewDouble3 nearCeilingPoint(
 			nearPoint.x,
 			voxelYReal + voxelHeight,
@@ -6106,7 +8326,7 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, SNInt voxelX, int voxelY, WEInt
 			LightContributionCap>(nearPoint, visLights, visLightList);
 
 		SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, wallU, 0.0,
-			Constants::JustBelowOne, wallNormal, textures.getTexture(transparentWallData.textureAssetRef),
+			Constants::JustBelowOne, wallNormal, textures.getTexture(textureHandles.primary),
 			wallLightPercent, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == VoxelType::Edge)
@@ -6136,7 +8356,7 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, SNInt voxelX, int voxelY, WEInt
 				LightContributionCap>(hit.point, visLights, visLightList);
 
 			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u,
-				0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(edgeData.textureAssetRef),
+				0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
@@ -6146,7 +8366,7 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, SNInt voxelX, int voxelY, WEInt
 		const VoxelDefinition::ChasmData &chasmData = voxelDef.chasm;
 
 		const NewInt3 voxel(voxelX, 0, voxelZ);
-		const VoxelInstance *chasmVoxelInst = levelData.tryGetVoxelInstance(voxel, VoxelInstance::Type::Chasm);
+		const VoxelInstance *chasmVoxelInst = levelSnapshot.tryGetVoxelInstance(voxel, VoxelInstance::Type::Chasm);
 		const VoxelInstance::ChasmState *chasmState = (chasmVoxelInst != nullptr) ?
 			&chasmVoxelInst->getChasmState() : nullptr;
 
@@ -6193,7 +8413,7 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, SNInt voxelX, int voxelY, WEInt
 
 			SoftwareRenderer::drawChasmPixels(x, drawRange, nearZ, nearU, 0.0,
 				Constants::JustBelowOne, nearNormal, RendererUtils::isChasmEmissive(chasmData.type),
-				textures.getTexture(chasmData.textureAssetRef), *chasmTexture, wallLightPercent, shadingInfo, occlusion, frame);
+				textures.getTexture(textureHandles.primary), *chasmTexture, wallLightPercent, shadingInfo, occlusion, frame);
 		}
 
 		const auto drawRanges = SoftwareRenderer::makeDrawRangeTwoPart(
@@ -6239,13 +8459,13 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, SNInt voxelX, int voxelY, WEInt
 			const Double3 farNormal = -VoxelUtils::getNormal(farFacing);
 			SoftwareRenderer::drawChasmPixels(x, drawRanges.at(0), farZ, farU, 0.0,
 				Constants::JustBelowOne, farNormal, RendererUtils::isChasmEmissive(chasmData.type),
-				textures.getTexture(chasmData.textureAssetRef), *chasmTexture, wallLightPercent, shadingInfo, occlusion, frame);
+				textures.getTexture(textureHandles.primary), *chasmTexture, wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == VoxelType::Door)
 	{
 		const VoxelDefinition::DoorData &doorData = voxelDef.door;
-		const double percentOpen = RendererUtils::getDoorPercentOpen(voxelX, voxelZ, levelData);
+		const double percentOpen = levelSnapshot.getDoorPercentOpen(voxelX, voxelZ);
 
 		RayHit hit;
 		const bool success = SoftwareRenderer::findDoorIntersection(voxelX, voxelZ,
@@ -6270,7 +8490,7 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, SNInt voxelX, int voxelY, WEInt
 					LightContributionCap>(hit.point, visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == VoxelDefinition::DoorData::Type::Sliding)
@@ -6290,7 +8510,7 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, SNInt voxelX, int voxelY, WEInt
 					LightContributionCap>(hit.point, visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, hit.u, 0.0,
-					Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == VoxelDefinition::DoorData::Type::Raising)
@@ -6318,7 +8538,7 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, SNInt voxelX, int voxelY, WEInt
 					LightContributionCap>(hit.point, visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, hit.u, vStart,
-					Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef), wallLightPercent,
+					Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary), wallLightPercent,
 					shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == VoxelDefinition::DoorData::Type::Splitting)
@@ -6338,36 +8558,33 @@ void SoftwareRenderer::drawVoxelSameFloor(int x, SNInt voxelX, int voxelY, WEInt
 					LightContributionCap>(hit.point, visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, hit.u, 0.0,
-					Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 		}
 	}
 }
 
-void SoftwareRenderer::drawVoxelAbove(int x, SNInt voxelX, int voxelY, WEInt voxelZ, const Camera &camera,
+void SoftwareRenderer::drawVoxelAbove(int x, VoxelColumn &column, int voxelY, const Camera &camera,
 	const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint, double nearZ,
 	double farZ, double wallU, const Double3 &wallNormal, const ShadingInfo &shadingInfo, int chunkDistance,
-	double ceilingHeight, const LevelData &levelData, const BufferView<const VisibleLight> &visLights,
-	const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &textures,
+	double ceilingHeight, const LevelSnapshot &levelSnapshot, const VisibleLightPool &visLights,
+	const VisibleLightList &visLightList, const VoxelTextures &textures,
 	const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame)
 {
-	const auto &voxelGrid = levelData.getVoxelGrid();
-	const uint16_t voxelID = voxelGrid.getVoxel(voxelX, voxelY, voxelZ);
+	const auto &voxelGrid = levelSnapshot.getVoxelGrid();
+	const SNInt voxelX = column.x;
+	const WEInt voxelZ = column.z;
+	const uint16_t voxelID = column.getVoxelID(voxelY, voxelGrid);
 	const VoxelDefinition &voxelDef = voxelGrid.getVoxelDef(voxelID);
+	const VoxelTextureHandles &textureHandles = textures.getHandles(voxelID);
 	const double voxelHeight = ceilingHeight;
 	const double voxelYReal = static_cast<double>(voxelY) * voxelHeight;
 
 	const NewDouble3 absoluteEye = VoxelUtils::coordToNewPoint(camera.eye);
-	const NewInt3 absoluteEyeVoxel = VoxelUtils::coordToNewVoxel(camera.eyeVoxel);
-	const VisibleLightList &visLightList = SoftwareRenderer::getVisibleLightList(
-		visLightLists, voxelX, voxelZ, absoluteEyeVoxel.x, absoluteEyeVoxel.z,
-		voxelGrid.getWidth(), voxelGrid.getDepth(), chunkDistance);
 
 	if (voxelDef.type == VoxelType::Wall)
 	{
-		const VoxelDefinition::WallData &wallData = voxelDef.wall;
-
 		const NewDouble3 nearCeilingPoint(
 			nearPoint.x,
 			voxelYReal + voxelHeight,
@@ -6383,19 +8600,18 @@ void SoftwareRenderer::drawVoxelAbove(int x, SNInt voxelX, int voxelY, WEInt vox
 
 		const auto drawRanges = SoftwareRenderer::makeDrawRangeTwoPart(
 			nearCeilingPoint, nearFloorPoint, farFloorPoint, camera, frame);
-		const double fadePercent = RendererUtils::getFadingVoxelPercent(
-			voxelX, voxelY, voxelZ, levelData);
+		const double fadePercent = column.getFadePercent(voxelY, levelSnapshot);
 		const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 			LightContributionCap>(nearPoint, visLights, visLightList);
 
 		// Wall.
 		SoftwareRenderer::drawPixels(x, drawRanges.at(0), nearZ, wallU, 0.0,
-			Constants::JustBelowOne, wallNormal, textures.getTexture(wallData.sideTextureAssetRef), fadePercent,
+			Constants::JustBelowOne, wallNormal, textures.getTexture(textureHandles.primary), fadePercent,
 			wallLightPercent, shadingInfo, occlusion, frame);
 
 		// Floor.
 		SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(1), nearPoint, farPoint,
-			nearZ, farZ, -Double3::UnitY, textures.getTexture(wallData.floorTextureAssetRef), fadePercent,
+			nearZ, farZ, -Double3::UnitY, textures.getTexture(textureHandles.floor), fadePercent,
 			visLights, visLightList, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == VoxelType::Floor)
@@ -6405,8 +8621,6 @@ void SoftwareRenderer::drawVoxelAbove(int x, SNInt voxelX, int voxelY, WEInt vox
 	else if (voxelDef.type == VoxelType::Ceiling)
 	{
 		// Draw bottom of ceiling voxel.
-		const VoxelDefinition::CeilingData &ceilingData = voxelDef.ceiling;
-
 		const NewDouble3 nearFloorPoint(
 			nearPoint.x,
 			voxelYReal,
@@ -6418,11 +8632,10 @@ void SoftwareRenderer::drawVoxelAbove(int x, SNInt voxelX, int voxelY, WEInt vox
 
 		const auto drawRange = SoftwareRenderer::makeDrawRange(
 			nearFloorPoint, farFloorPoint, camera, frame);
-		const double fadePercent = RendererUtils::getFadingVoxelPercent(
-			voxelX, voxelY, voxelZ, levelData);
+		const double fadePercent = column.getFadePercent(voxelY, levelSnapshot);
 
 		SoftwareRenderer::drawPerspectivePixels(x, drawRange, nearPoint, farPoint, nearZ,
-			farZ, -Double3::UnitY, textures.getTexture(ceilingData.textureAssetRef), fadePercent,
+			farZ, -Double3::UnitY, textures.getTexture(textureHandles.primary), fadePercent,
 			visLights, visLightList, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == VoxelType::Raised)
@@ -6449,12 +8662,11 @@ void SoftwareRenderer::drawVoxelAbove(int x, SNInt voxelX, int voxelY, WEInt vox
 
 			const auto drawRanges = SoftwareRenderer::makeDrawRangeTwoPart(
 				farCeilingPoint, nearCeilingPoint, nearFloorPoint, camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = column.getFadePercent(voxelY, levelSnapshot);
 
 			// Ceiling.
 			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), farPoint, nearPoint,
-				farZ, nearZ, Double3::UnitY, textures.getTexture(raisedData.ceilingTextureAssetRef), fadePercent,
+				farZ, nearZ, Double3::UnitY, textures.getTexture(textureHandles.ceiling), fadePercent,
 				visLights, visLightList, shadingInfo, occlusion, frame);
 
 			// Wall.
@@ -6462,7 +8674,7 @@ void SoftwareRenderer::drawVoxelAbove(int x, SNInt voxelX, int voxelY, WEInt vox
 				LightContributionCap>(nearPoint, visLights, visLightList);
 			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(1), nearZ, wallU,
 				raisedData.vTop, raisedData.vBottom, wallNormal,
-				textures.getTexture(raisedData.sideTextureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+				textures.getTexture(textureHandles.primary), wallLightPercent, shadingInfo, occlusion, frame);
 		}
 		else if (absoluteEye.y < nearFloorPoint.y)
 		{
@@ -6474,19 +8686,18 @@ void SoftwareRenderer::drawVoxelAbove(int x, SNInt voxelX, int voxelY, WEInt vox
 
 			const auto drawRanges = SoftwareRenderer::makeDrawRangeTwoPart(
 				nearCeilingPoint, nearFloorPoint, farFloorPoint, camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = column.getFadePercent(voxelY, levelSnapshot);
 
 			// Wall.
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(nearPoint, visLights, visLightList);
 			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(0), nearZ, wallU,
 				raisedData.vTop, raisedData.vBottom, wallNormal,
-				textures.getTexture(raisedData.sideTextureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+				textures.getTexture(textureHandles.primary), wallLightPercent, shadingInfo, occlusion, frame);
 
 			// Floor.
 			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(1), nearPoint, farPoint,
-				nearZ, farZ, -Double3::UnitY, textures.getTexture(raisedData.floorTextureAssetRef), fadePercent,
+				nearZ, farZ, -Double3::UnitY, textures.getTexture(textureHandles.floor), fadePercent,
 				visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 		else
@@ -6499,7 +8710,7 @@ void SoftwareRenderer::drawVoxelAbove(int x, SNInt voxelX, int voxelY, WEInt vox
 
 			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, wallU,
 				raisedData.vTop, raisedData.vBottom, wallNormal,
-				textures.getTexture(raisedData.sideTextureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+				textures.getTexture(textureHandles.primary), wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == VoxelType::Diagonal)
@@ -6525,21 +8736,18 @@ void SoftwareRenderer::drawVoxelAbove(int x, SNInt voxelX, int voxelY, WEInt vox
 
 			const auto drawRange = SoftwareRenderer::makeDrawRange(
 				diagTopPoint, diagBottomPoint, camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = column.getFadePercent(voxelY, levelSnapshot);
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(hit.point, visLights, visLightList);
 
 			SoftwareRenderer::drawPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
-				Constants::JustBelowOne, hit.normal, textures.getTexture(diagData.textureAssetRef), fadePercent,
+				Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary), fadePercent,
 				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == VoxelType::TransparentWall)
 	{
 		// Draw transparent side.
-		const VoxelDefinition::TransparentWallData &transparentWallData = voxelDef.transparentWall;
-
 		const NewDouble3 nearCeilingPoint(
 			nearPoint.x,
 			voxelYReal + voxelHeight,
@@ -6555,7 +8763,7 @@ void SoftwareRenderer::drawVoxelAbove(int x, SNInt voxelX, int voxelY, WEInt vox
 			LightContributionCap>(nearPoint, visLights, visLightList);
 
 		SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, wallU, 0.0,
-			Constants::JustBelowOne, wallNormal, textures.getTexture(transparentWallData.textureAssetRef),
+			Constants::JustBelowOne, wallNormal, textures.getTexture(textureHandles.primary),
 			wallLightPercent, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == VoxelType::Edge)
@@ -6585,7 +8793,7 @@ void SoftwareRenderer::drawVoxelAbove(int x, SNInt voxelX, int voxelY, WEInt vox
 				LightContributionCap>(hit.point, visLights, visLightList);
 
 			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u,
-				0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(edgeData.textureAssetRef),
+				0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
@@ -6596,7 +8804,7 @@ void SoftwareRenderer::drawVoxelAbove(int x, SNInt voxelX, int voxelY, WEInt vox
 	else if (voxelDef.type == VoxelType::Door)
 	{
 		const VoxelDefinition::DoorData &doorData = voxelDef.door;
-		const double percentOpen = RendererUtils::getDoorPercentOpen(voxelX, voxelZ, levelData);
+		const double percentOpen = levelSnapshot.getDoorPercentOpen(voxelX, voxelZ);
 
 		RayHit hit;
 		const bool success = SoftwareRenderer::findDoorIntersection(voxelX, voxelZ,
@@ -6621,7 +8829,7 @@ void SoftwareRenderer::drawVoxelAbove(int x, SNInt voxelX, int voxelY, WEInt vox
 					LightContributionCap>(hit.point, visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == VoxelDefinition::DoorData::Type::Sliding)
@@ -6641,7 +8849,7 @@ void SoftwareRenderer::drawVoxelAbove(int x, SNInt voxelX, int voxelY, WEInt vox
 					LightContributionCap>(hit.point, visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, hit.u, 0.0,
-					Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == VoxelDefinition::DoorData::Type::Raising)
@@ -6669,7 +8877,7 @@ void SoftwareRenderer::drawVoxelAbove(int x, SNInt voxelX, int voxelY, WEInt vox
 					LightContributionCap>(hit.point, visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, hit.u, vStart,
-					Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef), wallLightPercent,
+					Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary), wallLightPercent,
 					shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == VoxelDefinition::DoorData::Type::Splitting)
@@ -6689,36 +8897,33 @@ void SoftwareRenderer::drawVoxelAbove(int x, SNInt voxelX, int voxelY, WEInt vox
 					LightContributionCap>(hit.point, visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, hit.u, 0.0,
-					Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 		}
 	}
 }
 
-void SoftwareRenderer::drawVoxelBelow(int x, SNInt voxelX, int voxelY, WEInt voxelZ, const Camera &camera,
+void SoftwareRenderer::drawVoxelBelow(int x, VoxelColumn &column, int voxelY, const Camera &camera,
 	const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint, double nearZ,
 	double farZ, double wallU, const Double3 &wallNormal, const ShadingInfo &shadingInfo, int chunkDistance,
-	double ceilingHeight, const LevelData &levelData, const BufferView<const VisibleLight> &visLights,
-	const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &textures,
+	double ceilingHeight, const LevelSnapshot &levelSnapshot, const VisibleLightPool &visLights,
+	const VisibleLightList &visLightList, const VoxelTextures &textures,
 	const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame)
 {
-	const auto &voxelGrid = levelData.getVoxelGrid();
-	const uint16_t voxelID = voxelGrid.getVoxel(voxelX, voxelY, voxelZ);
+	const auto &voxelGrid = levelSnapshot.getVoxelGrid();
+	const SNInt voxelX = column.x;
+	const WEInt voxelZ = column.z;
+	const uint16_t voxelID = column.getVoxelID(voxelY, voxelGrid);
 	const VoxelDefinition &voxelDef = voxelGrid.getVoxelDef(voxelID);
+	const VoxelTextureHandles &textureHandles = textures.getHandles(voxelID);
 	const double voxelHeight = ceilingHeight;
 	const double voxelYReal = static_cast<double>(voxelY) * voxelHeight;
 
 	const NewDouble3 absoluteEye = VoxelUtils::coordToNewPoint(camera.eye);
-	const NewInt3 absoluteEyeVoxel = VoxelUtils::coordToNewVoxel(camera.eyeVoxel);
-	const VisibleLightList &visLightList = SoftwareRenderer::getVisibleLightList(
-		visLightLists, voxelX, voxelZ, absoluteEyeVoxel.x, absoluteEyeVoxel.z,
-		voxelGrid.getWidth(), voxelGrid.getDepth(), chunkDistance);
 
 	if (voxelDef.type == VoxelType::Wall)
 	{
-		const VoxelDefinition::WallData &wallData = voxelDef.wall;
-
 		const NewDouble3 farCeilingPoint(
 			farPoint.x,
 			voxelYReal + voxelHeight,
@@ -6734,26 +8939,23 @@ void SoftwareRenderer::drawVoxelBelow(int x, SNInt voxelX, int voxelY, WEInt vox
 
 		const auto drawRanges = SoftwareRenderer::makeDrawRangeTwoPart(
 			farCeilingPoint, nearCeilingPoint, nearFloorPoint, camera, frame);
-		const double fadePercent = RendererUtils::getFadingVoxelPercent(
-			voxelX, voxelY, voxelZ, levelData);
+		const double fadePercent = column.getFadePercent(voxelY, levelSnapshot);
 
 		// Ceiling.
 		SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), farPoint, nearPoint, farZ,
-			nearZ, Double3::UnitY, textures.getTexture(wallData.ceilingTextureAssetRef), fadePercent,
+			nearZ, Double3::UnitY, textures.getTexture(textureHandles.ceiling), fadePercent,
 			visLights, visLightList, shadingInfo, occlusion, frame);
 
 		// Wall.
 		const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 			LightContributionCap>(nearPoint, visLights, visLightList);
 		SoftwareRenderer::drawPixels(x, drawRanges.at(1), nearZ, wallU, 0.0,
-			Constants::JustBelowOne, wallNormal, textures.getTexture(wallData.sideTextureAssetRef), fadePercent,
+			Constants::JustBelowOne, wallNormal, textures.getTexture(textureHandles.primary), fadePercent,
 			wallLightPercent, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == VoxelType::Floor)
 	{
 		// Draw top of floor voxel.
-		const VoxelDefinition::FloorData &floorData = voxelDef.floor;
-
 		const NewDouble3 farCeilingPoint(
 			farPoint.x,
 			voxelYReal + voxelHeight,
@@ -6765,11 +8967,10 @@ void SoftwareRenderer::drawVoxelBelow(int x, SNInt voxelX, int voxelY, WEInt vox
 
 		const auto drawRange = SoftwareRenderer::makeDrawRange(
 			farCeilingPoint, nearCeilingPoint, camera, frame);
-		const double fadePercent = RendererUtils::getFadingVoxelPercent(
-			voxelX, voxelY, voxelZ, levelData);
+		const double fadePercent = column.getFadePercent(voxelY, levelSnapshot);
 
 		SoftwareRenderer::drawPerspectivePixels(x, drawRange, farPoint, nearPoint, farZ,
-			nearZ, Double3::UnitY, textures.getTexture(floorData.textureAssetRef), fadePercent,
+			nearZ, Double3::UnitY, textures.getTexture(textureHandles.primary), fadePercent,
 			visLights, visLightList, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == VoxelType::Ceiling)
@@ -6800,12 +9001,11 @@ void SoftwareRenderer::drawVoxelBelow(int x, SNInt voxelX, int voxelY, WEInt vox
 
 			const auto drawRanges = SoftwareRenderer::makeDrawRangeTwoPart(
 				farCeilingPoint, nearCeilingPoint, nearFloorPoint, camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = column.getFadePercent(voxelY, levelSnapshot);
 
 			// Ceiling.
 			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(0), farPoint, nearPoint,
-				farZ, nearZ, Double3::UnitY, textures.getTexture(raisedData.ceilingTextureAssetRef), fadePercent,
+				farZ, nearZ, Double3::UnitY, textures.getTexture(textureHandles.ceiling), fadePercent,
 				visLights, visLightList, shadingInfo, occlusion, frame);
 
 			// Wall.
@@ -6813,7 +9013,7 @@ void SoftwareRenderer::drawVoxelBelow(int x, SNInt voxelX, int voxelY, WEInt vox
 				LightContributionCap>(nearPoint, visLights, visLightList);
 			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(1), nearZ, wallU,
 				raisedData.vTop, raisedData.vBottom, wallNormal,
-				textures.getTexture(raisedData.sideTextureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+				textures.getTexture(textureHandles.primary), wallLightPercent, shadingInfo, occlusion, frame);
 		}
 		else if (absoluteEye.y < nearFloorPoint.y)
 		{
@@ -6825,19 +9025,18 @@ void SoftwareRenderer::drawVoxelBelow(int x, SNInt voxelX, int voxelY, WEInt vox
 
 			const auto drawRanges = SoftwareRenderer::makeDrawRangeTwoPart(
 				nearCeilingPoint, nearFloorPoint, farFloorPoint, camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = column.getFadePercent(voxelY, levelSnapshot);
 
 			// Wall.
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(nearPoint, visLights, visLightList);
 			SoftwareRenderer::drawTransparentPixels(x, drawRanges.at(0), nearZ, wallU,
 				raisedData.vTop, raisedData.vBottom, wallNormal,
-				textures.getTexture(raisedData.sideTextureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+				textures.getTexture(textureHandles.primary), wallLightPercent, shadingInfo, occlusion, frame);
 
 			// Floor.
 			SoftwareRenderer::drawPerspectivePixels(x, drawRanges.at(1), nearPoint, farPoint,
-				nearZ, farZ, -Double3::UnitY, textures.getTexture(raisedData.floorTextureAssetRef), fadePercent,
+				nearZ, farZ, -Double3::UnitY, textures.getTexture(textureHandles.floor), fadePercent,
 				visLights, visLightList, shadingInfo, occlusion, frame);
 		}
 		else
@@ -6850,7 +9049,7 @@ void SoftwareRenderer::drawVoxelBelow(int x, SNInt voxelX, int voxelY, WEInt vox
 
 			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, wallU,
 				raisedData.vTop, raisedData.vBottom, wallNormal,
-				textures.getTexture(raisedData.sideTextureAssetRef), wallLightPercent, shadingInfo, occlusion, frame);
+				textures.getTexture(textureHandles.primary), wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == VoxelType::Diagonal)
@@ -6876,21 +9075,18 @@ void SoftwareRenderer::drawVoxelBelow(int x, SNInt voxelX, int voxelY, WEInt vox
 
 			const auto drawRange = SoftwareRenderer::makeDrawRange(
 				diagTopPoint, diagBottomPoint, camera, frame);
-			const double fadePercent = RendererUtils::getFadingVoxelPercent(
-				voxelX, voxelY, voxelZ, levelData);
+			const double fadePercent = column.getFadePercent(voxelY, levelSnapshot);
 			const double wallLightPercent = SoftwareRenderer::getLightContributionAtPoint<
 				LightContributionCap>(hit.point, visLights, visLightList);
 
 			SoftwareRenderer::drawPixels(x, drawRange, nearZ + hit.innerZ, hit.u, 0.0,
-				Constants::JustBelowOne, hit.normal, textures.getTexture(diagData.textureAssetRef), fadePercent,
+				Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary), fadePercent,
 				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == VoxelType::TransparentWall)
 	{
 		// Draw transparent side.
-		const VoxelDefinition::TransparentWallData &transparentWallData = voxelDef.transparentWall;
-
 		const NewDouble3 nearCeilingPoint(
 			nearPoint.x,
 			voxelYReal + voxelHeight,
@@ -6906,7 +9102,7 @@ void SoftwareRenderer::drawVoxelBelow(int x, SNInt voxelX, int voxelY, WEInt vox
 			LightContributionCap>(nearPoint, visLights, visLightList);
 
 		SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, wallU, 0.0,
-			Constants::JustBelowOne, wallNormal, textures.getTexture(transparentWallData.textureAssetRef),
+			Constants::JustBelowOne, wallNormal, textures.getTexture(textureHandles.primary),
 			wallLightPercent, shadingInfo, occlusion, frame);
 	}
 	else if (voxelDef.type == VoxelType::Edge)
@@ -6936,7 +9132,7 @@ void SoftwareRenderer::drawVoxelBelow(int x, SNInt voxelX, int voxelY, WEInt vox
 				LightContributionCap>(hit.point, visLights, visLightList);
 
 			SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ, hit.u,
-				0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(edgeData.textureAssetRef),
+				0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 				wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
@@ -6946,7 +9142,7 @@ void SoftwareRenderer::drawVoxelBelow(int x, SNInt voxelX, int voxelY, WEInt vox
 		const VoxelDefinition::ChasmData &chasmData = voxelDef.chasm;
 
 		const NewInt3 voxel(voxelX, 0, voxelZ);
-		const VoxelInstance *chasmVoxelInst = levelData.tryGetVoxelInstance(voxel, VoxelInstance::Type::Chasm);
+		const VoxelInstance *chasmVoxelInst = levelSnapshot.tryGetVoxelInstance(voxel, VoxelInstance::Type::Chasm);
 		const VoxelInstance::ChasmState *chasmState = (chasmVoxelInst != nullptr) ?
 			&chasmVoxelInst->getChasmState() : nullptr;
 
@@ -6993,7 +9189,7 @@ void SoftwareRenderer::drawVoxelBelow(int x, SNInt voxelX, int voxelY, WEInt vox
 
 			SoftwareRenderer::drawChasmPixels(x, drawRange, nearZ, nearU, 0.0,
 				Constants::JustBelowOne, nearNormal, RendererUtils::isChasmEmissive(chasmData.type),
-				textures.getTexture(chasmData.textureAssetRef), *chasmTexture, wallLightPercent, shadingInfo, occlusion, frame);
+				textures.getTexture(textureHandles.primary), *chasmTexture, wallLightPercent, shadingInfo, occlusion, frame);
 		}
 
 		const auto drawRanges = SoftwareRenderer::makeDrawRangeTwoPart(
@@ -7039,13 +9235,13 @@ void SoftwareRenderer::drawVoxelBelow(int x, SNInt voxelX, int voxelY, WEInt vox
 			const Double3 farNormal = -VoxelUtils::getNormal(farFacing);
 			SoftwareRenderer::drawChasmPixels(x, drawRanges.at(0), farZ, farU, 0.0,
 				Constants::JustBelowOne, farNormal, RendererUtils::isChasmEmissive(chasmData.type),
-				textures.getTexture(chasmData.textureAssetRef), *chasmTexture, wallLightPercent, shadingInfo, occlusion, frame);
+				textures.getTexture(textureHandles.primary), *chasmTexture, wallLightPercent, shadingInfo, occlusion, frame);
 		}
 	}
 	else if (voxelDef.type == VoxelType::Door)
 	{
 		const VoxelDefinition::DoorData &doorData = voxelDef.door;
-		const double percentOpen = RendererUtils::getDoorPercentOpen(voxelX, voxelZ, levelData);
+		const double percentOpen = levelSnapshot.getDoorPercentOpen(voxelX, voxelZ);
 
 		RayHit hit;
 		const bool success = SoftwareRenderer::findDoorIntersection(voxelX, voxelZ,
@@ -7070,7 +9266,7 @@ void SoftwareRenderer::drawVoxelBelow(int x, SNInt voxelX, int voxelY, WEInt vox
 					LightContributionCap>(hit.point, visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ + hit.innerZ,
-					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					hit.u, 0.0, Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == VoxelDefinition::DoorData::Type::Sliding)
@@ -7090,7 +9286,7 @@ void SoftwareRenderer::drawVoxelBelow(int x, SNInt voxelX, int voxelY, WEInt vox
 					LightContributionCap>(hit.point, visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, hit.u, 0.0,
-					Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == VoxelDefinition::DoorData::Type::Raising)
@@ -7118,7 +9314,7 @@ void SoftwareRenderer::drawVoxelBelow(int x, SNInt voxelX, int voxelY, WEInt vox
 					LightContributionCap>(hit.point, visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, hit.u, vStart,
-					Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef), wallLightPercent,
+					Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary), wallLightPercent,
 					shadingInfo, occlusion, frame);
 			}
 			else if (doorData.type == VoxelDefinition::DoorData::Type::Splitting)
@@ -7138,18 +9334,18 @@ void SoftwareRenderer::drawVoxelBelow(int x, SNInt voxelX, int voxelY, WEInt vox
 					LightContributionCap>(hit.point, visLights, visLightList);
 
 				SoftwareRenderer::drawTransparentPixels(x, drawRange, nearZ, hit.u, 0.0,
-					Constants::JustBelowOne, hit.normal, textures.getTexture(doorData.textureAssetRef),
+					Constants::JustBelowOne, hit.normal, textures.getTexture(textureHandles.primary),
 					wallLightPercent, shadingInfo, occlusion, frame);
 			}
 		}
 	}
 }
 
-void SoftwareRenderer::drawVoxelColumn(int x, SNInt voxelX, WEInt voxelZ, const Camera &camera,
+void SoftwareRenderer::drawVoxelColumn(int x, VoxelColumn &column, const Camera &camera,
 	const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint,
 	double nearZ, double farZ, const ShadingInfo &shadingInfo, int chunkDistance, double ceilingHeight,
-	const LevelData &levelData, const BufferView<const VisibleLight> &visLights,
-	const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &textures,
+	const LevelSnapshot &levelSnapshot, const VisibleLightPool &visLights,
+	const VisibleLightList &visLightList, const VoxelTextures &textures,
 	const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame)
 {
 	// Much of the code here is duplicated from the initial voxel column drawing method, but
@@ -7159,6 +9355,15 @@ void SoftwareRenderer::drawVoxelColumn(int x, SNInt voxelX, WEInt voxelZ, const
 	// method if it had to worry about an "initialColumn" boolean that's always false in the
 	// general case.
 
+	// Air voxels draw nothing, so only the occupied part of the voxel column is visited.
+	if (column.isEmpty())
+	{
+		return;
+	}
+
+	const int occupiedMinY = column.minY;
+	const int occupiedMaxY = column.maxY;
+
 	// When clamping Y values for drawing ranges, subtract 0.5 from starts and add 0.5 to 
 	// ends before converting to integers because the drawing methods sample at the center 
 	// of pixels. The clamping function depends on which side of the range is being clamped; 
@@ -7199,34 +9404,220 @@ void SoftwareRenderer::drawVoxelColumn(int x, SNInt voxelX, WEInt voxelZ, const
 	// Relative Y voxel coordinate of the camera, compensating for the ceiling height.
 	const int adjustedVoxelY = camera.getAdjustedEyeVoxelY(ceilingHeight);
 
+	// Gets the bounded pixel row of a point at the given height on the far side of the voxel.
+	auto getFarPixelY = [&camera, &farPoint, &frame](double pointY, bool lowerBound)
+	{
+		const NewDouble3 farPoint3D(farPoint.x, pointY, farPoint.y);
+		const double yProj = RendererUtils::getProjectedY(
+			farPoint3D, camera.transform, camera.yShear) * frame.heightReal;
+		return lowerBound ? RendererUtils::getLowerBoundedPixel(yProj, frame.height) :
+			RendererUtils::getUpperBoundedPixel(yProj, frame.height);
+	};
+
+	// Everything in a voxel below the eye projects no higher on-screen than the voxel's top at
+	// the far point, and lower voxels project lower still. Once that is under the occlusion
+	// window, the rest of the column below is hidden. The same applies in reverse above the eye.
+	// One voxel of slack is given for edge Y offsets that poke outside their voxel.
+	const double eyeY = camera.eye.point.y;
+	auto isHiddenBelow = [ceilingHeight, &occlusion, &getFarPixelY, eyeY](int voxelY)
+	{
+		const double slackTopY = static_cast<double>(voxelY + 2) * ceilingHeight;
+		return (slackTopY <= eyeY) && (getFarPixelY(slackTopY, true) >= occlusion.yMax);
+	};
+
+	auto isHiddenAbove = [ceilingHeight, &occlusion, &getFarPixelY, eyeY](int voxelY)
+	{
+		const double slackBottomY = static_cast<double>(voxelY - 1) * ceilingHeight;
+		return (slackBottomY >= eyeY) && (getFarPixelY(slackBottomY, false) <= occlusion.yMin);
+	};
+
 	// Draw voxel straight ahead first.
-	SoftwareRenderer::drawVoxelSameFloor(x, voxelX, adjustedVoxelY, voxelZ, camera, ray, facing,
-		nearPoint, farPoint, nearZ, farZ, wallU, wallNormal, shadingInfo, chunkDistance, ceilingHeight,
-		levelData, visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
+	if ((adjustedVoxelY >= occupiedMinY) && (adjustedVoxelY <= occupiedMaxY))
+	{
+		SoftwareRenderer::drawVoxelSameFloor(x, column, adjustedVoxelY, camera, ray, facing,
+			nearPoint, farPoint, nearZ, farZ, wallU, wallNormal, shadingInfo, chunkDistance, ceilingHeight,
+			levelSnapshot, visLights, visLightList, textures, chasmTextureGroups, occlusion, frame);
+	}
 
 	// Draw voxels below the voxel.
-	for (int voxelY = (adjustedVoxelY - 1); voxelY >= 0; voxelY--)
+	for (int voxelY = std::min(adjustedVoxelY - 1, occupiedMaxY); voxelY >= occupiedMinY; voxelY--)
 	{
-		SoftwareRenderer::drawVoxelBelow(x, voxelX, voxelY, voxelZ, camera, ray, facing, nearPoint,
+		if (isHiddenBelow(voxelY))
+		{
+			break;
+		}
+
+		SoftwareRenderer::drawVoxelBelow(x, column, voxelY, camera, ray, facing, nearPoint,
 			farPoint, nearZ, farZ, wallU, wallNormal, shadingInfo, chunkDistance, ceilingHeight,
-			levelData, visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
+			levelSnapshot, visLights, visLightList, textures, chasmTextureGroups, occlusion, frame);
 	}
 
 	// Draw voxels above the voxel.
-	const auto &voxelGrid = levelData.getVoxelGrid();
-	for (int voxelY = (adjustedVoxelY + 1); voxelY < voxelGrid.getHeight(); voxelY++)
+	for (int voxelY = std::max(adjustedVoxelY + 1, occupiedMinY); voxelY <= occupiedMaxY; voxelY++)
 	{
-		SoftwareRenderer::drawVoxelAbove(x, voxelX, voxelY, voxelZ, camera, ray, facing, nearPoint,
+		if (isHiddenAbove(voxelY))
+		{
+			break;
+		}
+
+		SoftwareRenderer::drawVoxelAbove(x, column, voxelY, camera, ray, facing, nearPoint,
 			farPoint, nearZ, farZ, wallU, wallNormal, shadingInfo, chunkDistance, ceilingHeight,
-			levelData, visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
+			levelSnapshot, visLights, visLightList, textures, chasmTextureGroups, occlusion, frame);
+	}
+}
+
+template <typename TexelFunc>
+void SoftwareRenderer::drawFlatColumnSSE(int x, int yStart, int yEnd, double depth, double projectedYStart,
+	double projectedYEnd, int textureX, const FlatTexture &texture, const FrameView &frame,
+	const TexelFunc &texelFunc)
+{
+	constexpr int stride = sizeof(__m128) / sizeof(float);
+	constexpr int halfStride = stride / 2;
+
+	// Texel rows are computed with the same operations as the scalar loop so look-ups are identical.
+	const __m128d projectedYStarts = _mm_set1_pd(projectedYStart);
+	const __m128d projectedYDiffs = _mm_set1_pd(projectedYEnd - projectedYStart);
+	const __m128d halfReals = _mm_set1_pd(0.50);
+	const __m128d vStarts = _mm_setzero_pd();
+	const __m128d vDiffs = _mm_set1_pd(Constants::JustBelowOne);
+	const __m128d textureHeightReals = _mm_set1_pd(static_cast<double>(texture.height));
+	const __m128d depths = _mm_set1_pd(depth);
+
+	const int lastY = yEnd - 1;
+	for (int y = yStart; y < yEnd; y += stride)
+	{
+		// Lanes past the end of the range re-use the last row and are masked off.
+		alignas(16) double ys[stride];
+		alignas(16) int indices[stride];
+		alignas(16) double depthBuffers[stride];
+		for (int i = 0; i < stride; i++)
+		{
+			const int laneY = std::min(y + i, lastY);
+			ys[i] = static_cast<double>(laneY);
+			indices[i] = x + (laneY * frame.width);
+			depthBuffers[i] = frame.getDepth(indices[i]);
+		}
+
+		const int laneCount = std::min(stride, yEnd - y);
+		int writeMask = (1 << laneCount) - 1;
+
+		// Depth test.
+		const int depthMask =
+			_mm_movemask_pd(_mm_cmple_pd(depths, _mm_load_pd(depthBuffers))) |
+			(_mm_movemask_pd(_mm_cmple_pd(depths, _mm_load_pd(depthBuffers + halfStride))) << halfStride);
+		writeMask &= depthMask;
+		if (writeMask == 0)
+		{
+			continue;
+		}
+
+		// Texture rows.
+		const __m128d yPercentsLo = _mm_div_pd(
+			_mm_sub_pd(_mm_add_pd(_mm_load_pd(ys), halfReals), projectedYStarts), projectedYDiffs);
+		const __m128d yPercentsHi = _mm_div_pd(_mm_sub_pd(
+			_mm_add_pd(_mm_load_pd(ys + halfStride), halfReals), projectedYStarts), projectedYDiffs);
+		const __m128d vsLo = _mm_add_pd(vStarts, _mm_mul_pd(vDiffs, yPercentsLo));
+		const __m128d vsHi = _mm_add_pd(vStarts, _mm_mul_pd(vDiffs, yPercentsHi));
+		alignas(16) int textureYs[stride];
+		_mm_store_si128(reinterpret_cast<__m128i*>(textureYs), _mm_unpacklo_epi64(
+			_mm_cvttpd_epi32(_mm_mul_pd(vsLo, textureHeightReals)),
+			_mm_cvttpd_epi32(_mm_mul_pd(vsHi, textureHeightReals))));
+
+		// Palette look-ups and special texels are per-pixel, in order so puddles see the pixels above
+		// them like in the scalar loop. Transparent texels are not drawn.
+		for (int i = 0; i < laneCount; i++)
+		{
+			if ((writeMask & (1 << i)) != 0)
+			{
+				const FlatTexel &texel = texture.texels[textureX + (textureYs[i] * texture.width)];
+				if (texel.value != 0)
+				{
+					texelFunc(indices[i], y + i, texel);
+				}
+			}
+		}
+	}
+}
+
+template <typename TexelFunc>
+AVX2_TARGET void SoftwareRenderer::drawFlatColumnAVX(int x, int yStart, int yEnd, double depth,
+	double projectedYStart, double projectedYEnd, int textureX, const FlatTexture &texture,
+	const FrameView &frame, const TexelFunc &texelFunc)
+{
+	constexpr int stride = sizeof(__m256) / sizeof(float);
+	constexpr int halfStride = stride / 2;
+
+	// Texel rows are computed with the same operations as the scalar loop so look-ups are identical.
+	const __m256d projectedYStarts = _mm256_set1_pd(projectedYStart);
+	const __m256d projectedYDiffs = _mm256_set1_pd(projectedYEnd - projectedYStart);
+	const __m256d halfReals = _mm256_set1_pd(0.50);
+	const __m256d vStarts = _mm256_setzero_pd();
+	const __m256d vDiffs = _mm256_set1_pd(Constants::JustBelowOne);
+	const __m256d textureHeightReals = _mm256_set1_pd(static_cast<double>(texture.height));
+	const __m256d depths = _mm256_set1_pd(depth);
+
+	const int lastY = yEnd - 1;
+	for (int y = yStart; y < yEnd; y += stride)
+	{
+		// Lanes past the end of the range re-use the last row and are masked off.
+		alignas(32) double ys[stride];
+		alignas(32) int indices[stride];
+		alignas(32) double depthBuffers[stride];
+		for (int i = 0; i < stride; i++)
+		{
+			const int laneY = std::min(y + i, lastY);
+			ys[i] = static_cast<double>(laneY);
+			indices[i] = x + (laneY * frame.width);
+			depthBuffers[i] = frame.getDepth(indices[i]);
+		}
+
+		const int laneCount = std::min(stride, yEnd - y);
+		int writeMask = (1 << laneCount) - 1;
+
+		// Depth test.
+		const int depthMask =
+			_mm256_movemask_pd(_mm256_cmp_pd(depths, _mm256_load_pd(depthBuffers), _CMP_LE_OQ)) |
+			(_mm256_movemask_pd(_mm256_cmp_pd(depths, _mm256_load_pd(depthBuffers + halfStride),
+				_CMP_LE_OQ)) << halfStride);
+		writeMask &= depthMask;
+		if (writeMask == 0)
+		{
+			continue;
+		}
+
+		// Texture rows.
+		const __m256d yPercentsLo = _mm256_div_pd(_mm256_sub_pd(
+			_mm256_add_pd(_mm256_load_pd(ys), halfReals), projectedYStarts), projectedYDiffs);
+		const __m256d yPercentsHi = _mm256_div_pd(_mm256_sub_pd(
+			_mm256_add_pd(_mm256_load_pd(ys + halfStride), halfReals), projectedYStarts), projectedYDiffs);
+		const __m256d vsLo = _mm256_add_pd(vStarts, _mm256_mul_pd(vDiffs, yPercentsLo));
+		const __m256d vsHi = _mm256_add_pd(vStarts, _mm256_mul_pd(vDiffs, yPercentsHi));
+		alignas(32) int textureYs[stride];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(textureYs), _mm256_insertf128_si256(
+			_mm256_castsi128_si256(_mm256_cvttpd_epi32(_mm256_mul_pd(vsLo, textureHeightReals))),
+			_mm256_cvttpd_epi32(_mm256_mul_pd(vsHi, textureHeightReals)), 1));
+
+		// Palette look-ups and special texels are per-pixel, in order so puddles see the pixels above
+		// them like in the scalar loop. Transparent texels are not drawn.
+		for (int i = 0; i < laneCount; i++)
+		{
+			if ((writeMask & (1 << i)) != 0)
+			{
+				const FlatTexel &texel = texture.texels[textureX + (textureYs[i] * texture.width)];
+				if (texel.value != 0)
+				{
+					texelFunc(indices[i], y + i, texel);
+				}
+			}
+		}
 	}
 }
 
 void SoftwareRenderer::drawFlat(int startX, int endX, const VisibleFlat &flat, const Double3 &normal,
 	const NewDouble2 &eye, const NewInt2 &eyeVoxelXZ, double horizonProjY, const ShadingInfo &shadingInfo,
 	const Palette *overridePalette, int chunkDistance, const FlatTexture &texture,
-	const BufferView<const VisibleLight> &visLights, const BufferView2D<const VisibleLightList> &visLightLists,
-	int gridWidth, int gridDepth, const FrameView &frame)
+	const VisibleLightPool &visLights, const BufferView2D<const VisibleLightList> &visLightLists,
+	int gridWidth, int gridDepth, FlatShadingCache &shadingCache, const FrameView &frame)
 {
 	// X percents across the screen for the given start and end columns.
 	const double startXPercent = (static_cast<double>(startX) + 0.50) / 
@@ -7274,14 +9665,24 @@ void SoftwareRenderer::drawFlat(int startX, int endX, const VisibleFlat &flat, c
 	const double projectedYStart = flat.startY * frame.heightReal;
 	const double projectedYEnd = flat.endY * frame.heightReal;
 
-	// Clamp the coordinates for where the flat starts and stops on the screen.
+	// Clamp the coordinates for where the flat starts and stops on the screen. The end is also
+	// clamped to the given range so the next range's first column isn't drawn twice (which would
+	// apply ghost texels twice and break back-to-front order at bin edges).
 	const int xStart = RendererUtils::getLowerBoundedPixel(projectedXStart, frame.width);
-	const int xEnd = RendererUtils::getUpperBoundedPixel(projectedXEnd, frame.width);
+	const int xEnd = std::min(RendererUtils::getUpperBoundedPixel(projectedXEnd, frame.width), endX);
 	const int yStart = RendererUtils::getLowerBoundedPixel(projectedYStart, frame.height);
 	const int yEnd = RendererUtils::getUpperBoundedPixel(projectedYEnd, frame.height);
 
-	// Shading on the texture.
-	const Double3 shading(shadingInfo.ambient, shadingInfo.ambient, shadingInfo.ambient);
+	// Flats always face the camera, so one mipmap fits every column. Their projected size shrinks
+	// with distance like walls, and the axis with more texels per pixel picks the level so wide
+	// flats don't alias horizontally.
+	const int mipmapLevelCount = texture.getMipmapLevelCount();
+	const int mipmapLevel = std::max(
+		GetMipmapLevel(static_cast<double>(texture.width), (flat.endX - flat.startX) * frame.widthReal,
+			mipmapLevelCount),
+		GetMipmapLevel(static_cast<double>(texture.height), projectedYEnd - projectedYStart,
+			mipmapLevelCount));
+	const FlatTexture &mipmap = texture.getMipmap(mipmapLevel);
 
 	// Use the override palette for citizen variations or the base palette for most entities.
 	const Palette &palette = (overridePalette != nullptr) ? *overridePalette : shadingInfo.palette;
@@ -7296,7 +9697,7 @@ void SoftwareRenderer::drawFlat(int startX, int endX, const VisibleFlat &flat, c
 		const double u = startU + ((endU - startU) * xPercent);
 
 		// Horizontal texel position.
-		const int textureX = static_cast<int>(u * static_cast<double>(texture.width));
+		const int textureX = static_cast<int>(u * static_cast<double>(mipmap.width));
 
 		const NewDouble3 topPoint = startTopPoint.lerp(endTopPoint, xPercent);
 
@@ -7319,11 +9720,106 @@ void SoftwareRenderer::drawFlat(int startX, int endX, const VisibleFlat &flat, c
 		const Double3 &fogColor = shadingInfo.getFogColor();
 		const double fogPercent = std::min(depth / shadingInfo.fogDistance, 1.0);
 
+		// Shaded texel colors for this column, shared with other columns that have about the
+		// same light and fog.
+		const double shadingMax = 1.0;
+		const double light = std::min(shadingInfo.ambient + lightContributionPercent, shadingMax);
+		FlatShadingTable &shadingTable = shadingCache.getTable(palette, light, fogPercent);
+
+		// Shades an opaque texel that passed the depth test.
+		auto drawTexel = [x, depth, horizonProjY, fogPercent, &texture, &fogColor, &shadingInfo,
+			&shadingTable, &frame](int index, int y, const FlatTexel &texel)
+		{
+			uint32_t colorRGB;
+			const bool isGhostTexel = ArenaRenderUtils::IsGhostTexel(texel.value);
+			const bool isPuddleTexel = texture.reflective && ArenaRenderUtils::IsPuddleTexel(texel.value);
+			if (isGhostTexel || isPuddleTexel)
+			{
+				double colorR, colorG, colorB;
+				if (isGhostTexel)
+				{
+					// Ghost shader. The previously rendered pixel is diminished by some amount.
+					const double alpha = static_cast<double>(texel.value) /
+						static_cast<double>(ArenaRenderUtils::PALETTE_INDEX_LIGHT_LEVEL_DIVISOR);
+
+					const Double3 prevColor = Double3::fromRGB(frame.colorBuffer[index]);
+					const double visPercent = std::clamp(1.0 - alpha, 0.0, 1.0);
+					colorR = prevColor.x * visPercent;
+					colorG = prevColor.y * visPercent;
+					colorB = prevColor.z * visPercent;
+				}
+				else
+				{
+					// Reflective texel (i.e. puddle).
+					// Copy-paste the previously-drawn pixel from the Y pixel coordinate mirrored
+					// around the horizon. If it is outside the screen, use the sky color instead.
+					const int horizonY = static_cast<int>(horizonProjY * frame.heightReal);
+					const int reflectedY = horizonY + (horizonY - y);
+					const bool insideScreen = (reflectedY >= 0) && (reflectedY < frame.height);
+					if (insideScreen)
+					{
+						// Read from mirrored position in frame buffer.
+						const int reflectedIndex = x + (reflectedY * frame.width);
+						const Double3 prevColor = Double3::fromRGB(frame.colorBuffer[reflectedIndex]);
+						colorR = prevColor.x;
+						colorG = prevColor.y;
+						colorB = prevColor.z;
+					}
+					else
+					{
+						// Use sky color instead.
+						const Double3 &skyColor = shadingInfo.skyColors.back();
+						colorR = skyColor.x;
+						colorG = skyColor.y;
+						colorB = skyColor.z;
+					}
+				}
+
+				// Linearly interpolate with fog.
+				colorR += (fogColor.x - colorR) * fogPercent;
+				colorG += (fogColor.y - colorG) * fogPercent;
+				colorB += (fogColor.z - colorB) * fogPercent;
+
+				// Clamp maximum (don't worry about negative values).
+				const double high = 1.0;
+				colorR = (colorR > high) ? high : colorR;
+				colorG = (colorG > high) ? high : colorG;
+				colorB = (colorB > high) ? high : colorB;
+
+				// Convert floats to integers.
+				colorRGB = static_cast<uint32_t>(
+					((static_cast<uint8_t>(colorR * 255.0)) << 16) |
+					((static_cast<uint8_t>(colorG * 255.0)) << 8) |
+					((static_cast<uint8_t>(colorB * 255.0))));
+			}
+			else
+			{
+				// Texture color with shading, fog, and palette look-ups from the column's table.
+				colorRGB = shadingTable.getColor(texel.value, fogColor);
+			}
+
+			frame.colorBuffer[index] = colorRGB;
+			frame.setDepth(index, depth);
+		};
+
+		if (ActiveColumnKernel == ColumnKernel::AVX)
+		{
+			SoftwareRenderer::drawFlatColumnAVX(x, yStart, yEnd, depth, projectedYStart, projectedYEnd,
+				textureX, mipmap, frame, drawTexel);
+			continue;
+		}
+		else if (ActiveColumnKernel == ColumnKernel::SSE)
+		{
+			SoftwareRenderer::drawFlatColumnSSE(x, yStart, yEnd, depth, projectedYStart, projectedYEnd,
+				textureX, mipmap, frame, drawTexel);
+			continue;
+		}
+
 		for (int y = yStart; y < yEnd; y++)
 		{
 			const int index = x + (y * frame.width);
 
-			if (depth <= frame.depthBuffer[index])
+			if (depth <= frame.getDepth(index))
 			{
 				const double yPercent = ((static_cast<double>(y) + 0.50) - projectedYStart) /
 					(projectedYEnd - projectedYStart);
@@ -7334,88 +9830,16 @@ void SoftwareRenderer::drawFlat(int startX, int endX, const VisibleFlat &flat, c
 				const double v = startV + ((endV - startV) * yPercent);
 
 				// Vertical texel position.
-				const int textureY = static_cast<int>(v * static_cast<double>(texture.height));
+				const int textureY = static_cast<int>(v * static_cast<double>(mipmap.height));
 
 				// Alpha is checked in this loop and transparent texels are not drawn.
-				const int textureIndex = textureX + (textureY * texture.width);
-				const FlatTexel &texel = texture.texels[textureIndex];
+				const int textureIndex = textureX + (textureY * mipmap.width);
+				const FlatTexel &texel = mipmap.texels[textureIndex];
 				const bool isTransparentTexel = texel.value == 0;
 
 				if (!isTransparentTexel)
 				{
-					double colorR, colorG, colorB;
-					if (ArenaRenderUtils::IsGhostTexel(texel.value))
-					{
-						// Ghost shader. The previously rendered pixel is diminished by some amount.
-						const double alpha = static_cast<double>(texel.value) /
-							static_cast<double>(ArenaRenderUtils::PALETTE_INDEX_LIGHT_LEVEL_DIVISOR);
-
-						const Double3 prevColor = Double3::fromRGB(frame.colorBuffer[index]);
-						const double visPercent = std::clamp(1.0 - alpha, 0.0, 1.0);
-						colorR = prevColor.x * visPercent;
-						colorG = prevColor.y * visPercent;
-						colorB = prevColor.z * visPercent;
-					}
-					else if (texture.reflective && ArenaRenderUtils::IsPuddleTexel(texel.value))
-					{
-						// Reflective texel (i.e. puddle).
-						// Copy-paste the previously-drawn pixel from the Y pixel coordinate mirrored
-						// around the horizon. If it is outside the screen, use the sky color instead.
-						const int horizonY = static_cast<int>(horizonProjY * frame.heightReal);
-						const int reflectedY = horizonY + (horizonY - y);
-						const bool insideScreen = (reflectedY >= 0) && (reflectedY < frame.height);
-						if (insideScreen)
-						{
-							// Read from mirrored position in frame buffer.
-							const int reflectedIndex = x + (reflectedY * frame.width);
-							const Double3 prevColor = Double3::fromRGB(frame.colorBuffer[reflectedIndex]);
-							colorR = prevColor.x;
-							colorG = prevColor.y;
-							colorB = prevColor.z;
-						}
-						else
-						{
-							// Use sky color instead.
-							const Double3 &skyColor = shadingInfo.skyColors.back();
-							colorR = skyColor.x;
-							colorG = skyColor.y;
-							colorB = skyColor.z;
-						}
-					}
-					else
-					{
-						// Texture color with shading and some conditional palette look-ups.
-						const bool isRedSrc1 = (texel.value == ArenaRenderUtils::PALETTE_INDEX_RED_SRC1);
-						const bool isRedSrc2 = (texel.value == ArenaRenderUtils::PALETTE_INDEX_RED_SRC2);
-						const int paletteIndex = isRedSrc1 ? ArenaRenderUtils::PALETTE_INDEX_RED_DST1 :
-							(isRedSrc2 ? ArenaRenderUtils::PALETTE_INDEX_RED_DST2 : texel.value);
-						const Double4 texelColor = Double4::fromARGB(palette[paletteIndex].toARGB());
-
-						const double shadingMax = 1.0;
-						colorR = texelColor.x * std::min(shading.x + lightContributionPercent, shadingMax);
-						colorG = texelColor.y * std::min(shading.y + lightContributionPercent, shadingMax);
-						colorB = texelColor.z * std::min(shading.z + lightContributionPercent, shadingMax);
-					}
-
-					// Linearly interpolate with fog.
-					colorR += (fogColor.x - colorR) * fogPercent;
-					colorG += (fogColor.y - colorG) * fogPercent;
-					colorB += (fogColor.z - colorB) * fogPercent;
-
-					// Clamp maximum (don't worry about negative values).
-					const double high = 1.0;
-					colorR = (colorR > high) ? high : colorR;
-					colorG = (colorG > high) ? high : colorG;
-					colorB = (colorB > high) ? high : colorB;
-
-					// Convert floats to integers.
-					const uint32_t colorRGB = static_cast<uint32_t>(
-						((static_cast<uint8_t>(colorR * 255.0)) << 16) |
-						((static_cast<uint8_t>(colorG * 255.0)) << 8) |
-						((static_cast<uint8_t>(colorB * 255.0))));
-
-					frame.colorBuffer[index] = colorRGB;
-					frame.depthBuffer[index] = depth;
+					drawTexel(index, y, texel);
 				}
 			}
 		}
@@ -7424,8 +9848,8 @@ void SoftwareRenderer::drawFlat(int startX, int endX, const VisibleFlat &flat, c
 
 template <bool NonNegativeDirX, bool NonNegativeDirZ>
 void SoftwareRenderer::rayCast2DInternal(int x, const Camera &camera, const Ray &ray,
-	const ShadingInfo &shadingInfo, int chunkDistance, double ceilingHeight, const LevelData &levelData,
-	const BufferView<const VisibleLight> &visLights, const BufferView2D<const VisibleLightList> &visLightLists,
+	const ShadingInfo &shadingInfo, int chunkDistance, double ceilingHeight, const LevelSnapshot &levelSnapshot,
+	const VisibleLightPool &visLights, const BufferView2D<const VisibleLightList> &visLightLists,
 	const VoxelTextures &textures, const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion,
 	const FrameView &frame)
 {
@@ -7440,35 +9864,12 @@ void SoftwareRenderer::rayCast2DInternal(int x, const Camera &camera, const Ray
 	// -> (int)floor(-0.8) == -1
 	// -> (int)ceil(-0.8) == 0
 
-	constexpr SNInt stepX = NonNegativeDirX ? 1 : -1;
-	constexpr WEInt stepZ = NonNegativeDirZ ? 1 : -1;
-	constexpr SNDouble axisLenX = 1.0;
-	constexpr WEDouble axisLenZ = 1.0;
-
 	// Camera position values in absolute coordinate space.
 	const NewDouble3 absoluteEye = VoxelUtils::coordToNewPoint(camera.eye);
 	const NewDouble3 absoluteEyeVoxelReal = VoxelUtils::coordToNewPoint(camera.eyeVoxelReal);
 	const NewInt3 absoluteEyeVoxel = VoxelUtils::coordToNewVoxel(camera.eyeVoxel);
 
-	// Delta distance is how far the ray has to go to step one voxel's worth along a certain axis.
-	const SNDouble deltaDistX = (NonNegativeDirX ? axisLenX : -axisLenX) / ray.dirX;
-	const WEDouble deltaDistZ = (NonNegativeDirZ ? axisLenZ : -axisLenZ) / ray.dirZ;
-
-	// The initial delta distances are percentages of the delta distances, dependent on the ray
-	// start position inside the voxel.
-	const SNDouble initialDeltaDistPercentX = NonNegativeDirX ?
-		(1.0 - ((absoluteEye.x - absoluteEyeVoxelReal.x) / axisLenX)) :
-		((absoluteEye.x - absoluteEyeVoxelReal.x) / axisLenX);
-	const WEDouble initialDeltaDistPercentZ = NonNegativeDirZ ?
-		(1.0 - ((absoluteEye.z - absoluteEyeVoxelReal.z) / axisLenZ)) :
-		((absoluteEye.z - absoluteEyeVoxelReal.z) / axisLenZ);
-
-	// Initial delta distance is a fraction of delta distance based on the ray's position in
-	// the initial voxel.
-	const SNDouble initialDeltaDistX = deltaDistX * initialDeltaDistPercentX;
-	const WEDouble initialDeltaDistZ = deltaDistZ * initialDeltaDistPercentZ;
-
-	const VoxelGrid &voxelGrid = levelData.getVoxelGrid();
+	const VoxelGrid &voxelGrid = levelSnapshot.getVoxelGrid();
 	const SNInt gridWidth = voxelGrid.getWidth();
 	const int gridHeight = voxelGrid.getHeight();
 	const WEInt gridDepth = voxelGrid.getDepth();
@@ -7476,128 +9877,233 @@ void SoftwareRenderer::rayCast2DInternal(int x, const Camera &camera, const Ray
 	// The Z distance from the camera to the wall, and the X or Z normal of the intersected
 	// voxel face. The first Z distance is a special case, so it's brought outside the 
 	// DDA loop.
-	double zDistance;
-	VoxelFacing2D facing;
-
-	// Verify that the initial voxel coordinate is within the world bounds.
-	bool voxelIsValid =
-		(absoluteEyeVoxel.x >= 0) &&
-		(absoluteEyeVoxel.y >= 0) &&
-		(absoluteEyeVoxel.z >= 0) &&
-		(absoluteEyeVoxel.x < gridWidth) &&
-		(absoluteEyeVoxel.y < gridHeight) &&
-		(absoluteEyeVoxel.z < gridDepth);
+	RayTraversal traversal;
+	traversal.init<NonNegativeDirX, NonNegativeDirZ>(absoluteEye, absoluteEyeVoxelReal,
+		absoluteEyeVoxel, ray, gridWidth, gridHeight, gridDepth);
 
-	if (voxelIsValid)
+	if (traversal.voxelIsValid)
 	{
-		// Decide how far the wall is, and which voxel face was hit.
-		if (initialDeltaDistX < initialDeltaDistZ)
-		{
-			zDistance = initialDeltaDistX;
-			facing = NonNegativeDirX ? VoxelFacing2D::NegativeX : VoxelFacing2D::PositiveX;
-		}
-		else
-		{
-			zDistance = initialDeltaDistZ;
-			facing = NonNegativeDirZ ? VoxelFacing2D::NegativeZ : VoxelFacing2D::PositiveZ;
-		}
-
 		// The initial near point is directly in front of the player in the near Z 
 		// camera plane.
 		const NewDouble2 initialNearPoint(
 			absoluteEye.x + (ray.dirX * SoftwareRenderer::NEAR_PLANE),
 			absoluteEye.z + (ray.dirZ * SoftwareRenderer::NEAR_PLANE));
 
-		// The initial far point is the wall hit. This is used with the player's position 
-		// for drawing the initial floor and ceiling.
-		const NewDouble2 initialFarPoint(
-			absoluteEye.x + (ray.dirX * zDistance),
-			absoluteEye.z + (ray.dirZ * zDistance));
+		// The initial far point is the wall hit. This is used with the player's position 
+		// for drawing the initial floor and ceiling.
+		const NewDouble2 initialFarPoint(
+			absoluteEye.x + (ray.dirX * traversal.zDistance),
+			absoluteEye.z + (ray.dirZ * traversal.zDistance));
+
+		const VisibleLightList &visLightList = SoftwareRenderer::getVisibleLightList(visLightLists,
+			absoluteEyeVoxel.x, absoluteEyeVoxel.z, absoluteEyeVoxel.x, absoluteEyeVoxel.z, gridWidth,
+			gridDepth, chunkDistance);
+
+		// Draw all voxels in a column at the player's XZ coordinate.
+		SoftwareRenderer::drawInitialVoxelColumn(x, absoluteEyeVoxel.x, absoluteEyeVoxel.z,
+			camera, ray, traversal.facing, initialNearPoint, initialFarPoint, SoftwareRenderer::NEAR_PLANE,
+			traversal.zDistance, shadingInfo, chunkDistance, ceilingHeight, levelSnapshot, visLights,
+			visLightList, textures, chasmTextureGroups, occlusion, frame);
+	}
+
+	// Step forward in the grid once to leave the initial voxel and update the Z distance.
+	traversal.step<NonNegativeDirX, NonNegativeDirZ>(absoluteEye, ray, gridWidth, gridDepth);
+
+	SoftwareRenderer::rayCast2DContinue<NonNegativeDirX, NonNegativeDirZ>(x, camera, ray, traversal,
+		shadingInfo, chunkDistance, ceilingHeight, levelSnapshot, visLights, visLightLists, textures,
+		chasmTextureGroups, occlusion, frame);
+}
+
+template <bool NonNegativeDirX, bool NonNegativeDirZ>
+void SoftwareRenderer::rayCast2DContinue(int x, const Camera &camera, const Ray &ray,
+	RayTraversal &traversal, const ShadingInfo &shadingInfo, int chunkDistance, double ceilingHeight,
+	const LevelSnapshot &levelSnapshot, const VisibleLightPool &visLights,
+	const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &textures,
+	const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame)
+{
+	const NewDouble3 absoluteEye = VoxelUtils::coordToNewPoint(camera.eye);
+	const NewInt3 absoluteEyeVoxel = VoxelUtils::coordToNewVoxel(camera.eyeVoxel);
+
+	const VoxelGrid &voxelGrid = levelSnapshot.getVoxelGrid();
+	const SNInt gridWidth = voxelGrid.getWidth();
+	const WEInt gridDepth = voxelGrid.getDepth();
+
+	// Step through the voxel grid while the current coordinate is valid, the 
+	// distance stepped is less than the distance at which fog is maximum, and
+	// the column is not completely occluded.
+	while (traversal.voxelIsValid && (traversal.zDistance < shadingInfo.fogDistance) &&
+		(occlusion.yMin != occlusion.yMax))
+	{
+		// Store the cell coordinates, axis, and Z distance for wall rendering. The
+		// loop needs to do another DDA step to calculate the far point.
+		const SNInt savedCellX = traversal.cell.x;
+		const WEInt savedCellZ = traversal.cell.z;
+		const VoxelFacing2D savedFacing = traversal.facing;
+		const double wallDistance = traversal.zDistance;
+
+		// Decide which voxel in the XZ plane to step to next, and update the Z distance.
+		traversal.step<NonNegativeDirX, NonNegativeDirZ>(absoluteEye, ray, gridWidth, gridDepth);
+
+		// Near and far points in the XZ plane. The near point is where the wall is, and 
+		// the far point is used with the near point for drawing the floor and ceiling.
+		const NewDouble2 nearPoint(
+			absoluteEye.x + (ray.dirX * wallDistance),
+			absoluteEye.z + (ray.dirZ * wallDistance));
+		const NewDouble2 farPoint(
+			absoluteEye.x + (ray.dirX * traversal.zDistance),
+			absoluteEye.z + (ray.dirZ * traversal.zDistance));
+
+		VoxelColumn column;
+		column.init(savedCellX, savedCellZ, voxelGrid);
+		if (column.isEmpty())
+		{
+			continue;
+		}
+
+		const VisibleLightList &visLightList = SoftwareRenderer::getVisibleLightList(visLightLists,
+			savedCellX, savedCellZ, absoluteEyeVoxel.x, absoluteEyeVoxel.z, gridWidth, gridDepth,
+			chunkDistance);
+
+		// Draw all voxels in a column at the given XZ coordinate.
+		SoftwareRenderer::drawVoxelColumn(x, column, camera, ray, savedFacing, nearPoint, farPoint,
+			wallDistance, traversal.zDistance, shadingInfo, chunkDistance, ceilingHeight, levelSnapshot,
+			visLights, visLightList, textures, chasmTextureGroups, occlusion, frame);
+	}
+}
+
+template <bool NonNegativeDirX, bool NonNegativeDirZ>
+void SoftwareRenderer::rayCast2DBundleInternal(int startX, int rayCount, const Ray *rays,
+	const Camera &camera, const ShadingInfo &shadingInfo, int chunkDistance, double ceilingHeight,
+	const LevelSnapshot &levelSnapshot, const VisibleLightPool &visLights,
+	const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &textures,
+	const ChasmTextureGroups &chasmTextureGroups, OcclusionData *occlusion, const FrameView &frame)
+{
+	DebugAssert(rayCount > 0);
+	DebugAssert(rayCount <= SoftwareRenderer::RAY_BUNDLE_SIZE);
+
+	// Values shared by every ray in the bundle.
+	const NewDouble3 absoluteEye = VoxelUtils::coordToNewPoint(camera.eye);
+	const NewDouble3 absoluteEyeVoxelReal = VoxelUtils::coordToNewPoint(camera.eyeVoxelReal);
+	const NewInt3 absoluteEyeVoxel = VoxelUtils::coordToNewVoxel(camera.eyeVoxel);
+
+	const VoxelGrid &voxelGrid = levelSnapshot.getVoxelGrid();
+	const SNInt gridWidth = voxelGrid.getWidth();
+	const int gridHeight = voxelGrid.getHeight();
+	const WEInt gridDepth = voxelGrid.getDepth();
 
-		// Draw all voxels in a column at the player's XZ coordinate.
-		SoftwareRenderer::drawInitialVoxelColumn(x, absoluteEyeVoxel.x, absoluteEyeVoxel.z,
-			camera, ray, facing, initialNearPoint, initialFarPoint, SoftwareRenderer::NEAR_PLANE,
-			zDistance, shadingInfo, chunkDistance, ceilingHeight, levelData, visLights, visLightLists,
-			textures, chasmTextureGroups, occlusion, frame);
+	RayTraversal traversals[SoftwareRenderer::RAY_BUNDLE_SIZE];
+	for (int i = 0; i < rayCount; i++)
+	{
+		traversals[i].init<NonNegativeDirX, NonNegativeDirZ>(absoluteEye, absoluteEyeVoxelReal,
+			absoluteEyeVoxel, rays[i], gridWidth, gridHeight, gridDepth);
 	}
 
-	// The current voxel coordinate in the DDA loop. For all intents and purposes,
-	// the Y cell coordinate is constant.
-	NewInt3 cell(absoluteEyeVoxel.x, absoluteEyeVoxel.y, absoluteEyeVoxel.z);
-	
-	// Delta distance sums in each component, starting at the initial wall hit. The lowest
-	// component is the candidate for the next DDA loop.
-	SNDouble deltaDistSumX = initialDeltaDistX;
-	WEDouble deltaDistSumZ = initialDeltaDistZ;
+	// Every ray starts in the camera's voxel, so its validity and light list are the same for all.
+	if (traversals[0].voxelIsValid)
+	{
+		const VisibleLightList &visLightList = SoftwareRenderer::getVisibleLightList(visLightLists,
+			absoluteEyeVoxel.x, absoluteEyeVoxel.z, absoluteEyeVoxel.x, absoluteEyeVoxel.z, gridWidth,
+			gridDepth, chunkDistance);
 
-	// Helper values for Z distance calculation per step.
-	constexpr SNDouble halfOneMinusStepXReal = static_cast<double>((1 - stepX) / 2);
-	constexpr WEDouble halfOneMinusStepZReal = static_cast<double>((1 - stepZ) / 2);
+		for (int i = 0; i < rayCount; i++)
+		{
+			const Ray &ray = rays[i];
+			const RayTraversal &traversal = traversals[i];
+			const NewDouble2 initialNearPoint(
+				absoluteEye.x + (ray.dirX * SoftwareRenderer::NEAR_PLANE),
+				absoluteEye.z + (ray.dirZ * SoftwareRenderer::NEAR_PLANE));
+			const NewDouble2 initialFarPoint(
+				absoluteEye.x + (ray.dirX * traversal.zDistance),
+				absoluteEye.z + (ray.dirZ * traversal.zDistance));
 
-	// Lambda for stepping to the next XZ coordinate in the grid and updating the Z
-	// distance for the current edge point.
-	// @optimization: constexpr values in a lambda capture (stepX, zDistance values) are not baked in!!
-	// - Only way to get the values baked in is 1) make template doDDAStep() method, or 2) no lambda.
-	auto doDDAStep = [&ray, stepX, stepZ, &absoluteEye, deltaDistX, deltaDistZ, gridWidth, gridDepth,
-		&zDistance, &facing, &voxelIsValid, &cell, &deltaDistSumX, &deltaDistSumZ,
-		halfOneMinusStepXReal, halfOneMinusStepZReal]()
+			SoftwareRenderer::drawInitialVoxelColumn(startX + i, absoluteEyeVoxel.x, absoluteEyeVoxel.z,
+				camera, ray, traversal.facing, initialNearPoint, initialFarPoint, SoftwareRenderer::NEAR_PLANE,
+				traversal.zDistance, shadingInfo, chunkDistance, ceilingHeight, levelSnapshot, visLights,
+				visLightList, textures, chasmTextureGroups, occlusion[i], frame);
+		}
+	}
+
+	for (int i = 0; i < rayCount; i++)
+	{
+		traversals[i].step<NonNegativeDirX, NonNegativeDirZ>(absoluteEye, rays[i], gridWidth, gridDepth);
+	}
+
+	// Step the rays together for as long as they all continue into the same voxel column. Rays
+	// that are within a few pixels of each other usually stay together until the distance where
+	// they start crossing different voxel edges.
+	auto isCoherent = [rayCount, &traversals, &shadingInfo, occlusion]()
 	{
-		if (deltaDistSumX < deltaDistSumZ)
+		const NewInt3 &cell = traversals[0].cell;
+		for (int i = 0; i < rayCount; i++)
 		{
-			deltaDistSumX += deltaDistX;
-			cell.x += stepX;
-			facing = NonNegativeDirX ? VoxelFacing2D::NegativeX : VoxelFacing2D::PositiveX;
-			voxelIsValid &= (cell.x >= 0) && (cell.x < gridWidth);
-			zDistance = (((static_cast<double>(cell.x) - absoluteEye.x) + halfOneMinusStepXReal) / ray.dirX);
+			const RayTraversal &traversal = traversals[i];
+			const OcclusionData &rayOcclusion = occlusion[i];
+			const bool isActive = traversal.voxelIsValid && (traversal.zDistance < shadingInfo.fogDistance) &&
+				(rayOcclusion.yMin != rayOcclusion.yMax);
+			if (!isActive || (traversal.cell.x != cell.x) || (traversal.cell.z != cell.z))
+			{
+				return false;
+			}
 		}
-		else
+
+		return true;
+	};
+
+	// The voxel column, its voxel IDs and fade percents, and its light list are fetched once per
+	// step and shared by every ray in the bundle.
+	while (isCoherent())
+	{
+		const SNInt cellX = traversals[0].cell.x;
+		const WEInt cellZ = traversals[0].cell.z;
+		VoxelColumn column;
+		column.init(cellX, cellZ, voxelGrid);
+
+		if (column.isEmpty())
 		{
-			deltaDistSumZ += deltaDistZ;
-			cell.z += stepZ;
-			facing = NonNegativeDirZ ? VoxelFacing2D::NegativeZ : VoxelFacing2D::PositiveZ;
-			voxelIsValid &= (cell.z >= 0) && (cell.z < gridDepth);
-			zDistance = (((static_cast<double>(cell.z) - absoluteEye.z) + halfOneMinusStepZReal) / ray.dirZ);
+			for (int i = 0; i < rayCount; i++)
+			{
+				traversals[i].step<NonNegativeDirX, NonNegativeDirZ>(absoluteEye, rays[i], gridWidth, gridDepth);
+			}
+
+			continue;
 		}
-	};
 
-	// Step forward in the grid once to leave the initial voxel and update the Z distance.
-	doDDAStep();
+		const VisibleLightList &visLightList = SoftwareRenderer::getVisibleLightList(visLightLists,
+			cellX, cellZ, absoluteEyeVoxel.x, absoluteEyeVoxel.z, gridWidth, gridDepth, chunkDistance);
 
-	// Step through the voxel grid while the current coordinate is valid, the 
-	// distance stepped is less than the distance at which fog is maximum, and
-	// the column is not completely occluded.
-	while (voxelIsValid && (zDistance < shadingInfo.fogDistance) &&
-		(occlusion.yMin != occlusion.yMax))
-	{
-		// Store the cell coordinates, axis, and Z distance for wall rendering. The
-		// loop needs to do another DDA step to calculate the far point.
-		const SNInt savedCellX = cell.x;
-		const WEInt savedCellZ = cell.z;
-		const VoxelFacing2D savedFacing = facing;
-		const double wallDistance = zDistance;
+		for (int i = 0; i < rayCount; i++)
+		{
+			const Ray &ray = rays[i];
+			RayTraversal &traversal = traversals[i];
+			const VoxelFacing2D savedFacing = traversal.facing;
+			const double wallDistance = traversal.zDistance;
+			traversal.step<NonNegativeDirX, NonNegativeDirZ>(absoluteEye, ray, gridWidth, gridDepth);
 
-		// Decide which voxel in the XZ plane to step to next, and update the Z distance.
-		doDDAStep();
+			const NewDouble2 nearPoint(
+				absoluteEye.x + (ray.dirX * wallDistance),
+				absoluteEye.z + (ray.dirZ * wallDistance));
+			const NewDouble2 farPoint(
+				absoluteEye.x + (ray.dirX * traversal.zDistance),
+				absoluteEye.z + (ray.dirZ * traversal.zDistance));
 
-		// Near and far points in the XZ plane. The near point is where the wall is, and 
-		// the far point is used with the near point for drawing the floor and ceiling.
-		const NewDouble2 nearPoint(
-			absoluteEye.x + (ray.dirX * wallDistance),
-			absoluteEye.z + (ray.dirZ * wallDistance));
-		const NewDouble2 farPoint(
-			absoluteEye.x + (ray.dirX * zDistance),
-			absoluteEye.z + (ray.dirZ * zDistance));
+			SoftwareRenderer::drawVoxelColumn(startX + i, column, camera, ray, savedFacing, nearPoint,
+				farPoint, wallDistance, traversal.zDistance, shadingInfo, chunkDistance, ceilingHeight,
+				levelSnapshot, visLights, visLightList, textures, chasmTextureGroups, occlusion[i], frame);
+		}
+	}
 
-		// Draw all voxels in a column at the given XZ coordinate.
-		SoftwareRenderer::drawVoxelColumn(x, savedCellX, savedCellZ, camera, ray, savedFacing,
-			nearPoint, farPoint, wallDistance, zDistance, shadingInfo, chunkDistance, ceilingHeight,
-			levelData, visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
+	// The rays have diverged (or stopped), so finish each one individually.
+	for (int i = 0; i < rayCount; i++)
+	{
+		SoftwareRenderer::rayCast2DContinue<NonNegativeDirX, NonNegativeDirZ>(startX + i, camera, rays[i],
+			traversals[i], shadingInfo, chunkDistance, ceilingHeight, levelSnapshot, visLights, visLightLists,
+			textures, chasmTextureGroups, occlusion[i], frame);
 	}
 }
 
 void SoftwareRenderer::rayCast2D(int x, const Camera &camera, const Ray &ray, const ShadingInfo &shadingInfo,
-	int chunkDistance, double ceilingHeight, const LevelData &levelData,
-	const BufferView<const VisibleLight> &visLights, const BufferView2D<const VisibleLightList> &visLightLists,
+	int chunkDistance, double ceilingHeight, const LevelSnapshot &levelSnapshot,
+	const VisibleLightPool &visLights, const BufferView2D<const VisibleLightList> &visLightLists,
 	const VoxelTextures &textures, const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion,
 	const FrameView &frame)
 {
@@ -7611,12 +10117,12 @@ void SoftwareRenderer::rayCast2D(int x, const Camera &camera, const Ray &ray, co
 		if (nonNegativeDirZ)
 		{
 			SoftwareRenderer::rayCast2DInternal<true, true>(x, camera, ray, shadingInfo, chunkDistance,
-				ceilingHeight, levelData, visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
+				ceilingHeight, levelSnapshot, visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
 		}
 		else
 		{
 			SoftwareRenderer::rayCast2DInternal<true, false>(x, camera, ray, shadingInfo, chunkDistance,
-				ceilingHeight, levelData, visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
+				ceilingHeight, levelSnapshot, visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
 		}
 	}
 	else
@@ -7624,29 +10130,89 @@ void SoftwareRenderer::rayCast2D(int x, const Camera &camera, const Ray &ray, co
 		if (nonNegativeDirZ)
 		{
 			SoftwareRenderer::rayCast2DInternal<false, true>(x, camera, ray, shadingInfo, chunkDistance,
-				ceilingHeight, levelData, visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
+				ceilingHeight, levelSnapshot, visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
 		}
 		else
 		{
 			SoftwareRenderer::rayCast2DInternal<false, false>(x, camera, ray, shadingInfo, chunkDistance,
-				ceilingHeight, levelData, visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
+				ceilingHeight, levelSnapshot, visLights, visLightLists, textures, chasmTextureGroups, occlusion, frame);
+		}
+	}
+}
+
+void SoftwareRenderer::rayCast2DBundle(int startX, int rayCount, const Ray *rays, const Camera &camera,
+	const ShadingInfo &shadingInfo, int chunkDistance, double ceilingHeight,
+	const LevelSnapshot &levelSnapshot, const VisibleLightPool &visLights,
+	const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &textures,
+	const ChasmTextureGroups &chasmTextureGroups, OcclusionData *occlusion, const FrameView &frame)
+{
+	// Rays can only share DDA steps if they step in the same directions.
+	const bool nonNegativeDirX = rays[0].dirX >= 0.0;
+	const bool nonNegativeDirZ = rays[0].dirZ >= 0.0;
+
+	bool isCoherent = true;
+	for (int i = 1; i < rayCount; i++)
+	{
+		const Ray &ray = rays[i];
+		isCoherent &= ((ray.dirX >= 0.0) == nonNegativeDirX) && ((ray.dirZ >= 0.0) == nonNegativeDirZ);
+	}
+
+	if (!isCoherent)
+	{
+		for (int i = 0; i < rayCount; i++)
+		{
+			SoftwareRenderer::rayCast2D(startX + i, camera, rays[i], shadingInfo, chunkDistance, ceilingHeight,
+				levelSnapshot, visLights, visLightLists, textures, chasmTextureGroups, occlusion[i], frame);
+		}
+
+		return;
+	}
+
+	if (nonNegativeDirX)
+	{
+		if (nonNegativeDirZ)
+		{
+			SoftwareRenderer::rayCast2DBundleInternal<true, true>(startX, rayCount, rays, camera, shadingInfo,
+				chunkDistance, ceilingHeight, levelSnapshot, visLights, visLightLists, textures,
+				chasmTextureGroups, occlusion, frame);
+		}
+		else
+		{
+			SoftwareRenderer::rayCast2DBundleInternal<true, false>(startX, rayCount, rays, camera, shadingInfo,
+				chunkDistance, ceilingHeight, levelSnapshot, visLights, visLightLists, textures,
+				chasmTextureGroups, occlusion, frame);
+		}
+	}
+	else
+	{
+		if (nonNegativeDirZ)
+		{
+			SoftwareRenderer::rayCast2DBundleInternal<false, true>(startX, rayCount, rays, camera, shadingInfo,
+				chunkDistance, ceilingHeight, levelSnapshot, visLights, visLightLists, textures,
+				chasmTextureGroups, occlusion, frame);
+		}
+		else
+		{
+			SoftwareRenderer::rayCast2DBundleInternal<false, false>(startX, rayCount, rays, camera, shadingInfo,
+				chunkDistance, ceilingHeight, levelSnapshot, visLights, visLightLists, textures,
+				chasmTextureGroups, occlusion, frame);
 		}
 	}
 }
 
 void SoftwareRenderer::drawSkyGradient(int startY, int endY, double gradientProjYTop,
 	double gradientProjYBottom, Buffer<Double3> &skyGradientRowCache,
-	std::atomic<bool> &shouldDrawStars, const ShadingInfo &shadingInfo, const FrameView &frame)
+	std::atomic<bool> &shouldDrawStars, SkyCache &skyCache, const ShadingInfo &shadingInfo,
+	const FrameView &frame)
 {
 	// Lambda for drawing one row of colors and depth in the frame buffer.
-	auto drawSkyRow = [&frame](int y, const Double3 &color)
+	auto drawSkyRow = [&frame](int y, uint32_t colorValue)
 	{
 		uint32_t *colorPtr = frame.colorBuffer;
-		double *depthPtr = frame.depthBuffer;
+		DepthTexel *depthPtr = frame.depthBuffer;
 		const int startIndex = y * frame.width;
 		const int endIndex = (y + 1) * frame.width;
-		const uint32_t colorValue = color.toRGB();
-		constexpr double depthValue = DEPTH_BUFFER_INFINITY;
+		constexpr DepthTexel depthValue = DEPTH_TEXEL_INFINITY;
 
 		// Clear the color and depth of one row.
 		for (int i = startIndex; i < endIndex; i++)
@@ -7659,6 +10225,9 @@ void SoftwareRenderer::drawSkyGradient(int startY, int endY, double gradientProj
 	// While drawing the sky gradient, determine if it is dark enough for stars to be visible.
 	bool isDarkEnough = false;
 
+	// Whether any row looks different than in the stored sky.
+	bool rowsChanged = false;
+
 	for (int y = startY; y < endY; y++)
 	{
 		// Y percent across the screen.
@@ -7679,13 +10248,36 @@ void SoftwareRenderer::drawSkyGradient(int startY, int endY, double gradientProj
 		const double maxComp = std::max(std::max(color.x, color.y), color.z);
 		isDarkEnough |= maxComp <= ShadingInfo::STAR_VIS_THRESHOLD;
 
-		drawSkyRow(y, color);
+		// Compared before packing since distant objects blend with the unpacked color, which can
+		// change while the packed one stays the same.
+		if (color != skyCache.rowColors.get(y))
+		{
+			skyCache.rowColors.set(y, color);
+			rowsChanged = true;
+		}
+
+		drawSkyRow(y, color.toRGB());
 	}
 
 	if (isDarkEnough)
 	{
 		shouldDrawStars = true;
 	}
+
+	if (rowsChanged)
+	{
+		skyCache.gradientChanged = true;
+	}
+}
+
+void SoftwareRenderer::drawCachedSkyRows(int startY, int endY, const SkyCache &skyCache,
+	const FrameView &frame)
+{
+	const int startIndex = startY * frame.width;
+	const int endIndex = endY * frame.width;
+	std::copy(skyCache.colors.get() + startIndex, skyCache.colors.get() + endIndex,
+		frame.colorBuffer + startIndex);
+	std::fill(frame.depthBuffer + startIndex, frame.depthBuffer + endIndex, DEPTH_TEXEL_INFINITY);
 }
 
 void SoftwareRenderer::drawDistantSky(int startX, int endX, const VisDistantObjects &visDistantObjs,
@@ -7768,8 +10360,78 @@ void SoftwareRenderer::drawDistantSky(int startX, int endX, const VisDistantObje
 	drawDistantObjRange(visDistantObjs.landStart, visDistantObjs.landEnd, DistantRenderType::General);
 }
 
-void SoftwareRenderer::drawVoxels(int startX, int stride, const Camera &camera, int chunkDistance,
-	double ceilingHeight, const LevelData &levelData, const BufferView<const VisibleLight> &visLights,
+void SoftwareRenderer::drawCachedDistantSky(int startX, int endX, const VisDistantObjects &visDistantObjs,
+	const std::vector<SkyTexture> &skyTextures, const Buffer<Double3> &skyGradientRowCache,
+	bool shouldDrawStars, SkyCache &skyCache, const ShadingInfo &shadingInfo, const FrameView &frame)
+{
+	// The stored sky was already copied with the sky gradient.
+	if (skyCache.mode == SkyCache::Mode::Reuse)
+	{
+		return;
+	}
+
+	// Lambdas for copying columns between the frame buffer and the stored sky.
+	auto copyToFrame = [&skyCache, &frame](int x0, int x1)
+	{
+		for (int y = 0; y < frame.height; y++)
+		{
+			const int index = x0 + (y * frame.width);
+			std::copy(skyCache.colors.get() + index, skyCache.colors.get() + index + (x1 - x0),
+				frame.colorBuffer + index);
+		}
+	};
+
+	auto copyToCache = [&skyCache, &frame](int x0, int x1)
+	{
+		for (int y = 0; y < frame.height; y++)
+		{
+			const int index = x0 + (y * frame.width);
+			std::copy(frame.colorBuffer + index, frame.colorBuffer + index + (x1 - x0),
+				skyCache.colors.get() + index);
+		}
+	};
+
+	// Any change to the gradient or star visibility affects every column.
+	const bool redrawAll = (skyCache.mode == SkyCache::Mode::Redraw) || skyCache.gradientChanged ||
+		(shouldDrawStars != skyCache.starsVisible);
+
+	if (redrawAll)
+	{
+		SoftwareRenderer::drawDistantSky(startX, endX, visDistantObjs, skyTextures, skyGradientRowCache,
+			shouldDrawStars, shadingInfo, frame);
+		copyToCache(startX, endX);
+		return;
+	}
+
+	// The frame has the current sky gradient, which matches the stored one. Only columns with
+	// different distant objects are drawn; the rest are copied.
+	int x = startX;
+	while (x < endX)
+	{
+		const bool isDirty = skyCache.dirtyColumns.get(x);
+		int runEnd = x + 1;
+		while ((runEnd < endX) && (skyCache.dirtyColumns.get(runEnd) == isDirty))
+		{
+			runEnd++;
+		}
+
+		if (isDirty)
+		{
+			SoftwareRenderer::drawDistantSky(x, runEnd, visDistantObjs, skyTextures, skyGradientRowCache,
+				shouldDrawStars, shadingInfo, frame);
+			copyToCache(x, runEnd);
+		}
+		else
+		{
+			copyToFrame(x, runEnd);
+		}
+
+		x = runEnd;
+	}
+}
+
+void SoftwareRenderer::drawVoxels(int startX, int endX, const Camera &camera, int chunkDistance,
+	double ceilingHeight, const LevelSnapshot &levelSnapshot, const VisibleLightPool &visLights,
 	const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &voxelTextures,
 	const ChasmTextureGroups &chasmTextureGroups, Buffer<OcclusionData> &occlusion,
 	const ShadingInfo &shadingInfo, const FrameView &frame)
@@ -7777,8 +10439,7 @@ void SoftwareRenderer::drawVoxels(int startX, int stride, const Camera &camera,
 	const NewDouble2 forwardZoomed(camera.forwardZoomedX, camera.forwardZoomedZ);
 	const NewDouble2 rightAspected(camera.rightAspectedX, camera.rightAspectedZ);
 
-	// Draw pixel columns with spacing determined by the number of render threads.
-	for (int x = startX; x < frame.width; x += stride)
+	auto makeRay = [&frame, &forwardZoomed, &rightAspected](int x)
 	{
 		// X percent across the screen.
 		const double xPercent = (static_cast<double>(x) + 0.50) / frame.widthReal;
@@ -7790,52 +10451,125 @@ void SoftwareRenderer::drawVoxels(int startX, int stride, const Camera &camera,
 		// - If un-normalized, it uses the Z distance, but the insides of voxels
 		//   don't look right then.
 		const NewDouble2 direction = (forwardZoomed + rightComp).normalized();
-		const Ray ray(direction.x, direction.y);
+		return Ray(direction.x, direction.y);
+	};
+
+	if (CoherentRayBundles)
+	{
+		for (int x = startX; x < endX; x += SoftwareRenderer::RAY_BUNDLE_SIZE)
+		{
+			const int rayCount = std::min(SoftwareRenderer::RAY_BUNDLE_SIZE, endX - x);
+			Ray rays[SoftwareRenderer::RAY_BUNDLE_SIZE];
+			for (int i = 0; i < rayCount; i++)
+			{
+				rays[i] = makeRay(x + i);
+			}
 
-		// Cast the 2D ray and fill in the column's pixels with color.
-		SoftwareRenderer::rayCast2D(x, camera, ray, shadingInfo, chunkDistance, ceilingHeight, levelData,
-			visLights, visLightLists, voxelTextures, chasmTextureGroups, occlusion.get(x), frame);
+			// Cast the 2D rays together and fill in their columns' pixels with color.
+			SoftwareRenderer::rayCast2DBundle(x, rayCount, rays, camera, shadingInfo, chunkDistance,
+				ceilingHeight, levelSnapshot, visLights, visLightLists, voxelTextures, chasmTextureGroups,
+				&occlusion.get(x), frame);
+		}
+	}
+	else
+	{
+		for (int x = startX; x < endX; x++)
+		{
+			// Cast the 2D ray and fill in the column's pixels with color.
+			const Ray ray = makeRay(x);
+			SoftwareRenderer::rayCast2D(x, camera, ray, shadingInfo, chunkDistance, ceilingHeight, levelSnapshot,
+				visLights, visLightLists, voxelTextures, chasmTextureGroups, occlusion.get(x), frame);
+		}
 	}
 }
 
 void SoftwareRenderer::drawFlats(int startX, int endX, const Camera &camera,
 	const Double3 &flatNormal, const std::vector<VisibleFlat> &visibleFlats,
-	const FlatTextureGroups &flatTextureGroups, const ShadingInfo &shadingInfo, int chunkDistance,
-	const BufferView<const VisibleLight> &visLights,
+	const std::vector<std::vector<int>> &visibleFlatBins, const FlatTextureGroups &flatTextureGroups,
+	const ShadingInfo &shadingInfo, int chunkDistance, const VisibleLightPool &visLights,
 	const BufferView2D<const VisibleLightList> &visLightLists, SNInt gridWidth, WEInt gridDepth,
-	const FrameView &frame)
+	FlatShadingCache &shadingCache, const FrameView &frame)
 {
-	// Iterate through all flats, rendering those visible within the given X range of 
-	// the screen.
-	for (const VisibleFlat &flat : visibleFlats)
+	if (startX >= endX)
 	{
-		const NewDouble3 absoluteEye = VoxelUtils::coordToNewPoint(camera.eye);
-		const NewInt3 absoluteEyeVoxel = VoxelUtils::coordToNewVoxel(camera.eyeVoxel);
-		const NewDouble2 eye2D(absoluteEye.x, absoluteEye.z);
-		const NewInt2 eyeVoxel2D(absoluteEyeVoxel.x, absoluteEyeVoxel.z);
+		return;
+	}
+
+	const NewDouble3 absoluteEye = VoxelUtils::coordToNewPoint(camera.eye);
+	const NewInt3 absoluteEyeVoxel = VoxelUtils::coordToNewVoxel(camera.eyeVoxel);
+	const NewDouble2 eye2D(absoluteEye.x, absoluteEye.z);
+	const NewInt2 eyeVoxel2D(absoluteEyeVoxel.x, absoluteEyeVoxel.z);
+
+	// Iterate through the flats in each bin overlapping the given X range of the screen. Bins
+	// cover separate columns, so each one is drawn on its own in back-to-front order.
+	const int firstBin = startX / SoftwareRenderer::FLAT_BIN_WIDTH;
+	const int lastBin = std::min((endX - 1) / SoftwareRenderer::FLAT_BIN_WIDTH,
+		static_cast<int>(visibleFlatBins.size()) - 1);
+	for (int bin = firstBin; bin <= lastBin; bin++)
+	{
+		const int binStartX = std::max(bin * SoftwareRenderer::FLAT_BIN_WIDTH, startX);
+		const int binEndX = std::min((bin + 1) * SoftwareRenderer::FLAT_BIN_WIDTH, endX);
+
+		for (const int flatIndex : visibleFlatBins[bin])
+		{
+			const VisibleFlat &flat = visibleFlats[flatIndex];
 
-		// Texture of the flat. It might be flipped horizontally as well, given by
-		// the "flat.flipped" value.
-		const EntityRenderID entityRenderID = flat.entityRenderID;
-		const FlatTextureGroup &textureGroup = flatTextureGroups[entityRenderID];
-		const FlatTexture &texture = textureGroup.getTexture(
-			flat.animStateID, flat.animAngleID, flat.animTextureID);
+			// Texture of the flat. It might be flipped horizontally as well, given by
+			// the "flat.flipped" value.
+			const EntityRenderID entityRenderID = flat.entityRenderID;
+			const FlatTextureGroup &textureGroup = flatTextureGroups[entityRenderID];
+			const FlatTexture &texture = textureGroup.getTexture(
+				flat.animStateID, flat.animAngleID, flat.animTextureID);
 
-		SoftwareRenderer::drawFlat(startX, endX, flat, flatNormal, eye2D, eyeVoxel2D, camera.horizonProjY,
-			shadingInfo, flat.overridePalette, chunkDistance, texture, visLights, visLightLists, gridWidth,
-			gridDepth, frame);
+			SoftwareRenderer::drawFlat(binStartX, binEndX, flat, flatNormal, eye2D, eyeVoxel2D,
+				camera.horizonProjY, shadingInfo, flat.overridePalette, chunkDistance, texture, visLights,
+				visLightLists, gridWidth, gridDepth, shadingCache, frame);
+		}
+	}
+}
+
+void SoftwareRenderer::waitForThreads(const std::atomic<int> &threadsDone, int totalThreads)
+{
+	while (threadsDone.load(std::memory_order_acquire) < totalThreads)
+	{
+		std::this_thread::yield();
+	}
+}
+
+void SoftwareRenderer::waitForFlag(const std::atomic<bool> &flag)
+{
+	while (!flag.load(std::memory_order_acquire))
+	{
+		std::this_thread::yield();
 	}
 }
 
-void SoftwareRenderer::renderThreadLoop(RenderThreadData &threadData, int threadIndex, int startX,
-	int endX, int startY, int endY)
+void SoftwareRenderer::getRenderThreadBlock(int threadIndex, int threadCount, int size,
+	int *outStart, int *outEnd)
+{
+	// Block size is the approximate number of columns or rows per thread.
+	const double blockSize = static_cast<double>(size) / static_cast<double>(threadCount);
+	*outStart = static_cast<int>(std::round(static_cast<double>(threadIndex) * blockSize));
+	*outEnd = static_cast<int>(std::round(static_cast<double>(threadIndex + 1) * blockSize));
+
+	// Make sure the rounding is correct.
+	DebugAssert(*outStart >= 0);
+	DebugAssert(*outEnd <= size);
+}
+
+void SoftwareRenderer::renderThreadLoop(RenderThreadData &threadData, int threadIndex)
 {
+	using Clock = std::chrono::high_resolution_clock;
+
 	while (true)
 	{
 		// Initial wait condition. The lock must be unlocked after wait() so other threads can
-		// lock it.
+		// lock it. Threads outside this frame's thread count keep waiting.
 		std::unique_lock<std::mutex> lk(threadData.mutex);
-		threadData.condVar.wait(lk, [&threadData]() { return threadData.go; });
+		threadData.condVar.wait(lk, [&threadData, threadIndex]()
+		{
+			return threadData.isDestructing || (threadData.go && (threadIndex < threadData.totalThreads));
+		});
 		lk.unlock();
 
 		// Received a go signal. Check if the renderer is being destroyed before doing anything.
@@ -7844,103 +10578,174 @@ void SoftwareRenderer::renderThreadLoop(RenderThreadData &threadData, int thread
 			break;
 		}
 
-		// Lambda for making a thread wait until others are finished rendering something. The last
-		// thread to call this calls notify on all others.
-		auto threadBarrier = [&threadData, &lk](auto &data)
+		// Per-thread data is looked up each frame since the pool can grow between frames.
+		RenderThreadStats &stats = threadData.threadStats.get(threadIndex);
+
+		const auto frameStartTime = Clock::now();
+		stats.clear();
+
+		// Get this thread's columns and rows for the current frame dimensions.
+		const FrameView &frame = *threadData.frame;
+		int startX, endX, startY, endY;
+		SoftwareRenderer::getRenderThreadBlock(threadIndex, threadData.totalThreads, frame.width,
+			&startX, &endX);
+		SoftwareRenderer::getRenderThreadBlock(threadIndex, threadData.totalThreads, frame.height,
+			&startY, &endY);
+
+		// Lambda for waiting on other threads or the main thread, which counts as idle time.
+		auto waitIdle = [&stats](auto &&waitFunc)
+		{
+			const auto waitStartTime = Clock::now();
+			waitFunc();
+			const auto waitEndTime = Clock::now();
+			stats.idleTime += std::chrono::duration<double>(waitEndTime - waitStartTime).count();
+		};
+
+		// Lambda for timing a phase's drawing, not counting waits on other threads.
+		auto timePhase = [](double &phaseTime, auto &&drawFunc)
+		{
+			const auto phaseStartTime = Clock::now();
+			drawFunc();
+			const auto phaseEndTime = Clock::now();
+			phaseTime = std::chrono::duration<double>(phaseEndTime - phaseStartTime).count();
+		};
+
+		// Lambda for making a thread wait until others are finished rendering something.
+		auto threadBarrier = [&threadData, &waitIdle](auto &data)
 		{
-			lk.lock();
-			data.threadsDone++;
+			data.threadsDone.fetch_add(1, std::memory_order_acq_rel);
+			waitIdle([&threadData, &data]()
+			{
+				SoftwareRenderer::waitForThreads(data.threadsDone, threadData.totalThreads);
+			});
+		};
 
-			// If this was the last thread, notify all to continue.
-			if (data.threadsDone == threadData.totalThreads)
+		// Draw this thread's portion of the sky gradient, or copy it from the sky cache if the
+		// whole sky is unchanged.
+		RenderThreadData::SkyGradient &skyGradient = threadData.skyGradient;
+		SkyCache &skyCache = *skyGradient.skyCache;
+		timePhase(stats.skyTime, [&]()
+		{
+			if (skyCache.mode == SkyCache::Mode::Reuse)
 			{
-				lk.unlock();
-				threadData.condVar.notify_all();
+				SoftwareRenderer::drawCachedSkyRows(startY, endY, skyCache, *threadData.frame);
 			}
 			else
 			{
-				// Wait for other threads to finish.
-				threadData.condVar.wait(lk, [&threadData, &data]()
-				{
-					return data.threadsDone == threadData.totalThreads;
-				});
-
-				lk.unlock();
+				SoftwareRenderer::drawSkyGradient(startY, endY, skyGradient.projectedYTop,
+					skyGradient.projectedYBottom, *skyGradient.rowCache, skyGradient.shouldDrawStars,
+					skyCache, *threadData.shadingInfo, *threadData.frame);
 			}
-		};
-
-		// Draw this thread's portion of the sky gradient.
-		RenderThreadData::SkyGradient &skyGradient = threadData.skyGradient;
-		SoftwareRenderer::drawSkyGradient(startY, endY, skyGradient.projectedYTop,
-			skyGradient.projectedYBottom, *skyGradient.rowCache, skyGradient.shouldDrawStars,
-			*threadData.shadingInfo, *threadData.frame);
+		});
 
 		// Wait for other threads to finish the sky gradient.
 		threadBarrier(skyGradient);
 
 		// Wait for the visible distant object testing to finish.
 		RenderThreadData::DistantSky &distantSky = threadData.distantSky;
-		lk.lock();
-		threadData.condVar.wait(lk, [&distantSky]() { return distantSky.doneVisTesting; });
-		lk.unlock();
+		waitIdle([&distantSky]() { SoftwareRenderer::waitForFlag(distantSky.doneVisTesting); });
 
 		// Draw this thread's portion of distant sky objects.
-		SoftwareRenderer::drawDistantSky(startX, endX, *distantSky.visDistantObjs,
-			*distantSky.skyTextures, *skyGradient.rowCache, skyGradient.shouldDrawStars,
-			*threadData.shadingInfo, *threadData.frame);
+		timePhase(stats.distantSkyTime, [&]()
+		{
+			SoftwareRenderer::drawCachedDistantSky(startX, endX, *distantSky.visDistantObjs,
+				*distantSky.skyTextures, *skyGradient.rowCache, skyGradient.shouldDrawStars, skyCache,
+				*threadData.shadingInfo, *threadData.frame);
+		});
 
 		// Wait for other threads to finish distant sky objects.
 		threadBarrier(distantSky);
 
 		// Wait for visible light testing to finish.
 		RenderThreadData::Voxels &voxels = threadData.voxels;
-		lk.lock();
-		threadData.condVar.wait(lk, [&voxels]() { return voxels.doneLightVisTesting; });
-		lk.unlock();
+		waitIdle([&voxels]() { SoftwareRenderer::waitForFlag(voxels.doneLightVisTesting); });
 
-		// Number of columns to skip per ray cast (for interleaved ray casting as a means of
-		// load-balancing).
-		const int strideX = threadData.totalThreads;
-
-		// Draw this thread's portion of voxels.
-		const BufferView<const VisibleLight> voxelsVisLightsView(voxels.visLights->data(),
-			static_cast<int>(voxels.visLights->size()));
+		// Draw voxel column tiles, starting with this thread's own queue and then stealing from
+		// neighboring threads' queues once it's empty, so threads facing open sky don't sit idle
+		// while others are still ray casting down a city street.
+		const VisibleLightPool &voxelsVisLights = *voxels.visLights;
 		const BufferView2D<const VisibleLightList> voxelsVisLightListsView(voxels.visLightLists->get(),
 			voxels.visLightLists->getWidth(), voxels.visLightLists->getHeight());
-		SoftwareRenderer::drawVoxels(threadIndex, strideX, *threadData.camera, voxels.chunkDistance,
-			voxels.ceilingHeight, *voxels.levelData, voxelsVisLightsView, voxelsVisLightListsView,
-			*voxels.voxelTextures, *voxels.chasmTextureGroups, *voxels.occlusion, *threadData.shadingInfo,
-			*threadData.frame);
+		auto drawVoxelTile = [&threadData, &voxels, &voxelsVisLights, &voxelsVisLightListsView, &frame](int tile)
+		{
+			const int tileStartX = tile * SoftwareRenderer::VOXEL_COLUMN_TILE_WIDTH;
+			const int tileEndX = std::min(tileStartX + SoftwareRenderer::VOXEL_COLUMN_TILE_WIDTH, frame.width);
+			SoftwareRenderer::drawVoxels(tileStartX, tileEndX, *threadData.camera, voxels.chunkDistance,
+				voxels.ceilingHeight, *voxels.levelSnapshot, voxelsVisLights, voxelsVisLightListsView,
+				*voxels.voxelTextures, *voxels.chasmTextureGroups, *voxels.occlusion, *threadData.shadingInfo,
+				frame);
+		};
+
+		timePhase(stats.voxelTime, [&]()
+		{
+			int tile;
+			ColumnTileQueue &ownTileQueue = voxels.tileQueues.get(threadIndex);
+			while (ownTileQueue.tryPopFront(&tile))
+			{
+				drawVoxelTile(tile);
+			}
+
+			for (int i = 1; i < threadData.totalThreads; i++)
+			{
+				const int victimIndex = (threadIndex + i) % threadData.totalThreads;
+				ColumnTileQueue &victimTileQueue = voxels.tileQueues.get(victimIndex);
+				while (victimTileQueue.tryPopBack(&tile))
+				{
+					drawVoxelTile(tile);
+					stats.stolenTileCount++;
+				}
+			}
+		});
 
 		// Wait for other threads to finish voxels.
 		threadBarrier(voxels);
 
 		// Wait for the visible flat sorting to finish.
 		RenderThreadData::Flats &flats = threadData.flats;
-		lk.lock();
-		threadData.condVar.wait(lk, [&flats]() { return flats.doneSorting; });
-		lk.unlock();
+		waitIdle([&flats]() { SoftwareRenderer::waitForFlag(flats.doneSorting); });
 
 		// Draw this thread's portion of flats.
-		const BufferView<const VisibleLight> flatsVisLightsView(flats.visLights->data(),
-			static_cast<int>(flats.visLights->size()));
 		const BufferView2D<const VisibleLightList> flatsVisLightListsView(flats.visLightLists->get(),
 			flats.visLightLists->getWidth(), flats.visLightLists->getHeight());
-		const VoxelGrid &voxelGrid = voxels.levelData->getVoxelGrid();
-		SoftwareRenderer::drawFlats(startX, endX, *threadData.camera, *flats.flatNormal, *flats.visibleFlats,
-			*flats.flatTextureGroups, *threadData.shadingInfo, voxels.chunkDistance, flatsVisLightsView,
-			flatsVisLightListsView, voxelGrid.getWidth(), voxelGrid.getDepth(), *threadData.frame);
+		const VoxelGrid &voxelGrid = voxels.levelSnapshot->getVoxelGrid();
+
+		// Shaded palettes shared by this thread's flats.
+		FlatShadingCache shadingCache;
+		timePhase(stats.flatTime, [&]()
+		{
+			SoftwareRenderer::drawFlats(startX, endX, *threadData.camera, *flats.flatNormal, *flats.visibleFlats,
+				*flats.visibleFlatBins, *flats.flatTextureGroups, *threadData.shadingInfo, voxels.chunkDistance,
+				*flats.visLights, flatsVisLightListsView, voxelGrid.getWidth(), voxelGrid.getDepth(),
+				shadingCache, *threadData.frame);
+		});
 
-		// Wait for other threads to finish flats.
-		threadBarrier(flats);
+		stats.flatShadingHitCount = shadingCache.getHitCount();
+		stats.flatShadingMissCount = shadingCache.getMissCount();
+
+		// Stats must be written before signaling the main thread, which reads them once every
+		// thread is done.
+		const auto frameEndTime = Clock::now();
+		const double frameTime = std::chrono::duration<double>(frameEndTime - frameStartTime).count();
+		stats.busyTime = frameTime - stats.idleTime;
+		stats.endTime = frameEndTime;
+
+		// Nothing is left to draw this frame, so there's no need to wait on the other threads.
+		flats.threadsDone.fetch_add(1, std::memory_order_release);
 	}
 }
 
-void SoftwareRenderer::render(const CoordDouble3 &eye, const Double3 &direction, double fovY, double ambient,
-	double daytimePercent, double chasmAnimPercent, double latitude, bool nightLightsAreActive, bool isExterior,
-	bool playerHasLight, int chunkDistance, double ceilingHeight, const LevelData &levelData,
-	const EntityDefinitionLibrary &entityDefLibrary, const Palette &palette, uint32_t *colorBuffer)
+void SoftwareRenderer::render(const RenderCamera &renderCamera, const RenderFrameSettings &settings,
+	const RenderInstanceGroup &instGroup, const LevelData &levelData, const Palette &palette,
+	uint32_t *colorBuffer)
 {
+	// Render threads must be done with the previous frame before any of its data is replaced.
+	this->finishFrame();
+	this->frameStartTime = std::chrono::high_resolution_clock::now();
+
+	const double daytimePercent = settings.getDaytimePercent();
+	const int chunkDistance = settings.getChunkDistance();
+	const double ceilingHeight = settings.getCeilingHeight();
+
 	// Constants for screen dimensions.
 	const double widthReal = static_cast<double>(this->width);
 	const double heightReal = static_cast<double>(this->height);
@@ -7949,35 +10754,70 @@ void SoftwareRenderer::render(const CoordDouble3 &eye, const Double3 &direction,
 	// To account for tall pixels.
 	const double projectionModifier = ArenaRenderUtils::TALL_PIXEL_RATIO;
 
-	// 2.5D camera definition.
-	const Camera camera(eye, direction, fovY, aspect, projectionModifier);
+	// 2.5D camera definition. Per-frame values are members so they outlive this function when
+	// frames are pipelined.
+	const Camera &camera = this->frameCamera.emplace(renderCamera.getEye(), renderCamera.getDirection(),
+		renderCamera.getFovY(), aspect, projectionModifier);
 
 	// Normal of all flats (always facing the camera).
 	const Double3 flatNormal = Double3(-camera.forwardX, 0.0, -camera.forwardZ).normalized();
 
 	// Calculate shading information for this frame. Create some helper structs to keep similar
 	// values together.
-	const ShadingInfo shadingInfo(palette, this->skyPalette, daytimePercent, latitude, ambient,
-		this->fogDistance, chasmAnimPercent, nightLightsAreActive, isExterior, playerHasLight);
-	const FrameView frame(colorBuffer, this->depthBuffer.get(), this->width, this->height);
+	const ShadingInfo &shadingInfo = this->frameShadingInfo.emplace(palette, this->skyPalette,
+		daytimePercent, settings.getLatitude(), settings.getAmbient(), this->fogDistance,
+		settings.getChasmAnimPercent(), settings.areNightLightsActive(), settings.isExterior(),
+		settings.hasPlayerLight());
+
+	// When pipelined, render threads draw into the back color buffer while the game updates, and
+	// the level is copied so the game can change it freely in the meantime.
+	uint32_t *frameColorBuffer = colorBuffer;
+	if (this->pipelined)
+	{
+		this->backColorBufferIndex ^= 1;
+		frameColorBuffer = this->colorBuffers[this->backColorBufferIndex].get();
+		this->levelSnapshot.initCopy(levelData, camera.eye.chunk, chunkDistance);
+	}
+	else
+	{
+		this->levelSnapshot.initLive(levelData);
+	}
+
+	const FrameView &frame = this->frameView.emplace(frameColorBuffer, this->depthBuffer.get(),
+		this->width, this->height, shadingInfo.fogDistance);
 
 	// Projected Y range of the sky gradient.
 	double gradientProjYTop, gradientProjYBottom;
 	SoftwareRenderer::getSkyGradientProjectedYRange(camera, gradientProjYTop, gradientProjYBottom);
 
-	// Set all the render-thread-specific shared data for this frame.
-	this->threadData.init(this->renderThreads.getCount(), camera, shadingInfo, frame);
-	this->threadData.skyGradient.init(gradientProjYTop, gradientProjYBottom, this->skyGradientRowCache);
+	// Decide how much of the previous sky can be reused.
+	const int daytimeStep = static_cast<int>(daytimePercent * static_cast<double>(SkyCacheDaytimeSteps));
+	this->skyCache.beginFrame(camera, daytimeStep, shadingInfo.distantAmbient,
+		this->distantObjects.getAnimLandFrameHash());
+
+	// Resolve texture handles for any voxel definitions added since the level was activated (i.e.,
+	// chasms from fading floors). This must happen before the render threads start reading them.
+	this->voxelTextures.updateHandles(levelData.getVoxelGrid());
+
+	// Set all the render-thread-specific shared data for this frame. The thread count is read by
+	// idle threads in their wait condition, so it's set under the lock.
+	std::unique_lock<std::mutex> lk(this->threadData.mutex);
+	this->threadData.init(this->renderThreadCount, camera, shadingInfo, frame);
+	lk.unlock();
+
+	this->threadData.skyGradient.init(gradientProjYTop, gradientProjYBottom, this->skyGradientRowCache,
+		this->skyCache);
 	this->threadData.distantSky.init(this->visDistantObjs, this->skyTextures);
-	this->threadData.voxels.init(chunkDistance, ceilingHeight, levelData, this->visibleLights,
-		this->visLightLists, this->voxelTextures, this->chasmTextureGroups, this->occlusion);
-	this->threadData.flats.init(flatNormal, this->visibleFlats, this->visibleLights, this->visLightLists,
-		this->flatTextureGroups);
+	this->threadData.voxels.init(chunkDistance, ceilingHeight, this->levelSnapshot, this->visLightPool,
+		this->visLightLists, this->voxelTextures, this->chasmTextureGroups, this->occlusion, this->width,
+		this->renderThreadCount);
+	this->threadData.flats.init(flatNormal, this->visibleFlats, this->visibleFlatBins, this->visLightPool,
+		this->visLightLists, this->flatTextureGroups);
 
 	// Give the render threads the go signal. They can work on the sky and voxels while this thread
 	// does things like resetting occlusion and doing visible flat determination.
 	// - Note about locks: they must always be locked before wait(), and stay locked after wait().
-	std::unique_lock<std::mutex> lk(this->threadData.mutex);
+	lk.lock();
 	this->threadData.go = true;
 	lk.unlock();
 	this->threadData.condVar.notify_all();
@@ -7986,62 +10826,67 @@ void SoftwareRenderer::render(const CoordDouble3 &eye, const Double3 &direction,
 	// it is read.
 	this->occlusion.fill(OcclusionData(0, this->height));
 
-	// Refresh the visible distant objects.
-	this->updateVisibleDistantObjects(shadingInfo, camera, frame);
+	// Main thread visibility work is timed for the profiler. It overlaps with the render threads.
+	using Clock = std::chrono::high_resolution_clock;
+	const auto visStartTime = Clock::now();
 
-	lk.lock();
-	this->threadData.condVar.wait(lk, [this]()
+	// Refresh the visible distant objects unless the stored sky is being reused as-is.
+	if (this->skyCache.mode != SkyCache::Mode::Reuse)
 	{
-		return this->threadData.skyGradient.threadsDone == this->threadData.totalThreads;
-	});
+		this->updateVisibleDistantObjects(shadingInfo, camera, frame);
+		this->updateSkyCacheColumns();
+	}
+
+	const auto visDistantEndTime = Clock::now();
+
+	SoftwareRenderer::waitForThreads(this->threadData.skyGradient.threadsDone, this->threadData.totalThreads);
 
 	// Keep the render threads from getting the go signal again before the next frame.
+	lk.lock();
 	this->threadData.go = false;
+	lk.unlock();
 
 	// Let the render threads know that they can start drawing distant objects.
-	this->threadData.distantSky.doneVisTesting = true;
-	lk.unlock();
-	this->threadData.condVar.notify_all();
+	this->threadData.distantSky.doneVisTesting.store(true, std::memory_order_release);
 
 	// Refresh the visible flats. This should erase the old list, calculate a new list, and sort
 	// it by depth.
+	const auto visFlatsStartTime = Clock::now();
 	const VoxelGrid &voxelGrid = levelData.getVoxelGrid();
-	const EntityManager &entityManager = levelData.getEntityManager();
-	this->updateVisibleFlats(camera, shadingInfo, chunkDistance, ceilingHeight,
-		voxelGrid, entityManager, entityDefLibrary);
+	this->updateVisibleFlats(camera, shadingInfo, instGroup);
+	this->updateVisibleFlatBins();
 
 	// Refresh visible light lists used for shading voxels and entities efficiently.
 	this->updateVisibleLightLists(camera, chunkDistance, ceilingHeight, voxelGrid);
+	const auto visEndTime = Clock::now();
+	this->visibilityTime = std::chrono::duration<double>(visDistantEndTime - visStartTime).count() +
+		std::chrono::duration<double>(visEndTime - visFlatsStartTime).count();
 
-	lk.lock();
-	this->threadData.condVar.wait(lk, [this]()
-	{
-		return this->threadData.distantSky.threadsDone == this->threadData.totalThreads;
-	});
+	SoftwareRenderer::waitForThreads(this->threadData.distantSky.threadsDone, this->threadData.totalThreads);
 
 	// Let the render threads know that they can start drawing voxels.
-	this->threadData.voxels.doneLightVisTesting = true;
-	lk.unlock();
-	this->threadData.condVar.notify_all();
+	this->threadData.voxels.doneLightVisTesting.store(true, std::memory_order_release);
+	this->frameInFlight = true;
 
-	lk.lock();
-	this->threadData.condVar.wait(lk, [this]()
+	if (this->pipelined)
 	{
-		return this->threadData.voxels.threadsDone == this->threadData.totalThreads;
-	});
+		// Flats are already sorted and render threads wait on each other before drawing them, so
+		// there's nothing left for this thread to do. Present the previous frame while this one
+		// finishes in the background.
+		this->threadData.flats.doneSorting.store(true, std::memory_order_release);
 
-	// Let the render threads know that they can start drawing flats.
-	this->threadData.flats.doneSorting = true;
+		const Buffer<uint32_t> &frontColorBuffer = this->colorBuffers[this->backColorBufferIndex ^ 1];
+		std::copy(frontColorBuffer.get(), frontColorBuffer.end(), colorBuffer);
+		return;
+	}
 
-	lk.unlock();
-	this->threadData.condVar.notify_all();
+	SoftwareRenderer::waitForThreads(this->threadData.voxels.threadsDone, this->threadData.totalThreads);
+
+	// Let the render threads know that they can start drawing flats.
+	this->threadData.flats.doneSorting.store(true, std::memory_order_release);
 
 	// Wait until render threads are done drawing flats.
-	lk.lock();
-	this->threadData.condVar.wait(lk, [this]()
-	{
-		return this->threadData.flats.threadsDone == this->threadData.totalThreads;
-	});
+	this->finishFrame();
 }
 
 void SoftwareRenderer::submitFrame(const RenderDefinitionGroup &defGroup, const RenderInstanceGroup &instGroup,
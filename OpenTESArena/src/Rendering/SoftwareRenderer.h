@@ -3,9 +3,12 @@
 
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstdint>
+#include <limits>
 #include <mutex>
+#include <optional>
 #include <thread>
 #include <unordered_map>
 #include <vector>
@@ -38,12 +41,38 @@ enum class VoxelFacing2D;
 class SoftwareRenderer : public RendererSystem3D
 {
 private:
+	// Precision of per-pixel voxel and chasm shading. Texels only have 8-bit channels, so float is
+	// plenty. Building with TES_SHADING_DOUBLE matches the original double-precision output, for
+	// comparing against it.
+#if defined(TES_SHADING_DOUBLE)
+	using ShadingReal = double;
+#else
+	using ShadingReal = float;
+#endif
+
+	// Storage of one depth buffer texel. Depths are linear XZ distances from the eye, so float has
+	// plenty of precision within fog range and halves depth traffic compared to double. Building with
+	// TES_DEPTH_TEXEL_UINT16 stores depth normalized to the fog distance instead (anything past it is
+	// fully fogged anyway). Set to double when comparing against the original double-precision output.
+#if defined(TES_DEPTH_TEXEL_UINT16)
+	using DepthTexel = uint16_t;
+#else
+	using DepthTexel = float;
+#endif
+
+	// Depth texel value that is behind everything (i.e., the sky).
+	static constexpr DepthTexel DEPTH_TEXEL_INFINITY = std::numeric_limits<DepthTexel>::has_infinity ?
+		std::numeric_limits<DepthTexel>::infinity() : std::numeric_limits<DepthTexel>::max();
+
+	// Palette colors are stored as 8-bit channels and only normalized when sampled, which keeps
+	// each texel a few bytes instead of several doubles.
 	struct VoxelTexel
 	{
-		double r, g, b, emission;
+		uint8_t r, g, b;
+		uint8_t emission; // 0 is unlit, 255 is fully emissive.
 		bool transparent; // Only supports alpha testing, not alpha blending.
 
-		void init(double r, double g, double b, double emission, bool transparent);
+		void init(uint8_t r, uint8_t g, uint8_t b, uint8_t emission, bool transparent);
 	};
 
 	struct FlatTexel
@@ -65,9 +94,9 @@ private:
 
 	struct ChasmTexel
 	{
-		double r, g, b;
+		uint8_t r, g, b;
 
-		void init(double r, double g, double b);
+		void init(uint8_t r, uint8_t g, uint8_t b);
 	};
 
 	struct VoxelTexture
@@ -75,23 +104,38 @@ private:
 		std::vector<VoxelTexel> texels;
 		std::vector<Int2> lightTexels; // Black during the day, yellow at night.
 		// @todo: replace lightTexels with two VoxelTextures: one for day, one for night.
+		std::vector<VoxelTexture> mipmaps; // Each half the size of the previous, down to 1x1.
 		int width, height;
 
 		VoxelTexture();
 
 		void init(int width, int height, const uint8_t *srcTexels, const Palette &palette);
 		void setLightTexelsActive(bool active, const Palette &palette);
+
+		// Level 0 is the texture itself. Levels past the end are clamped to the smallest mipmap.
+		int getMipmapLevelCount() const;
+		const VoxelTexture &getMipmap(int level) const;
+	private:
+		// Regenerates the mipmaps from the full-resolution texels.
+		void initMipmaps();
 	};
 
 	struct FlatTexture
 	{
 		std::vector<FlatTexel> texels;
+		std::vector<FlatTexture> mipmaps; // Each half the size of the previous, down to 1x1.
 		int width, height;
 		bool reflective;
 
 		FlatTexture();
 
 		void init(int width, int height, const uint8_t *srcTexels, bool flipped, bool reflective);
+
+		// Level 0 is the texture itself. Levels past the end are clamped to the smallest mipmap.
+		int getMipmapLevelCount() const;
+		const FlatTexture &getMipmap(int level) const;
+	private:
+		void initMipmaps();
 	};
 
 	struct SkyTexture
@@ -125,14 +169,37 @@ private:
 		VoxelTextureMapping(TextureAssetReference &&textureAssetRef, int textureIndex);
 	};
 
+	// Texture indices of a voxel definition, resolved ahead of time so the ray caster can index the
+	// voxel textures list directly instead of comparing texture asset references every column.
+	struct VoxelTextureHandles
+	{
+		static constexpr int NO_TEXTURE = -1;
+
+		// Side texture for walls and raised platforms, or the only texture for other voxel types.
+		int primary;
+
+		// Only used by walls and raised platforms.
+		int floor, ceiling;
+
+		VoxelTextureHandles();
+	};
+
 	struct VoxelTextures
 	{
 		std::vector<VoxelTexture> textures;
 		std::vector<VoxelTextureMapping> mappings;
+		std::vector<VoxelTextureHandles> handles; // One per voxel definition ID.
 
 		void addTexture(VoxelTexture &&texture, TextureAssetReference &&textureAssetRef);
 
-		const VoxelTexture &getTexture(const TextureAssetReference &textureAssetRef) const;
+		// Slow look-up for a texture index by its asset reference, used when resolving handles.
+		std::optional<int> tryGetTextureIndex(const TextureAssetReference &textureAssetRef) const;
+
+		// Resolves texture handles for any voxel definitions that don't have them yet.
+		void updateHandles(const VoxelGrid &voxelGrid);
+
+		const VoxelTextureHandles &getHandles(uint16_t voxelID) const;
+		const VoxelTexture &getTexture(int textureIndex) const;
 
 		void clear();
 	};
@@ -195,6 +262,29 @@ private:
 		WEDouble dirZ;
 
 		Ray(SNDouble dirX, WEDouble dirZ);
+		Ray();
+	};
+
+	// DDA state of a 2D ray stepping through the voxel grid.
+	struct RayTraversal
+	{
+		NewInt3 cell; // Current voxel coordinate. The Y coordinate is constant.
+		SNDouble deltaDistX, deltaDistSumX;
+		WEDouble deltaDistZ, deltaDistSumZ;
+		double zDistance; // Distance to the most recently crossed voxel edge.
+		VoxelFacing2D facing; // Voxel face at the most recently crossed edge.
+		bool voxelIsValid;
+
+		// Starts the ray in the camera's voxel, with the Z distance and facing of the first
+		// voxel edge it reaches.
+		template <bool NonNegativeDirX, bool NonNegativeDirZ>
+		void init(const NewDouble3 &absoluteEye, const NewDouble3 &absoluteEyeVoxelReal,
+			const NewInt3 &absoluteEyeVoxel, const Ray &ray, SNInt gridWidth, int gridHeight,
+			WEInt gridDepth);
+
+		// Steps to the next XZ coordinate in the grid and updates the Z distance for the new edge.
+		template <bool NonNegativeDirX, bool NonNegativeDirZ>
+		void step(const NewDouble3 &absoluteEye, const Ray &ray, SNInt gridWidth, WEInt gridDepth);
 	};
 
 	// A draw range contains data for the vertical range that two projected vertices
@@ -292,11 +382,20 @@ private:
 	struct FrameView
 	{
 		uint32_t *colorBuffer;
-		double *depthBuffer;
+		DepthTexel *depthBuffer;
 		int width, height;
 		double widthReal, heightReal;
+		double depthEncodeScale, depthDecodeScale; // Only used by integer depth texels.
+
+		// The max depth is where integer depth texels run out of range (i.e., the fog distance).
+		FrameView(uint32_t *colorBuffer, DepthTexel *depthBuffer, int width, int height, double maxDepth);
 
-		FrameView(uint32_t *colorBuffer, double *depthBuffer, int width, int height);
+		// Converts between linear depth and the depth buffer's storage format.
+		DepthTexel encodeDepth(double depth) const;
+		double decodeDepth(DepthTexel texel) const;
+
+		double getDepth(int index) const;
+		void setDepth(int index, double depth) const;
 	};
 
 	// Each renderable entity ID has a set of animation state mappings to groups of texture
@@ -352,14 +451,64 @@ private:
 		// Camera Z for depth sorting.
 		double z;
 
+		// For keeping the sort order from one frame to the next.
+		EntityID entityID;
+
 		// Entity animation texture look-up values.
-		const Palette *overridePalette; // For citizen variations.
+		const Palette *overridePalette; // For citizen variations. Points into the renderer's copies.
 		EntityRenderID entityRenderID;
 		int animStateID;
 		int animAngleID;
 		int animTextureID;
 	};
 
+	// Flat texel colors for one palette with a column's shading and fog applied, indexed by palette
+	// index. Colors are filled in the first time they're used since most flats only use a few.
+	class FlatShadingTable
+	{
+	private:
+		static constexpr uint32_t UNSET_COLOR = 0xFFFFFFFF; // Output colors have no alpha bits.
+
+		std::array<uint32_t, 256> colors;
+		const Palette *palette;
+		double light, fogPercent;
+		int lightLevel, fogLevel;
+	public:
+		// Light and fog percents are quantized to this many steps so nearby columns share tables.
+		static constexpr int LEVEL_COUNT = 256;
+
+		FlatShadingTable();
+
+		bool matches(const Palette &palette, int lightLevel, int fogLevel) const;
+
+		void init(const Palette &palette, int lightLevel, int fogLevel);
+
+		// Gets the shaded color of a texel that isn't a ghost or puddle, including the red texel
+		// substitution. The fog color must be the same for every call on this table.
+		uint32_t getColor(uint8_t texelValue, const Double3 &fogColor);
+	};
+
+	// A few recently used flat shading tables. Meant for one thread's flats in one frame, so the fog
+	// color isn't part of the look-up.
+	class FlatShadingCache
+	{
+	private:
+		static constexpr int TABLE_COUNT = 8;
+
+		std::array<FlatShadingTable, TABLE_COUNT> tables;
+		int nextTableIndex; // Replaced next when no table matches.
+		int hitCount, missCount; // Look-ups that found a table or had to replace one.
+	public:
+		FlatShadingCache();
+
+		int getHitCount() const;
+		int getMissCount() const;
+
+		// Gets the table for the given palette (base or citizen override) and shading, replacing
+		// the oldest table if there isn't one yet.
+		FlatShadingTable &getTable(const Palette &palette, double light, double fogPercent);
+	};
+
 	// Pairs together a distant sky object with its render texture index. If it's an animation,
 	// then the index points to the start of its textures.
 	template <typename T>
@@ -377,11 +526,27 @@ private:
 		// Default index if no sun exists in the world.
 		static constexpr int NO_SUN = -1;
 
+		// Dimensions of the latitude-longitude grid that stars are grouped into.
+		static constexpr int STAR_CELL_ELEVATION_COUNT = 16;
+		static constexpr int STAR_CELL_AZIMUTH_COUNT = 32;
+
+		// A group of stars with similar directions (before latitude and time of day rotation).
+		// The bounds let the renderer reject every star in the cell with one test.
+		struct StarCell
+		{
+			Double3 direction; // Average direction of the cell's stars.
+			double chordRadius; // Max distance between the direction and any star's unit direction.
+			bool isWide; // Whether a star is a hemisphere or more away from the direction, so never culled.
+			double maxWidth; // Widest star texture in the cell, in distant sky units.
+			std::vector<int> starIndices; // Ascending indices into the stars list.
+		};
+
 		std::vector<DistantObject<DistantSky::LandObject>> lands;
 		std::vector<DistantObject<DistantSky::AnimatedLandObject>> animLands;
 		std::vector<DistantObject<DistantSky::AirObject>> airs;
 		std::vector<DistantObject<DistantSky::MoonObject>> moons;
 		std::vector<DistantObject<DistantSky::StarObject>> stars;
+		std::vector<StarCell> starCells; // Non-empty star cells.
 		int sunTextureIndex; // Points into skyTextures if the sun exists, or NO_SUN if it doesn't.
 
 		// @temp hack to assist with animated land texture count determination.
@@ -393,6 +558,15 @@ private:
 		void init(const DistantSky &distantSky, std::vector<SkyTexture> &skyTextures,
 			const Palette &palette, TextureManager &textureManager);
 
+		void initStarCells(const std::vector<SkyTexture> &skyTextures);
+
+		// Gets the sky texture index of an animated land's current frame, or -1 if its frame count
+		// isn't known.
+		int getAnimLandTextureIndex(const DistantObject<DistantSky::AnimatedLandObject> &animLand) const;
+
+		// Hash of every animated land's current frame, so a stored sky is redrawn when one changes.
+		uint64_t getAnimLandFrameHash() const;
+
 		void clear();
 	};
 
@@ -423,6 +597,45 @@ private:
 		void clear();
 	};
 
+	// The previous frame's sky (gradient and distant objects), reused while the camera orientation
+	// is unchanged and the time of day is within the same step. When only the time step changes
+	// and the gradient looks the same, just the columns whose distant objects moved are redrawn.
+	struct SkyCache
+	{
+		enum class Mode
+		{
+			Redraw, // Draw the whole sky and store it.
+			Reuse, // Copy the stored sky.
+			Update // Redraw columns whose distant objects changed, or everything if the gradient changed.
+		};
+
+		Buffer2D<uint32_t> colors;
+		Buffer<Double3> rowColors; // Sky gradient color of each row, as distant objects blend with it.
+		Buffer<uint64_t> columnHashes; // Distant objects covering each column.
+		Buffer<uint64_t> nextColumnHashes; // Scratch space for this frame's column hashes.
+		Buffer<bool> dirtyColumns; // Columns redrawn by an update.
+		VoxelDouble3 direction;
+		Degrees fovY;
+		double aspect;
+		double distantAmbient;
+		uint64_t animLandFrameHash;
+		int daytimeStep;
+		bool starsVisible;
+		bool valid;
+		Mode mode; // Decided by the main thread at the start of each frame.
+		std::atomic<bool> gradientChanged; // Set by render threads if any row color changed.
+
+		SkyCache();
+
+		void init(int width, int height);
+
+		// Decides how much of the stored sky can be used for a frame and remembers the values
+		// it was decided from.
+		void beginFrame(const Camera &camera, int daytimeStep, double distantAmbient, uint64_t animLandFrameHash);
+
+		void invalidate();
+	};
+
 	// Instance of an entity light in the world.
 	struct VisibleLight
 	{
@@ -450,15 +663,105 @@ private:
 
 		std::array<LightID, MAX_LIGHTS> lightIDs;
 		int count;
+		int poolStart; // Index of this list's first light in the visible light pool.
 
 		VisibleLightList();
 
 		bool isFull() const;
 		void add(LightID lightID);
 		void clear();
+	};
+
+	// Structure-of-arrays copy of each non-empty visible light list, stored list after list so a
+	// voxel column's lights are contiguous and can be evaluated together. Each list's range is
+	// padded to a multiple of LIGHT_STRIDE with lights that never reach anything.
+	struct VisibleLightPool
+	{
+		static constexpr int LIGHT_STRIDE = 2;
+
+		std::vector<double> xs, zs, invRadii;
 
-		// Shading optimization, only useful when the light intensity cap is on for early-out.
-		void sortByNearest(const Double3 &point, const BufferView<const VisibleLight> &visLights);
+		int getCount() const;
+		void add(const VisibleLight &light);
+		void addPadding();
+		void clear();
+	};
+
+	// Level state read by render threads. Normally a view of the live level, but when frames are
+	// pipelined it is a copy of the voxel grid and nearby voxel instances so the game can keep
+	// updating the level while the previous frame is still being drawn. The copy is kept between
+	// frames and only chunks the level changed since then are copied again.
+	class LevelSnapshot
+	{
+	private:
+		const LevelData *levelData; // Non-null when viewing the live level.
+		std::optional<VoxelGrid> voxelGrid;
+		std::vector<VoxelInstance> voxelInsts; // Sorted by voxel so the storage can be reused.
+	public:
+		LevelSnapshot();
+
+		void initLive(const LevelData &levelData);
+		void initCopy(const LevelData &levelData, const ChunkInt2 &cameraChunk, int chunkDistance);
+
+		const VoxelGrid &getVoxelGrid() const;
+		const VoxelInstance *tryGetVoxelInstance(const NewInt3 &voxel, VoxelInstance::Type type) const;
+
+		double getDoorPercentOpen(SNInt voxelX, WEInt voxelZ) const;
+		double getFadingVoxelPercent(SNInt voxelX, int voxelY, WEInt voxelZ) const;
+
+		void clear();
+	};
+
+	// Voxels of one XZ column in the grid, fetched once for every ray of a coherent bundle that
+	// crosses it rather than once per ray. Fade percents are only looked up when a voxel is drawn.
+	struct VoxelColumn
+	{
+		static constexpr int MAX_HEIGHT = 16; // Taller columns read each voxel from the grid instead.
+
+		SNInt x;
+		WEInt z;
+		int minY, maxY; // Occupied range. Empty if the column is all air.
+		uint16_t voxelIDs[MAX_HEIGHT]; // Indexed by Y minus the min Y.
+		double fadePercents[MAX_HEIGHT]; // Negative until looked up.
+		bool isCached; // Whether the occupied range fits in the arrays.
+
+		void init(SNInt x, WEInt z, const VoxelGrid &voxelGrid);
+
+		bool isEmpty() const;
+
+		// The Y coordinate must be in the occupied range.
+		uint16_t getVoxelID(int y, const VoxelGrid &voxelGrid) const;
+		double getFadePercent(int y, const LevelSnapshot &levelSnapshot);
+	};
+
+	// Range of voxel column tiles queued for one render thread. The owning thread takes tiles from
+	// the front and idle threads steal from the back. Both ends share one atomic word so a tile can
+	// never be handed out twice and no lock is needed.
+	struct ColumnTileQueue
+	{
+		std::atomic<uint64_t> range; // Start tile in the low 32 bits, end tile in the high 32 bits.
+
+		ColumnTileQueue();
+
+		void init(int startTile, int endTile);
+
+		// Tries to take the next tile from the front (owner) or back (thief) of the queue.
+		bool tryPopFront(int *outTile);
+		bool tryPopBack(int *outTile);
+	};
+
+	// Per-thread profiling values for the most recent frame. Each render thread only writes its own.
+	struct RenderThreadStats
+	{
+		double busyTime, idleTime; // In seconds.
+		double skyTime, distantSkyTime, voxelTime, flatTime; // Drawing time of each phase, in seconds.
+		int stolenTileCount; // Voxel column tiles taken from other threads' queues.
+		int flatShadingHitCount, flatShadingMissCount; // Flat shading table look-ups.
+		std::chrono::high_resolution_clock::time_point endTime; // When the thread finished the frame.
+
+		RenderThreadStats();
+
+		void clear();
 	};
 
 	// Data owned by the main thread that is referenced by render threads.
@@ -466,20 +769,22 @@ private:
 	{
 		struct SkyGradient
 		{
-			int threadsDone;
+			std::atomic<int> threadsDone;
 			Buffer<Double3> *rowCache;
+			SkyCache *skyCache;
 			double projectedYTop, projectedYBottom; // Projected Y range of sky gradient.
 			std::atomic<bool> shouldDrawStars; // True if the sky is dark enough.
 
-			void init(double projectedYTop, double projectedYBottom, Buffer<Double3> &rowCache);
+			void init(double projectedYTop, double projectedYBottom, Buffer<Double3> &rowCache,
+				SkyCache &skyCache);
 		};
 
 		struct DistantSky
 		{
-			int threadsDone;
+			std::atomic<int> threadsDone;
 			const VisDistantObjects *visDistantObjs;
 			const std::vector<SkyTexture> *skyTextures;
-			bool doneVisTesting; // True when render threads can start rendering distant sky.
+			std::atomic<bool> doneVisTesting; // True when render threads can start rendering distant sky.
 
 			void init(const VisDistantObjects &visDistantObjs,
 				const std::vector<SkyTexture> &skyTextures);
@@ -487,35 +792,39 @@ private:
 
 		struct Voxels
 		{
-			int threadsDone;
-			const LevelData *levelData;
-			const std::vector<VisibleLight> *visLights;
+			std::atomic<int> threadsDone;
+			Buffer<ColumnTileQueue> tileQueues; // One per render thread.
+			int tileCount;
+			const LevelSnapshot *levelSnapshot;
+			const VisibleLightPool *visLights;
 			const Buffer2D<VisibleLightList> *visLightLists;
 			const VoxelTextures *voxelTextures;
 			const ChasmTextureGroups *chasmTextureGroups;
 			Buffer<OcclusionData> *occlusion;
 			double ceilingHeight;
 			int chunkDistance;
-			bool doneLightVisTesting; // True when render threads can start rendering voxels.
+			std::atomic<bool> doneLightVisTesting; // True when render threads can start rendering voxels.
 
-			void init(int chunkDistance, double ceilingHeight, const LevelData &levelData,
-				const std::vector<VisibleLight> &visLights, const Buffer2D<VisibleLightList> &visLightLists,
+			// Also splits the frame's columns into tiles and spreads them evenly across tile queues.
+			void init(int chunkDistance, double ceilingHeight, const LevelSnapshot &levelSnapshot,
+				const VisibleLightPool &visLights, const Buffer2D<VisibleLightList> &visLightLists,
 				const VoxelTextures &voxelTextures, const ChasmTextureGroups &chasmTextureGroups,
-				Buffer<OcclusionData> &occlusion);
+				Buffer<OcclusionData> &occlusion, int frameWidth, int threadCount);
 		};
 
 		struct Flats
 		{
-			int threadsDone;
+			std::atomic<int> threadsDone;
 			const Double3 *flatNormal;
 			const std::vector<VisibleFlat> *visibleFlats;
-			const std::vector<VisibleLight> *visLights;
+			const std::vector<std::vector<int>> *visibleFlatBins;
+			const VisibleLightPool *visLights;
 			const Buffer2D<VisibleLightList> *visLightLists;
 			const FlatTextureGroups *flatTextureGroups;
-			bool doneSorting; // True when render threads can start rendering flats.
+			std::atomic<bool> doneSorting; // True when render threads can start rendering flats.
 
 			void init(const Double3 &flatNormal, const std::vector<VisibleFlat> &visibleFlats,
-				const std::vector<VisibleLight> &visLights,
+				const std::vector<std::vector<int>> &visibleFlatBins, const VisibleLightPool &visLights,
 				const Buffer2D<VisibleLightList> &visLightLists,
 				const FlatTextureGroups &flatTextureGroups);
 		};
@@ -524,13 +833,16 @@ private:
 		DistantSky distantSky;
 		Voxels voxels;
 		Flats flats;
+		Buffer<RenderThreadStats> threadStats; // One per pooled render thread.
 		const Camera *camera;
 		const ShadingInfo *shadingInfo;
 		const FrameView *frame;
 
+		// Only used for the go signal so idle threads sleep between frames. Phase hand-offs within
+		// a frame are done with the atomics above.
 		std::condition_variable condVar;
 		std::mutex mutex;
-		int totalThreads;
+		int totalThreads; // Pooled threads at or above this index sit the frame out.
 		bool go; // Initial go signal to start work each frame.
 		bool isDestructing; // Helps shut down threads in the renderer destructor.
 
@@ -550,48 +862,101 @@ private:
 	// Max angle of distant clouds above the horizon, in degrees.
 	static constexpr double DISTANT_CLOUDS_MAX_ANGLE = 25.0;
 
-	Buffer2D<double> depthBuffer;
+	// Number of adjacent screen columns ray cast together as one unit of render thread work.
+	static constexpr int VOXEL_COLUMN_TILE_WIDTH = 8;
+
+	// Number of adjacent screen columns per visible flat bin.
+	static constexpr int FLAT_BIN_WIDTH = 32;
+
+	// Max number of adjacent rays stepped through the voxel grid together.
+	static constexpr int RAY_BUNDLE_SIZE = 4;
+
+	// Scales between 8-bit texel channels and normalized shading values.
+	static constexpr ShadingReal TEXEL_CHANNEL_MAX = static_cast<ShadingReal>(255.0);
+	static constexpr ShadingReal TEXEL_CHANNEL_RECIP = static_cast<ShadingReal>(1.0 / 255.0);
+
+	Buffer2D<DepthTexel> depthBuffer;
 	Buffer<OcclusionData> occlusion; // 1D buffer, min and max Y for each pixel column.
-	std::vector<const Entity*> potentiallyVisibleFlats; // Updated every frame.
+	std::vector<int> potentiallyVisibleStars; // Updated every frame.
 	std::vector<VisibleFlat> visibleFlats; // Flats to be drawn.
+	std::vector<Palette> visibleFlatPalettes; // Copies of visible flats' override palettes for this frame.
+	std::vector<std::vector<int>> visibleFlatBins; // Visible flat indices per screen column bin, farthest to nearest.
+
+	// Last frame's visible flat order, so flats only need re-sorting where they moved. Ranks are
+	// indexed by entity ID and only valid if the order at that rank has the same entity ID.
+	std::vector<EntityID> prevVisibleFlatOrder;
+	std::vector<int> visibleFlatRanks;
+	std::vector<int> visibleFlatSlots; // Visible flat index per last-frame rank (or -1), then new flats.
+	std::vector<VisibleFlat> sortedVisibleFlats; // Scratch for re-ordering.
 	DistantObjects distantObjects; // Distant sky objects (mountains, clouds, etc.).
 	VisDistantObjects visDistantObjs; // Visible distant sky objects.
 	Buffer2D<VisibleLightList> visLightLists; // Potentially-visible voxel column references to visible lights.
 	std::vector<VisibleLight> visibleLights; // Lights that contribute to the current frame.
+	VisibleLightPool visLightPool; // Light data for each visible light list, read by render threads.
+	LevelSnapshot levelSnapshot; // Level state read by render threads.
 	VoxelTextures voxelTextures; // Voxel textures and their mappings.
 	FlatTextureGroups flatTextureGroups; // Entity anim textures accessed by entity render ID.
 	ChasmTextureGroups chasmTextureGroups; // Mappings from chasm ID to textures.
 	std::vector<SkyTexture> skyTextures; // Distant object textures. Size is managed internally.
 	std::vector<Double3> skyPalette; // Colors for each time of day.
 	Buffer<Double3> skyGradientRowCache; // Contains row colors of most recent sky gradient.
-	Buffer<std::thread> renderThreads; // Threads used for rendering the world.
+	SkyCache skyCache; // Sky of a previous frame that might be reusable.
+	Buffer<std::thread> renderThreads; // Pool of threads used for rendering the world. Only grows.
 	RenderThreadData threadData; // Managed by main thread, used by render threads.
 	double fogDistance; // Distance at which fog is maximum.
 	int width, height; // Dimensions of frame buffer.
 	int renderThreadsMode; // Determines number of threads to use for rendering.
-
-	// Initializes render threads that run in the background for the duration of the renderer's
-	// lifetime. This can also be used to reset threads after a screen resize.
-	void initRenderThreads(int width, int height, int threadCount);
+	int renderThreadCount; // Number of pooled render threads given each frame.
+
+	// Pipelined rendering state. Render threads draw frame N into the back color buffer while the
+	// game updates frame N+1, and the front color buffer (frame N-1) is what gets presented.
+	std::array<Buffer<uint32_t>, 2> colorBuffers;
+	std::optional<Camera> frameCamera; // Per-frame values referenced by render threads.
+	std::optional<ShadingInfo> frameShadingInfo;
+	std::optional<FrameView> frameView;
+	std::vector<RenderThreadStats> frameThreadStats; // Copy of the most recently finished frame's stats.
+	int backColorBufferIndex;
+	bool pipelined; // Whether render() returns before render threads are done.
+	bool frameInFlight; // Whether render threads may still be working on a frame.
+	double visibilityTime; // Seconds the main thread spent on visibility in the last render().
+	std::chrono::high_resolution_clock::time_point frameStartTime; // When the in-flight frame's render() began.
+	double renderTime; // Seconds from render() until every render thread was done, for the last finished frame.
+	int potentiallyVisFlatCount; // Entity render instances given to the last render().
+
+	// Sets how many render threads work on each frame. Threads run in the background for the
+	// duration of the renderer's lifetime; the pool is only grown when more threads are needed
+	// than have been started before, and a smaller count just leaves the extra threads asleep.
+	void setRenderThreadCount(int threadCount);
 
 	// Turns off each thread in the render threads list peacefully. The render threads are expected
 	// to be at their initial wait condition before being given the go + destruct signals.
 	void resetRenderThreads();
 
+	// Waits for the in-flight frame (if any) to be completely drawn. Anything that render threads
+	// read must not be modified before this is called.
+	void finishFrame();
+
+	// Allocates the pipelined color buffers for the given frame dimensions.
+	void initColorBuffers(int width, int height);
+
 	// Refreshes the list of distant objects to be drawn.
 	void updateVisibleDistantObjects(const ShadingInfo &shadingInfo, const Camera &camera,
 		const FrameView &frame);
 
-	// Refreshes the list of potentially visible flats (to be passed to actually-visible flat
-	// calculation).
-	static void updatePotentiallyVisibleFlats(const Camera &camera, SNInt gridWidth, WEInt gridDepth,
-		int chunkDistance, const EntityManager &entityManager,
-		std::vector<const Entity*> *outPotentiallyVisFlats, int *outEntityCount);
+	// Hashes the visible distant objects covering each screen column and marks the columns that
+	// differ from the stored sky.
+	void updateSkyCacheColumns();
+
+	// Refreshes the list of flats to be drawn from this frame's entity render instances.
+	void updateVisibleFlats(const Camera &camera, const ShadingInfo &shadingInfo,
+		const RenderInstanceGroup &instGroup);
+
+	// Sorts the visible flats farthest to nearest, starting from last frame's order.
+	void sortVisibleFlats();
 
-	// Refreshes the list of flats to be drawn.
-	void updateVisibleFlats(const Camera &camera, const ShadingInfo &shadingInfo, int chunkDistance,
-		double ceilingHeight, const VoxelGrid &voxelGrid, const EntityManager &entityManager,
-		const EntityDefinitionLibrary &entityDefLibrary);
+	// Sorts the visible flats into screen column bins so render threads only look at flats that
+	// overlap their columns. Must be called after the visible flats are sorted by depth.
+	void updateVisibleFlatBins();
 
 	// Refreshes the visible light lists in each voxel column in the view frustum.
 	void updateVisibleLightLists(const Camera &camera, int chunkDistance, double ceilingHeight,
@@ -609,10 +974,6 @@ private:
 		VoxelDefinition::ChasmData::Type chasmType, double chasmAnimPercent,
 		const ChasmTexture **outTexture);
 
-	// Looks up a light in the visible lights list given some light ID.
-	static const VisibleLight &getVisibleLightByID(const BufferView<const VisibleLight> &visLights,
-		VisibleLightList::LightID lightID);
-
 	// Gets the visible light list associated with some voxel column.
 	static const VisibleLightList &getVisibleLightList(
 		const BufferView2D<const VisibleLightList> &visLightLists, SNInt voxelX, WEInt voxelZ,
@@ -702,22 +1063,20 @@ private:
 		int lightIntensity, const NewDouble2 &eye2D, const NewDouble2 &cameraDir, Degrees fovX,
 		double viewDistance, LightVisibilityData *outVisData);
 
-	// Gets the amount of light at a point. Capped at 100% intensity if not unlimited.
-	// @todo: give actual visible light count as template parameter so the for loop can be
-	// completely inlined for each light count (permutation count depends on visible light
-	// list max lights).
+	// Gets the amount of light at a point. Capped at 100% intensity if not unlimited. Evaluates
+	// the list's lights in groups from the visible light pool.
 	template <bool CappedSum>
 	static double getLightContributionAtPoint(const NewDouble2 &point,
-		const BufferView<const VisibleLight> &visLights, const VisibleLightList &visLightList);
+		const VisibleLightPool &visLights, const VisibleLightList &visLightList);
 
 	// Low-level texture sampling function.
 	template <int FilterMode, bool Transparency>
 	static void sampleVoxelTexture(const VoxelTexture &texture, double u, double v,
-		double *r, double *g, double *b, double *emission, bool *transparent);
+		ShadingReal *r, ShadingReal *g, ShadingReal *b, ShadingReal *emission, bool *transparent);
 
 	// Low-level screen-space chasm texture sampling function.
 	static void sampleChasmTexture(const ChasmTexture &texture, double screenXPercent,
-		double screenYPercent, double *r, double *g, double *b);
+		double screenYPercent, ShadingReal *r, ShadingReal *g, ShadingReal *b);
 
 	// Low-level shader for wall pixel rendering. Template parameters are used for
 	// compile-time generation of shader permutations.
@@ -727,6 +1086,27 @@ private:
 		double fadePercent, double lightContributionPercent, const ShadingInfo &shadingInfo,
 		OcclusionData &occlusion, const FrameView &frame);
 
+	// SIMD versions of the wall pixel shaders for SSE2 (4 pixels per step) and AVX2 (8 pixels per
+	// step). The Y range must already be clipped against the occlusion buffer. Only nearest texture
+	// filtering is supported. With transparency, texels that pass the depth test but are transparent
+	// are given to the transparent texel function as (index, y) instead of being shaded (i.e., for
+	// chasm walls).
+	template <bool Fading, bool Transparency, typename TransparentTexelFunc>
+	static void drawPixelsSSE(int x, int yStart, int yEnd, const DrawRange &drawRange, double depth,
+		double u, double vStart, double vEnd, const VoxelTexture &texture, double fadePercent,
+		double lightContributionPercent, const ShadingInfo &shadingInfo, const FrameView &frame,
+		const TransparentTexelFunc &transparentTexelFunc);
+	template <bool Fading, bool Transparency, typename TransparentTexelFunc>
+	static void drawPixelsAVX(int x, int yStart, int yEnd, const DrawRange &drawRange, double depth,
+		double u, double vStart, double vEnd, const VoxelTexture &texture, double fadePercent,
+		double lightContributionPercent, const ShadingInfo &shadingInfo, const FrameView &frame,
+		const TransparentTexelFunc &transparentTexelFunc);
+
+	// Gets the mipmap of a voxel texture closest to one texel per pixel for a column showing vStart
+	// to vEnd of the texture. Distant walls have short projected heights and get smaller mipmaps.
+	static const VoxelTexture &getVoxelMipmap(const VoxelTexture &texture, const DrawRange &drawRange,
+		double vStart, double vEnd);
+
 	// Draws a column of pixels with no perspective or transparency.
 	static void drawPixels(int x, const DrawRange &drawRange, double depth, double u,
 		double vStart, double vEnd, const Double3 &normal, const VoxelTexture &texture,
@@ -738,14 +1118,28 @@ private:
 	static void drawPerspectivePixelsShader(int x, const DrawRange &drawRange,
 		const NewDouble2 &startPoint, const NewDouble2 &endPoint, double depthStart, double depthEnd,
 		const Double3 &normal, const VoxelTexture &texture, double fadePercent,
-		const BufferView<const VisibleLight> &visLights, const VisibleLightList &visLightList,
+		const VisibleLightPool &visLights, const VisibleLightList &visLightList,
 		const ShadingInfo &shadingInfo, OcclusionData &occlusion, const FrameView &frame);
 
+	// SIMD versions of the perspective pixel shader, with the same limits as the wall ones. Depth,
+	// fog and texture coordinates are per-pixel vector math, while light contributions are still
+	// summed per pixel.
+	template <bool Fading>
+	static void drawPerspectivePixelsSSE(int x, int yStart, int yEnd, const DrawRange &drawRange,
+		const NewDouble2 &startPoint, const NewDouble2 &endPoint, double depthStart, double depthEnd,
+		const VoxelTexture &texture, double fadePercent, const VisibleLightPool &visLights,
+		const VisibleLightList &visLightList, const ShadingInfo &shadingInfo, const FrameView &frame);
+	template <bool Fading>
+	static void drawPerspectivePixelsAVX(int x, int yStart, int yEnd, const DrawRange &drawRange,
+		const NewDouble2 &startPoint, const NewDouble2 &endPoint, double depthStart, double depthEnd,
+		const VoxelTexture &texture, double fadePercent, const VisibleLightPool &visLights,
+		const VisibleLightList &visLightList, const ShadingInfo &shadingInfo, const FrameView &frame);
+
 	// Draws a column of pixels with perspective but no transparency. The pixel drawing order is 
 	// top to bottom, so the start and end values should be passed with that in mind.
 	static void drawPerspectivePixels(int x, const DrawRange &drawRange, const NewDouble2 &startPoint,
 		const NewDouble2 &endPoint, double depthStart, double depthEnd, const Double3 &normal,
-		const VoxelTexture &texture, double fadePercent, const BufferView<const VisibleLight> &visLights,
+		const VoxelTexture &texture, double fadePercent, const VisibleLightPool &visLights,
 		const VisibleLightList &visLightList, const ShadingInfo &shadingInfo, OcclusionData &occlusion,
 		const FrameView &frame);
 
@@ -814,61 +1208,63 @@ private:
 		const Camera &camera, const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint,
 		const NewDouble2 &farPoint, double nearZ, double farZ, double wallU, const Double3 &wallNormal,
 		const ShadingInfo &shadingInfo, int chunkDistance, double ceilingHeight,
-		const LevelData &levelData, const BufferView<const VisibleLight> &visLights,
-		const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &textures,
+		const LevelSnapshot &levelSnapshot, const VisibleLightPool &visLights,
+		const VisibleLightList &visLightList, const VoxelTextures &textures,
 		const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame);
 	static void drawInitialVoxelAbove(int x, SNInt voxelX, int voxelY, WEInt voxelZ,
 		const Camera &camera, const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint,
 		const NewDouble2 &farPoint, double nearZ, double farZ, double wallU, const Double3 &wallNormal,
 		const ShadingInfo &shadingInfo, int chunkDistance, double ceilingHeight,
-		const LevelData &levelData, const BufferView<const VisibleLight> &visLights,
-		const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &textures,
+		const LevelSnapshot &levelSnapshot, const VisibleLightPool &visLights,
+		const VisibleLightList &visLightList, const VoxelTextures &textures,
 		const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame);
 	static void drawInitialVoxelBelow(int x, SNInt voxelX, int voxelY, WEInt voxelZ,
 		const Camera &camera, const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint,
 		const NewDouble2 &farPoint, double nearZ, double farZ, double wallU, const Double3 &wallNormal,
 		const ShadingInfo &shadingInfo, int chunkDistance, double ceilingHeight,
-		const LevelData &levelData, const BufferView<const VisibleLight> &visLights,
-		const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &textures,
+		const LevelSnapshot &levelSnapshot, const VisibleLightPool &visLights,
+		const VisibleLightList &visLightList, const VoxelTextures &textures,
 		const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame);
 
-	// Manages drawing voxels in the column that the player is in.
+	// Manages drawing voxels in the column that the player is in. The visible light list is the
+	// one for the column's XZ coordinate.
 	static void drawInitialVoxelColumn(int x, SNInt voxelX, WEInt voxelZ, const Camera &camera,
 		const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint,
 		double nearZ, double farZ, const ShadingInfo &shadingInfo, int chunkDistance, double ceilingHeight,
-		const LevelData &levelData, const BufferView<const VisibleLight> &visLights,
-		const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &textures,
+		const LevelSnapshot &levelSnapshot, const VisibleLightPool &visLights,
+		const VisibleLightList &visLightList, const VoxelTextures &textures,
 		const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame);
 
 	// Helper functions for drawing a voxel column.
-	static void drawVoxelSameFloor(int x, SNInt voxelX, int voxelY, WEInt voxelZ, const Camera &camera,
+	static void drawVoxelSameFloor(int x, VoxelColumn &column, int voxelY, const Camera &camera,
 		const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint,
 		double nearZ, double farZ, double wallU, const Double3 &wallNormal, const ShadingInfo &shadingInfo,
-		int chunkDistance, double ceilingHeight, const LevelData &levelData,
-		const BufferView<const VisibleLight> &visLights,
-		const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &textures,
+		int chunkDistance, double ceilingHeight, const LevelSnapshot &levelSnapshot,
+		const VisibleLightPool &visLights,
+		const VisibleLightList &visLightList, const VoxelTextures &textures,
 		const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame);
-	static void drawVoxelAbove(int x, SNInt voxelX, int voxelY, WEInt voxelZ, const Camera &camera,
+	static void drawVoxelAbove(int x, VoxelColumn &column, int voxelY, const Camera &camera,
 		const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint,
 		double nearZ, double farZ, double wallU, const Double3 &wallNormal, const ShadingInfo &shadingInfo,
-		int chunkDistance, double ceilingHeight, const LevelData &levelData,
-		const BufferView<const VisibleLight> &visLights,
-		const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &textures,
+		int chunkDistance, double ceilingHeight, const LevelSnapshot &levelSnapshot,
+		const VisibleLightPool &visLights,
+		const VisibleLightList &visLightList, const VoxelTextures &textures,
 		const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame);
-	static void drawVoxelBelow(int x, SNInt voxelX, int voxelY, WEInt voxelZ, const Camera &camera,
+	static void drawVoxelBelow(int x, VoxelColumn &column, int voxelY, const Camera &camera,
 		const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint,
 		double nearZ, double farZ, double wallU, const Double3 &wallNormal, const ShadingInfo &shadingInfo,
-		int chunkDistance, double ceilingHeight, const LevelData &levelData,
-		const BufferView<const VisibleLight> &visLights,
-		const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &textures,
+		int chunkDistance, double ceilingHeight, const LevelSnapshot &levelSnapshot,
+		const VisibleLightPool &visLights,
+		const VisibleLightList &visLightList, const VoxelTextures &textures,
 		const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame);
 
-	// Manages drawing voxels in the column of the given XZ coordinate in the voxel grid.
-	static void drawVoxelColumn(int x, SNInt voxelX, WEInt voxelZ, const Camera &camera,
+	// Manages drawing voxels in the given voxel column. The visible light list is the one for the
+	// column's XZ coordinate.
+	static void drawVoxelColumn(int x, VoxelColumn &column, const Camera &camera,
 		const Ray &ray, VoxelFacing2D facing, const NewDouble2 &nearPoint, const NewDouble2 &farPoint,
 		double nearZ, double farZ, const ShadingInfo &shadingInfo, int chunkDistance, double ceilingHeight,
-		const LevelData &levelData, const BufferView<const VisibleLight> &visLights,
-		const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &textures,
+		const LevelSnapshot &levelSnapshot, const VisibleLightPool &visLights,
+		const VisibleLightList &visLightList, const VoxelTextures &textures,
 		const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame);
 
 	// Draws the portion of a flat contained within the given X range of the screen. The end
@@ -876,31 +1272,73 @@ private:
 	static void drawFlat(int startX, int endX, const VisibleFlat &flat, const Double3 &normal,
 		const NewDouble2 &eye, const NewInt2 &eyeVoxelXZ, double horizonProjY, const ShadingInfo &shadingInfo,
 		const Palette *overridePalette, int chunkDistance, const FlatTexture &texture,
-		const BufferView<const VisibleLight> &visLights, const BufferView2D<const VisibleLightList> &visLightLists,
-		SNInt gridWidth, WEInt gridDepth, const FrameView &frame);
+		const VisibleLightPool &visLights, const BufferView2D<const VisibleLightList> &visLightLists,
+		SNInt gridWidth, WEInt gridDepth, FlatShadingCache &shadingCache, const FrameView &frame);
+
+	// SIMD versions of a flat's column loop. The depth test and texel rows are vector math, and
+	// opaque texels that pass the depth test are given to the texel function as (index, y, texel)
+	// to be shaded through the flat's palette.
+	template <typename TexelFunc>
+	static void drawFlatColumnSSE(int x, int yStart, int yEnd, double depth, double projectedYStart,
+		double projectedYEnd, int textureX, const FlatTexture &texture, const FrameView &frame,
+		const TexelFunc &texelFunc);
+	template <typename TexelFunc>
+	static void drawFlatColumnAVX(int x, int yStart, int yEnd, double depth, double projectedYStart,
+		double projectedYEnd, int textureX, const FlatTexture &texture, const FrameView &frame,
+		const TexelFunc &texelFunc);
 
 	// Casts a 2D ray that steps through the current floor, rendering all voxels
 	// in the XZ column of each voxel.
 	template <bool NonNegativeDirX, bool NonNegativeDirZ>
 	static void rayCast2DInternal(int x, const Camera &camera, const Ray &ray,
 		const ShadingInfo &shadingInfo, int chunkDistance, double ceilingHeight,
-		const LevelData &levelData, const BufferView<const VisibleLight> &visLights,
+		const LevelSnapshot &levelSnapshot, const VisibleLightPool &visLights,
 		const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &textures,
 		const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame);
 
+	// Steps a ray that has left the camera's voxel through the rest of the grid, drawing each voxel
+	// column it passes through.
+	template <bool NonNegativeDirX, bool NonNegativeDirZ>
+	static void rayCast2DContinue(int x, const Camera &camera, const Ray &ray, RayTraversal &traversal,
+		const ShadingInfo &shadingInfo, int chunkDistance, double ceilingHeight,
+		const LevelSnapshot &levelSnapshot, const VisibleLightPool &visLights,
+		const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &textures,
+		const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame);
+
+	// Casts a bundle of adjacent rays that share a direction quadrant. The rays are stepped together
+	// while they pass through the same voxel columns so per-column look-ups are only done once, and
+	// each ray is finished on its own once they diverge.
+	template <bool NonNegativeDirX, bool NonNegativeDirZ>
+	static void rayCast2DBundleInternal(int startX, int rayCount, const Ray *rays, const Camera &camera,
+		const ShadingInfo &shadingInfo, int chunkDistance, double ceilingHeight,
+		const LevelSnapshot &levelSnapshot, const VisibleLightPool &visLights,
+		const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &textures,
+		const ChasmTextureGroups &chasmTextureGroups, OcclusionData *occlusion, const FrameView &frame);
+
 	// Helper method for internal ray casting function that takes template parameters for better
 	// code generation.
 	static void rayCast2D(int x, const Camera &camera, const Ray &ray, const ShadingInfo &shadingInfo,
-		int chunkDistance, double ceilingHeight, const LevelData &levelData,
-		const BufferView<const VisibleLight> &visLights,
+		int chunkDistance, double ceilingHeight, const LevelSnapshot &levelSnapshot,
+		const VisibleLightPool &visLights,
 		const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &textures,
 		const ChasmTextureGroups &chasmTextureGroups, OcclusionData &occlusion, const FrameView &frame);
 
+	// Casts a bundle of rays for adjacent screen columns, falling back to individual rays if they
+	// don't all step in the same X and Z directions. The occlusion pointer is for the first column.
+	static void rayCast2DBundle(int startX, int rayCount, const Ray *rays, const Camera &camera,
+		const ShadingInfo &shadingInfo, int chunkDistance, double ceilingHeight,
+		const LevelSnapshot &levelSnapshot, const VisibleLightPool &visLights,
+		const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &textures,
+		const ChasmTextureGroups &chasmTextureGroups, OcclusionData *occlusion, const FrameView &frame);
+
 	// Draws a portion of the sky gradient. The start and end Y are determined from current
 	// threading settings.
 	static void drawSkyGradient(int startY, int endY, double gradientProjYTop, double gradientProjYBottom,
-		Buffer<Double3> &skyGradientRowCache, std::atomic<bool> &shouldDrawStars, const ShadingInfo &shadingInfo,
-		const FrameView &frame);
+		Buffer<Double3> &skyGradientRowCache, std::atomic<bool> &shouldDrawStars, SkyCache &skyCache,
+		const ShadingInfo &shadingInfo, const FrameView &frame);
+
+	// Copies some rows of the stored sky into the frame buffer in place of drawing the sky.
+	static void drawCachedSkyRows(int startY, int endY, const SkyCache &skyCache, const FrameView &frame);
 
 	// Draws some columns of distant sky objects (mountains, clouds, etc.). The start and end X
 	// are determined from current threading settings.
@@ -908,30 +1346,61 @@ private:
 		const std::vector<SkyTexture> &skyTextures, const Buffer<Double3> &skyGradientRowCache,
 		bool shouldDrawStars, const ShadingInfo &shadingInfo, const FrameView &frame);
 
+	// Draws some columns of distant sky objects depending on the sky cache mode, and keeps the
+	// stored sky in sync with what was drawn.
+	static void drawCachedDistantSky(int startX, int endX, const VisDistantObjects &visDistantObjs,
+		const std::vector<SkyTexture> &skyTextures, const Buffer<Double3> &skyGradientRowCache,
+		bool shouldDrawStars, SkyCache &skyCache, const ShadingInfo &shadingInfo, const FrameView &frame);
+
 	// Handles drawing all voxels for the current frame.
-	static void drawVoxels(int startX, int stride, const Camera &camera, int chunkDistance,
-		double ceilingHeight, const LevelData &levelData, const BufferView<const VisibleLight> &visLights,
+	static void drawVoxels(int startX, int endX, const Camera &camera, int chunkDistance,
+		double ceilingHeight, const LevelSnapshot &levelSnapshot, const VisibleLightPool &visLights,
 		const BufferView2D<const VisibleLightList> &visLightLists, const VoxelTextures &voxelTextures,
 		const ChasmTextureGroups &chasmTextureGroups, Buffer<OcclusionData> &occlusion,
 		const ShadingInfo &shadingInfo, const FrameView &frame);
 
-	// Handles drawing all flats for the current frame.
+	// Handles drawing all flats for the current frame. Only the flats in bins overlapping the
+	// given X range are visited.
 	static void drawFlats(int startX, int endX, const Camera &camera, const Double3 &flatNormal,
-		const std::vector<VisibleFlat> &visibleFlats, const FlatTextureGroups &flatTextureGroups,
-		const ShadingInfo &shadingInfo, int chunkDistance, const BufferView<const VisibleLight> &visLights,
+		const std::vector<VisibleFlat> &visibleFlats, const std::vector<std::vector<int>> &visibleFlatBins,
+		const FlatTextureGroups &flatTextureGroups,
+		const ShadingInfo &shadingInfo, int chunkDistance, const VisibleLightPool &visLights,
 		const BufferView2D<const VisibleLightList> &visLightLists, SNInt gridWidth, WEInt gridDepth,
-		const FrameView &frame);
+		FlatShadingCache &shadingCache, const FrameView &frame);
+
+	// Waits for all render threads to reach a phase hand-off. Spins with yields instead of sleeping
+	// since phases are usually only a few milliseconds apart.
+	static void waitForThreads(const std::atomic<int> &threadsDone, int totalThreads);
+	static void waitForFlag(const std::atomic<bool> &flag);
+
+	// Gets the start (inclusive) and end (exclusive) pixel of a render thread's share of a
+	// frame dimension. Rounding is involved so the ranges are correct for all resolutions.
+	static void getRenderThreadBlock(int threadIndex, int threadCount, int size, int *outStart,
+		int *outEnd);
 
 	// Thread loop for each render thread. All threads are initialized in the constructor and
 	// wait for a go signal at the beginning of each render(). If the renderer is destructing,
 	// then each render thread still gets a go signal, but they immediately leave their loop
-	// and terminate. Non-thread-data parameters are for start/end column/row for each thread.
-	static void renderThreadLoop(RenderThreadData &threadData, int threadIndex, int startX,
-		int endX, int startY, int endY);
+	// and terminate. Each thread's start/end columns and rows are recalculated from the frame
+	// every time, since the resolution can change between frames (i.e., dynamic resolution).
+	// Voxel columns are not bound to a thread; they are taken from the thread's own tile queue
+	// first and then stolen from neighboring threads' queues.
+	static void renderThreadLoop(RenderThreadData &threadData, int threadIndex);
 public:
+	// Column shader kernels for walls, chasm walls, perspective floors and ceilings, and flats. The
+	// scalar one is also used when a kernel doesn't cover the current texture filtering or shading
+	// precision.
+	enum class ColumnKernel { Scalar, SSE, AVX };
+
 	SoftwareRenderer();
 	virtual ~SoftwareRenderer();
 
+	// The column kernel is shared by all software renderers. init() picks the widest one the CPU
+	// supports; setting it afterwards (i.e., to compare kernels) fails if the CPU doesn't support it.
+	// It must not be changed while a frame is being rendered.
+	static ColumnKernel getColumnKernel();
+	static bool trySetColumnKernel(ColumnKernel kernel);
+
 	bool isInited() const override;
 
 	// Gets profiling information about renderer internals.
@@ -980,6 +1449,15 @@ public:
 	// with time-dependent light sources and textures.
 	void setNightLightsActive(bool active, const Palette &palette) override;
 
+	// Resolves voxel definitions to texture indices so voxel drawing doesn't look up textures by name.
+	void updateVoxelTextureHandles(const VoxelGrid &voxelGrid) override;
+
+	// Times looking up the primary texture of the grid's voxels through their resolved handles and
+	// through asset reference comparisons (how voxel drawing used to find textures), for benchmarking.
+	// Mismatches are voxel definitions whose handle doesn't point at the texture the comparison finds.
+	void measureVoxelTextureLookups(const VoxelGrid &voxelGrid, int lookupCount,
+		double *outHandleSeconds, double *outAssetRefSeconds, int *outMismatchCount) override;
+
 	// Zeroes out all renderer textures and entity render ID mappings to textures.
 	void clearTexturesAndEntityRenderIDs() override;
 
@@ -1001,12 +1479,11 @@ public:
 	void freeEntityTexture(const TextureAssetReference &textureAssetRef) override;
 	void freeSkyTexture(const TextureAssetReference &textureAssetRef) override;
 
-	// Draws the scene to the output color buffer in ARGB8888 format.
-	// @todo: move everything to RenderCamera and RenderFrameSettings temporarily until design is finished.
-	void render(const CoordDouble3 &eye, const Double3 &direction, Degrees fovY, double ambient, double daytimePercent,
-		double chasmAnimPercent, double latitude, bool nightLightsAreActive, bool isExterior, bool playerHasLight,
-		int chunkDistance, double ceilingHeight, const LevelData &levelData,
-		const EntityDefinitionLibrary &entityDefLibrary, const Palette &palette, uint32_t *colorBuffer) override;
+	// Draws the scene to the output color buffer in ARGB8888 format. Entities come from the render
+	// instance group; voxels are still ray cast through the level's voxel grid.
+	void render(const RenderCamera &camera, const RenderFrameSettings &settings,
+		const RenderInstanceGroup &instGroup, const LevelData &levelData, const Palette &palette,
+		uint32_t *colorBuffer) override;
 
 	// @todo: might want to simplify the various set() function lifetimes of the renderer from
 	// at-init/occasional/every-frame to just at-init/every-frame. Things like the sky palette or render
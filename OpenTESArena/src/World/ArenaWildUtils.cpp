@@ -153,37 +153,17 @@ void ArenaWildUtils::reviseWildernessCity(const LocationDefinition &locationDef,
 	Buffer2D<uint16_t> &flor, Buffer2D<uint16_t> &map1, Buffer2D<uint16_t> &map2,
 	const BinaryAssetLibrary &binaryAssetLibrary)
 {
-	// For now, assume the given buffers are for the entire 4096x4096 wilderness.
-	// @todo: change to only care about 128x128 layers.
-	DebugAssert(flor.getWidth() == (ArenaWildUtils::WILD_WIDTH * RMDFile::WIDTH));
-	DebugAssert(flor.getWidth() == flor.getHeight());
+	DebugAssert(flor.getWidth() == (RMDFile::WIDTH * 2));
+	DebugAssert(flor.getHeight() == (RMDFile::DEPTH * 2));
 	DebugAssert(flor.getWidth() == map1.getWidth());
+	DebugAssert(flor.getHeight() == map1.getHeight());
 	DebugAssert(flor.getWidth() == map2.getWidth());
+	DebugAssert(flor.getHeight() == map2.getHeight());
 
 	// Clear all placeholder city blocks.
-	constexpr int placeholderWidth = RMDFile::WIDTH * 2;
-	constexpr int placeholderDepth = RMDFile::DEPTH * 2;
-
-	// @todo: change to only care about 128x128 floors -- these should both be removed.
-	constexpr WEInt xOffset = RMDFile::WIDTH * 31;
-	constexpr SNInt zOffset = RMDFile::DEPTH * 31;
-
-	for (WEInt x = 0; x < placeholderWidth; x++)
-	{
-		const int startIndex = zOffset + ((x + xOffset) * flor.getHeight());
-
-		auto clearRow = [placeholderDepth, startIndex](Buffer2D<uint16_t> &dst)
-		{
-			const auto dstBegin = dst.get() + startIndex;
-			const auto dstEnd = dstBegin + placeholderDepth;
-			DebugAssert(dstEnd <= dst.end());
-			std::fill(dstBegin, dstEnd, 0);
-		};
-
-		clearRow(flor);
-		clearRow(map1);
-		clearRow(map2);
-	}
+	flor.fill(0);
+	map1.fill(0);
+	map2.fill(0);
 
 	// Get city generation info -- the .MIF filename to load for the city skeleton.
 	const LocationDefinition::CityDefinition &cityDef = locationDef.getCityDefinition();
@@ -196,6 +176,8 @@ void ArenaWildUtils::reviseWildernessCity(const LocationDefinition &locationDef,
 	}
 
 	const MIFFile::Level &level = mif.getLevel(0);
+	DebugAssert(mif.getWidth() <= flor.getWidth());
+	DebugAssert(mif.getDepth() <= flor.getHeight());
 
 	// Buffers for the city data. Copy the .MIF data into them.
 	Buffer2D<uint16_t> cityFlor(mif.getWidth(), mif.getDepth());
@@ -267,19 +249,14 @@ void ArenaWildUtils::reviseWildernessCity(const LocationDefinition &locationDef,
 		}
 	}
 
-	// Write city buffers into the wilderness.
+	// Write city buffers into the wild chunks.
 	for (SNInt z = 0; z < mif.getDepth(); z++)
 	{
 		for (WEInt x = 0; x < mif.getWidth(); x++)
 		{
-			const uint16_t srcFlorVoxel = cityFlor.get(x, z);
-			const uint16_t srcMap1Voxel = cityMap1.get(x, z);
-			const uint16_t srcMap2Voxel = cityMap2.get(x, z);
-			const WEInt dstX = xOffset + x;
-			const SNInt dstZ = zOffset + z;
-			flor.set(dstX, dstZ, srcFlorVoxel);
-			map1.set(dstX, dstZ, srcMap1Voxel);
-			map2.set(dstX, dstZ, srcMap2Voxel);
+			flor.set(x, z, cityFlor.get(x, z));
+			map1.set(x, z, cityMap1.get(x, z));
+			map2.set(x, z, cityMap2.get(x, z));
 		}
 	}
 }
@@ -38,9 +38,8 @@ namespace ArenaWildUtils
 	Buffer2D<WildBlockID> generateWildernessIndices(uint32_t wildSeed,
 		const ExeData::Wilderness &wildData);
 
-	// Changes the default filler city skeleton to the one intended for the city.
-	// @todo: maybe this should eventually take a bag of chunks w/ their coordinates
-	// and it would search for the wild chunks that were at the city coordinates.
+	// Changes the default filler city skeleton to the one intended for the city. The buffers are the
+	// 128x128 layers of the 2x2 wild chunks the city is in.
 	void reviseWildernessCity(const LocationDefinition &locationDef, Buffer2D<uint16_t> &flor,
 		Buffer2D<uint16_t> &map1, Buffer2D<uint16_t> &map2,
 		const BinaryAssetLibrary &binaryAssetLibrary);
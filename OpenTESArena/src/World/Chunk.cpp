@@ -17,6 +17,10 @@ void Chunk::init(const ChunkInt2 &coord, int height)
 	// point to it.
 	this->activeVoxelDefs.front() = true;
 
+	this->changedVoxels.clear();
+	this->changedVoxelCount = 0;
+	this->changedVoxelDefs.fill(false);
+	this->isTrackingChanges = false;
 	this->coord = coord;
 }
 
@@ -65,8 +69,42 @@ const VoxelInstance &Chunk::getVoxelInst(int index) const
 	return this->voxelInsts[index];
 }
 
+int Chunk::getChangedVoxelCount() const
+{
+	return this->changedVoxelCount;
+}
+
+bool Chunk::isVoxelChanged(SNInt x, int y, WEInt z) const
+{
+	if (!this->isTrackingChanges)
+	{
+		return false;
+	}
+
+	const int index = x + (z * Chunk::WIDTH) + (y * Chunk::WIDTH * Chunk::DEPTH);
+	DebugAssertIndex(this->changedVoxels, index);
+	return this->changedVoxels[index];
+}
+
+bool Chunk::isVoxelDefChanged(VoxelID id) const
+{
+	DebugAssert(id < this->changedVoxelDefs.size());
+	return this->changedVoxelDefs[id];
+}
+
 void Chunk::setVoxel(SNInt x, int y, WEInt z, VoxelID value)
 {
+	if (this->isTrackingChanges)
+	{
+		const int index = x + (z * Chunk::WIDTH) + (y * Chunk::WIDTH * Chunk::DEPTH);
+		DebugAssertIndex(this->changedVoxels, index);
+		if (!this->changedVoxels[index])
+		{
+			this->changedVoxels[index] = true;
+			this->changedVoxelCount++;
+		}
+	}
+
 	this->voxels.set(x, y, z, value);
 }
 
@@ -84,6 +122,7 @@ bool Chunk::tryAddVoxelDef(VoxelDefinition &&voxelDef, Chunk::VoxelID *outID)
 	const VoxelID id = static_cast<VoxelID>(std::distance(this->activeVoxelDefs.begin(), iter));
 	this->voxelDefs[id] = std::move(voxelDef);
 	this->activeVoxelDefs[id] = true;
+	this->changedVoxelDefs[id] = this->isTrackingChanges;
 	*outID = id;
 	return true;
 }
@@ -93,6 +132,31 @@ void Chunk::removeVoxelDef(VoxelID id)
 	DebugAssert(id < this->voxelDefs.size());
 	this->voxelDefs[id] = VoxelDefinition();
 	this->activeVoxelDefs[id] = false;
+	this->changedVoxelDefs[id] = false;
+}
+
+void Chunk::addVoxelInst(VoxelInstance &&voxelInst)
+{
+	this->voxelInsts.emplace_back(std::move(voxelInst));
+}
+
+void Chunk::beginTrackingChanges()
+{
+	// Reuses the dirty bits' storage when a pooled chunk is activated again.
+	this->changedVoxels.assign(Chunk::WIDTH * this->getHeight() * Chunk::DEPTH, false);
+	this->changedVoxelCount = 0;
+	this->changedVoxelDefs.fill(false);
+	this->isTrackingChanges = true;
+}
+
+void Chunk::compactVoxels()
+{
+	this->voxels.compact();
+}
+
+size_t Chunk::getVoxelByteCount() const
+{
+	return this->voxels.getByteCount();
 }
 
 void Chunk::clear()
@@ -101,6 +165,10 @@ void Chunk::clear()
 	this->voxelDefs.fill(VoxelDefinition());
 	this->activeVoxelDefs.fill(false);
 	this->voxelInsts.clear();
+	this->changedVoxels.clear();
+	this->changedVoxelCount = 0;
+	this->changedVoxelDefs.fill(false);
+	this->isTrackingChanges = false;
 	this->coord = ChunkInt2();
 }
 
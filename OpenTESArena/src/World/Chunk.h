@@ -13,7 +13,7 @@
 #include "VoxelUtils.h"
 #include "../Math/MathUtils.h"
 
-#include "components/utilities/Buffer3D.h"
+#include "components/utilities/CompressedBuffer3D.h"
 
 // A 3D set of voxels for a portion of the game world.
 
@@ -30,8 +30,8 @@ private:
 	static constexpr int MAX_VOXEL_DEFS = 1 << BITS_PER_VOXEL;
 	static constexpr VoxelID AIR_VOXEL_ID = 0;
 
-	// Indices into voxel definitions.
-	Buffer3D<VoxelID> voxels;
+	// Indices into voxel definitions. Mostly air above the main floor, so uniform patches are compressed.
+	CompressedBuffer3D<VoxelID> voxels;
 
 	// Voxel definitions, pointed to by voxel IDs. If the associated bool is true,
 	// the voxel data is in use by the voxel grid.
@@ -41,6 +41,14 @@ private:
 	// Instance data for voxels that are uniquely different in some way.
 	std::vector<VoxelInstance> voxelInsts;
 
+	// Dirty bit per voxel set since the chunk started tracking changes, and voxel definitions added
+	// since then. Population happens before tracking so only changes from gameplay are saved when the
+	// chunk is recycled.
+	std::vector<bool> changedVoxels;
+	int changedVoxelCount;
+	std::array<bool, MAX_VOXEL_DEFS> changedVoxelDefs;
+	bool isTrackingChanges;
+
 	// Chunk coordinates in the world.
 	ChunkInt2 coord;
 public:
@@ -71,6 +79,16 @@ public:
 	VoxelInstance &getVoxelInst(int index);
 	const VoxelInstance &getVoxelInst(int index) const;
 
+	// Gets the number of distinct voxels set since tracking began.
+	int getChangedVoxelCount() const;
+
+	// Returns whether the voxel at the given coordinate was set since tracking began.
+	bool isVoxelChanged(SNInt x, int y, WEInt z) const;
+
+	// Returns whether the voxel definition was added since tracking began, meaning population
+	// won't recreate it.
+	bool isVoxelDefChanged(VoxelID id) const;
+
 	// Sets the voxel at the given coordinate.
 	void setVoxel(SNInt x, int y, WEInt z, VoxelID id);
 
@@ -80,6 +98,18 @@ public:
 	// Removes a voxel definition so its corresponding voxel ID can be reused.
 	void removeVoxelDef(VoxelID id);
 
+	// Adds instance data for a voxel.
+	void addVoxelInst(VoxelInstance &&voxelInst);
+
+	// Starts recording voxel changes. Called once the chunk is populated.
+	void beginTrackingChanges();
+
+	// Compresses voxels that became uniform after a batch of changes (i.e., population).
+	void compactVoxels();
+
+	// Bytes used by the chunk's voxel IDs.
+	size_t getVoxelByteCount() const;
+
 	// Clears all chunk state.
 	void clear();
 
@@ -0,0 +1,150 @@
+#include <array>
+#include <limits>
+
+#include "ChunkDelta.h"
+
+#include "components/debug/Debug.h"
+
+void ChunkDelta::init(const Chunk &chunk)
+{
+	this->voxelChanges.clear();
+	this->addedVoxelDefs.clear();
+	this->voxelInsts.clear();
+	this->removedEntityIDs.clear();
+
+	// The dirty bits are visited in Y, Z, X order, so changes come out sorted with one per voxel.
+	const int changedVoxelCount = chunk.getChangedVoxelCount();
+	if (changedVoxelCount > 0)
+	{
+		std::array<bool, std::numeric_limits<Chunk::VoxelID>::max() + 1> savedVoxelDefs;
+		savedVoxelDefs.fill(false);
+
+		this->voxelChanges.reserve(changedVoxelCount);
+		for (int y = 0; y < chunk.getHeight(); y++)
+		{
+			for (WEInt z = 0; z < Chunk::DEPTH; z++)
+			{
+				for (SNInt x = 0; x < Chunk::WIDTH; x++)
+				{
+					if (!chunk.isVoxelChanged(x, y, z))
+					{
+						continue;
+					}
+
+					VoxelChange change;
+					change.x = static_cast<uint8_t>(x);
+					change.y = static_cast<uint16_t>(y);
+					change.z = static_cast<uint8_t>(z);
+					change.id = chunk.getVoxel(x, y, z);
+					this->voxelChanges.emplace_back(change);
+
+					if (chunk.isVoxelDefChanged(change.id) && !savedVoxelDefs[change.id])
+					{
+						AddedVoxelDef addedVoxelDef;
+						addedVoxelDef.id = change.id;
+						addedVoxelDef.voxelDef = chunk.getVoxelDef(change.id);
+						this->addedVoxelDefs.emplace_back(std::move(addedVoxelDef));
+						savedVoxelDefs[change.id] = true;
+					}
+				}
+			}
+		}
+
+		DebugAssert(static_cast<int>(this->voxelChanges.size()) == changedVoxelCount);
+	}
+
+	// Chunk population doesn't make voxel instances, so all of them are changes.
+	this->voxelInsts.reserve(chunk.getVoxelInstCount());
+	for (int i = 0; i < chunk.getVoxelInstCount(); i++)
+	{
+		this->voxelInsts.emplace_back(chunk.getVoxelInst(i));
+	}
+}
+
+void ChunkDelta::setRemovedEntityIDs(std::vector<EntityID> &&entityIDs)
+{
+	this->removedEntityIDs = std::move(entityIDs);
+}
+
+bool ChunkDelta::isEmpty() const
+{
+	return this->voxelChanges.empty() && this->voxelInsts.empty() && this->removedEntityIDs.empty();
+}
+
+int ChunkDelta::getVoxelChangeCount() const
+{
+	return static_cast<int>(this->voxelChanges.size());
+}
+
+int ChunkDelta::getAddedVoxelDefCount() const
+{
+	return static_cast<int>(this->addedVoxelDefs.size());
+}
+
+int ChunkDelta::getVoxelInstCount() const
+{
+	return static_cast<int>(this->voxelInsts.size());
+}
+
+int ChunkDelta::getRemovedEntityCount() const
+{
+	return static_cast<int>(this->removedEntityIDs.size());
+}
+
+EntityID ChunkDelta::getRemovedEntityID(int index) const
+{
+	DebugAssertIndex(this->removedEntityIDs, index);
+	return this->removedEntityIDs[index];
+}
+
+void ChunkDelta::apply(Chunk &chunk) const
+{
+	// Saved IDs map to themselves unless their definition had to be added again.
+	constexpr int voxelIdCount = std::numeric_limits<Chunk::VoxelID>::max() + 1;
+	std::array<Chunk::VoxelID, voxelIdCount> newVoxelIDs;
+	std::array<bool, voxelIdCount> validVoxelIDs;
+	for (int i = 0; i < voxelIdCount; i++)
+	{
+		newVoxelIDs[i] = static_cast<Chunk::VoxelID>(i);
+	}
+
+	validVoxelIDs.fill(true);
+
+	for (const AddedVoxelDef &addedVoxelDef : this->addedVoxelDefs)
+	{
+		VoxelDefinition voxelDefCopy = addedVoxelDef.voxelDef;
+		Chunk::VoxelID newID;
+		if (!chunk.tryAddVoxelDef(std::move(voxelDefCopy), &newID))
+		{
+			DebugLogError("Couldn't add saved voxel definition " + std::to_string(addedVoxelDef.id) +
+				" to chunk (" + chunk.getCoord().toString() + ").");
+			validVoxelIDs[addedVoxelDef.id] = false;
+			continue;
+		}
+
+		newVoxelIDs[addedVoxelDef.id] = newID;
+	}
+
+	for (const VoxelChange &change : this->voxelChanges)
+	{
+		if (change.y >= chunk.getHeight())
+		{
+			DebugLogError("Voxel change Y (" + std::to_string(change.y) + ") is outside chunk (" +
+				chunk.getCoord().toString() + ").");
+			continue;
+		}
+
+		if (!validVoxelIDs[change.id])
+		{
+			continue;
+		}
+
+		chunk.setVoxel(change.x, change.y, change.z, newVoxelIDs[change.id]);
+	}
+
+	for (const VoxelInstance &voxelInst : this->voxelInsts)
+	{
+		VoxelInstance voxelInstCopy = voxelInst;
+		chunk.addVoxelInst(std::move(voxelInstCopy));
+	}
+}
@@ -0,0 +1,66 @@
+#ifndef CHUNK_DELTA_H
+#define CHUNK_DELTA_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Chunk.h"
+#include "VoxelInstance.h"
+#include "../Entities/EntityUtils.h"
+
+// Changes made to a chunk since it was populated from its level definition. Saved when the chunk
+// leaves the active range and replayed when it's populated again, so a chunk keeps its opened doors
+// and changed voxels without staying in memory. Unchanged chunks don't need one.
+
+// Voxel definitions added after population are saved with the delta, since population doesn't
+// recreate them and their IDs might be taken by something else when the delta is applied.
+
+// Entities are deleted with the chunk and population doesn't spawn them again, so the delta only
+// records which ones were removed. Their IDs stay reserved until the delta is replayed.
+
+class ChunkDelta
+{
+private:
+	// Six bytes with padding.
+	struct VoxelChange
+	{
+		uint8_t x, z;
+		uint16_t y;
+		Chunk::VoxelID id;
+	};
+
+	static_assert(Chunk::WIDTH <= UINT8_MAX + 1);
+	static_assert(Chunk::DEPTH <= UINT8_MAX + 1);
+
+	// A voxel definition the chunk didn't get from population, with the ID it had when saved.
+	struct AddedVoxelDef
+	{
+		Chunk::VoxelID id;
+		VoxelDefinition voxelDef;
+	};
+
+	std::vector<VoxelChange> voxelChanges; // Sorted by Y, then Z, then X.
+	std::vector<AddedVoxelDef> addedVoxelDefs;
+	std::vector<VoxelInstance> voxelInsts;
+	std::vector<EntityID> removedEntityIDs; // Entities deleted along with the chunk.
+public:
+	// Saves the chunk's changed voxels, the voxel definitions they need that population doesn't
+	// recreate, and all of its voxel instances.
+	void init(const Chunk &chunk);
+
+	// Records the entities deleted along with the chunk when it was recycled.
+	void setRemovedEntityIDs(std::vector<EntityID> &&entityIDs);
+
+	bool isEmpty() const;
+	int getVoxelChangeCount() const;
+	int getAddedVoxelDefCount() const;
+	int getVoxelInstCount() const;
+	int getRemovedEntityCount() const;
+	EntityID getRemovedEntityID(int index) const;
+
+	// Replays the changes onto a freshly populated chunk at the same coordinate. Saved voxel
+	// definitions are added to the chunk and changed voxels are remapped to their new IDs.
+	void apply(Chunk &chunk) const;
+};
+
+#endif
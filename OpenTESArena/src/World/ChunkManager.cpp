@@ -1,4 +1,6 @@
 #include <algorithm>
+#include <cstdlib>
+#include <functional>
 
 #include "ChunkManager.h"
 #include "ChunkUtils.h"
@@ -10,6 +12,41 @@
 #include "components/debug/Debug.h"
 #include "components/utilities/Buffer.h"
 
+ChunkManager::PopulateThreadData::PopulateThreadData()
+{
+	this->runningJobCount = 0;
+	this->stop = false;
+}
+
+ChunkManager::ChunkManager()
+{
+	this->pendingMapGeneration = -1;
+	this->pendingLevelIndex = -1;
+	this->allocatedChunkCount = 0;
+}
+
+ChunkManager::~ChunkManager()
+{
+	if (this->populateThreadData == nullptr)
+	{
+		return;
+	}
+
+	// Queued jobs are dropped, and running ones are waited on by joining their threads. Jobs own their
+	// map definition, so nothing they read can be freed before then.
+	PopulateThreadData &threadData = *this->populateThreadData;
+	std::unique_lock<std::mutex> lk(threadData.mutex);
+	threadData.stop = true;
+	threadData.queuedJobs.clear();
+	lk.unlock();
+	threadData.condVar.notify_all();
+
+	for (std::thread &thread : threadData.threads)
+	{
+		thread.join();
+	}
+}
+
 int ChunkManager::getChunkCount() const
 {
 	return static_cast<int>(this->activeChunks.size());
@@ -35,15 +72,16 @@ const Chunk &ChunkManager::getChunk(int index) const
 
 std::optional<int> ChunkManager::tryGetChunkIndex(const ChunkInt2 &coord) const
 {
-	const auto iter = std::find_if(this->activeChunks.begin(), this->activeChunks.end(),
-		[&coord](const ChunkPtr &chunkPtr)
+	if (this->chunkIndexSlots.empty())
 	{
-		return chunkPtr->getCoord() == coord;
-	});
+		return std::nullopt;
+	}
 
-	if (iter != this->activeChunks.end())
+	const ChunkIndexSlot &slot = this->chunkIndexSlots[this->getChunkIndexSlot(coord)];
+	if (slot.index >= 0)
 	{
-		return static_cast<int>(std::distance(this->activeChunks.begin(), iter));
+		DebugAssert(this->activeChunks[slot.index]->getCoord() == coord);
+		return slot.index;
 	}
 	else
 	{
@@ -51,6 +89,28 @@ std::optional<int> ChunkManager::tryGetChunkIndex(const ChunkInt2 &coord) const
 	}
 }
 
+const Chunk *ChunkManager::tryGetChunkOrPlaceholder(const ChunkInt2 &coord) const
+{
+	const std::optional<int> index = this->tryGetChunkIndex(coord);
+	if (index.has_value())
+	{
+		return &this->getChunk(*index);
+	}
+	else if (this->isChunkPending(coord))
+	{
+		return &this->placeholderChunk;
+	}
+	else
+	{
+		return nullptr;
+	}
+}
+
+bool ChunkManager::isPlaceholderChunk(const Chunk &chunk) const
+{
+	return &chunk == &this->placeholderChunk;
+}
+
 int ChunkManager::getCenterChunkIndex() const
 {
 	const std::optional<int> index = this->tryGetChunkIndex(this->centerChunk);
@@ -58,20 +118,182 @@ int ChunkManager::getCenterChunkIndex() const
 	return *index;
 }
 
-int ChunkManager::spawnChunk()
+int ChunkManager::getPooledChunkCount() const
+{
+	return static_cast<int>(this->chunkPool.size());
+}
+
+bool ChunkManager::isChunkPending(const ChunkInt2 &coord) const
+{
+	return std::find(this->pendingCoords.begin(), this->pendingCoords.end(), coord) != this->pendingCoords.end();
+}
+
+int ChunkManager::getAllocatedChunkCount() const
+{
+	return this->allocatedChunkCount;
+}
+
+int ChunkManager::getChunkDeltaCount() const
+{
+	int count = 0;
+	for (const auto &pair : this->chunkDeltas)
+	{
+		count += static_cast<int>(pair.second.size());
+	}
+
+	return count;
+}
+
+uint32_t ChunkManager::getChunkIndexSlotHash(const ChunkInt2 &coord)
+{
+	// Multiply each coordinate by a different odd constant so neighboring chunks don't cluster.
+	const uint32_t hash = (static_cast<uint32_t>(coord.x) * 0x9E3779B1u) ^
+		(static_cast<uint32_t>(coord.y) * 0x85EBCA77u);
+	return hash ^ (hash >> 16);
+}
+
+int ChunkManager::getChunkIndexSlot(const ChunkInt2 &coord) const
+{
+	DebugAssert(!this->chunkIndexSlots.empty());
+	const int mask = static_cast<int>(this->chunkIndexSlots.size()) - 1;
+	int slotIndex = static_cast<int>(ChunkManager::getChunkIndexSlotHash(coord)) & mask;
+
+	// The table is never more than half full, so an empty slot always ends the search.
+	while (true)
+	{
+		const ChunkIndexSlot &slot = this->chunkIndexSlots[slotIndex];
+		if ((slot.index < 0) || (slot.coord == coord))
+		{
+			return slotIndex;
+		}
+
+		slotIndex = (slotIndex + 1) & mask;
+	}
+}
+
+void ChunkManager::reserveChunkIndexSlots(int chunkCount)
+{
+	int capacity = 16;
+	while (capacity < (chunkCount * 2))
+	{
+		capacity *= 2;
+	}
+
+	if (capacity <= static_cast<int>(this->chunkIndexSlots.size()))
+	{
+		return;
+	}
+
+	ChunkIndexSlot emptySlot;
+	emptySlot.coord = ChunkInt2();
+	emptySlot.index = -1;
+	this->chunkIndexSlots.assign(capacity, emptySlot);
+
+	for (int i = 0; i < static_cast<int>(this->activeChunks.size()); i++)
+	{
+		this->setChunkIndex(this->activeChunks[i]->getCoord(), i);
+	}
+}
+
+void ChunkManager::setChunkIndex(const ChunkInt2 &coord, int index)
+{
+	DebugAssert(index >= 0);
+	DebugAssert((static_cast<int>(this->activeChunks.size()) * 2) <= static_cast<int>(this->chunkIndexSlots.size()));
+
+	ChunkIndexSlot &slot = this->chunkIndexSlots[this->getChunkIndexSlot(coord)];
+	slot.coord = coord;
+	slot.index = index;
+}
+
+void ChunkManager::removeChunkIndex(const ChunkInt2 &coord)
+{
+	if (this->chunkIndexSlots.empty())
+	{
+		return;
+	}
+
+	const int mask = static_cast<int>(this->chunkIndexSlots.size()) - 1;
+	int holeIndex = this->getChunkIndexSlot(coord);
+	if (this->chunkIndexSlots[holeIndex].index < 0)
+	{
+		return;
+	}
+
+	// Backward-shift deletion: move later entries of the probe chain into the hole when the hole
+	// lies between their home slot and where they are now, so look-ups never stop early.
+	int nextIndex = (holeIndex + 1) & mask;
+	while (this->chunkIndexSlots[nextIndex].index >= 0)
+	{
+		const ChunkIndexSlot &nextSlot = this->chunkIndexSlots[nextIndex];
+		const int homeIndex = static_cast<int>(ChunkManager::getChunkIndexSlotHash(nextSlot.coord)) & mask;
+		const int nextProbeLength = (nextIndex - homeIndex) & mask;
+		const int holeDistance = (nextIndex - holeIndex) & mask;
+		if (nextProbeLength >= holeDistance)
+		{
+			this->chunkIndexSlots[holeIndex] = nextSlot;
+			holeIndex = nextIndex;
+		}
+
+		nextIndex = (nextIndex + 1) & mask;
+	}
+
+	this->chunkIndexSlots[holeIndex].index = -1;
+}
+
+ChunkManager::ChunkPtr ChunkManager::takePooledChunk()
 {
 	if (!this->chunkPool.empty())
 	{
-		this->activeChunks.emplace_back(std::move(this->chunkPool.back()));
+		ChunkPtr chunk = std::move(this->chunkPool.back());
 		this->chunkPool.pop_back();
+		return chunk;
 	}
 	else
 	{
 		// Always allow expanding in the event that chunk distance is increased.
-		this->activeChunks.emplace_back(std::make_unique<Chunk>());
+		this->allocatedChunkCount++;
+		return std::make_unique<Chunk>();
 	}
+}
+
+void ChunkManager::returnPooledChunk(ChunkPtr &&chunk)
+{
+	chunk->clear();
+	this->chunkPool.emplace_back(std::move(chunk));
+}
 
-	return static_cast<int>(this->activeChunks.size()) - 1;
+ChunkManager::ChunkDeltaMap &ChunkManager::getPendingChunkDeltas()
+{
+	return this->chunkDeltas[std::make_pair(this->pendingMapGeneration, this->pendingLevelIndex)];
+}
+
+int ChunkManager::activateChunk(ChunkPtr &&chunk, EntityManager &entityManager)
+{
+	const ChunkInt2 coord = chunk->getCoord();
+
+	// Replayed changes are tracked too, so they're saved again when the chunk is next recycled.
+	chunk->beginTrackingChanges();
+	ChunkDeltaMap &chunkDeltas = this->getPendingChunkDeltas();
+	const auto deltaIter = chunkDeltas.find(coord);
+	if (deltaIter != chunkDeltas.end())
+	{
+		const ChunkDelta &chunkDelta = deltaIter->second;
+		chunkDelta.apply(*chunk);
+
+		// Nothing refers to the removed entities anymore.
+		for (int i = 0; i < chunkDelta.getRemovedEntityCount(); i++)
+		{
+			entityManager.releaseEntityID(chunkDelta.getRemovedEntityID(i));
+		}
+
+		chunkDeltas.erase(deltaIter);
+	}
+
+	this->activeChunks.emplace_back(std::move(chunk));
+
+	const int index = static_cast<int>(this->activeChunks.size()) - 1;
+	this->setChunkIndex(coord, index);
+	return index;
 }
 
 void ChunkManager::recycleChunk(int index, EntityManager &entityManager)
@@ -80,13 +302,42 @@ void ChunkManager::recycleChunk(int index, EntityManager &entityManager)
 	ChunkPtr &chunkPtr = this->activeChunks[index];
 	const ChunkInt2 coord = chunkPtr->getCoord();
 
-	// @todo: save chunk changes
+	ChunkDelta chunkDelta;
+	chunkDelta.init(*chunkPtr);
+
+	// The chunk's entities are deleted with it below, so record which ones are gone.
+	const int entitySlotCount = entityManager.getTotalCountInChunk(coord);
+	if (entitySlotCount > 0)
+	{
+		std::vector<const Entity*> entities(entitySlotCount);
+		const int entityCount = entityManager.getTotalEntitiesInChunk(coord, entities.data(), entitySlotCount);
+		std::vector<EntityID> entityIDs(entityCount);
+		for (int i = 0; i < entityCount; i++)
+		{
+			entityIDs[i] = entities[i]->getID();
+		}
+
+		chunkDelta.setRemovedEntityIDs(std::move(entityIDs));
+	}
+
+	if (!chunkDelta.isEmpty())
+	{
+		this->getPendingChunkDeltas()[coord] = std::move(chunkDelta);
+	}
+
+	// Move chunk to chunk pool and fill its place with the last active chunk. It's okay to shift
+	// chunk pointers around because this is during the time when references get invalidated.
+	this->removeChunkIndex(coord);
+	this->returnPooledChunk(std::move(chunkPtr));
+
+	const int lastIndex = static_cast<int>(this->activeChunks.size()) - 1;
+	if (index != lastIndex)
+	{
+		this->activeChunks[index] = std::move(this->activeChunks[lastIndex]);
+		this->setChunkIndex(this->activeChunks[index]->getCoord(), index);
+	}
 
-	// Move chunk to chunk pool. It's okay to shift chunk pointers around because this is during the 
-	// time when references get invalidated.
-	chunkPtr->clear();
-	this->chunkPool.emplace_back(std::move(chunkPtr));
-	this->activeChunks.erase(this->activeChunks.begin() + index);
+	this->activeChunks.pop_back();
 
 	// Notify entity manager that the chunk is being cleared.
 	entityManager.clearChunk(coord);
@@ -139,11 +390,9 @@ void ChunkManager::populateChunkFromLevel(Chunk &chunk, const LevelDefinition &l
 	}
 }
 
-bool ChunkManager::populateChunk(int index, const ChunkInt2 &coord, int activeLevelIndex,
-	const MapDefinition &mapDefinition)
+bool ChunkManager::populateChunk(Chunk &chunk, const ChunkInt2 &coord, int activeLevelIndex,
+	const MapDefinition &mapDefinition, const MapDefinition::WildBlock *wildBlock)
 {
-	Chunk &chunk = this->getChunk(index);
-
 	// Populate all or part of the chunk from a level definition depending on the world type.
 	const MapType mapType = mapDefinition.getMapType();
 	if (mapType == MapType::Interior)
@@ -159,7 +408,7 @@ bool ChunkManager::populateChunk(int index, const ChunkInt2 &coord, int activeLe
 		{
 			// Populate chunk from the part of the level it overlaps.
 			const LevelInt2 levelOffset = coord * ChunkUtils::CHUNK_DIM;
-			this->populateChunkFromLevel(chunk, levelDefinition, levelInfoDefinition, levelOffset);
+			ChunkManager::populateChunkFromLevel(chunk, levelDefinition, levelInfoDefinition, levelOffset);
 		}
 	}
 	else if (mapType == MapType::City)
@@ -176,21 +425,25 @@ bool ChunkManager::populateChunk(int index, const ChunkInt2 &coord, int activeLe
 		{
 			// Populate chunk from the part of the level it overlaps.
 			const LevelInt2 levelOffset = coord * ChunkUtils::CHUNK_DIM;
-			this->populateChunkFromLevel(chunk, levelDefinition, levelInfoDefinition, levelOffset);
+			ChunkManager::populateChunkFromLevel(chunk, levelDefinition, levelInfoDefinition, levelOffset);
 		}
 	}
 	else if (mapType == MapType::Wilderness)
 	{
-		const MapDefinition::Wild &mapDefWild = mapDefinition.getWild();
-		const int levelDefIndex = mapDefWild.getLevelDefIndex(coord);
-		const LevelDefinition &levelDefinition = mapDefinition.getLevel(levelDefIndex);
-		const LevelInfoDefinition &levelInfoDefinition = mapDefinition.getLevelInfoForLevel(levelDefIndex);
+		if (wildBlock == nullptr)
+		{
+			// The map definition's wild blocks weren't updated for this chunk.
+			return false;
+		}
+
+		const LevelDefinition &levelDefinition = wildBlock->levelDef;
+		const LevelInfoDefinition &levelInfoDefinition = wildBlock->levelInfoDef;
 		chunk.init(coord, levelDefinition.getHeight());
 
 		// Copy level definition directly into chunk.
 		DebugAssert(levelDefinition.getWidth() == Chunk::WIDTH);
 		DebugAssert(levelDefinition.getDepth() == Chunk::DEPTH);
-		this->populateChunkFromLevel(chunk, levelDefinition, levelInfoDefinition, LevelInt2(0, 0));
+		ChunkManager::populateChunkFromLevel(chunk, levelDefinition, levelInfoDefinition, LevelInt2(0, 0));
 	}
 	else
 	{
@@ -198,15 +451,236 @@ bool ChunkManager::populateChunk(int index, const ChunkInt2 &coord, int activeLe
 		return false;
 	}
 
+	chunk.compactVoxels();
 	return true;
 }
 
+void ChunkManager::populateThreadLoop(PopulateThreadData &threadData)
+{
+	std::unique_lock<std::mutex> lk(threadData.mutex);
+	while (true)
+	{
+		threadData.condVar.wait(lk, [&threadData]()
+		{
+			return threadData.stop || !threadData.queuedJobs.empty();
+		});
+
+		if (threadData.stop)
+		{
+			return;
+		}
+
+		PopulateJob job = std::move(threadData.queuedJobs.front());
+		threadData.queuedJobs.pop_front();
+		threadData.runningJobCount++;
+
+		// Populate without the lock so other threads and the main thread aren't held up.
+		lk.unlock();
+		job.success = ChunkManager::populateChunk(*job.chunk, job.coord, job.activeLevelIndex,
+			*job.mapDefinition, job.wildBlock.get());
+		lk.lock();
+
+		threadData.finishedJobs.emplace_back(std::move(job));
+		threadData.runningJobCount--;
+		threadData.doneCondVar.notify_all();
+	}
+}
+
+void ChunkManager::startPopulateThreads()
+{
+	if (this->populateThreadData != nullptr)
+	{
+		return;
+	}
+
+	// Leave most cores to the renderer; chunk population only needs to keep ahead of the player.
+	const int hardwareThreadCount = static_cast<int>(std::thread::hardware_concurrency());
+	const int threadCount = std::clamp(hardwareThreadCount / 4, 1, 2);
+
+	this->populateThreadData = std::make_unique<PopulateThreadData>();
+	PopulateThreadData &threadData = *this->populateThreadData;
+	for (int i = 0; i < threadCount; i++)
+	{
+		threadData.threads.emplace_back(ChunkManager::populateThreadLoop, std::ref(threadData));
+	}
+}
+
+void ChunkManager::queuePopulateJob(const ChunkInt2 &coord, int activeLevelIndex,
+	const std::shared_ptr<const MapDefinition> &mapDefinition)
+{
+	this->startPopulateThreads();
+
+	PopulateJob job;
+	job.chunk = this->takePooledChunk();
+	job.coord = coord;
+	job.activeLevelIndex = activeLevelIndex;
+	job.mapDefinition = mapDefinition;
+	job.mapGeneration = mapDefinition->getGeneration();
+	job.success = false;
+
+	if (mapDefinition->getMapType() == MapType::Wilderness)
+	{
+		job.wildBlock = mapDefinition->getWild().getBlock(coord);
+	}
+
+	PopulateThreadData &threadData = *this->populateThreadData;
+	std::unique_lock<std::mutex> lk(threadData.mutex);
+	threadData.queuedJobs.emplace_back(std::move(job));
+	lk.unlock();
+	threadData.condVar.notify_one();
+
+	this->pendingCoords.emplace_back(coord);
+}
+
+void ChunkManager::waitForPopulateJobs()
+{
+	if (this->populateThreadData == nullptr)
+	{
+		return;
+	}
+
+	PopulateThreadData &threadData = *this->populateThreadData;
+	std::unique_lock<std::mutex> lk(threadData.mutex);
+	threadData.doneCondVar.wait(lk, [&threadData]()
+	{
+		return threadData.queuedJobs.empty() && (threadData.runningJobCount == 0);
+	});
+}
+
+void ChunkManager::discardOutOfRangePopulateJobs(int chunkDistance)
+{
+	if (this->populateThreadData == nullptr)
+	{
+		return;
+	}
+
+	PopulateThreadData &threadData = *this->populateThreadData;
+	std::lock_guard<std::mutex> lk(threadData.mutex);
+	std::deque<PopulateJob> &queuedJobs = threadData.queuedJobs;
+	for (auto iter = queuedJobs.begin(); iter != queuedJobs.end(); )
+	{
+		if (ChunkUtils::isWithinActiveRange(this->centerChunk, iter->coord, chunkDistance))
+		{
+			++iter;
+			continue;
+		}
+
+		const auto pendingIter = std::find(this->pendingCoords.begin(), this->pendingCoords.end(), iter->coord);
+		DebugAssert(pendingIter != this->pendingCoords.end());
+		*pendingIter = this->pendingCoords.back();
+		this->pendingCoords.pop_back();
+
+		this->returnPooledChunk(std::move(iter->chunk));
+		iter = queuedJobs.erase(iter);
+	}
+}
+
+void ChunkManager::waitForPopulateJob(const ChunkInt2 &coord)
+{
+	DebugAssert(this->isChunkPending(coord));
+	DebugAssert(this->populateThreadData != nullptr);
+
+	PopulateThreadData &threadData = *this->populateThreadData;
+	std::unique_lock<std::mutex> lk(threadData.mutex);
+
+	// Jobs are queued nearest first, but older jobs from before a teleport might be ahead of it.
+	std::deque<PopulateJob> &queuedJobs = threadData.queuedJobs;
+	const auto queuedIter = std::find_if(queuedJobs.begin(), queuedJobs.end(),
+		[&coord](const PopulateJob &job) { return job.coord == coord; });
+	if ((queuedIter != queuedJobs.end()) && (queuedIter != queuedJobs.begin()))
+	{
+		PopulateJob job = std::move(*queuedIter);
+		queuedJobs.erase(queuedIter);
+		queuedJobs.emplace_front(std::move(job));
+	}
+
+	// A pending coordinate only ever has one job, whether queued, running, or finished.
+	const std::vector<PopulateJob> &finishedJobs = threadData.finishedJobs;
+	threadData.doneCondVar.wait(lk, [&finishedJobs, &coord]()
+	{
+		return std::any_of(finishedJobs.begin(), finishedJobs.end(),
+			[&coord](const PopulateJob &job) { return job.coord == coord; });
+	});
+}
+
+void ChunkManager::commitPopulatedChunks(int chunkDistance, EntityManager &entityManager)
+{
+	if (this->populateThreadData == nullptr)
+	{
+		return;
+	}
+
+	// Only pointers are moved here, so holding the lock is cheap.
+	PopulateThreadData &threadData = *this->populateThreadData;
+	std::lock_guard<std::mutex> lk(threadData.mutex);
+	for (PopulateJob &job : threadData.finishedJobs)
+	{
+		const auto pendingIter = std::find(this->pendingCoords.begin(), this->pendingCoords.end(), job.coord);
+		DebugAssert(pendingIter != this->pendingCoords.end());
+		*pendingIter = this->pendingCoords.back();
+		this->pendingCoords.pop_back();
+
+		if (!job.success)
+		{
+			DebugLogError("Couldn't populate chunk at (" + job.coord.toString() + ").");
+			this->returnPooledChunk(std::move(job.chunk));
+			continue;
+		}
+
+		// The player might have moved away or changed levels while the chunk was being populated.
+		const bool isCurrentMap = (job.mapGeneration == this->pendingMapGeneration) &&
+			(job.activeLevelIndex == this->pendingLevelIndex);
+		const bool isInRange = ChunkUtils::isWithinActiveRange(this->centerChunk, job.coord, chunkDistance);
+		if (isCurrentMap && isInRange && !this->tryGetChunkIndex(job.coord).has_value())
+		{
+			this->activateChunk(std::move(job.chunk), entityManager);
+		}
+		else
+		{
+			this->returnPooledChunk(std::move(job.chunk));
+		}
+	}
+
+	threadData.finishedJobs.clear();
+}
+
 void ChunkManager::update(double dt, const ChunkInt2 &centerChunk, int activeLevelIndex,
-	const MapDefinition &mapDefinition, int chunkDistance, EntityManager &entityManager)
+	const std::shared_ptr<const MapDefinition> &mapDefinition, int chunkDistance,
+	EntityManager &entityManager)
 {
+	DebugAssert(mapDefinition != nullptr);
 	this->centerChunk = centerChunk;
 
-	// Free any out-of-range chunks.
+	SNInt activeChunkCountX;
+	WEInt activeChunkCountZ;
+	ChunkUtils::getPotentiallyVisibleChunkCounts(chunkDistance, &activeChunkCountX, &activeChunkCountZ);
+	this->reserveChunkIndexSlots(activeChunkCountX * activeChunkCountZ);
+
+	// Jobs for a previous map or level are finished so their coordinates stop being pending, then
+	// thrown away when committed. The map is compared by generation since a new map might be
+	// allocated at the same address.
+	const int mapGeneration = mapDefinition->getGeneration();
+	if ((mapGeneration != this->pendingMapGeneration) || (activeLevelIndex != this->pendingLevelIndex))
+	{
+		this->waitForPopulateJobs();
+
+		// Chunks of the previous map or level save their changes under it, so they're replayed if
+		// it becomes active again.
+		for (int i = static_cast<int>(this->activeChunks.size()) - 1; i >= 0; i--)
+		{
+			this->recycleChunk(i, entityManager);
+		}
+
+		this->pendingMapGeneration = mapGeneration;
+		this->pendingLevelIndex = activeLevelIndex;
+	}
+
+	// Add chunks that finished populating since the last update.
+	this->commitPopulatedChunks(chunkDistance, entityManager);
+
+	// Free any out-of-range chunks, and skip populating ones that left the range before their job
+	// started.
+	this->discardOutOfRangePopulateJobs(chunkDistance);
 	for (int i = static_cast<int>(this->activeChunks.size()) - 1; i >= 0; i--)
 	{
 		const ChunkPtr &chunkPtr = this->activeChunks[i];
@@ -217,31 +691,52 @@ void ChunkManager::update(double dt, const ChunkInt2 &centerChunk, int activeLev
 		}
 	}
 
-	// Add new chunks until the area around the center chunk is filled.
-	ChunkInt2 minCoord, maxCoord;
-	ChunkUtils::getSurroundingChunks(centerChunk, chunkDistance, &minCoord, &maxCoord);
-
-	for (WEInt y = minCoord.y; y <= maxCoord.y; y++)
+	// Queue the missing chunks around the center, nearest rings first so the chunks the player is
+	// about to reach are ready soonest.
+	for (int ring = 0; ring <= chunkDistance; ring++)
 	{
-		for (SNInt x = minCoord.x; x <= maxCoord.x; x++)
+		ChunkInt2 minCoord, maxCoord;
+		ChunkUtils::getSurroundingChunks(centerChunk, std::max(ring, 1), &minCoord, &maxCoord);
+
+		for (WEInt y = minCoord.y; y <= maxCoord.y; y++)
 		{
-			const ChunkInt2 coord(x, y);
-			const std::optional<int> index = this->tryGetChunkIndex(coord);
-			if (!index.has_value())
+			for (SNInt x = minCoord.x; x <= maxCoord.x; x++)
 			{
-				const int spawnIndex = this->spawnChunk();
-				if (!this->populateChunk(spawnIndex, coord, activeLevelIndex, mapDefinition))
+				const ChunkInt2 coord(x, y);
+				const int coordRing = std::max(std::abs(x - centerChunk.x), std::abs(y - centerChunk.y));
+				if ((coordRing != ring) || this->tryGetChunkIndex(coord).has_value() || this->isChunkPending(coord))
 				{
-					DebugLogError("Couldn't populate chunk \"" + std::to_string(spawnIndex) +
-						"\" at (" + coord.toString() + ").");
+					continue;
 				}
+
+				this->queuePopulateJob(coord, activeLevelIndex, mapDefinition);
 			}
 		}
 	}
 
-	// Free any unneeded chunks for memory savings in case the chunk distance was once large
-	// and is now small. This is significant even for chunk distance 2->1, or 25->9 chunks.
-	this->chunkPool.clear();
+	// The center chunk is needed right away (i.e., for the player's physics), which only happens
+	// when a level is first loaded or the player teleports. The rest can keep populating.
+	if (!this->tryGetChunkIndex(centerChunk).has_value())
+	{
+		this->waitForPopulateJob(centerChunk);
+		this->commitPopulatedChunks(chunkDistance, entityManager);
+	}
+
+	// The placeholder only needs to match the level's height.
+	const Chunk &centerChunkRef = this->getChunk(this->getCenterChunkIndex());
+	if (this->placeholderChunk.getHeight() != centerChunkRef.getHeight())
+	{
+		this->placeholderChunk.init(ChunkInt2(), centerChunkRef.getHeight());
+	}
+
+	// Keep enough pooled chunks for a row or column entering range so walking across chunk
+	// boundaries doesn't allocate, but free the rest in case the chunk distance was once large and
+	// is now small. This is significant even for chunk distance 2->1, or 25->9 chunks.
+	const int maxPooledChunkCount = std::max(activeChunkCountX, activeChunkCountZ);
+	if (static_cast<int>(this->chunkPool.size()) > maxPooledChunkCount)
+	{
+		this->chunkPool.resize(maxPooledChunkCount);
+	}
 
 	// Update each chunk so they can animate/destroy faded voxel instances, etc..
 	for (int i = 0; i < static_cast<int>(this->activeChunks.size()) - 1; i++)
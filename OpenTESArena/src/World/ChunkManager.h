@@ -1,23 +1,38 @@
 #ifndef CHUNK_MANAGER_H
 #define CHUNK_MANAGER_H
 
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "Chunk.h"
+#include "ChunkDelta.h"
 #include "ChunkUtils.h"
+#include "MapDefinition.h"
 #include "VoxelUtils.h"
 
 // Handles lifetimes of chunks. Does not store any entities. When freeing a chunk, it needs to tell
 // the entity manager so the entities in it are handled correctly (marked for deletion one way or
 // another).
 
+// New chunks are populated by background threads into chunks that aren't active yet, and finished
+// ones are committed at the start of the next update. Until then they aren't returned by index
+// look-ups, and tryGetChunkOrPlaceholder() gives an all-air placeholder to be drawn fogged, like
+// space beyond the fog. Populate jobs share ownership of the map definition they read, so the
+// caller can drop it at any time, but it must not be initialized again while shared.
+
 class EntityManager;
 class Game;
 class LevelDefinition;
 class LevelInfoDefinition;
-class MapDefinition;
 
 enum class MapType;
 
@@ -26,37 +41,170 @@ class ChunkManager
 private:
 	using ChunkPtr = std::unique_ptr<Chunk>;
 
+	// Entry in the chunk coordinate -> active chunk index table. Empty if the index is negative.
+	struct ChunkIndexSlot
+	{
+		ChunkInt2 coord;
+		int index;
+	};
+
+	// A chunk being populated away from the active chunks. The job keeps the map definition alive
+	// until it's committed or discarded.
+	struct PopulateJob
+	{
+		ChunkPtr chunk;
+		ChunkInt2 coord;
+		int activeLevelIndex;
+		std::shared_ptr<const MapDefinition> mapDefinition;
+		int mapGeneration;
+		std::shared_ptr<const MapDefinition::WildBlock> wildBlock; // Only in the wilderness.
+		bool success;
+	};
+
+	// State shared with the populate threads. Heap allocated so the chunk manager can still be moved.
+	struct PopulateThreadData
+	{
+		std::vector<std::thread> threads;
+		std::mutex mutex;
+		std::condition_variable condVar; // Signals queued jobs or stopping.
+		std::condition_variable doneCondVar; // Signals finished jobs.
+		std::deque<PopulateJob> queuedJobs; // Nearest chunks first.
+		std::vector<PopulateJob> finishedJobs;
+		int runningJobCount;
+		bool stop;
+
+		PopulateThreadData();
+	};
+
 	std::vector<ChunkPtr> chunkPool;
 	std::vector<ChunkPtr> activeChunks;
+
+	// All air, returned in place of chunks that are pending. Same height as the center chunk.
+	Chunk placeholderChunk;
+
+	// Open-addressing (linear probing) table for active chunk look-ups. The capacity is a power of
+	// two and kept at least twice the active chunk count so probe sequences stay short.
+	std::vector<ChunkIndexSlot> chunkIndexSlots;
+
+	std::unique_ptr<PopulateThreadData> populateThreadData;
+	std::vector<ChunkInt2> pendingCoords; // Chunks queued, being populated, or waiting to be committed.
+	int pendingMapGeneration; // Map and level the pending chunks are populated from.
+	int pendingLevelIndex;
+
 	ChunkInt2 centerChunk;
+	int allocatedChunkCount; // Chunks created since construction, including pooled ones.
+
+	// Changes of recycled chunks, replayed when they're populated again. Only changed chunks have one.
+	// Kept per map generation and level index so switching levels doesn't lose them.
+	using ChunkDeltaMap = std::unordered_map<ChunkInt2, ChunkDelta>;
+	std::map<std::pair<int, int>, ChunkDeltaMap> chunkDeltas;
+
+	static uint32_t getChunkIndexSlotHash(const ChunkInt2 &coord);
+
+	// Gets the table slot holding the given chunk coordinate, or the empty slot where it would go.
+	int getChunkIndexSlot(const ChunkInt2 &coord) const;
+
+	// Grows the look-up table if needed so it can hold the given number of active chunks.
+	void reserveChunkIndexSlots(int chunkCount);
+
+	// Adds or replaces the active chunk index for the given coordinate.
+	void setChunkIndex(const ChunkInt2 &coord, int index);
+
+	// Removes the coordinate from the look-up table, shifting back any entries in its probe chain.
+	void removeChunkIndex(const ChunkInt2 &coord);
+
+	// Takes a chunk from the chunk pool, or allocates one if the pool is empty.
+	ChunkPtr takePooledChunk();
 
-	// Takes a chunk from the chunk pool, moves it to the active chunks, and returns its index.
-	int spawnChunk();
+	// Clears the chunk and puts it in the chunk pool.
+	void returnPooledChunk(ChunkPtr &&chunk);
 
-	// Clears the chunk, including entities, and removes it from the active chunks.
+	// Gets the saved changes of the map and level being populated.
+	ChunkDeltaMap &getPendingChunkDeltas();
+
+	// Moves a populated chunk to the active chunks and returns its index. Any saved changes for the
+	// chunk are replayed first, and the IDs of entities deleted with it are released.
+	int activateChunk(ChunkPtr &&chunk, EntityManager &entityManager);
+
+	// Saves the chunk's changes, clears the chunk, including entities, and removes it from the active
+	// chunks. The last active chunk takes its index.
 	void recycleChunk(int index, EntityManager &entityManager);
 
 	// Helper function for setting the chunk's voxels and definitions from the given level. This might
 	// not touch all voxels in the chunk because it does not fully overlap the level.
-	void populateChunkFromLevel(Chunk &chunk, const LevelDefinition &levelDefinition,
+	static void populateChunkFromLevel(Chunk &chunk, const LevelDefinition &levelDefinition,
 		const LevelInfoDefinition &levelInfoDefinition, const LevelInt2 &levelOffset);
 
-	// Fills the chunk with the data required based on its position and the world type.
-	bool populateChunk(int index, const ChunkInt2 &coord, int activeLevelIndex,
-		const MapDefinition &mapDefinition);
+	// Fills the chunk with the data required based on its position and the world type. Only reads
+	// the map definition and wild block, so it's safe to call from populate threads. The wild block
+	// is looked up beforehand because the map definition's block cache can change in the meantime.
+	static bool populateChunk(Chunk &chunk, const ChunkInt2 &coord, int activeLevelIndex,
+		const MapDefinition &mapDefinition, const MapDefinition::WildBlock *wildBlock);
+
+	// Populate thread entry point. Runs jobs until told to stop.
+	static void populateThreadLoop(PopulateThreadData &threadData);
+
+	// Starts the populate threads if they aren't running yet.
+	void startPopulateThreads();
+
+	// Adds a job for populating the chunk at the given coordinate.
+	void queuePopulateJob(const ChunkInt2 &coord, int activeLevelIndex,
+		const std::shared_ptr<const MapDefinition> &mapDefinition);
+
+	// Drops queued jobs for chunks that left the active range before they were started.
+	void discardOutOfRangePopulateJobs(int chunkDistance);
+
+	// Moves the chunk's job to the front of the queue if it hasn't started, and blocks until it's
+	// finished. Other jobs keep running in the background.
+	void waitForPopulateJob(const ChunkInt2 &coord);
+
+	// Moves finished chunks that are still in range to the active chunks and returns the others to
+	// the chunk pool.
+	void commitPopulatedChunks(int chunkDistance, EntityManager &entityManager);
 public:
+	ChunkManager();
+	ChunkManager(ChunkManager&&) = default;
+	~ChunkManager();
+
+	ChunkManager &operator=(ChunkManager&&) = default;
+
 	int getChunkCount() const;
 	Chunk &getChunk(int index);
 	const Chunk &getChunk(int index) const;
 	std::optional<int> tryGetChunkIndex(const ChunkInt2 &coord) const;
 
+	// Gets the active chunk at the given coordinate, or the placeholder if the chunk is still pending,
+	// so look-ups in range don't miss while chunks populate. The placeholder has no voxels and should
+	// be drawn entirely fogged. Returns null for chunks that are neither active nor pending.
+	const Chunk *tryGetChunkOrPlaceholder(const ChunkInt2 &coord) const;
+	bool isPlaceholderChunk(const Chunk &chunk) const;
+
 	// Index of the chunk all other active chunks surround.
 	int getCenterChunkIndex() const;
 
+	// Number of inactive chunks kept for reuse.
+	int getPooledChunkCount() const;
+
+	// Whether the chunk is in range but hasn't been committed to the active chunks yet.
+	bool isChunkPending(const ChunkInt2 &coord) const;
+
+	// Number of chunks allocated so far. This should stop growing once the chunk distance settles.
+	int getAllocatedChunkCount() const;
+
+	// Number of inactive chunks with saved changes, in all maps and levels.
+	int getChunkDeltaCount() const;
+
+	// Blocks until every queued and running job is finished.
+	void waitForPopulateJobs();
+
 	// Updates the chunk manager with the given chunk as the current center of the game world.
-	// This invalidates all active chunk references and they must be looked up again.
+	// Chunks populated since the last update are committed first, and populating newly in-range
+	// chunks is handed to background threads. Only waits on the center chunk's job when it isn't
+	// ready (i.e., when a level is first loaded). This invalidates all active chunk references and they
+	// must be looked up again.
 	void update(double dt, const ChunkInt2 &centerChunk, int activeLevelIndex,
-		const MapDefinition &mapDefinition, int chunkDistance, EntityManager &entityManager);
+		const std::shared_ptr<const MapDefinition> &mapDefinition, int chunkDistance,
+		EntityManager &entityManager);
 };
 
 #endif
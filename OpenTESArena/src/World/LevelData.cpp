@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <cstdlib>
 #include <functional>
 #include <optional>
 
@@ -68,6 +69,15 @@ void LevelData::FlatDef::addPosition(const NewInt2 &position)
 	this->positions.push_back(position);
 }
 
+void LevelData::FlatDef::removePositions(const ChunkInt2 &chunk)
+{
+	this->positions.erase(std::remove_if(this->positions.begin(), this->positions.end(),
+		[&chunk](const NewInt2 &position)
+	{
+		return VoxelUtils::newVoxelToChunk(position) == chunk;
+	}), this->positions.end());
+}
+
 LevelData::Lock::Lock(const NewInt2 &position, int lockLevel)
 	: position(position)
 {
@@ -192,8 +202,8 @@ LevelData LevelData::loadInterior(const MIFFile::Level &level, SNInt gridWidth,
 
 	// Load FLOR and MAP1 voxels.
 	constexpr MapType mapType = MapType::Interior;
-	levelData.readFLOR(level.getFLOR(), inf, mapType);
-	levelData.readMAP1(level.getMAP1(), inf, mapType, exeData);
+	levelData.readFLOR(level.getFLOR(), inf, mapType, NewInt2(0, 0));
+	levelData.readMAP1(level.getMAP1(), inf, mapType, exeData, NewInt2(0, 0));
 
 	// All interiors have ceilings except some main quest dungeons which have a 1
 	// as the third number after *CEILING in their .INF file.
@@ -212,6 +222,9 @@ LevelData LevelData::loadInterior(const MIFFile::Level &level, SNInt gridWidth,
 	// Assign text and sound triggers.
 	levelData.readTriggers(level.getTRIG(), inf);
 
+	// Compress patches of voxels that ended up uniform now that generation is done.
+	levelData.getVoxelGrid().compact();
+
 	return levelData;
 }
 
@@ -338,8 +351,8 @@ LevelData LevelData::loadDungeon(ArenaRandom &random, const MIFFile &mif, int le
 
 	// Load FLOR, MAP1, and ceiling into the voxel grid.
 	constexpr MapType mapType = MapType::Interior;
-	levelData.readFLOR(tempFlorView, inf, mapType);
-	levelData.readMAP1(tempMap1View, inf, mapType, exeData);
+	levelData.readFLOR(tempFlorView, inf, mapType, NewInt2(0, 0));
+	levelData.readMAP1(tempMap1View, inf, mapType, exeData, NewInt2(0, 0));
 	levelData.readCeiling(inf);
 
 	const BufferView<const ArenaTypes::MIFLock> tempLocksView(
@@ -351,6 +364,9 @@ LevelData LevelData::loadDungeon(ArenaRandom &random, const MIFFile &mif, int le
 	levelData.readLocks(tempLocksView);
 	levelData.readTriggers(tempTriggersView, inf);
 
+	// Compress patches of voxels that ended up uniform now that generation is done.
+	levelData.getVoxelGrid().compact();
+
 	return levelData;
 }
 
@@ -403,9 +419,9 @@ LevelData LevelData::loadCity(const LocationDefinition &locationDef, const Provi
 
 	// Load FLOR, MAP1, and MAP2 voxels into the voxel grid.
 	constexpr MapType mapType = MapType::City;
-	levelData.readFLOR(tempFlorConstView, inf, mapType);
-	levelData.readMAP1(tempMap1ConstView, inf, mapType, exeData);
-	levelData.readMAP2(tempMap2ConstView, inf);
+	levelData.readFLOR(tempFlorConstView, inf, mapType, NewInt2(0, 0));
+	levelData.readMAP1(tempMap1ConstView, inf, mapType, exeData, NewInt2(0, 0));
+	levelData.readMAP2(tempMap2ConstView, inf, NewInt2(0, 0));
 
 	// Generate building names.
 	levelData.exterior.menuNames = LevelData::generateBuildingNames(locationDef, provinceDef, random,
@@ -415,92 +431,65 @@ LevelData LevelData::loadCity(const LocationDefinition &locationDef, const Provi
 	levelData.exterior.distantSky.init(locationDef, provinceDef, weatherType, currentDay,
 		starCount, exeData, textureManager);
 
+	// Compress patches of voxels that ended up uniform now that generation is done.
+	levelData.getVoxelGrid().compact();
+
 	return levelData;
 }
 
 LevelData LevelData::loadWilderness(const LocationDefinition &locationDef, const ProvinceDefinition &provinceDef,
 	WeatherType weatherType, int currentDay, int starCount, const std::string &infName,
-	const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager)
+	const ChunkInt2 &startChunk, int chunkDistance, const BinaryAssetLibrary &binaryAssetLibrary,
+	TextureManager &textureManager)
 {
-	const LocationDefinition::CityDefinition &cityDef = locationDef.getCityDefinition();
-	const ExeData::Wilderness &wildData = binaryAssetLibrary.getExeData().wild;
-	const Buffer2D<ArenaWildUtils::WildBlockID> wildIndices =
-		ArenaWildUtils::generateWildernessIndices(cityDef.wildSeed, wildData);
-
-	// Temp buffers for voxel data.
-	Buffer2D<ArenaTypes::VoxelID> tempFlor(RMDFile::DEPTH * wildIndices.getWidth(),
-		RMDFile::WIDTH * wildIndices.getHeight());
-	Buffer2D<ArenaTypes::VoxelID> tempMap1(tempFlor.getWidth(), tempFlor.getHeight());
-	Buffer2D<ArenaTypes::VoxelID> tempMap2(tempFlor.getWidth(), tempFlor.getHeight());
-	tempFlor.fill(0);
-	tempMap1.fill(0);
-	tempMap2.fill(0);
+	// Create the level for the voxel data to be written into. Blocks are read into it as the player
+	// gets near them, so the rest of the grid stays air without any storage.
+	const std::string levelName = "WILD"; // Arbitrary
+	constexpr bool isInterior = false;
+	LevelData levelData(ArenaWildUtils::WILD_WIDTH * RMDFile::WIDTH, ArenaWildUtils::LEVEL_HEIGHT,
+		ArenaWildUtils::WILD_HEIGHT * RMDFile::DEPTH, infName, levelName, isInterior);
 
-	auto writeRMD = [&binaryAssetLibrary, &tempFlor, &tempMap1, &tempMap2](
-		uint8_t rmdID, WEInt xOffset, SNInt zOffset)
-	{
-		const std::vector<RMDFile> &rmdFiles = binaryAssetLibrary.getWildernessChunks();
-		const int rmdIndex = DebugMakeIndex(rmdFiles, rmdID - 1);
-		const RMDFile &rmd = rmdFiles[rmdIndex];
+	const LocationDefinition::CityDefinition &cityDef = locationDef.getCityDefinition();
+	const ExeData &exeData = binaryAssetLibrary.getExeData();
+	levelData.wild.blockIDs = ArenaWildUtils::generateWildernessIndices(cityDef.wildSeed, exeData.wild);
 
-		// Copy .RMD voxel data to temp buffers.
-		const BufferView2D<const ArenaTypes::VoxelID> rmdFLOR = rmd.getFLOR();
-		const BufferView2D<const ArenaTypes::VoxelID> rmdMAP1 = rmd.getMAP1();
-		const BufferView2D<const ArenaTypes::VoxelID> rmdMAP2 = rmd.getMAP2();
+	// Change the placeholder WILD00{1..4}.MIF blocks to the ones for the given city.
+	constexpr int cityBlockStart = 31;
+	Buffer2D<ArenaTypes::VoxelID> cityFlor(RMDFile::WIDTH * 2, RMDFile::DEPTH * 2);
+	Buffer2D<ArenaTypes::VoxelID> cityMap1(cityFlor.getWidth(), cityFlor.getHeight());
+	Buffer2D<ArenaTypes::VoxelID> cityMap2(cityFlor.getWidth(), cityFlor.getHeight());
+	ArenaWildUtils::reviseWildernessCity(locationDef, cityFlor, cityMap1, cityMap2, binaryAssetLibrary);
 
-		for (SNInt z = 0; z < RMDFile::DEPTH; z++)
+	// Split the city into its four blocks. A layer's first coordinate is along the grid's Z axis.
+	for (WEInt blockZ = 0; blockZ < 2; blockZ++)
+	{
+		for (SNInt blockX = 0; blockX < 2; blockX++)
 		{
-			for (WEInt x = 0; x < RMDFile::WIDTH; x++)
+			Wild::BlockVoxels blockVoxels;
+			blockVoxels.flor.init(RMDFile::WIDTH, RMDFile::DEPTH);
+			blockVoxels.map1.init(RMDFile::WIDTH, RMDFile::DEPTH);
+			blockVoxels.map2.init(RMDFile::WIDTH, RMDFile::DEPTH);
+
+			for (int j = 0; j < RMDFile::DEPTH; j++)
 			{
-				const ArenaTypes::VoxelID srcFlorVoxel = rmdFLOR.get(x, z);
-				const ArenaTypes::VoxelID srcMap1Voxel = rmdMAP1.get(x, z);
-				const ArenaTypes::VoxelID srcMap2Voxel = rmdMAP2.get(x, z);
-				const WEInt dstX = xOffset + x;
-				const SNInt dstZ = zOffset + z;
-				tempFlor.set(dstX, dstZ, srcFlorVoxel);
-				tempMap1.set(dstX, dstZ, srcMap1Voxel);
-				tempMap2.set(dstX, dstZ, srcMap2Voxel);
+				for (int i = 0; i < RMDFile::WIDTH; i++)
+				{
+					const int cityI = (blockZ * RMDFile::WIDTH) + i;
+					const int cityJ = (blockX * RMDFile::DEPTH) + j;
+					blockVoxels.flor.set(i, j, cityFlor.get(cityI, cityJ));
+					blockVoxels.map1.set(i, j, cityMap1.get(cityI, cityJ));
+					blockVoxels.map2.set(i, j, cityMap2.get(cityI, cityJ));
+				}
 			}
-		}
-	};
 
-	// Load .RMD files into the wilderness, each at some X and Z offset in the voxel grid.
-	for (int y = 0; y < wildIndices.getHeight(); y++)
-	{
-		for (int x = 0; x < wildIndices.getWidth(); x++)
-		{
-			const uint8_t wildIndex = wildIndices.get(x, y);
-			writeRMD(wildIndex, x * RMDFile::WIDTH, y * RMDFile::DEPTH);
+			const ChunkInt2 chunk(cityBlockStart + blockX, cityBlockStart + blockZ);
+			levelData.wild.revisedBlocks.emplace(std::make_pair(chunk, std::move(blockVoxels)));
 		}
 	}
 
-	// Change the placeholder WILD00{1..4}.MIF blocks to the ones for the given city.
-	ArenaWildUtils::reviseWildernessCity(locationDef, tempFlor, tempMap1, tempMap2, binaryAssetLibrary);
-
-	// Create the level for the voxel data to be written into.
-	const std::string levelName = "WILD"; // Arbitrary
-	constexpr bool isInterior = false;
-	LevelData levelData(tempFlor.getWidth(), ArenaWildUtils::LEVEL_HEIGHT, tempFlor.getHeight(),
-		infName, levelName, isInterior);
-
-	const BufferView2D<const ArenaTypes::VoxelID> tempFlorView(
-		tempFlor.get(), tempFlor.getWidth(), tempFlor.getHeight());
-	const BufferView2D<const ArenaTypes::VoxelID> tempMap1View(
-		tempMap1.get(), tempMap1.getWidth(), tempMap1.getHeight());
-	const BufferView2D<const ArenaTypes::VoxelID> tempMap2View(
-		tempMap2.get(), tempMap2.getWidth(), tempMap2.getHeight());
-	const INFFile &inf = levelData.getInfFile();
-	const auto &exeData = binaryAssetLibrary.getExeData();
-
-	// Load FLOR, MAP1, and MAP2 voxels into the voxel grid.
-	constexpr MapType mapType = MapType::Wilderness;
-	levelData.readFLOR(tempFlorView, inf, mapType);
-	levelData.readMAP1(tempMap1View, inf, mapType, exeData);
-	levelData.readMAP2(tempMap2View, inf);
-
-	// Generate wilderness building names.
-	levelData.exterior.menuNames = LevelData::generateWildChunkBuildingNames(
-		levelData.getVoxelGrid(), levelData.getTransitions(), exeData);
+	// Load the blocks around the player. Their flats get entities when the level is set active.
+	constexpr int maxLoadCount = -1; // The level isn't shown until it's loaded.
+	levelData.updateWildBlocks(startChunk, chunkDistance, maxLoadCount, binaryAssetLibrary, nullptr);
 
 	// Generate distant sky.
 	levelData.exterior.distantSky.init(locationDef, provinceDef, weatherType, currentDay,
@@ -642,6 +631,11 @@ const EntityManager &LevelData::getEntityManager() const
 	return this->entityManager;
 }
 
+const std::vector<ChunkInt2> &LevelData::getLoadedWildChunks() const
+{
+	return this->wild.loadedChunks;
+}
+
 VoxelGrid &LevelData::getVoxelGrid()
 {
 	return this->voxelGrid;
@@ -777,15 +771,17 @@ void LevelData::setVoxel(SNInt x, int y, WEInt z, uint16_t id)
 }
 
 void LevelData::readFLOR(const BufferView2D<const ArenaTypes::VoxelID> &flor, const INFFile &inf,
-	MapType mapType)
+	MapType mapType, const NewInt2 &gridOffset)
 {
 	const SNInt gridWidth = flor.getHeight();
 	const WEInt gridDepth = flor.getWidth();
+	const SNInt gridEndX = gridOffset.x + gridWidth;
+	const WEInt gridEndZ = gridOffset.y + gridDepth;
 
 	// Lambda for obtaining a two-byte FLOR voxel.
-	auto getFlorVoxel = [&flor, gridWidth, gridDepth](SNInt x, WEInt z)
+	auto getFlorVoxel = [&flor, &gridOffset](SNInt x, WEInt z)
 	{
-		const uint16_t voxel = flor.get(z, x);
+		const uint16_t voxel = flor.get(z - gridOffset.y, x - gridOffset.x);
 		return voxel;
 	};
 
@@ -916,9 +912,9 @@ void LevelData::readFLOR(const BufferView2D<const ArenaTypes::VoxelID> &flor, co
 	};
 
 	// Write the voxel IDs into the voxel grid.
-	for (SNInt x = 0; x < gridWidth; x++)
+	for (SNInt x = gridOffset.x; x < gridEndX; x++)
 	{
-		for (WEInt z = 0; z < gridDepth; z++)
+		for (WEInt z = gridOffset.y; z < gridEndZ; z++)
 		{
 			auto getFloorTextureID = [](uint16_t voxel)
 			{
@@ -977,9 +973,9 @@ void LevelData::readFLOR(const BufferView2D<const ArenaTypes::VoxelID> &flor, co
 	}
 
 	// Set chasm faces based on adjacent voxels.
-	for (SNInt x = 0; x < gridWidth; x++)
+	for (SNInt x = gridOffset.x; x < gridEndX; x++)
 	{
-		for (WEInt z = 0; z < gridDepth; z++)
+		for (WEInt z = gridOffset.y; z < gridEndZ; z++)
 		{
 			const NewInt3 voxel(x, 0, z);
 
@@ -1020,15 +1016,17 @@ void LevelData::readFLOR(const BufferView2D<const ArenaTypes::VoxelID> &flor, co
 }
 
 void LevelData::readMAP1(const BufferView2D<const ArenaTypes::VoxelID> &map1, const INFFile &inf,
-	MapType mapType, const ExeData &exeData)
+	MapType mapType, const ExeData &exeData, const NewInt2 &gridOffset)
 {
 	const SNInt gridWidth = map1.getHeight();
 	const WEInt gridDepth = map1.getWidth();
+	const SNInt gridEndX = gridOffset.x + gridWidth;
+	const WEInt gridEndZ = gridOffset.y + gridDepth;
 
 	// Lambda for obtaining a two-byte MAP1 voxel.
-	auto getMap1Voxel = [&map1, gridWidth, gridDepth](SNInt x, WEInt z)
+	auto getMap1Voxel = [&map1, &gridOffset](SNInt x, WEInt z)
 	{
-		const uint16_t voxel = map1.get(z, x);
+		const uint16_t voxel = map1.get(z - gridOffset.y, x - gridOffset.x);
 		return voxel;
 	};
 
@@ -1440,9 +1438,9 @@ void LevelData::readMAP1(const BufferView2D<const ArenaTypes::VoxelID> &map1, co
 	};
 
 	// Write the voxel IDs into the voxel grid.
-	for (SNInt x = 0; x < gridWidth; x++)
+	for (SNInt x = gridOffset.x; x < gridEndX; x++)
 	{
-		for (WEInt z = 0; z < gridDepth; z++)
+		for (WEInt z = gridOffset.y; z < gridEndZ; z++)
 		{
 			const uint16_t map1Voxel = getMap1Voxel(x, z);
 
@@ -1526,15 +1524,18 @@ void LevelData::readMAP1(const BufferView2D<const ArenaTypes::VoxelID> &map1, co
 	}
 }
 
-void LevelData::readMAP2(const BufferView2D<const ArenaTypes::VoxelID> &map2, const INFFile &inf)
+void LevelData::readMAP2(const BufferView2D<const ArenaTypes::VoxelID> &map2, const INFFile &inf,
+	const NewInt2 &gridOffset)
 {
 	const SNInt gridWidth = map2.getHeight();
 	const WEInt gridDepth = map2.getWidth();
+	const SNInt gridEndX = gridOffset.x + gridWidth;
+	const WEInt gridEndZ = gridOffset.y + gridDepth;
 
 	// Lambda for obtaining a two-byte MAP2 voxel.
-	auto getMap2Voxel = [&map2, gridWidth, gridDepth](SNInt x, WEInt z)
+	auto getMap2Voxel = [&map2, &gridOffset](SNInt x, WEInt z)
 	{
-		const uint16_t voxel = map2.get(z, x);
+		const uint16_t voxel = map2.get(z - gridOffset.y, x - gridOffset.x);
 		return voxel;
 	};
 
@@ -1568,9 +1569,9 @@ void LevelData::readMAP2(const BufferView2D<const ArenaTypes::VoxelID> &map2, co
 	};
 
 	// Write the voxel IDs into the voxel grid.
-	for (SNInt x = 0; x < gridWidth; x++)
+	for (SNInt x = gridOffset.x; x < gridEndX; x++)
 	{
-		for (WEInt z = 0; z < gridDepth; z++)
+		for (WEInt z = gridOffset.y; z < gridEndZ; z++)
 		{
 			const uint16_t map2Voxel = getMap2Voxel(x, z);
 
@@ -1928,8 +1929,8 @@ ArenaLevelUtils::MenuNamesList LevelData::generateBuildingNames(const LocationDe
 	return menuNames;
 }
 
-ArenaLevelUtils::MenuNamesList LevelData::generateWildChunkBuildingNames(const VoxelGrid &voxelGrid,
-	const LevelData::Transitions &transitions, const ExeData &exeData)
+ArenaLevelUtils::MenuNamesList LevelData::generateWildChunkBuildingNames(const ChunkInt2 &chunk,
+	const VoxelGrid &voxelGrid, const LevelData::Transitions &transitions, const ExeData &exeData)
 {
 	ArenaLevelUtils::MenuNamesList menuNames;
 
@@ -2056,15 +2057,11 @@ ArenaLevelUtils::MenuNamesList LevelData::generateWildChunkBuildingNames(const V
 		}
 	};
 
-	// Iterate over each wild chunk.
-	for (int y = 0; y < ArenaWildUtils::WILD_HEIGHT; y++)
-	{
-		for (int x = 0; x < ArenaWildUtils::WILD_WIDTH; x++)
-		{
-			generateNames(x, y, ArenaTypes::MenuType::Tavern);
-			generateNames(x, y, ArenaTypes::MenuType::Temple);
-		}
-	}
+	// The original game's wild chunk coordinates start at the opposite corner.
+	const int wildX = (ArenaWildUtils::WILD_WIDTH - 1) - chunk.y;
+	const int wildY = (ArenaWildUtils::WILD_HEIGHT - 1) - chunk.x;
+	generateNames(wildX, wildY, ArenaTypes::MenuType::Tavern);
+	generateNames(wildX, wildY, ArenaTypes::MenuType::Temple);
 
 	return menuNames;
 }
@@ -2381,128 +2378,252 @@ void LevelData::updateFadingVoxels(const ChunkInt2 &minChunk, const ChunkInt2 &m
 	}
 }
 
-void LevelData::setActive(bool nightLightsAreActive, const WorldData &worldData,
-	const ProvinceDefinition &provinceDef, const LocationDefinition &locationDef,
-	const EntityDefinitionLibrary &entityDefLibrary, const CharacterClassLibrary &charClassLibrary,
-	const BinaryAssetLibrary &binaryAssetLibrary, Random &random, CitizenManager &citizenManager,
-	TextureManager &textureManager, Renderer &renderer)
+void LevelData::loadWildBlock(const ChunkInt2 &chunk, const BinaryAssetLibrary &binaryAssetLibrary)
 {
-	// Clear renderer textures, distant sky, and entities.
-	renderer.clearTexturesAndEntityRenderIDs();
-	renderer.clearDistantSky();
-	this->entityManager.clear();
+	const ExeData &exeData = binaryAssetLibrary.getExeData();
+	const NewInt2 gridOffset(chunk.x * RMDFile::WIDTH, chunk.y * RMDFile::DEPTH);
 
-	// Palette for voxels and flats, required in the renderer so it can conditionally transform
-	// certain palette indices for transparency.
-	const std::string &paletteFilename = ArenaPaletteName::Default;
-	const std::optional<PaletteID> paletteID = textureManager.tryGetPaletteID(paletteFilename.c_str());
-	if (!paletteID.has_value())
+	auto readBlock = [this, &exeData, &gridOffset](const BufferView2D<const ArenaTypes::VoxelID> &flor,
+		const BufferView2D<const ArenaTypes::VoxelID> &map1, const BufferView2D<const ArenaTypes::VoxelID> &map2)
 	{
-		DebugCrash("Couldn't get palette ID for \"" + paletteFilename + "\".");
+		constexpr MapType mapType = MapType::Wilderness;
+		this->readFLOR(flor, this->inf, mapType, gridOffset);
+		this->readMAP1(map1, this->inf, mapType, exeData, gridOffset);
+		this->readMAP2(map2, this->inf, gridOffset);
+	};
+
+	const auto revisedIter = this->wild.revisedBlocks.find(chunk);
+	if (revisedIter != this->wild.revisedBlocks.end())
+	{
+		const Wild::BlockVoxels &blockVoxels = revisedIter->second;
+		readBlock(
+			BufferView2D<const ArenaTypes::VoxelID>(blockVoxels.flor.get(), blockVoxels.flor.getWidth(),
+				blockVoxels.flor.getHeight()),
+			BufferView2D<const ArenaTypes::VoxelID>(blockVoxels.map1.get(), blockVoxels.map1.getWidth(),
+				blockVoxels.map1.getHeight()),
+			BufferView2D<const ArenaTypes::VoxelID>(blockVoxels.map2.get(), blockVoxels.map2.getWidth(),
+				blockVoxels.map2.getHeight()));
+	}
+	else
+	{
+		// Block IDs are indexed the same way as the layers.
+		const std::vector<RMDFile> &rmdFiles = binaryAssetLibrary.getWildernessChunks();
+		const uint8_t rmdID = this->wild.blockIDs.get(chunk.y, chunk.x);
+		const int rmdIndex = DebugMakeIndex(rmdFiles, rmdID - 1);
+		const RMDFile &rmd = rmdFiles[rmdIndex];
+		readBlock(rmd.getFLOR(), rmd.getMAP1(), rmd.getMAP2());
 	}
 
-	const Palette &palette = textureManager.getPaletteHandle(*paletteID);
+	ArenaLevelUtils::MenuNamesList blockMenuNames = LevelData::generateWildChunkBuildingNames(
+		chunk, this->voxelGrid, this->transitions, exeData);
+	ArenaLevelUtils::MenuNamesList &menuNames = this->exterior.menuNames;
+	menuNames.insert(menuNames.end(), std::make_move_iterator(blockMenuNames.begin()),
+		std::make_move_iterator(blockMenuNames.end()));
+
+	this->updateWildBlockEdgeChasms(chunk);
+}
 
-	// Loads .INF voxel textures into the renderer.
-	auto loadVoxelTextures = [this, &textureManager, &renderer, &palette]()
+void LevelData::unloadWildBlock(const ChunkInt2 &chunk)
+{
+	// Entities in the block are removed with it and made again from its flats if it's reloaded, so
+	// killed or looted ones come back. This is intended: the original game regenerates the wilderness
+	// around the player the same way instead of remembering changes to it.
+	// Wild blocks are one chunk each, so the block's voxel storage is freed with it.
+	this->voxelGrid.clearChunk(chunk);
+
+	const NewInt2 gridOffset(chunk.x * RMDFile::WIDTH, chunk.y * RMDFile::DEPTH);
+	for (WEInt z = gridOffset.y; z < (gridOffset.y + RMDFile::DEPTH); z++)
 	{
-		// Iterate the voxel grid's voxel definitions, get the texture asset reference(s), and allocate
-		// textures in the renderer.
-		// @todo: avoid allocating duplicate textures (maybe keep a hash set here).
-		const int voxelDefCount = this->voxelGrid.getVoxelDefCount();
-		for (int i = 0; i < voxelDefCount; i++)
+		for (SNInt x = gridOffset.x; x < (gridOffset.x + RMDFile::WIDTH); x++)
 		{
-			const VoxelDefinition &voxelDef = this->voxelGrid.getVoxelDef(i);
-			const Buffer<TextureAssetReference> textureAssetRefs = voxelDef.getTextureAssetReferences();
-			for (int j = 0; j < textureAssetRefs.getCount(); j++)
-			{
-				const TextureAssetReference &textureAssetRef = textureAssetRefs.get(j);
-				if (!renderer.tryCreateVoxelTexture(textureAssetRef, textureManager))
-				{
-					DebugLogError("Couldn't create voxel texture for \"" + textureAssetRef.filename + "\".");
-				}
-			}
+			this->transitions.erase(NewInt2(x, z));
 		}
-	};
+	}
 
-	// Loads screen-space chasm textures into the renderer.
-	auto loadChasmTextures = [this, &textureManager, &renderer, &palette]()
+	for (int i = static_cast<int>(this->flatsLists.size()) - 1; i >= 0; i--)
 	{
-		constexpr int chasmWidth = RCIFile::WIDTH;
-		constexpr int chasmHeight = RCIFile::HEIGHT;
-		Buffer<uint8_t> chasmBuffer(chasmWidth * chasmHeight);
+		FlatDef &flatDef = this->flatsLists[i];
+		flatDef.removePositions(chunk);
+		if (flatDef.getPositions().empty())
+		{
+			this->flatsLists.erase(this->flatsLists.begin() + i);
+		}
+	}
 
-		// Dry chasm (just a single color).
-		chasmBuffer.fill(ArenaRenderUtils::PALETTE_INDEX_DRY_CHASM_COLOR);
-		renderer.addChasmTexture(VoxelDefinition::ChasmData::Type::Dry, chasmBuffer.get(),
-			chasmWidth, chasmHeight, palette);
+	ArenaLevelUtils::MenuNamesList &menuNames = this->exterior.menuNames;
+	menuNames.erase(std::remove_if(menuNames.begin(), menuNames.end(),
+		[&chunk](const std::pair<NewInt2, std::string> &pair)
+	{
+		return VoxelUtils::newVoxelToChunk(pair.first) == chunk;
+	}), menuNames.end());
 
-		// Lambda for writing an .RCI animation to the renderer.
-		auto writeChasmAnim = [&textureManager, &renderer, &palette, chasmWidth, chasmHeight](
-			VoxelDefinition::ChasmData::Type chasmType, const std::string &rciName)
+	this->voxelInstMap.erase(chunk);
+	this->entityManager.clearChunk(chunk);
+	this->updateWildBlockEdgeChasms(chunk);
+}
+
+void LevelData::updateWildBlockEdgeChasms(const ChunkInt2 &chunk)
+{
+	const NewInt2 gridOffset(chunk.x * RMDFile::WIDTH, chunk.y * RMDFile::DEPTH);
+	for (int i = 0; i < RMDFile::WIDTH; i++)
+	{
+		this->tryUpdateChasmVoxel(NewInt3(gridOffset.x - 1, 0, gridOffset.y + i));
+		this->tryUpdateChasmVoxel(NewInt3(gridOffset.x + RMDFile::WIDTH, 0, gridOffset.y + i));
+		this->tryUpdateChasmVoxel(NewInt3(gridOffset.x + i, 0, gridOffset.y - 1));
+		this->tryUpdateChasmVoxel(NewInt3(gridOffset.x + i, 0, gridOffset.y + RMDFile::DEPTH));
+	}
+}
+
+bool LevelData::updateWildBlocks(const ChunkInt2 &centerChunk, int chunkDistance, int maxLoadCount,
+	const BinaryAssetLibrary &binaryAssetLibrary, std::vector<FlatDef> *outNewFlats)
+{
+	DebugAssert(this->wild.blockIDs.isValid());
+	std::vector<ChunkInt2> &loadedChunks = this->wild.loadedChunks;
+	bool anyChanged = false;
+
+	// Blocks are unloaded one chunk further out than they're loaded, so walking back and forth
+	// over a chunk edge doesn't keep reloading the same blocks.
+	for (int i = static_cast<int>(loadedChunks.size()) - 1; i >= 0; i--)
+	{
+		const ChunkInt2 chunk = loadedChunks[i];
+		if (!ChunkUtils::isWithinActiveRange(centerChunk, chunk, chunkDistance + 1))
 		{
-			const std::optional<TextureBuilderIdGroup> textureBuilderIDs =
-				textureManager.tryGetTextureBuilderIDs(rciName.c_str());
-			if (!textureBuilderIDs.has_value())
-			{
-				DebugLogError("Couldn't get texture builder IDs for \"" + rciName + "\".");
-				return;
-			}
+			this->unloadWildBlock(chunk);
+			loadedChunks[i] = loadedChunks.back();
+			loadedChunks.pop_back();
+			anyChanged = true;
+		}
+	}
 
-			for (int i = 0; i < textureBuilderIDs->getCount(); i++)
+	// Read flats of new blocks into an empty list so they can be told apart from existing ones.
+	std::vector<FlatDef> oldFlats = std::move(this->flatsLists);
+	this->flatsLists.clear();
+
+	std::vector<ChunkInt2> missingChunks;
+	ChunkInt2 minChunk, maxChunk;
+	ChunkUtils::getSurroundingChunks(centerChunk, chunkDistance, &minChunk, &maxChunk);
+	for (WEInt y = std::max(minChunk.y, 0); y <= std::min(maxChunk.y, ArenaWildUtils::WILD_HEIGHT - 1); y++)
+	{
+		for (SNInt x = std::max(minChunk.x, 0); x <= std::min(maxChunk.x, ArenaWildUtils::WILD_WIDTH - 1); x++)
+		{
+			const ChunkInt2 chunk(x, y);
+			if (std::find(loadedChunks.begin(), loadedChunks.end(), chunk) == loadedChunks.end())
 			{
-				const TextureBuilderID textureBuilderID = textureBuilderIDs->getID(i);
-				const TextureBuilder &textureBuilder = textureManager.getTextureBuilderHandle(textureBuilderID);
-				
-				DebugAssert(textureBuilder.getType() == TextureBuilder::Type::Paletted);
-				const TextureBuilder::PalettedTexture &palettedTexture = textureBuilder.getPaletted();
-				renderer.addChasmTexture(chasmType, palettedTexture.texels.get(),
-					textureBuilder.getWidth(), textureBuilder.getHeight(), palette);
+				missingChunks.emplace_back(chunk);
 			}
-		};
+		}
+	}
 
-		writeChasmAnim(VoxelDefinition::ChasmData::Type::Wet, "WATERANI.RCI");
-		writeChasmAnim(VoxelDefinition::ChasmData::Type::Lava, "LAVAANI.RCI");
+	auto getChunkDistance = [&centerChunk](const ChunkInt2 &chunk)
+	{
+		return std::max(std::abs(chunk.x - centerChunk.x), std::abs(chunk.y - centerChunk.y));
 	};
 
-	// Initializes entities from the flat defs list and write their textures to the renderer.
-	auto loadEntities = [this, nightLightsAreActive, &worldData, &provinceDef, &locationDef,
-		&entityDefLibrary, &charClassLibrary, &binaryAssetLibrary, &random, &citizenManager,
-		&textureManager, &renderer, &palette]()
+	std::stable_sort(missingChunks.begin(), missingChunks.end(),
+		[&getChunkDistance](const ChunkInt2 &a, const ChunkInt2 &b)
 	{
-		// See whether the current ruler (if any) is male. This affects the displayed ruler in palaces.
-		const std::optional<bool> rulerIsMale = [&locationDef]() -> std::optional<bool>
+		return getChunkDistance(a) < getChunkDistance(b);
+	});
+
+	int loadCount = 0;
+	for (const ChunkInt2 &chunk : missingChunks)
+	{
+		const bool isNextToCenter = getChunkDistance(chunk) <= 1;
+		if (!isNextToCenter)
 		{
-			if (locationDef.getType() == LocationDefinition::Type::City)
-			{
-				const LocationDefinition::CityDefinition &cityDef = locationDef.getCityDefinition();
-				return cityDef.rulerIsMale;
-			}
-			else
+			if ((maxLoadCount >= 0) && (loadCount >= maxLoadCount))
 			{
-				return std::nullopt;
+				// The rest are loaded by later updates.
+				break;
 			}
-		}();
 
-		const MapType mapType = worldData.getMapType();
-		const std::optional<ArenaTypes::InteriorType> interiorType = [&worldData, mapType]()
-			-> std::optional<ArenaTypes::InteriorType>
+			loadCount++;
+		}
+
+		this->loadWildBlock(chunk, binaryAssetLibrary);
+		loadedChunks.emplace_back(chunk);
+		anyChanged = true;
+	}
+
+	std::vector<FlatDef> newFlats = std::move(this->flatsLists);
+	this->flatsLists = std::move(oldFlats);
+	for (const FlatDef &flatDef : newFlats)
+	{
+		for (const NewInt2 &position : flatDef.getPositions())
 		{
-			if (mapType == MapType::Interior)
-			{
-				const WorldData::Interior &interior = worldData.getInterior();
-				return interior.interiorType;
-			}
-			else
+			this->addFlatInstance(flatDef.getFlatIndex(), position);
+		}
+	}
+
+	if (outNewFlats != nullptr)
+	{
+		*outNewFlats = std::move(newFlats);
+	}
+
+	if (anyChanged)
+	{
+		this->voxelGrid.compact();
+	}
+
+	return anyChanged;
+}
+
+void LevelData::loadVoxelTextures(int startVoxelDefID, TextureManager &textureManager, Renderer &renderer)
+{
+	// Iterate the voxel grid's voxel definitions, get the texture asset reference(s), and allocate
+	// textures in the renderer.
+	// @todo: avoid allocating duplicate textures (maybe keep a hash set here).
+	const int voxelDefCount = this->voxelGrid.getVoxelDefCount();
+	for (int i = startVoxelDefID; i < voxelDefCount; i++)
+	{
+		const VoxelDefinition &voxelDef = this->voxelGrid.getVoxelDef(i);
+		const Buffer<TextureAssetReference> textureAssetRefs = voxelDef.getTextureAssetReferences();
+		for (int j = 0; j < textureAssetRefs.getCount(); j++)
+		{
+			const TextureAssetReference &textureAssetRef = textureAssetRefs.get(j);
+			if (!renderer.tryCreateVoxelTexture(textureAssetRef, textureManager))
 			{
-				return std::nullopt;
+				DebugLogError("Couldn't create voxel texture for \"" + textureAssetRef.filename + "\".");
 			}
-		}();
+		}
+	}
 
-		const auto &exeData = binaryAssetLibrary.getExeData();
-		for (const auto &flatDef : this->flatsLists)
+	// Resolve each voxel definition to texture indices now so the renderer doesn't have to look
+	// them up by name while drawing.
+	renderer.updateVoxelTextureHandles(this->voxelGrid);
+}
+
+void LevelData::loadFlatEntities(const std::vector<FlatDef> &flatDefs, bool nightLightsAreActive,
+	MapType mapType, const std::optional<ArenaTypes::InteriorType> &interiorType,
+	const LocationDefinition &locationDef, const EntityDefinitionLibrary &entityDefLibrary,
+	const CharacterClassLibrary &charClassLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
+	Random &random, TextureManager &textureManager, Renderer &renderer)
+{
+	// See whether the current ruler (if any) is male. This affects the displayed ruler in palaces.
+	const std::optional<bool> rulerIsMale = [&locationDef]() -> std::optional<bool>
+	{
+		if (locationDef.getType() == LocationDefinition::Type::City)
+		{
+			const LocationDefinition::CityDefinition &cityDef = locationDef.getCityDefinition();
+			return cityDef.rulerIsMale;
+		}
+		else
+		{
+			return std::nullopt;
+		}
+	}();
+
+	for (const FlatDef &flatDef : flatDefs)
+	{
+		const ArenaTypes::FlatIndex flatIndex = flatDef.getFlatIndex();
+
+		// Must be at least one instance of the entity for the loop to try and
+		// instantiate it and write textures to the renderer.
+		DebugAssert(flatDef.getPositions().size() > 0);
+
+		auto flatEntityDefIter = this->flatEntityDefs.find(flatIndex);
+		if (flatEntityDefIter == this->flatEntityDefs.end())
 		{
-			const ArenaTypes::FlatIndex flatIndex = flatDef.getFlatIndex();
 			const INFFile::FlatData &flatData = this->inf.getFlat(flatIndex);
 			const EntityType entityType = ArenaAnimUtils::getEntityTypeFromFlat(flatIndex, this->inf);
 			const std::optional<ArenaTypes::ItemIndex> &optItemIndex = flatData.itemIndex;
@@ -2513,10 +2634,6 @@ void LevelData::setActive(bool nightLightsAreActive, const WorldData &worldData,
 			const bool isHumanEnemy = optItemIndex.has_value() &&
 				ArenaAnimUtils::isHumanEnemyIndex(*optItemIndex);
 
-			// Must be at least one instance of the entity for the loop to try and
-			// instantiate it and write textures to the renderer.
-			DebugAssert(flatDef.getPositions().size() > 0);
-
 			// Add entity animation data. Static entities have only idle animations (and maybe on/off
 			// state for lampposts). Dynamic entities have several animation states and directions.
 			//auto &entityAnimData = newEntityDef.getAnimationData();
@@ -2614,102 +2731,201 @@ void LevelData::setActive(bool nightLightsAreActive, const WorldData &worldData,
 					lightIntensity, std::move(entityAnimDef));
 			}
 
-			const bool isStreetlight = (newEntityDef.getType() == EntityDefinition::Type::Doodad) &&
-				newEntityDef.getDoodad().streetlight;
 			const bool isPuddle = (newEntityDef.getType() == EntityDefinition::Type::Doodad) &&
 				newEntityDef.getDoodad().puddle;
-			const EntityDefID entityDefID = this->entityManager.addEntityDef(
-				std::move(newEntityDef), entityDefLibrary);
-			const EntityDefinition &entityDefRef = this->entityManager.getEntityDef(
-				entityDefID, entityDefLibrary);
-			
-			// Quick hack to get back the anim def that was moved into the entity def.
-			const EntityAnimationDefinition &entityAnimDefRef = entityDefRef.getAnimDef();
+
+			FlatEntityDef flatEntityDef;
+			flatEntityDef.entityType = entityType;
+			flatEntityDef.isStreetlight = (newEntityDef.getType() == EntityDefinition::Type::Doodad) &&
+				newEntityDef.getDoodad().streetlight;
+			flatEntityDef.entityDefID = this->entityManager.addEntityDef(std::move(newEntityDef), entityDefLibrary);
 
 			// Generate render ID for this entity type to share between identical instances.
-			const EntityRenderID entityRenderID = renderer.makeEntityRenderID();
+			flatEntityDef.entityRenderID = renderer.makeEntityRenderID();
+			flatEntityDef.entityAnimInst = entityAnimInst;
 
-			// Initialize each instance of the flat def.
-			for (const NewInt2 &position : flatDef.getPositions())
+			// Initialize renderer buffers for the entity animation then populate all textures
+			// of the animation. Quick hack to get back the anim def that was moved into the entity def.
+			const EntityDefinition &entityDefRef = this->entityManager.getEntityDef(
+				flatEntityDef.entityDefID, entityDefLibrary);
+			renderer.setFlatTextures(flatEntityDef.entityRenderID, entityDefRef.getAnimDef(), entityAnimInst,
+				isPuddle, textureManager);
+
+			flatEntityDefIter = this->flatEntityDefs.emplace(std::make_pair(flatIndex, std::move(flatEntityDef))).first;
+		}
+
+		const FlatEntityDef &flatEntityDef = flatEntityDefIter->second;
+		const EntityType entityType = flatEntityDef.entityType;
+		const EntityDefID entityDefID = flatEntityDef.entityDefID;
+		const EntityAnimationInstance &entityAnimInst = flatEntityDef.entityAnimInst;
+		const EntityDefinition &entityDefRef = this->entityManager.getEntityDef(entityDefID, entityDefLibrary);
+		const EntityAnimationDefinition &entityAnimDefRef = entityDefRef.getAnimDef();
+
+		// Initialize each instance of the flat def.
+		for (const NewInt2 &position : flatDef.getPositions())
+		{
+			EntityRef entityRef = this->entityManager.makeEntity(entityType);
+
+			// Using raw entity pointer in this scope for performance due to it currently being
+			// impractical to use the ref wrapper when loading the entire wilderness.
+			Entity *entityPtr = entityRef.get();
+
+			if (entityType == EntityType::Static)
+			{
+				StaticEntity *staticEntity = dynamic_cast<StaticEntity*>(entityPtr);
+				staticEntity->initDoodad(entityDefID, entityAnimInst);
+			}
+			else if (entityType == EntityType::Dynamic)
 			{
-				EntityRef entityRef = this->entityManager.makeEntity(entityType);
+				// All dynamic entities in a level are creatures (never citizens).
+				DynamicEntity *dynamicEntity = dynamic_cast<DynamicEntity*>(entityPtr);
+				dynamicEntity->initCreature(entityDefID, entityAnimInst,
+					CardinalDirection::North, random);
+			}
+			else
+			{
+				DebugCrash("Unrecognized entity type \"" +
+					std::to_string(static_cast<int>(entityType)) + "\".");
+			}
 
-				// Using raw entity pointer in this scope for performance due to it currently being
-				// impractical to use the ref wrapper when loading the entire wilderness.
-				Entity *entityPtr = entityRef.get();
+			entityPtr->setRenderID(flatEntityDef.entityRenderID);
 
-				if (entityType == EntityType::Static)
-				{
-					StaticEntity *staticEntity = dynamic_cast<StaticEntity*>(entityPtr);
-					staticEntity->initDoodad(entityDefID, entityAnimInst);
-				}
-				else if (entityType == EntityType::Dynamic)
+			// Set default animation state.
+			int defaultStateIndex;
+			if (!flatEntityDef.isStreetlight)
+			{
+				// Entities will use idle animation by default.
+				if (!entityAnimDefRef.tryGetStateIndex(EntityAnimationUtils::STATE_IDLE.c_str(), &defaultStateIndex))
 				{
-					// All dynamic entities in a level are creatures (never citizens).
-					DynamicEntity *dynamicEntity = dynamic_cast<DynamicEntity*>(entityPtr);
-					dynamicEntity->initCreature(entityDefID, entityAnimInst,
-						CardinalDirection::North, random);
+					DebugLogWarning("Couldn't get idle state index for flat \"" +
+						std::to_string(flatIndex) + "\".");
+					continue;
 				}
-				else
+			}
+			else
+			{
+				// Need to turn streetlights on or off at initialization.
+				const std::string &streetlightStateName = nightLightsAreActive ?
+					EntityAnimationUtils::STATE_ACTIVATED : EntityAnimationUtils::STATE_IDLE;
+
+				if (!entityAnimDefRef.tryGetStateIndex(streetlightStateName.c_str(), &defaultStateIndex))
 				{
-					DebugCrash("Unrecognized entity type \"" +
-						std::to_string(static_cast<int>(entityType)) + "\".");
+					DebugLogWarning("Couldn't get \"" + streetlightStateName +
+						"\" streetlight state index for flat \"" + std::to_string(flatIndex) + "\".");
+					continue;
 				}
+			}
 
-				entityPtr->setRenderID(entityRenderID);
+			EntityAnimationInstance &animInst = entityPtr->getAnimInstance();
+			animInst.setStateIndex(defaultStateIndex);
 
-				// Set default animation state.
-				int defaultStateIndex;
-				if (!isStreetlight)
-				{
-					// Entities will use idle animation by default.
-					if (!entityAnimDefRef.tryGetStateIndex(EntityAnimationUtils::STATE_IDLE.c_str(), &defaultStateIndex))
-					{
-						DebugLogWarning("Couldn't get idle state index for flat \"" +
-							std::to_string(flatIndex) + "\".");
-						continue;
-					}
-				}
-				else
-				{
-					// Need to turn streetlights on or off at initialization.
-					const std::string &streetlightStateName = nightLightsAreActive ?
-						EntityAnimationUtils::STATE_ACTIVATED : EntityAnimationUtils::STATE_IDLE;
+			// Note: since the entity pointer is being used directly, update the position last
+			// in scope to avoid a dangling pointer problem in case it changes chunks (from 0, 0).
+			const NewDouble2 positionXZ = VoxelUtils::getVoxelCenter(position);
+			const CoordDouble2 coord = VoxelUtils::newPointToCoord(positionXZ);
+			entityPtr->setPosition(coord, this->entityManager, this->voxelGrid);
+		}
+	}
+}
 
-					if (!entityAnimDefRef.tryGetStateIndex(streetlightStateName.c_str(), &defaultStateIndex))
-					{
-						DebugLogWarning("Couldn't get \"" + streetlightStateName +
-							"\" streetlight state index for flat \"" + std::to_string(flatIndex) + "\".");
-						continue;
-					}
-				}
+void LevelData::setActive(bool nightLightsAreActive, const WorldData &worldData,
+	const ProvinceDefinition &provinceDef, const LocationDefinition &locationDef,
+	const EntityDefinitionLibrary &entityDefLibrary, const CharacterClassLibrary &charClassLibrary,
+	const BinaryAssetLibrary &binaryAssetLibrary, Random &random, CitizenManager &citizenManager,
+	TextureManager &textureManager, Renderer &renderer)
+{
+	// Clear renderer textures, distant sky, and entities.
+	renderer.clearTexturesAndEntityRenderIDs();
+	renderer.clearDistantSky();
+	this->entityManager.clear();
+	this->flatEntityDefs.clear();
+
+	// Palette for voxels and flats, required in the renderer so it can conditionally transform
+	// certain palette indices for transparency.
+	const std::string &paletteFilename = ArenaPaletteName::Default;
+	const std::optional<PaletteID> paletteID = textureManager.tryGetPaletteID(paletteFilename.c_str());
+	if (!paletteID.has_value())
+	{
+		DebugCrash("Couldn't get palette ID for \"" + paletteFilename + "\".");
+	}
+
+	const Palette &palette = textureManager.getPaletteHandle(*paletteID);
 
-				EntityAnimationInstance &animInst = entityPtr->getAnimInstance();
-				animInst.setStateIndex(defaultStateIndex);
+	// Loads screen-space chasm textures into the renderer.
+	auto loadChasmTextures = [this, &textureManager, &renderer, &palette]()
+	{
+		constexpr int chasmWidth = RCIFile::WIDTH;
+		constexpr int chasmHeight = RCIFile::HEIGHT;
+		Buffer<uint8_t> chasmBuffer(chasmWidth * chasmHeight);
+
+		// Dry chasm (just a single color).
+		chasmBuffer.fill(ArenaRenderUtils::PALETTE_INDEX_DRY_CHASM_COLOR);
+		renderer.addChasmTexture(VoxelDefinition::ChasmData::Type::Dry, chasmBuffer.get(),
+			chasmWidth, chasmHeight, palette);
 
-				// Note: since the entity pointer is being used directly, update the position last
-				// in scope to avoid a dangling pointer problem in case it changes chunks (from 0, 0).
-				const NewDouble2 positionXZ = VoxelUtils::getVoxelCenter(position);
-				const CoordDouble2 coord = VoxelUtils::newPointToCoord(positionXZ);
-				entityPtr->setPosition(coord, this->entityManager, this->voxelGrid);
+		// Lambda for writing an .RCI animation to the renderer.
+		auto writeChasmAnim = [&textureManager, &renderer, &palette, chasmWidth, chasmHeight](
+			VoxelDefinition::ChasmData::Type chasmType, const std::string &rciName)
+		{
+			const std::optional<TextureBuilderIdGroup> textureBuilderIDs =
+				textureManager.tryGetTextureBuilderIDs(rciName.c_str());
+			if (!textureBuilderIDs.has_value())
+			{
+				DebugLogError("Couldn't get texture builder IDs for \"" + rciName + "\".");
+				return;
 			}
 
-			// Initialize renderer buffers for the entity animation then populate all textures
-			// of the animation.
-			renderer.setFlatTextures(entityRenderID, entityAnimDefRef, entityAnimInst, isPuddle, textureManager);
-		}
+			for (int i = 0; i < textureBuilderIDs->getCount(); i++)
+			{
+				const TextureBuilderID textureBuilderID = textureBuilderIDs->getID(i);
+				const TextureBuilder &textureBuilder = textureManager.getTextureBuilderHandle(textureBuilderID);
+				
+				DebugAssert(textureBuilder.getType() == TextureBuilder::Type::Paletted);
+				const TextureBuilder::PalettedTexture &palettedTexture = textureBuilder.getPaletted();
+				renderer.addChasmTexture(chasmType, palettedTexture.texels.get(),
+					textureBuilder.getWidth(), textureBuilder.getHeight(), palette);
+			}
+		};
+
+		writeChasmAnim(VoxelDefinition::ChasmData::Type::Wet, "WATERANI.RCI");
+		writeChasmAnim(VoxelDefinition::ChasmData::Type::Lava, "LAVAANI.RCI");
+	};
+
+	// Initializes entities from the flat defs list and write their textures to the renderer.
+	auto loadEntities = [this, nightLightsAreActive, &worldData, &provinceDef, &locationDef,
+		&entityDefLibrary, &charClassLibrary, &binaryAssetLibrary, &random, &citizenManager,
+		&textureManager, &renderer]()
+	{
+		const MapType mapType = worldData.getMapType();
+		const std::optional<ArenaTypes::InteriorType> interiorType = [&worldData, mapType]()
+			-> std::optional<ArenaTypes::InteriorType>
+		{
+			if (mapType == MapType::Interior)
+			{
+				const WorldData::Interior &interior = worldData.getInterior();
+				return interior.interiorType;
+			}
+			else
+			{
+				return std::nullopt;
+			}
+		}();
+
+		this->loadFlatEntities(this->flatsLists, nightLightsAreActive, mapType, interiorType, locationDef,
+			entityDefLibrary, charClassLibrary, binaryAssetLibrary, random, textureManager, renderer);
 
 		// Spawn citizens at level start if the conditions are met for the new level.
 		const bool isCity = mapType == MapType::City;
 		const bool isWild = mapType == MapType::Wilderness;
 		if (isCity || isWild)
 		{
-			citizenManager.spawnCitizens(provinceDef.getRaceID(), this->voxelGrid, this->entityManager,
-				locationDef, entityDefLibrary, binaryAssetLibrary, random, textureManager, renderer);
+			citizenManager.spawnCitizens(provinceDef.getRaceID(), this->voxelGrid, this->wild.loadedChunks,
+				this->entityManager, locationDef, entityDefLibrary, binaryAssetLibrary, random, textureManager,
+				renderer);
 		}
 	};
 
-	loadVoxelTextures();
+	this->loadVoxelTextures(0, textureManager, renderer);
 	loadChasmTextures();
 	loadEntities();
 
@@ -2729,7 +2945,26 @@ void LevelData::tick(Game &game, double dt)
 	const int chunkDistance = game.getOptions().getMisc_ChunkDistance();
 	const auto &player = game.getGameData().getPlayer();
 	const ChunkInt2 &playerChunk = player.getPosition().chunk;
-	
+
+	// Stream wilderness blocks around the player, then give anything new its textures and entities.
+	if (this->wild.blockIDs.isValid())
+	{
+		const int oldVoxelDefCount = this->voxelGrid.getVoxelDefCount();
+		std::vector<FlatDef> newFlats;
+		if (this->updateWildBlocks(playerChunk, chunkDistance, LevelData::MAX_WILD_BLOCK_LOADS_PER_TICK,
+			game.getBinaryAssetLibrary(), &newFlats))
+		{
+			const auto &gameData = game.getGameData();
+			TextureManager &textureManager = game.getTextureManager();
+			Renderer &renderer = game.getRenderer();
+			this->loadVoxelTextures(oldVoxelDefCount, textureManager, renderer);
+			this->loadFlatEntities(newFlats, gameData.nightLightsAreActive(), MapType::Wilderness,
+				std::nullopt, gameData.getLocationDefinition(), game.getEntityDefinitionLibrary(),
+				game.getCharacterClassLibrary(), game.getBinaryAssetLibrary(), game.getRandom(),
+				textureManager, renderer);
+		}
+	}
+
 	ChunkInt2 minChunk, maxChunk;
 	ChunkUtils::getSurroundingChunks(playerChunk, chunkDistance, &minChunk, &maxChunk);
 	this->updateFadingVoxels(minChunk, maxChunk, dt);
@@ -4,6 +4,7 @@
 #include <array>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -18,8 +19,10 @@
 #include "../Assets/INFFile.h"
 #include "../Assets/MIFFile.h"
 #include "../Entities/EntityManager.h"
+#include "../Entities/EntityType.h"
 #include "../Math/Vector2.h"
 
+#include "components/utilities/Buffer2D.h"
 #include "components/utilities/BufferView.h"
 #include "components/utilities/BufferView2D.h"
 
@@ -139,6 +142,21 @@ public:
 		ArenaLevelUtils::MenuNamesList menuNames;
 	};
 
+	// Wilderness-specific data. Only the .RMD blocks near the player are in the voxel grid, and it
+	// only has storage for their chunks, so its memory doesn't depend on the size of the wilderness.
+	struct Wild
+	{
+		// FLOR, MAP1, and MAP2 of a block that isn't read from its .RMD file as-is.
+		struct BlockVoxels
+		{
+			Buffer2D<ArenaTypes::VoxelID> flor, map1, map2;
+		};
+
+		Buffer2D<uint8_t> blockIDs; // .RMD file of each wild chunk (ArenaWildUtils::WildBlockID).
+		std::unordered_map<ChunkInt2, BlockVoxels> revisedBlocks; // The city's blocks.
+		std::vector<ChunkInt2> loadedChunks;
+	};
+
 	// One group per chunk. Needs to be a hash table for chasm rendering performance.
 	using VoxelInstanceGroup = std::unordered_map<NewInt3, std::vector<VoxelInstance>>;
 private:
@@ -155,6 +173,17 @@ private:
 		const std::vector<NewInt2> &getPositions() const;
 
 		void addPosition(const NewInt2 &position);
+		void removePositions(const ChunkInt2 &chunk);
+	};
+
+	// Entity definition and render ID made for a flat, shared by all of its instances.
+	struct FlatEntityDef
+	{
+		EntityType entityType;
+		EntityDefID entityDefID;
+		EntityRenderID entityRenderID;
+		EntityAnimationInstance entityAnimInst;
+		bool isStreetlight;
 	};
 
 	// Mappings of IDs to voxel data indices. These maps are stored here because they might be
@@ -165,6 +194,7 @@ private:
 	EntityManager entityManager;
 	INFFile inf;
 	std::vector<FlatDef> flatsLists;
+	std::unordered_map<ArenaTypes::FlatIndex, FlatEntityDef> flatEntityDefs; // Flats with entities in the renderer.
 	std::unordered_map<NewInt2, Lock> locks;
 	std::unordered_map<ChunkInt2, VoxelInstanceGroup> voxelInstMap; // @temp interim solution until using chunk system.
 	Transitions transitions;
@@ -174,6 +204,7 @@ private:
 	bool isInterior;
 	LevelData::Interior interior;
 	LevelData::Exterior exterior;
+	LevelData::Wild wild;
 
 	// Used by derived LevelData load methods.
 	LevelData(SNInt gridWidth, int gridHeight, WEInt gridDepth, const std::string &infName,
@@ -183,11 +214,14 @@ private:
 
 	void addFlatInstance(ArenaTypes::FlatIndex flatIndex, const NewInt2 &flatPosition);
 
+	// The grid offset is the voxel the first element of the layer is written to, so a wilderness
+	// block can be read into its place in the grid.
 	void readFLOR(const BufferView2D<const ArenaTypes::VoxelID> &flor, const INFFile &inf,
-		MapType mapType);
+		MapType mapType, const NewInt2 &gridOffset);
 	void readMAP1(const BufferView2D<const ArenaTypes::VoxelID> &map1, const INFFile &inf,
-		MapType mapType, const ExeData &exeData);
-	void readMAP2(const BufferView2D<const ArenaTypes::VoxelID> &map2, const INFFile &inf);
+		MapType mapType, const ExeData &exeData, const NewInt2 &gridOffset);
+	void readMAP2(const BufferView2D<const ArenaTypes::VoxelID> &map2, const INFFile &inf,
+		const NewInt2 &gridOffset);
 	void readCeiling(const INFFile &inf);
 	void readLocks(const BufferView<const ArenaTypes::MIFLock> &locks);
 	void readTriggers(const BufferView<const ArenaTypes::MIFTrigger> &triggers, const INFFile &inf);
@@ -204,9 +238,9 @@ private:
 		const LevelData::Transitions &transitions, const BinaryAssetLibrary &binaryAssetLibrary,
 		const TextAssetLibrary &textAssetLibrary);
 
-	// Creates mappings of wilderness *MENU voxel coordinates to *MENU names.
-	static ArenaLevelUtils::MenuNamesList generateWildChunkBuildingNames(const VoxelGrid &voxelGrid,
-		const LevelData::Transitions &transitions, const ExeData &exeData);
+	// Creates mappings of *MENU voxel coordinates to *MENU names for one wilderness chunk.
+	static ArenaLevelUtils::MenuNamesList generateWildChunkBuildingNames(const ChunkInt2 &chunk,
+		const VoxelGrid &voxelGrid, const LevelData::Transitions &transitions, const ExeData &exeData);
 
 	// Refreshes a chasm voxel, after one of its neighbors presumably just changed from a
 	// floor voxel.
@@ -217,7 +251,32 @@ private:
 
 	// Updates fading voxels in the given chunk range (interim solution to using the chunk system).
 	void updateFadingVoxels(const ChunkInt2 &minChunk, const ChunkInt2 &maxChunk, double dt);
+
+	// Reads a wilderness block's voxels, flats, transitions, and building names into its chunk, or
+	// removes them. Unloading also removes the block's entities, which respawn when it's reloaded.
+	void loadWildBlock(const ChunkInt2 &chunk, const BinaryAssetLibrary &binaryAssetLibrary);
+	void unloadWildBlock(const ChunkInt2 &chunk);
+
+	// Refreshes the chasms along the edges of a wilderness block's neighbors after it was loaded
+	// or unloaded.
+	void updateWildBlockEdgeChasms(const ChunkInt2 &chunk);
+
+	// Creates renderer textures for voxel definitions starting at the given one.
+	void loadVoxelTextures(int startVoxelDefID, TextureManager &textureManager, Renderer &renderer);
+
+	// Creates entities at each flat def's positions. A flat's entity definition and textures are
+	// only made the first time the flat is seen after the level is set active.
+	void loadFlatEntities(const std::vector<FlatDef> &flatDefs, bool nightLightsAreActive, MapType mapType,
+		const std::optional<ArenaTypes::InteriorType> &interiorType, const LocationDefinition &locationDef,
+		const EntityDefinitionLibrary &entityDefLibrary, const CharacterClassLibrary &charClassLibrary,
+		const BinaryAssetLibrary &binaryAssetLibrary, Random &random, TextureManager &textureManager,
+		Renderer &renderer);
 public:
+	// Most wild blocks loaded by one tick besides the ones next to the player. Crossing a chunk edge
+	// brings a whole row of blocks into range, so loading them is spread over a few frames instead.
+	// Blocks that aren't loaded yet are air, like space beyond the fog.
+	static constexpr int MAX_WILD_BLOCK_LOADS_PER_TICK = 2;
+
 	LevelData(LevelData&&) = default;
 
 	// Interior level. The .INF is obtained from the level's info member.
@@ -238,11 +297,12 @@ public:
 		const std::string &infName, SNInt gridWidth, WEInt gridDepth, const BinaryAssetLibrary &binaryAssetLibrary,
 		const TextAssetLibrary &textAssetLibrary, TextureManager &textureManager);
 
-	// Exterior wilderness level with a pre-defined .INF file. This loads the skeleton of the wilderness
-	// and fills in the rest by loading the required .RMD chunks.
+	// Exterior wilderness level with a pre-defined .INF file. Only the .RMD blocks within the chunk
+	// distance of the start chunk are loaded, and the rest are loaded as the player gets near them.
 	static LevelData loadWilderness(const LocationDefinition &locationDef, const ProvinceDefinition &provinceDef,
 		WeatherType weatherType, int currentDay, int starCount, const std::string &infName,
-		const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager);
+		const ChunkInt2 &startChunk, int chunkDistance, const BinaryAssetLibrary &binaryAssetLibrary,
+		TextureManager &textureManager);
 
 	const std::string &getName() const;
 	double getCeilingHeight() const;
@@ -263,6 +323,17 @@ public:
 	VoxelGrid &getVoxelGrid();
 	const VoxelGrid &getVoxelGrid() const;
 
+	// Only for wilderness levels. Gets the chunks of the wild blocks currently in the voxel grid.
+	const std::vector<ChunkInt2> &getLoadedWildChunks() const;
+
+	// Only for wilderness levels. Unloads blocks beyond the chunk distance of the given chunk and loads
+	// the missing ones in range, nearest first. Blocks next to the given chunk are always loaded, and
+	// at most the given number of others are (negative for no limit). Returns whether any block was
+	// loaded or unloaded. Flats of the new blocks are written to the optional list so their entities
+	// can be made if the level is active.
+	bool updateWildBlocks(const ChunkInt2 &centerChunk, int chunkDistance, int maxLoadCount,
+		const BinaryAssetLibrary &binaryAssetLibrary, std::vector<FlatDef> *outNewFlats);
+
 	// Returns a pointer to some lock if the given voxel has a lock, or null if it doesn't.
 	const Lock *getLock(const NewInt2 &voxel) const;
 
@@ -292,7 +363,8 @@ public:
 		const BinaryAssetLibrary &binaryAssetLibrary, Random &random, CitizenManager &citizenManager,
 		TextureManager &textureManager, Renderer &renderer);
 
-	// Ticks the level data by delta time. Does nothing by default.
+	// Ticks the level data by delta time. The wilderness also loads and unloads blocks around the
+	// player here.
 	void tick(Game &game, double dt);
 };
 
@@ -38,9 +38,18 @@ const EntityManager &LevelInstance::getEntityManager() const
 	return this->entityManager;
 }
 
-void LevelInstance::update(double dt, const ChunkInt2 &centerChunk,
-	int activeLevelIndex, const MapDefinition &mapDefinition, int chunkDistance)
+void LevelInstance::update(double dt, const ChunkInt2 &centerChunk, int activeLevelIndex,
+	const std::shared_ptr<MapDefinition> &mapDefinition, int chunkDistance,
+	const CharacterClassLibrary &charClassLibrary, const EntityDefinitionLibrary &entityDefLibrary,
+	const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager)
 {
+	DebugAssert(mapDefinition != nullptr);
+	if (mapDefinition->getMapType() == MapType::Wilderness)
+	{
+		mapDefinition->updateWild(centerChunk, chunkDistance, charClassLibrary, entityDefLibrary,
+			binaryAssetLibrary, textureManager);
+	}
+
 	this->chunkManager.update(dt, centerChunk, activeLevelIndex, mapDefinition, chunkDistance,
 		this->entityManager);
 }
@@ -1,6 +1,7 @@
 #ifndef LEVEL_INSTANCE_H
 #define LEVEL_INSTANCE_H
 
+#include <memory>
 #include <optional>
 
 #include "ChunkManager.h"
@@ -9,7 +10,11 @@
 // Instance of a level with voxels and entities. Its data is in a baked, context-sensitive format
 // and depends on one or more level definitions for its population.
 
+class BinaryAssetLibrary;
+class CharacterClassLibrary;
+class EntityDefinitionLibrary;
 class MapDefinition;
+class TextureManager;
 
 enum class MapType;
 
@@ -29,8 +34,13 @@ public:
 	EntityManager &getEntityManager();
 	const EntityManager &getEntityManager() const;
 
+	// The map definition isn't const since the wilderness generates its blocks around the center
+	// chunk before the chunk manager populates chunks from them. It's shared with the chunk manager's
+	// populate jobs, so a different map must be a new object rather than the same one re-initialized.
 	void update(double dt, const ChunkInt2 &centerChunk, int activeLevelIndex,
-		const MapDefinition &mapDefinition, int chunkDistance);
+		const std::shared_ptr<MapDefinition> &mapDefinition, int chunkDistance, const CharacterClassLibrary &charClassLibrary,
+		const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
+		TextureManager &textureManager);
 
 	// @todo: some "setActive()" like LevelData so the renderer can be initialized with this level's data.
 	// Probably also store the table of asset filenames/ImageIDs/etc. -> voxel/entity/etc. texture IDs in
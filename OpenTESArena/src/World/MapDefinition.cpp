@@ -30,32 +30,59 @@ ArenaTypes::InteriorType MapDefinition::Interior::getInteriorType() const
 	return this->interiorType;
 }
 
-void MapDefinition::Wild::init(Buffer2D<int> &&levelDefIndices, uint32_t fallbackSeed,
-	std::vector<MapGeneration::WildChunkBuildingNameInfo> &&buildingNameInfos)
+void MapDefinition::Wild::init(Buffer2D<ArenaWildUtils::WildBlockID> &&wildBlockIDs, uint32_t fallbackSeed,
+	MapGeneration::WildCityVoxels &&cityVoxels, uint32_t rulerSeed, bool palaceIsMainQuestDungeon, LocationDefinition::CityDefinition::Type cityType,
+	const INFFile &inf, double ceilingScale)
 {
-	this->levelDefIndices = std::move(levelDefIndices);
+	this->wildBlockIDs = std::move(wildBlockIDs);
 	this->fallbackSeed = fallbackSeed;
-	this->buildingNameInfos = std::move(buildingNameInfos);
+	this->cityVoxels = std::move(cityVoxels);
+	this->rulerSeed = rulerSeed;
+	this->palaceIsMainQuestDungeon = palaceIsMainQuestDungeon;
+	this->cityType = cityType;
+	this->inf = inf;
+	this->ceilingScale = ceilingScale;
+	this->blockCache.clear();
+	this->updateIndex = 0;
+	this->buildingNameInfos.clear();
 }
 
-int MapDefinition::Wild::getLevelDefIndex(const ChunkInt2 &chunk) const
+ArenaWildUtils::WildBlockID MapDefinition::Wild::getBlockID(const ChunkInt2 &chunk) const
 {
-	const bool isValid = (chunk.x >= 0) && (chunk.x < this->levelDefIndices.getWidth()) &&
-		(chunk.y >= 0) && (chunk.y < this->levelDefIndices.getHeight());
+	const bool isValid = (chunk.x >= 0) && (chunk.x < this->wildBlockIDs.getWidth()) &&
+		(chunk.y >= 0) && (chunk.y < this->wildBlockIDs.getHeight());
 
 	if (isValid)
 	{
-		return this->levelDefIndices.get(chunk.x, chunk.y);
+		return this->wildBlockIDs.get(chunk.x, chunk.y);
 	}
 	else
 	{
 		// @todo: use fallbackSeed when outside the defined wild chunks. Not sure yet how
-		// to generate a random value between 0 and levelDefCount for an arbitrary Int2
-		// without running random.next() some arbitrary number of times.
-		return 0;
+		// to generate a random block ID for an arbitrary Int2 without running random.next()
+		// some arbitrary number of times.
+		return this->wildBlockIDs.get(0, 0);
 	}
 }
 
+int MapDefinition::Wild::findCachedBlockIndex(ArenaWildUtils::WildBlockID blockID) const
+{
+	const auto iter = std::find_if(this->blockCache.begin(), this->blockCache.end(),
+		[blockID](const BlockCacheEntry &entry)
+	{
+		return entry.block->blockID == blockID;
+	});
+
+	return (iter != this->blockCache.end()) ? static_cast<int>(std::distance(this->blockCache.begin(), iter)) : -1;
+}
+
+std::shared_ptr<const MapDefinition::WildBlock> MapDefinition::Wild::getBlock(const ChunkInt2 &chunk) const
+{
+	const ArenaWildUtils::WildBlockID blockID = this->getBlockID(chunk);
+	const int index = this->findCachedBlockIndex(blockID);
+	return (index >= 0) ? this->blockCache[index].block : nullptr;
+}
+
 const MapGeneration::WildChunkBuildingNameInfo *MapDefinition::Wild::getBuildingNameInfo(const ChunkInt2 &chunk) const
 {
 	const auto iter = std::find_if(this->buildingNameInfos.begin(), this->buildingNameInfos.end(),
@@ -64,12 +91,130 @@ const MapGeneration::WildChunkBuildingNameInfo *MapDefinition::Wild::getBuilding
 		return buildingNameInfo.getChunk() == chunk;
 	});
 
-	return (iter != this->buildingNameInfos.end()) ? &(*iter) : nullptr;
+	if ((iter == this->buildingNameInfos.end()) || !iter->hasBuildingNames())
+	{
+		return nullptr;
+	}
+
+	return &(*iter);
+}
+
+int MapDefinition::Wild::getCachedBlockCount() const
+{
+	return static_cast<int>(this->blockCache.size());
+}
+
+size_t MapDefinition::Wild::getCachedBlockByteCount() const
+{
+	size_t byteCount = 0;
+	for (const BlockCacheEntry &entry : this->blockCache)
+	{
+		const LevelDefinition &levelDef = entry.block->levelDef;
+		byteCount += static_cast<size_t>(levelDef.getWidth()) * levelDef.getHeight() * levelDef.getDepth() *
+			sizeof(LevelDefinition::VoxelDefID);
+	}
+
+	return byteCount;
+}
+
+void MapDefinition::Wild::update(const ChunkInt2 &centerChunk, int chunkDistance,
+	const CharacterClassLibrary &charClassLibrary, const EntityDefinitionLibrary &entityDefLibrary,
+	const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager)
+{
+	this->updateIndex++;
+
+	// Building names of chunks out of range are regenerated if the player comes back.
+	for (int i = static_cast<int>(this->buildingNameInfos.size()) - 1; i >= 0; i--)
+	{
+		const ChunkInt2 &chunk = this->buildingNameInfos[i].getChunk();
+		if (!ChunkUtils::isWithinActiveRange(centerChunk, chunk, chunkDistance))
+		{
+			this->buildingNameInfos[i] = std::move(this->buildingNameInfos.back());
+			this->buildingNameInfos.pop_back();
+		}
+	}
+
+	ChunkInt2 minChunk, maxChunk;
+	ChunkUtils::getSurroundingChunks(centerChunk, chunkDistance, &minChunk, &maxChunk);
+	for (WEInt y = minChunk.y; y <= maxChunk.y; y++)
+	{
+		for (SNInt x = minChunk.x; x <= maxChunk.x; x++)
+		{
+			const ChunkInt2 chunk(x, y);
+			const ArenaWildUtils::WildBlockID blockID = this->getBlockID(chunk);
+			int blockIndex = this->findCachedBlockIndex(blockID);
+			if (blockIndex < 0)
+			{
+				// Each .RMD file should be one chunk's width and depth.
+				auto block = std::make_shared<WildBlock>();
+				block->blockID = blockID;
+
+				constexpr int chunkDim = ChunkUtils::CHUNK_DIM;
+				block->levelDef.init(chunkDim, 6, chunkDim);
+				block->levelInfoDef.init(this->ceilingScale);
+
+				MapGeneration::generateRmdWilderness(blockID, this->cityVoxels, this->rulerSeed,
+					this->palaceIsMainQuestDungeon, this->cityType, this->inf, charClassLibrary, entityDefLibrary,
+					binaryAssetLibrary, textureManager, &block->levelDef, &block->levelInfoDef);
+
+				BlockCacheEntry entry;
+				entry.block = std::move(block);
+				this->blockCache.emplace_back(std::move(entry));
+				blockIndex = static_cast<int>(this->blockCache.size()) - 1;
+			}
+
+			BlockCacheEntry &entry = this->blockCache[blockIndex];
+			entry.lastUsedUpdate = this->updateIndex;
+
+			const bool hasBuildingNameInfo = std::any_of(this->buildingNameInfos.begin(), this->buildingNameInfos.end(),
+				[&chunk](const MapGeneration::WildChunkBuildingNameInfo &buildingNameInfo)
+			{
+				return buildingNameInfo.getChunk() == chunk;
+			});
+
+			if (!hasBuildingNameInfo)
+			{
+				// Kept even without names so the chunk isn't searched again while it's in range.
+				MapGeneration::WildChunkBuildingNameInfo buildingNameInfo;
+				MapGeneration::generateRmdWildChunkBuildingNames(chunk, entry.block->levelDef,
+					entry.block->levelInfoDef, binaryAssetLibrary, &buildingNameInfo);
+				this->buildingNameInfos.emplace_back(std::move(buildingNameInfo));
+			}
+		}
+	}
+
+	// Free least recently used blocks beyond one per chunk in range. Blocks in range are never
+	// freed since there can't be more of them than chunks in range.
+	SNInt chunkCountX;
+	WEInt chunkCountZ;
+	ChunkUtils::getPotentiallyVisibleChunkCounts(chunkDistance, &chunkCountX, &chunkCountZ);
+	const int maxCachedBlockCount = chunkCountX * chunkCountZ;
+	while (static_cast<int>(this->blockCache.size()) > maxCachedBlockCount)
+	{
+		const auto iter = std::min_element(this->blockCache.begin(), this->blockCache.end(),
+			[](const BlockCacheEntry &a, const BlockCacheEntry &b)
+		{
+			return a.lastUsedUpdate < b.lastUsedUpdate;
+		});
+
+		*iter = std::move(this->blockCache.back());
+		this->blockCache.pop_back();
+	}
+}
+
+MapDefinition::MapDefinition()
+{
+	this->generation = -1;
 }
 
 void MapDefinition::init(MapType mapType)
 {
+	// Shared by all map definitions so no two initializations get the same generation.
+	static int nextGeneration = 0;
+
 	this->mapType = mapType;
+	this->generation = nextGeneration;
+	nextGeneration++;
 }
 
 bool MapDefinition::initInteriorLevels(const MIFFile &mif, ArenaTypes::InteriorType interiorType,
@@ -297,89 +442,49 @@ bool MapDefinition::initCityLevel(const MIFFile &mif, uint32_t citySeed, uint32_
 }
 
 bool MapDefinition::initWildLevels(const BufferView2D<const ArenaWildUtils::WildBlockID> &wildBlockIDs,
-	uint32_t fallbackSeed, uint32_t rulerSeed, bool palaceIsMainQuestDungeon,
+	uint32_t fallbackSeed, const LocationDefinition &locationDef, uint32_t rulerSeed, bool palaceIsMainQuestDungeon,
 	LocationDefinition::CityDefinition::Type cityType, const SkyGeneration::ExteriorSkyGenInfo &skyGenInfo,
 	const INFFile &inf, const CharacterClassLibrary &charClassLibrary,
 	const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
 	TextureManager &textureManager)
 {
-	// Create a list of unique block IDs and a 2D table of level definition index mappings. The index
-	// of a wild block ID is its level definition index.
-	std::vector<ArenaWildUtils::WildBlockID> uniqueWildBlockIDs;
-	Buffer2D<int> levelDefIndices(wildBlockIDs.getWidth(), wildBlockIDs.getHeight());
-	for (int y = 0; y < wildBlockIDs.getHeight(); y++)
-	{
-		for (int x = 0; x < wildBlockIDs.getWidth(); x++)
-		{
-			const ArenaWildUtils::WildBlockID blockID = wildBlockIDs.get(x, y);
-			const auto iter = std::find(uniqueWildBlockIDs.begin(), uniqueWildBlockIDs.end(), blockID);
-
-			int levelDefIndex;
-			if (iter != uniqueWildBlockIDs.end())
-			{
-				levelDefIndex = static_cast<int>(std::distance(uniqueWildBlockIDs.begin(), iter));
-			}
-			else
-			{
-				uniqueWildBlockIDs.push_back(blockID);
-				levelDefIndex = static_cast<int>(uniqueWildBlockIDs.size()) - 1;
-			}
-
-			levelDefIndices.set(x, y, levelDefIndex);
-		}
-	}
-
-	// N LevelDefinitions (for chunks) and 1 LevelInfoDefinition.
-	this->levels.init(static_cast<int>(uniqueWildBlockIDs.size()));
+	// No level definitions. Wild blocks are generated as the player gets near them, and the one
+	// level info definition is only for values shared by the whole wilderness.
 	this->levelInfos.init(1);
-	this->levelInfoMappings.init(this->levels.getCount());
+	this->levelInfoMappings.init(1);
 	this->skies.init(1);
-	this->skyMappings.init(this->levels.getCount()); // Unnecessary but convenient for API.
+	this->skyMappings.init(1); // Unnecessary but convenient for API.
 	this->skyInfos.init(1);
 	this->skyInfoMappings.init(1);
 
-	for (int i = 0; i < this->levels.getCount(); i++)
-	{
-		// Each .RMD file should be one chunk's width and depth.
-		constexpr int chunkDim = ChunkUtils::CHUNK_DIM;
-		LevelDefinition &levelDef = this->levels.get(i);
-		levelDef.init(chunkDim, 6, chunkDim);
-	}
-
 	LevelInfoDefinition &levelInfoDef = this->levelInfos.get(0);
 	const INFFile::CeilingData &ceiling = inf.getCeiling();
 	const double ceilingScale = ArenaLevelUtils::convertArenaCeilingHeight(ceiling.height);
 	levelInfoDef.init(ceilingScale);
 
-	const BufferView<const ArenaWildUtils::WildBlockID> uniqueWildBlockIdsConstView(
-		uniqueWildBlockIDs.data(), static_cast<int>(uniqueWildBlockIDs.size()));
-	const BufferView2D<const int> levelDefIndicesConstView(levelDefIndices.get(),
-		levelDefIndices.getWidth(), levelDefIndices.getHeight());
-	BufferView<LevelDefinition> levelDefsView(this->levels.get(), this->levels.getCount());
-	std::vector<MapGeneration::WildChunkBuildingNameInfo> buildingNameInfos;
-	MapGeneration::generateRmdWilderness(uniqueWildBlockIdsConstView, levelDefIndicesConstView,
-		rulerSeed, palaceIsMainQuestDungeon, cityType, inf, charClassLibrary, entityDefLibrary,
-		binaryAssetLibrary, textureManager, levelDefsView, &levelInfoDef, &buildingNameInfos);
-
 	SkyDefinition &skyDef = this->skies.get(0);
 	SkyInfoDefinition &skyInfoDef = this->skyInfos.get(0);
 	SkyGeneration::generateExteriorSky(skyGenInfo, binaryAssetLibrary, textureManager, &skyDef, &skyInfoDef);
 
-	// Every wild chunk level definition uses the same level info definition.
-	for (int i = 0; i < this->levelInfoMappings.getCount(); i++)
-	{
-		this->levelInfoMappings.set(i, 0);
-	}
+	this->levelInfoMappings.set(0, 0);
+	this->skyMappings.set(0, 0);
+	this->skyInfoMappings.set(0, 0);
 
-	for (int i = 0; i < this->skyMappings.getCount(); i++)
+	// Populate wild chunk look-up values.
+	Buffer2D<ArenaWildUtils::WildBlockID> wildBlockIDsCopy(wildBlockIDs.getWidth(), wildBlockIDs.getHeight());
+	for (int y = 0; y < wildBlockIDs.getHeight(); y++)
 	{
-		this->skyMappings.set(i, 0);
+		for (int x = 0; x < wildBlockIDs.getWidth(); x++)
+		{
+			wildBlockIDsCopy.set(x, y, wildBlockIDs.get(x, y));
+		}
 	}
 
-	this->skyInfoMappings.set(0, 0);
+	MapGeneration::WildCityVoxels cityVoxels;
+	cityVoxels.init(locationDef, binaryAssetLibrary);
 
-	// Populate wild chunk look-up values.
-	this->wild.init(std::move(levelDefIndices), fallbackSeed, std::move(buildingNameInfos));
+	this->wild.init(std::move(wildBlockIDsCopy), fallbackSeed, std::move(cityVoxels), rulerSeed,
+		palaceIsMainQuestDungeon, cityType, inf, ceilingScale);
 
 	return true;
 }
@@ -511,8 +616,9 @@ bool MapDefinition::initWild(const MapGeneration::WildGenInfo &generationInfo,
 	const BufferView2D<const ArenaWildUtils::WildBlockID> wildBlockIDs(generationInfo.wildBlockIDs.get(),
 		generationInfo.wildBlockIDs.getWidth(), generationInfo.wildBlockIDs.getHeight());
 
-	this->initWildLevels(wildBlockIDs, generationInfo.fallbackSeed, generationInfo.rulerSeed,
-		generationInfo.palaceIsMainQuestDungeon, generationInfo.cityType, exteriorSkyGenInfo, inf,
+	DebugAssert(generationInfo.locationDef != nullptr);
+	this->initWildLevels(wildBlockIDs, generationInfo.fallbackSeed, *generationInfo.locationDef,
+		generationInfo.rulerSeed, generationInfo.palaceIsMainQuestDungeon, generationInfo.cityType, exteriorSkyGenInfo, inf,
 		charClassLibrary, entityDefLibrary, binaryAssetLibrary, textureManager);
 
 	// No start level index and no start points in the wilderness due to the nature of chunks.
@@ -572,6 +678,11 @@ MapType MapDefinition::getMapType() const
 	return this->mapType;
 }
 
+int MapDefinition::getGeneration() const
+{
+	return this->generation;
+}
+
 const MapDefinition::Interior &MapDefinition::getInterior() const
 {
 	DebugAssert(this->mapType == MapType::Interior);
@@ -583,3 +694,12 @@ const MapDefinition::Wild &MapDefinition::getWild() const
 	DebugAssert(this->mapType == MapType::Wilderness);
 	return this->wild;
 }
+
+void MapDefinition::updateWild(const ChunkInt2 &centerChunk, int chunkDistance,
+	const CharacterClassLibrary &charClassLibrary, const EntityDefinitionLibrary &entityDefLibrary,
+	const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager)
+{
+	DebugAssert(this->mapType == MapType::Wilderness);
+	this->wild.update(centerChunk, chunkDistance, charClassLibrary, entityDefLibrary, binaryAssetLibrary,
+		textureManager);
+}
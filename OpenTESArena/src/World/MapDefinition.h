@@ -1,6 +1,7 @@
 #ifndef MAP_DEFINITION_H
 #define MAP_DEFINITION_H
 
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -15,6 +16,7 @@
 #include "SkyInfoDefinition.h"
 #include "VoxelUtils.h"
 #include "../Assets/ArenaTypes.h"
+#include "../Assets/INFFile.h"
 
 #include "components/utilities/Buffer.h"
 #include "components/utilities/BufferView2D.h"
@@ -49,21 +51,66 @@ public:
 		ArenaTypes::InteriorType getInteriorType() const;
 	};
 
+	// A wilderness .RMD block in the modern format. Chunk populate jobs share ownership so a block
+	// can leave the block cache while a chunk is still being populated from it.
+	struct WildBlock
+	{
+		ArenaWildUtils::WildBlockID blockID;
+		LevelDefinition levelDef;
+		LevelInfoDefinition levelInfoDef;
+	};
+
 	class Wild
 	{
 	private:
-		// Each index is a wild chunk pointing into the map's level definitions.
-		Buffer2D<int> levelDefIndices;
+		struct BlockCacheEntry
+		{
+			std::shared_ptr<const WildBlock> block;
+			int lastUsedUpdate; // Most recent update the block was in range.
+		};
+
+		Buffer2D<ArenaWildUtils::WildBlockID> wildBlockIDs; // Block used by each wild chunk.
 		uint32_t fallbackSeed; // I.e. the world map location seed.
+		MapGeneration::WildCityVoxels cityVoxels; // Replacements for the city's placeholder blocks.
 
-		// Building name infos for each chunk.
+		// Values for generating blocks as the player gets near them.
+		uint32_t rulerSeed;
+		bool palaceIsMainQuestDungeon;
+		LocationDefinition::CityDefinition::Type cityType;
+		INFFile inf;
+		double ceilingScale;
+
+		// Generated blocks, least recently used ones are freed once there are more than the chunks
+		// in range. This keeps memory bounded by the chunk distance instead of the wilderness size.
+		std::vector<BlockCacheEntry> blockCache;
+		int updateIndex;
+
+		// Building name infos for each chunk in range.
 		std::vector<MapGeneration::WildChunkBuildingNameInfo> buildingNameInfos;
+
+		ArenaWildUtils::WildBlockID getBlockID(const ChunkInt2 &chunk) const;
+		int findCachedBlockIndex(ArenaWildUtils::WildBlockID blockID) const;
 	public:
-		void init(Buffer2D<int> &&levelDefIndices, uint32_t fallbackSeed,
-			std::vector<MapGeneration::WildChunkBuildingNameInfo> &&buildingNameInfos);
+		void init(Buffer2D<ArenaWildUtils::WildBlockID> &&wildBlockIDs, uint32_t fallbackSeed,
+			MapGeneration::WildCityVoxels &&cityVoxels, uint32_t rulerSeed, bool palaceIsMainQuestDungeon, LocationDefinition::CityDefinition::Type cityType,
+			const INFFile &inf, double ceilingScale);
+
+		// Gets the generated block for a wild chunk, or null if the block hasn't been generated
+		// (i.e., it has never been in range or was freed).
+		std::shared_ptr<const WildBlock> getBlock(const ChunkInt2 &chunk) const;
 
-		int getLevelDefIndex(const ChunkInt2 &chunk) const;
 		const MapGeneration::WildChunkBuildingNameInfo *getBuildingNameInfo(const ChunkInt2 &chunk) const;
+
+		int getCachedBlockCount() const;
+
+		// Bytes used by the voxels of every cached block.
+		size_t getCachedBlockByteCount() const;
+
+		// Generates the blocks and building names of chunks in range of the given chunk, and frees the
+		// ones that are no longer needed. Must be called before the chunk manager is updated.
+		void update(const ChunkInt2 &centerChunk, int chunkDistance, const CharacterClassLibrary &charClassLibrary,
+			const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
+			TextureManager &textureManager);
 	};
 private:
 	Buffer<LevelDefinition> levels;
@@ -81,6 +128,10 @@ private:
 	Interior interior;
 	Wild wild;
 
+	// Unique for each initialization, so a map assigned into an existing map definition object can be
+	// told apart from the one it replaced.
+	int generation;
+
 	void init(MapType mapType);
 	bool initInteriorLevels(const MIFFile &mif, ArenaTypes::InteriorType interiorType,
 		const std::optional<uint32_t> &rulerSeed, const std::optional<bool> &rulerIsMale,
@@ -100,13 +151,15 @@ private:
 		const BinaryAssetLibrary &binaryAssetLibrary, const TextAssetLibrary &textAssetLibrary,
 		TextureManager &textureManager);
 	bool initWildLevels(const BufferView2D<const ArenaWildUtils::WildBlockID> &wildBlockIDs,
-		uint32_t fallbackSeed, uint32_t rulerSeed, bool palaceIsMainQuestDungeon,
+		uint32_t fallbackSeed, const LocationDefinition &locationDef, uint32_t rulerSeed, bool palaceIsMainQuestDungeon,
 		LocationDefinition::CityDefinition::Type cityType, const SkyGeneration::ExteriorSkyGenInfo &skyGenInfo,
 		const INFFile &inf, const CharacterClassLibrary &charClassLibrary,
 		const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
 		TextureManager &textureManager);
 	void initStartPoints(const MIFFile &mif);
 public:
+	MapDefinition();
+
 	bool initInterior(const MapGeneration::InteriorGenInfo &generationInfo,
 		const CharacterClassLibrary &charClassLibrary, const EntityDefinitionLibrary &entityDefLibrary,
 		const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager);
@@ -130,9 +183,8 @@ public:
 	int getLevelCount() const;
 
 	// This has different semantics based on the world type. For interiors, levels are separated by
-	// level up/down transitions. For a city, there is only one level. For the wilderness, it gets
-	// the level associated with a wild chunk whose index is acquired by querying some wild chunk
-	// coordinate.
+	// level up/down transitions. For a city, there is only one level. The wilderness has no levels
+	// and its chunks are populated from wild blocks instead.
 	const LevelDefinition &getLevel(int index) const;
 
 	const LevelInfoDefinition &getLevelInfoForLevel(int levelIndex) const;	
@@ -142,8 +194,14 @@ public:
 	const SkyInfoDefinition &getSkyInfoForSky(int skyIndex) const;
 
 	MapType getMapType() const;
+	int getGeneration() const;
 	const Interior &getInterior() const;
 	const Wild &getWild() const;
+
+	// Updates the wild block cache around the given chunk.
+	void updateWild(const ChunkInt2 &centerChunk, int chunkDistance, const CharacterClassLibrary &charClassLibrary,
+		const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
+		TextureManager &textureManager);
 };
 
 #endif
@@ -41,7 +41,6 @@ namespace MapGeneration
 	using ArenaLockMappingCache = std::vector<std::pair<ArenaTypes::MIFLock, LevelDefinition::LockDefID>>;
 	using ArenaTriggerMappingCache = std::vector<std::pair<ArenaTypes::MIFTrigger, LevelDefinition::TriggerDefID>>;
 	using ArenaTransitionMappingCache = std::unordered_map<ArenaTypes::VoxelID, LevelDefinition::TransitionDefID>;
-	using ArenaBuildingNameMappingCache = std::unordered_map<std::string, LevelDefinition::BuildingNameID>;
 
 	static_assert(sizeof(ArenaTypes::VoxelID) == sizeof(uint16_t));
 
@@ -1594,18 +1593,17 @@ namespace MapGeneration
 	}
 
 	// Using a separate building name info struct because the same level definition might be
-	// used in multiple places in the wild, so it can't store the building name IDs.
+	// used in multiple places in the wild, so it can't store the building names.
 	void generateArenaWildChunkBuildingNames(uint32_t wildChunkSeed, const LevelDefinition &levelDef,
-		const BinaryAssetLibrary &binaryAssetLibrary,
-		MapGeneration::WildChunkBuildingNameInfo *outBuildingNameInfo,
-		LevelInfoDefinition *outLevelInfoDef, ArenaBuildingNameMappingCache *buildingNameMappings)
+		const LevelInfoDefinition &levelInfoDef, const BinaryAssetLibrary &binaryAssetLibrary,
+		MapGeneration::WildChunkBuildingNameInfo *outBuildingNameInfo)
 	{
 		const auto &exeData = binaryAssetLibrary.getExeData();
 
 		// Lambda for searching for an interior entrance voxel of the given type in the chunk
 		// and generating a name for it if found.
-		auto tryGenerateChunkBuildingName = [wildChunkSeed, &levelDef, outBuildingNameInfo,
-			outLevelInfoDef, buildingNameMappings, &exeData](ArenaTypes::InteriorType interiorType)
+		auto tryGenerateChunkBuildingName = [wildChunkSeed, &levelDef, &levelInfoDef,
+			outBuildingNameInfo, &exeData](ArenaTypes::InteriorType interiorType)
 		{
 			auto createTavernName = [&exeData](int prefixIndex, int suffixIndex)
 			{
@@ -1648,14 +1646,13 @@ namespace MapGeneration
 			};
 
 			// The lambda called for each main-floor voxel in the chunk.
-			auto tryGenerateBlockName = [wildChunkSeed, &levelDef, outBuildingNameInfo,
-				outLevelInfoDef, buildingNameMappings, interiorType, &createTavernName,
-				&createTempleName](SNInt x, WEInt z) -> bool
+			auto tryGenerateBlockName = [wildChunkSeed, &levelDef, &levelInfoDef, outBuildingNameInfo,
+				interiorType, &createTavernName, &createTempleName](SNInt x, WEInt z) -> bool
 			{
 				ArenaRandom random(wildChunkSeed);
 
 				// See if the current voxel is an interior transition block and matches the target type.
-				const bool matchesTargetType = [&levelDef, outLevelInfoDef, interiorType, x, z]()
+				const bool matchesTargetType = [&levelDef, &levelInfoDef, interiorType, x, z]()
 				{
 					// Find the associated transition for this voxel (if any).
 					const std::optional<LevelDefinition::TransitionDefID> transitionDefID =
@@ -1683,7 +1680,7 @@ namespace MapGeneration
 						return false;
 					}
 
-					const TransitionDefinition &transitionDef = outLevelInfoDef->getTransitionDef(*transitionDefID);
+					const TransitionDefinition &transitionDef = levelInfoDef.getTransitionDef(*transitionDefID);
 					const TransitionType transitionType = transitionDef.getType();
 					if (transitionType != TransitionType::EnterInterior)
 					{
@@ -1723,18 +1720,7 @@ namespace MapGeneration
 					}();
 
 					// Set building name info for the given menu type.
-					const auto iter = buildingNameMappings->find(name);
-					if (iter != buildingNameMappings->end())
-					{
-						outBuildingNameInfo->setBuildingNameID(interiorType, iter->second);
-					}
-					else
-					{
-						const LevelDefinition::BuildingNameID buildingNameID =
-							outLevelInfoDef->addBuildingName(std::string(name));
-						outBuildingNameInfo->setBuildingNameID(interiorType, buildingNameID);
-						buildingNameMappings->emplace(std::move(name), buildingNameID);
-					}
+					outBuildingNameInfo->setBuildingName(interiorType, std::move(name));
 
 					return true;
 				}
@@ -1858,16 +1844,27 @@ void MapGeneration::CityGenInfo::init(std::string &&mifName, std::string &&cityT
 }
 
 void MapGeneration::WildGenInfo::init(Buffer2D<ArenaWildUtils::WildBlockID> &&wildBlockIDs,
-	LocationDefinition::CityDefinition::Type cityType, uint32_t fallbackSeed, uint32_t rulerSeed,
-	bool palaceIsMainQuestDungeon)
+	const LocationDefinition *locationDef, LocationDefinition::CityDefinition::Type cityType,
+	uint32_t fallbackSeed, uint32_t rulerSeed, bool palaceIsMainQuestDungeon)
 {
 	this->wildBlockIDs = std::move(wildBlockIDs);
+	this->locationDef = locationDef;
 	this->cityType = cityType;
 	this->fallbackSeed = fallbackSeed;
 	this->rulerSeed = rulerSeed;
 	this->palaceIsMainQuestDungeon = palaceIsMainQuestDungeon;
 }
 
+void MapGeneration::WildCityVoxels::init(const LocationDefinition &locationDef,
+	const BinaryAssetLibrary &binaryAssetLibrary)
+{
+	constexpr int chunkDim = ChunkUtils::CHUNK_DIM;
+	this->flor.init(chunkDim * 2, chunkDim * 2);
+	this->map1.init(this->flor.getWidth(), this->flor.getHeight());
+	this->map2.init(this->flor.getWidth(), this->flor.getHeight());
+	ArenaWildUtils::reviseWildernessCity(locationDef, this->flor, this->map1, this->map2, binaryAssetLibrary);
+}
+
 void MapGeneration::WildChunkBuildingNameInfo::init(const ChunkInt2 &chunk)
 {
 	this->chunk = chunk;
@@ -1880,35 +1877,27 @@ const ChunkInt2 &MapGeneration::WildChunkBuildingNameInfo::getChunk() const
 
 bool MapGeneration::WildChunkBuildingNameInfo::hasBuildingNames() const
 {
-	return this->ids.size() > 0;
+	return this->names.size() > 0;
 }
 
-bool MapGeneration::WildChunkBuildingNameInfo::tryGetBuildingNameID(
-	ArenaTypes::InteriorType interiorType, LevelDefinition::BuildingNameID *outID) const
+const std::string *MapGeneration::WildChunkBuildingNameInfo::tryGetBuildingName(
+	ArenaTypes::InteriorType interiorType) const
 {
-	const auto iter = this->ids.find(interiorType);
-	if (iter != this->ids.end())
-	{
-		*outID = iter->second;
-		return true;
-	}
-	else
-	{
-		return false;
-	}
+	const auto iter = this->names.find(interiorType);
+	return (iter != this->names.end()) ? &iter->second : nullptr;
 }
 
-void MapGeneration::WildChunkBuildingNameInfo::setBuildingNameID(
-	ArenaTypes::InteriorType interiorType, LevelDefinition::BuildingNameID id)
+void MapGeneration::WildChunkBuildingNameInfo::setBuildingName(
+	ArenaTypes::InteriorType interiorType, std::string &&name)
 {
-	const auto iter = this->ids.find(interiorType);
-	if (iter != this->ids.end())
+	const auto iter = this->names.find(interiorType);
+	if (iter != this->names.end())
 	{
-		iter->second = id;
+		iter->second = std::move(name);
 	}
 	else
 	{
-		this->ids.emplace(interiorType, id);
+		this->names.emplace(interiorType, std::move(name));
 	}
 }
 
@@ -2118,116 +2107,98 @@ void MapGeneration::generateMifCity(const MIFFile &mif, uint32_t citySeed, uint3
 		outLevelInfoDef);
 }
 
-void MapGeneration::generateRmdWilderness(const BufferView<const ArenaWildUtils::WildBlockID> &uniqueWildBlockIDs,
-	const BufferView2D<const int> &levelDefIndices, uint32_t rulerSeed, bool palaceIsMainQuestDungeon,
-	LocationDefinition::CityDefinition::Type cityType, const INFFile &inf,
+void MapGeneration::generateRmdWilderness(ArenaWildUtils::WildBlockID wildBlockID,
+	const WildCityVoxels &cityVoxels, uint32_t rulerSeed, bool palaceIsMainQuestDungeon, LocationDefinition::CityDefinition::Type cityType, const INFFile &inf,
 	const CharacterClassLibrary &charClassLibrary, const EntityDefinitionLibrary &entityDefLibrary,
 	const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager,
-	BufferView<LevelDefinition> &outLevelDefs, LevelInfoDefinition *outLevelInfoDef,
-	std::vector<MapGeneration::WildChunkBuildingNameInfo> *outBuildingNameInfos)
+	LevelDefinition *outLevelDef, LevelInfoDefinition *outLevelInfoDef)
 {
-	DebugAssert(uniqueWildBlockIDs.getCount() == outLevelDefs.getCount());
-
+	// Mappings are only shared within the block since its level info isn't shared with other blocks.
 	ArenaVoxelMappingCache florMappings, map1Mappings, map2Mappings;
 	ArenaEntityMappingCache entityMappings;
 	ArenaTransitionMappingCache transitionMappings;
-	ArenaBuildingNameMappingCache buildingNameMappings;
 
-	// Create temp voxel data buffers to be used by each wilderness chunk.
+	// Create temp voxel data buffers for the block.
 	constexpr int chunkDim = ChunkUtils::CHUNK_DIM;
 	Buffer2D<ArenaTypes::VoxelID> tempFlor(chunkDim, chunkDim);
 	Buffer2D<ArenaTypes::VoxelID> tempMap1(chunkDim, chunkDim);
 	Buffer2D<ArenaTypes::VoxelID> tempMap2(chunkDim, chunkDim);
 
-	for (int i = 0; i < uniqueWildBlockIDs.getCount(); i++)
-	{
-		const ArenaWildUtils::WildBlockID wildBlockID = uniqueWildBlockIDs.get(i);
-		const auto &rmdFiles = binaryAssetLibrary.getWildernessChunks();
-		const int rmdIndex = DebugMakeIndex(rmdFiles, wildBlockID - 1);
-		const RMDFile &rmd = rmdFiles[rmdIndex];
-		const BufferView2D<const ArenaTypes::VoxelID> rmdFLOR = rmd.getFLOR();
-		const BufferView2D<const ArenaTypes::VoxelID> rmdMAP1 = rmd.getMAP1();
-		const BufferView2D<const ArenaTypes::VoxelID> rmdMAP2 = rmd.getMAP2();
-
-		// Copy .RMD voxels into temp buffers.
-		for (int y = 0; y < tempFlor.getHeight(); y++)
-		{
-			for (int x = 0; x < tempFlor.getWidth(); x++)
-			{
-				const ArenaTypes::VoxelID rmdFlorID = rmdFLOR.get(x, y);
-				const ArenaTypes::VoxelID rmdMap1ID = rmdMAP1.get(x, y);
-				const ArenaTypes::VoxelID rmdMap2ID = rmdMAP2.get(x, y);
-				tempFlor.set(x, y, rmdFlorID);
-				tempMap1.set(x, y, rmdMap1ID);
-				tempMap2.set(x, y, rmdMap2ID);
-			}
-		}
+	const auto &rmdFiles = binaryAssetLibrary.getWildernessChunks();
+	const int rmdIndex = DebugMakeIndex(rmdFiles, wildBlockID - 1);
+	const RMDFile &rmd = rmdFiles[rmdIndex];
+	const BufferView2D<const ArenaTypes::VoxelID> rmdFLOR = rmd.getFLOR();
+	const BufferView2D<const ArenaTypes::VoxelID> rmdMAP1 = rmd.getMAP1();
+	const BufferView2D<const ArenaTypes::VoxelID> rmdMAP2 = rmd.getMAP2();
 
-		const bool isCityBlockID = (wildBlockID >= 1) && (wildBlockID <= 4);
-		if (isCityBlockID)
+	// Copy .RMD voxels into temp buffers.
+	for (int y = 0; y < tempFlor.getHeight(); y++)
+	{
+		for (int x = 0; x < tempFlor.getWidth(); x++)
 		{
-			// Change the placeholder WILD00{1..4}.RMD block to the one for the given city.
-			BufferView2D<ArenaTypes::VoxelID> tempFlorView(
-				tempFlor.get(), tempFlor.getWidth(), tempFlor.getHeight());
-			BufferView2D<ArenaTypes::VoxelID> tempMap1View(
-				tempMap1.get(), tempMap1.getWidth(), tempMap1.getHeight());
-			BufferView2D<ArenaTypes::VoxelID> tempMap2View(
-				tempMap2.get(), tempMap2.getWidth(), tempMap2.getHeight());
-
-			// @todo: change this to take wild block ID instead of assuming it's the whole wilderness
-			// and rename to reviseWildCityBlock() maybe.
-			/*WildLevelUtils::reviseWildernessCity(locationDef, tempFlorView, tempMap1View,
-				tempMap2View, binaryAssetLibrary);*/
-			DebugNotImplemented();
+			const ArenaTypes::VoxelID rmdFlorID = rmdFLOR.get(x, y);
+			const ArenaTypes::VoxelID rmdMap1ID = rmdMAP1.get(x, y);
+			const ArenaTypes::VoxelID rmdMap2ID = rmdMAP2.get(x, y);
+			tempFlor.set(x, y, rmdFlorID);
+			tempMap1.set(x, y, rmdMap1ID);
+			tempMap2.set(x, y, rmdMap2ID);
 		}
-
-		LevelDefinition &levelDef = outLevelDefs.get(i);
-
-		const BufferView2D<const ArenaTypes::VoxelID> tempFlorConstView(
-			tempFlor.get(), tempFlor.getWidth(), tempFlor.getHeight());
-		const BufferView2D<const ArenaTypes::VoxelID> tempMap1ConstView(
-			tempMap1.get(), tempMap1.getWidth(), tempMap1.getHeight());
-		const BufferView2D<const ArenaTypes::VoxelID> tempMap2ConstView(
-			tempMap2.get(), tempMap2.getWidth(), tempMap2.getHeight());
-
-		constexpr MapType mapType = MapType::Wilderness;
-		constexpr std::optional<ArenaTypes::InteriorType> interiorType; // Wilderness is not an interior.
-		constexpr std::optional<bool> rulerIsMale; // Not necessary for wild.
-		constexpr LocationDefinition::DungeonDefinition *dungeonDef = nullptr; // Not necessary for wild.
-		constexpr std::optional<bool> isArtifactDungeon; // Not necessary for wild.
-
-		MapGeneration::readArenaFLOR(tempFlorConstView, mapType, interiorType, rulerIsMale, inf,
-			charClassLibrary, entityDefLibrary, binaryAssetLibrary, textureManager, &levelDef,
-			outLevelInfoDef, &florMappings, &entityMappings);
-		MapGeneration::readArenaMAP1(tempMap1ConstView, mapType, interiorType, rulerSeed, rulerIsMale,
-			palaceIsMainQuestDungeon, cityType, dungeonDef, isArtifactDungeon, inf, charClassLibrary,
-			entityDefLibrary, binaryAssetLibrary,
-			textureManager, &levelDef, outLevelInfoDef, &map1Mappings, &entityMappings, &transitionMappings);
-		MapGeneration::readArenaMAP2(tempMap2ConstView, inf, &levelDef, outLevelInfoDef, &map2Mappings);
 	}
 
-	// Generate chunk-wise building names for the wilderness.
-	for (WEInt z = 0; z < levelDefIndices.getHeight(); z++)
+	const bool isCityBlockID = (wildBlockID >= 1) && (wildBlockID <= 4);
+	if (isCityBlockID)
 	{
-		for (SNInt x = 0; x < levelDefIndices.getWidth(); x++)
+		// Change the placeholder WILD00{1..4}.RMD block to the city's quarter it stands for. Block IDs
+		// go left to right then top to bottom, and a layer's first coordinate is along the Z axis.
+		DebugAssert(cityVoxels.flor.getWidth() == (chunkDim * 2));
+		DebugAssert(cityVoxels.flor.getHeight() == (chunkDim * 2));
+		const int cityBlockIndex = wildBlockID - 1;
+		const SNInt blockX = cityBlockIndex % 2;
+		const WEInt blockZ = cityBlockIndex / 2;
+		for (int y = 0; y < tempFlor.getHeight(); y++)
 		{
-			const int levelDefIndex = levelDefIndices.get(x, z);
-			const LevelDefinition &levelDef = outLevelDefs.get(levelDefIndex);
-			const ChunkInt2 chunk(x, z); // @todo: verify
-			const uint32_t chunkSeed = ArenaWildUtils::makeWildChunkSeed(chunk.x, chunk.y);
-			MapGeneration::WildChunkBuildingNameInfo buildingNameInfo;
-			buildingNameInfo.init(chunk);
-
-			MapGeneration::generateArenaWildChunkBuildingNames(chunkSeed, levelDef, binaryAssetLibrary,
-				&buildingNameInfo, outLevelInfoDef, &buildingNameMappings);
-
-			// Register the chunk if it has any buildings with names.
-			if (buildingNameInfo.hasBuildingNames())
+			for (int x = 0; x < tempFlor.getWidth(); x++)
 			{
-				outBuildingNameInfos->emplace_back(std::move(buildingNameInfo));
+				const int cityX = (blockZ * chunkDim) + x;
+				const int cityY = (blockX * chunkDim) + y;
+				tempFlor.set(x, y, cityVoxels.flor.get(cityX, cityY));
+				tempMap1.set(x, y, cityVoxels.map1.get(cityX, cityY));
+				tempMap2.set(x, y, cityVoxels.map2.get(cityX, cityY));
 			}
 		}
 	}
+
+	const BufferView2D<const ArenaTypes::VoxelID> tempFlorConstView(
+		tempFlor.get(), tempFlor.getWidth(), tempFlor.getHeight());
+	const BufferView2D<const ArenaTypes::VoxelID> tempMap1ConstView(
+		tempMap1.get(), tempMap1.getWidth(), tempMap1.getHeight());
+	const BufferView2D<const ArenaTypes::VoxelID> tempMap2ConstView(
+		tempMap2.get(), tempMap2.getWidth(), tempMap2.getHeight());
+
+	constexpr MapType mapType = MapType::Wilderness;
+	constexpr std::optional<ArenaTypes::InteriorType> interiorType; // Wilderness is not an interior.
+	constexpr std::optional<bool> rulerIsMale; // Not necessary for wild.
+	constexpr LocationDefinition::DungeonDefinition *dungeonDef = nullptr; // Not necessary for wild.
+	constexpr std::optional<bool> isArtifactDungeon; // Not necessary for wild.
+
+	MapGeneration::readArenaFLOR(tempFlorConstView, mapType, interiorType, rulerIsMale, inf,
+		charClassLibrary, entityDefLibrary, binaryAssetLibrary, textureManager, outLevelDef,
+		outLevelInfoDef, &florMappings, &entityMappings);
+	MapGeneration::readArenaMAP1(tempMap1ConstView, mapType, interiorType, rulerSeed, rulerIsMale,
+		palaceIsMainQuestDungeon, cityType, dungeonDef, isArtifactDungeon, inf, charClassLibrary,
+		entityDefLibrary, binaryAssetLibrary,
+		textureManager, outLevelDef, outLevelInfoDef, &map1Mappings, &entityMappings, &transitionMappings);
+	MapGeneration::readArenaMAP2(tempMap2ConstView, inf, outLevelDef, outLevelInfoDef, &map2Mappings);
+}
+
+void MapGeneration::generateRmdWildChunkBuildingNames(const ChunkInt2 &chunk, const LevelDefinition &levelDef,
+	const LevelInfoDefinition &levelInfoDef, const BinaryAssetLibrary &binaryAssetLibrary,
+	WildChunkBuildingNameInfo *outBuildingNameInfo)
+{
+	const uint32_t chunkSeed = ArenaWildUtils::makeWildChunkSeed(chunk.x, chunk.y); // @todo: verify
+	outBuildingNameInfo->init(chunk);
+	generateArenaWildChunkBuildingNames(chunkSeed, levelDef, levelInfoDef, binaryAssetLibrary,
+		outBuildingNameInfo);
 }
 
 void MapGeneration::readMifLocks(const BufferView<const MIFFile::Level> &levels, const INFFile &inf,
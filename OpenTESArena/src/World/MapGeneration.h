@@ -113,34 +113,47 @@ namespace MapGeneration
 			WEInt blockStartPosX, SNInt blockStartPosY, int cityBlocksPerSide);
 	};
 
-	// Input: 70 .RMD files (from asset library) + 1 weather .INF
-	// Output: 70 LevelDefinitions + 1 LevelInfoDefinition
+	// Input: 70 .RMD files (from asset library) + 1 weather .INF + city .MIF
+	// Output: LevelDefinition + LevelInfoDefinition pairs for the blocks near the player
 	struct WildGenInfo
 	{
 		Buffer2D<ArenaWildUtils::WildBlockID> wildBlockIDs;
+		const LocationDefinition *locationDef; // For revising the city blocks.
 		LocationDefinition::CityDefinition::Type cityType;
 		uint32_t fallbackSeed;
 		uint32_t rulerSeed;
 		bool palaceIsMainQuestDungeon;
 
-		void init(Buffer2D<ArenaWildUtils::WildBlockID> &&wildBlockIDs,
+		void init(Buffer2D<ArenaWildUtils::WildBlockID> &&wildBlockIDs, const LocationDefinition *locationDef,
 			LocationDefinition::CityDefinition::Type cityType, uint32_t fallbackSeed, uint32_t rulerSeed,
 			bool palaceIsMainQuestDungeon);
 	};
 
+	// Voxel layers of the 2x2 wild blocks a city is in. They replace the placeholder WILD00{1..4}.RMD
+	// blocks and are generated once per wilderness so lazily generated city blocks can share them.
+	struct WildCityVoxels
+	{
+		Buffer2D<ArenaTypes::VoxelID> flor, map1, map2;
+
+		void init(const LocationDefinition &locationDef, const BinaryAssetLibrary &binaryAssetLibrary);
+	};
+
 	// Building names in the wild are shared per-chunk.
 	class WildChunkBuildingNameInfo
 	{
 	private:
 		ChunkInt2 chunk;
-		std::unordered_map<ArenaTypes::InteriorType, LevelDefinition::BuildingNameID> ids;
+
+		// Names are stored here instead of in a level info definition so a chunk's names can be
+		// generated and freed without touching the wild block it uses.
+		std::unordered_map<ArenaTypes::InteriorType, std::string> names;
 	public:
 		void init(const ChunkInt2 &chunk);
 
 		const ChunkInt2 &getChunk() const;
 		bool hasBuildingNames() const;
-		bool tryGetBuildingNameID(ArenaTypes::InteriorType interiorType, LevelDefinition::BuildingNameID *outID) const;
-		void setBuildingNameID(ArenaTypes::InteriorType interiorType, LevelDefinition::BuildingNameID id);
+		const std::string *tryGetBuildingName(ArenaTypes::InteriorType interiorType) const;
+		void setBuildingName(ArenaTypes::InteriorType interiorType, std::string &&name);
 	};
 
 	// Data that can be used when creating an actual transition definition.
@@ -188,15 +201,18 @@ namespace MapGeneration
 		const TextAssetLibrary &textAssetLibrary, TextureManager &textureManager,
 		LevelDefinition *outLevelDef, LevelInfoDefinition *outLevelInfoDef);
 
-	// Generates wilderness chunks from a list of unique wild block IDs. Each block ID maps to the
-	// level definition at the same index.
-	void generateRmdWilderness(const BufferView<const ArenaWildUtils::WildBlockID> &uniqueWildBlockIDs,
-		const BufferView2D<const int> &levelDefIndices, uint32_t rulerSeed, bool palaceIsMainQuestDungeon,
-		LocationDefinition::CityDefinition::Type cityType, const INFFile &inf,
+	// Generates one wilderness block from its .RMD file. The wilderness is generated lazily around
+	// the player, so each block gets its own level info definition and can be freed on its own.
+	void generateRmdWilderness(ArenaWildUtils::WildBlockID wildBlockID, const WildCityVoxels &cityVoxels,
+		uint32_t rulerSeed, bool palaceIsMainQuestDungeon, LocationDefinition::CityDefinition::Type cityType, const INFFile &inf,
 		const CharacterClassLibrary &charClassLibrary, const EntityDefinitionLibrary &entityDefLibrary,
 		const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager,
-		BufferView<LevelDefinition> &outLevelDefs, LevelInfoDefinition *outLevelInfoDef,
-		std::vector<MapGeneration::WildChunkBuildingNameInfo> *outBuildingNameInfos);
+		LevelDefinition *outLevelDef, LevelInfoDefinition *outLevelInfoDef);
+
+	// Generates the tavern and temple names for a wild chunk from the block it uses.
+	void generateRmdWildChunkBuildingNames(const ChunkInt2 &chunk, const LevelDefinition &levelDef,
+		const LevelInfoDefinition &levelInfoDef, const BinaryAssetLibrary &binaryAssetLibrary,
+		WildChunkBuildingNameInfo *outBuildingNameInfo);
 
 	void readMifLocks(const BufferView<const MIFFile::Level> &levels, const INFFile &inf,
 		BufferView<LevelDefinition> &outLevelDefs, LevelInfoDefinition *outLevelInfoDef);
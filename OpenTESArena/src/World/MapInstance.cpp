@@ -168,10 +168,14 @@ void MapInstance::setActiveLevelIndex(int levelIndex)
 }
 
 void MapInstance::update(double dt, const ChunkInt2 &centerChunk,
-	const MapDefinition &mapDefinition, double latitude, double daytimePercent, int chunkDistance)
+	const std::shared_ptr<MapDefinition> &mapDefinition,
+	double latitude, double daytimePercent, int chunkDistance, const CharacterClassLibrary &charClassLibrary,
+	const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
+	TextureManager &textureManager)
 {
 	LevelInstance &levelInst = this->getActiveLevel();
-	levelInst.update(dt, centerChunk, this->activeLevelIndex, mapDefinition, chunkDistance);
+	levelInst.update(dt, centerChunk, this->activeLevelIndex, mapDefinition, chunkDistance, charClassLibrary,
+		entityDefLibrary, binaryAssetLibrary, textureManager);
 
 	SkyInstance &skyInst = this->getActiveSky();
 	skyInst.update(dt, latitude, daytimePercent);
@@ -1,6 +1,8 @@
 #ifndef MAP_INSTANCE_H
 #define MAP_INSTANCE_H
 
+#include <memory>
+
 #include "LevelInstance.h"
 #include "SkyInstance.h"
 
@@ -9,6 +11,9 @@
 // Contains instance data for the associated map definition. This is the current state of voxels,
 // entities, and sky for every level instance in the map.
 
+class BinaryAssetLibrary;
+class CharacterClassLibrary;
+class EntityDefinitionLibrary;
 class MapDefinition;
 class TextureManager;
 
@@ -42,8 +47,10 @@ public:
 
 	void setActiveLevelIndex(int levelIndex);
 
-	void update(double dt, const ChunkInt2 &centerChunk, const MapDefinition &mapDefinition,
-		double latitude, double daytimePercent, int chunkDistance);
+	void update(double dt, const ChunkInt2 &centerChunk, const std::shared_ptr<MapDefinition> &mapDefinition,
+		double latitude, double daytimePercent, int chunkDistance, const CharacterClassLibrary &charClassLibrary,
+		const EntityDefinitionLibrary &entityDefLibrary, const BinaryAssetLibrary &binaryAssetLibrary,
+		TextureManager &textureManager);
 };
 
 #endif
@@ -1,26 +1,85 @@
 #include <algorithm>
+#include <atomic>
 
+#include "ChunkUtils.h"
 #include "VoxelGrid.h"
 
 #include "components/debug/Debug.h"
 
+namespace
+{
+	std::atomic<int> NextGridID(0);
+}
+
 VoxelGrid::VoxelGrid(SNInt width, int height, WEInt depth)
 {
-	const int voxelCount = width * height * depth;
-	this->voxels = std::vector<uint16_t>(voxelCount, 0);
+	DebugAssert(height <= INT8_MAX);
+	this->chunkCountX = (width + ChunkUtils::CHUNK_DIM - 1) / ChunkUtils::CHUNK_DIM;
+	this->chunkCountZ = (depth + ChunkUtils::CHUNK_DIM - 1) / ChunkUtils::CHUNK_DIM;
+	this->chunks.resize(this->chunkCountX * this->chunkCountZ);
+	this->chunkRevisions.resize(this->chunkCountX * this->chunkCountZ, 0);
 
 	this->width = width;
 	this->height = height;
 	this->depth = depth;
+	this->id = NextGridID++;
 
 	// Add empty (air) voxel definition by default.
 	this->addVoxelDef(VoxelDefinition());
 }
 
-int VoxelGrid::getIndex(SNInt x, int y, WEInt z) const
+void VoxelGrid::allocateChunk(int chunkIndex)
 {
-	DebugAssert(this->coordIsValid(x, y, z));
-	return x + (y * this->width) + (z * this->width * this->height);
+	ChunkVoxels &chunkVoxels = this->chunks[chunkIndex];
+	DebugAssert(!chunkVoxels.voxels.isValid());
+
+	// Edge chunks are cut off at the grid's dimensions.
+	const SNInt startX = (chunkIndex % this->chunkCountX) * ChunkUtils::CHUNK_DIM;
+	const WEInt startZ = (chunkIndex / this->chunkCountX) * ChunkUtils::CHUNK_DIM;
+	const SNInt chunkWidth = std::min(ChunkUtils::CHUNK_DIM, this->width - startX);
+	const WEInt chunkDepth = std::min(ChunkUtils::CHUNK_DIM, this->depth - startZ);
+
+	chunkVoxels.voxels.init(chunkWidth, this->height, chunkDepth);
+	chunkVoxels.voxels.fill(0);
+	chunkVoxels.columnMinYs.init(chunkWidth, 1, chunkDepth);
+	chunkVoxels.columnMinYs.fill(static_cast<int8_t>(this->height));
+	chunkVoxels.columnMaxYs.init(chunkWidth, 1, chunkDepth);
+	chunkVoxels.columnMaxYs.fill(-1);
+}
+
+void VoxelGrid::updateColumnRange(SNInt x, WEInt z)
+{
+	int minY = this->height;
+	int maxY = -1;
+
+	for (int y = 0; y < this->height; y++)
+	{
+		if (this->getVoxel(x, y, z) != 0)
+		{
+			minY = std::min(minY, y);
+			maxY = y;
+		}
+	}
+
+	ChunkVoxels &chunkVoxels = this->chunks[this->getChunkIndex(x, z)];
+	const SNInt chunkX = x % ChunkUtils::CHUNK_DIM;
+	const WEInt chunkZ = z % ChunkUtils::CHUNK_DIM;
+	chunkVoxels.columnMinYs.set(chunkX, 0, chunkZ, static_cast<int8_t>(minY));
+	chunkVoxels.columnMaxYs.set(chunkX, 0, chunkZ, static_cast<int8_t>(maxY));
+}
+
+int VoxelGrid::getChunkIndex(const ChunkInt2 &chunk) const
+{
+	DebugAssert(chunk.x >= 0);
+	DebugAssert(chunk.y >= 0);
+	DebugAssert(chunk.x < this->chunkCountX);
+	DebugAssert(chunk.y < this->chunkCountZ);
+	return chunk.x + (chunk.y * this->chunkCountX);
+}
+
+int VoxelGrid::getChunkIndex(SNInt x, WEInt z) const
+{
+	return this->getChunkIndex(ChunkInt2(x / ChunkUtils::CHUNK_DIM, z / ChunkUtils::CHUNK_DIM));
 }
 
 SNInt VoxelGrid::getWidth() const
@@ -38,6 +97,21 @@ WEInt VoxelGrid::getDepth() const
 	return this->depth;
 }
 
+int VoxelGrid::getID() const
+{
+	return this->id;
+}
+
+int VoxelGrid::getChunkCountX() const
+{
+	return this->chunkCountX;
+}
+
+int VoxelGrid::getChunkCountZ() const
+{
+	return this->chunkCountZ;
+}
+
 bool VoxelGrid::coordIsValid(SNInt x, int y, WEInt z) const
 {
 	return (x >= 0) && (x < this->width) && (y >= 0) && (y < this->height) &&
@@ -46,19 +120,37 @@ bool VoxelGrid::coordIsValid(SNInt x, int y, WEInt z) const
 
 uint16_t VoxelGrid::getVoxel(SNInt x, int y, WEInt z) const
 {
-	const int index = this->getIndex(x, y, z);
-	return this->voxels.data()[index];
+	DebugAssert(this->coordIsValid(x, y, z));
+	const ChunkVoxels &chunkVoxels = this->chunks[this->getChunkIndex(x, z)];
+	if (!chunkVoxels.voxels.isValid())
+	{
+		return 0;
+	}
+
+	return chunkVoxels.voxels.get(x % ChunkUtils::CHUNK_DIM, y, z % ChunkUtils::CHUNK_DIM);
 }
 
-int VoxelGrid::getVoxelDefCount() const
+bool VoxelGrid::tryGetColumnRange(SNInt x, WEInt z, int *outMinY, int *outMaxY) const
 {
-	return static_cast<int>(this->voxelDefs.size());
+	DebugAssert(this->coordIsValid(x, 0, z));
+	const ChunkVoxels &chunkVoxels = this->chunks[this->getChunkIndex(x, z)];
+	if (!chunkVoxels.voxels.isValid())
+	{
+		*outMinY = this->height;
+		*outMaxY = -1;
+		return false;
+	}
+
+	const SNInt chunkX = x % ChunkUtils::CHUNK_DIM;
+	const WEInt chunkZ = z % ChunkUtils::CHUNK_DIM;
+	*outMinY = chunkVoxels.columnMinYs.get(chunkX, 0, chunkZ);
+	*outMaxY = chunkVoxels.columnMaxYs.get(chunkX, 0, chunkZ);
+	return *outMinY <= *outMaxY;
 }
 
-VoxelDefinition &VoxelGrid::getVoxelDef(uint16_t id)
+int VoxelGrid::getVoxelDefCount() const
 {
-	DebugAssertIndex(this->voxelDefs, id);
-	return this->voxelDefs[id];
+	return static_cast<int>(this->voxelDefs.size());
 }
 
 const VoxelDefinition &VoxelGrid::getVoxelDef(uint16_t id) const
@@ -89,6 +181,86 @@ uint16_t VoxelGrid::addVoxelDef(const VoxelDefinition &voxelDef)
 
 void VoxelGrid::setVoxel(SNInt x, int y, WEInt z, uint16_t id)
 {
-	const int index = this->getIndex(x, y, z);
-	this->voxels.data()[index] = id;
+	DebugAssert(this->coordIsValid(x, y, z));
+	const int chunkIndex = this->getChunkIndex(x, z);
+	this->chunkRevisions[chunkIndex]++;
+
+	ChunkVoxels &chunkVoxels = this->chunks[chunkIndex];
+	if (!chunkVoxels.voxels.isValid())
+	{
+		if (id == 0)
+		{
+			// Already air.
+			return;
+		}
+
+		this->allocateChunk(chunkIndex);
+	}
+
+	const SNInt chunkX = x % ChunkUtils::CHUNK_DIM;
+	const WEInt chunkZ = z % ChunkUtils::CHUNK_DIM;
+	chunkVoxels.voxels.set(chunkX, y, chunkZ, id);
+
+	// Voxel ID 0 is always air. Any other ID is treated as occupied even if its definition is
+	// air, which only makes the column range conservative.
+	const int minY = chunkVoxels.columnMinYs.get(chunkX, 0, chunkZ);
+	const int maxY = chunkVoxels.columnMaxYs.get(chunkX, 0, chunkZ);
+	if (id != 0)
+	{
+		chunkVoxels.columnMinYs.set(chunkX, 0, chunkZ, static_cast<int8_t>(std::min(minY, y)));
+		chunkVoxels.columnMaxYs.set(chunkX, 0, chunkZ, static_cast<int8_t>(std::max(maxY, y)));
+	}
+	else if ((y == minY) || (y == maxY))
+	{
+		this->updateColumnRange(x, z);
+	}
+}
+
+uint32_t VoxelGrid::getChunkRevision(const ChunkInt2 &chunk) const
+{
+	return this->chunkRevisions[this->getChunkIndex(chunk)];
+}
+
+void VoxelGrid::copyChunk(const VoxelGrid &other, const ChunkInt2 &chunk)
+{
+	DebugAssert(other.width == this->width);
+	DebugAssert(other.height == this->height);
+	DebugAssert(other.depth == this->depth);
+
+	const int chunkIndex = this->getChunkIndex(chunk);
+	this->chunks[chunkIndex] = other.chunks[chunkIndex];
+	this->chunkRevisions[chunkIndex] = other.chunkRevisions[chunkIndex];
+}
+
+void VoxelGrid::clearChunk(const ChunkInt2 &chunk)
+{
+	// Assigning empty buffers gives their memory back, unlike clearing them.
+	const int chunkIndex = this->getChunkIndex(chunk);
+	this->chunks[chunkIndex] = ChunkVoxels();
+	this->chunkRevisions[chunkIndex]++;
+}
+
+void VoxelGrid::compact()
+{
+	for (ChunkVoxels &chunkVoxels : this->chunks)
+	{
+		if (chunkVoxels.voxels.isValid())
+		{
+			chunkVoxels.voxels.compact();
+			chunkVoxels.columnMinYs.compact();
+			chunkVoxels.columnMaxYs.compact();
+		}
+	}
+}
+
+size_t VoxelGrid::getVoxelByteCount() const
+{
+	size_t byteCount = this->chunks.capacity() * sizeof(ChunkVoxels);
+	for (const ChunkVoxels &chunkVoxels : this->chunks)
+	{
+		byteCount += chunkVoxels.voxels.getByteCount() + chunkVoxels.columnMinYs.getByteCount() +
+			chunkVoxels.columnMaxYs.getByteCount();
+	}
+
+	return byteCount;
 }
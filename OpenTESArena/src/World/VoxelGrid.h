@@ -10,6 +10,8 @@
 #include "VoxelUtils.h"
 #include "../Math/Vector2.h"
 
+#include "components/utilities/CompressedBuffer3D.h"
+
 // A voxel grid is a 3D array of voxel IDs with their associated voxel definitions.
 
 // In very complex scenes with several different kinds of voxels (including chasms, etc.),
@@ -21,14 +23,40 @@ class VoxelGrid
 public:
 	using VoxelDefPredicate = std::function<bool(const VoxelDefinition&)>;
 private:
-	std::vector<uint16_t> voxels;
+	// Voxels of one chunk. Most of a city or the wilderness is air above the main floor, so uniform
+	// patches of voxels are compressed. A chunk without storage is all air, so only chunks that have
+	// been written to use memory (i.e., the wild blocks near the player).
+	struct ChunkVoxels
+	{
+		CompressedBuffer3D<uint16_t> voxels;
+
+		// Lowest and highest non-air voxel Y of each XZ column (one layer tall), so renderers can skip
+		// empty space. An all-air column has a min greater than its max.
+		CompressedBuffer3D<int8_t> columnMinYs, columnMaxYs;
+	};
+
+	std::vector<ChunkVoxels> chunks;
 	std::vector<VoxelDefinition> voxelDefs;
+
+	// Incremented whenever a voxel in the chunk is set, so a copy of the grid can tell which chunks
+	// it needs to update.
+	std::vector<uint32_t> chunkRevisions;
+	int chunkCountX, chunkCountZ;
+
 	SNInt width;
 	int height;
 	WEInt depth;
 
-	// Converts XYZ coordinate to index.
-	int getIndex(SNInt x, int y, WEInt z) const;
+	int id; // Unique to each constructed grid. Copies share the ID of the grid they came from.
+
+	int getChunkIndex(const ChunkInt2 &chunk) const;
+	int getChunkIndex(SNInt x, WEInt z) const;
+
+	// Gives an all-air chunk its storage so voxels can be set in it.
+	void allocateChunk(int chunkIndex);
+
+	// Recalculates the non-air range of a voxel column from scratch.
+	void updateColumnRange(SNInt x, WEInt z);
 public:
 	VoxelGrid(SNInt width, int height, WEInt depth);
 
@@ -37,16 +65,26 @@ public:
 	int getHeight() const;
 	WEInt getDepth() const;
 
+	int getID() const;
+
+	// Number of chunks covering the grid. Edge chunks can be partially outside of it.
+	int getChunkCountX() const;
+	int getChunkCountZ() const;
+
 	// Returns whether the given coordinate lies within the voxel grid.
 	bool coordIsValid(SNInt x, int y, WEInt z) const;
 
 	// Convenience method for getting a voxel's ID.
 	uint16_t getVoxel(SNInt x, int y, WEInt z) const;
 
+	// Gets the lowest and highest Y of non-air voxels in the given XZ column. Returns false if
+	// the column is entirely air.
+	bool tryGetColumnRange(SNInt x, WEInt z, int *outMinY, int *outMaxY) const;
+
 	int getVoxelDefCount() const;
 
-	// Gets the voxel definitions associated with an ID.
-	VoxelDefinition &getVoxelDef(uint16_t id);
+	// Gets the voxel definition associated with an ID. There's no mutable access since changing a
+	// definition would change every chunk using it without bumping their revisions.
 	const VoxelDefinition &getVoxelDef(uint16_t id) const;
 	
 	// Finds a voxel definition ID that matches the predicate, or none if not found.
@@ -57,6 +95,21 @@ public:
 
 	// Convenience method for setting a voxel's ID.
 	void setVoxel(SNInt x, int y, WEInt z, uint16_t id);
+
+	uint32_t getChunkRevision(const ChunkInt2 &chunk) const;
+
+	// Copies one chunk's voxels and revision from a grid of the same dimensions. Voxel definitions
+	// aren't copied.
+	void copyChunk(const VoxelGrid &other, const ChunkInt2 &chunk);
+
+	// Sets every voxel in the chunk to air and frees its storage.
+	void clearChunk(const ChunkInt2 &chunk);
+
+	// Compresses voxels that became uniform after a batch of changes. Called once a level is generated.
+	void compact();
+
+	// Bytes used by voxel IDs and column ranges of every chunk.
+	size_t getVoxelByteCount() const;
 };
 
 #endif
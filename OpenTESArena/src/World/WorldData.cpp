@@ -157,15 +157,15 @@ WorldData WorldData::loadCity(const LocationDefinition &locationDef, const Provi
 }
 
 WorldData WorldData::loadWilderness(const LocationDefinition &locationDef, const ProvinceDefinition &provinceDef,
-	WeatherType weatherType, int currentDay, int starCount, const BinaryAssetLibrary &binaryAssetLibrary,
-	TextureManager &textureManager)
+	WeatherType weatherType, int currentDay, int starCount, const ChunkInt2 &startChunk, int chunkDistance,
+	const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager)
 {
 	const LocationDefinition::CityDefinition &cityDef = locationDef.getCityDefinition();
 	const std::string infName = ArenaWildUtils::generateInfName(cityDef.climateType, weatherType);
 
 	// Load wilderness data (no starting points to load).
 	LevelData levelData = LevelData::loadWilderness(locationDef, provinceDef, weatherType, currentDay,
-		starCount, infName, binaryAssetLibrary, textureManager);
+		starCount, infName, startChunk, chunkDistance, binaryAssetLibrary, textureManager);
 
 	// Generate world data from the wilderness data.
 	WorldData worldData(MapType::Wilderness, 0);
@@ -51,10 +51,10 @@ public:
 		const BinaryAssetLibrary &binaryAssetLibrary, const TextAssetLibrary &textAssetLibrary,
 		TextureManager &textureManager);
 
-	// Loads wilderness for a given city on the world map.
+	// Loads wilderness for a given city on the world map, with the blocks around the start chunk.
 	static WorldData loadWilderness(const LocationDefinition &locationDef, const ProvinceDefinition &provinceDef,
-		WeatherType weatherType, int currentDay, int starCount, const BinaryAssetLibrary &binaryAssetLibrary,
-		TextureManager &textureManager);
+		WeatherType weatherType, int currentDay, int starCount, const ChunkInt2 &startChunk, int chunkDistance,
+		const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager);
 
 	MapType getMapType() const;
 	int getActiveLevelIndex() const;
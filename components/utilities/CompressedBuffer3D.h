@@ -0,0 +1,228 @@
+#ifndef COMPRESSED_BUFFER3D_H
+#define COMPRESSED_BUFFER3D_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "../debug/Debug.h"
+
+// 3D array split into small XZ tiles one layer tall. A tile where every element is the same value
+// (i.e., a patch of air above the ground floor) only stores that value, and the rest store their
+// elements in a dense tile pool. Reads are O(1) either way.
+
+// Setting a different value in a uniform tile gives it a dense tile, and compact() turns dense tiles
+// that became uniform back, so it should be called once a batch of writes is done.
+
+template <typename T>
+class CompressedBuffer3D
+{
+private:
+	static constexpr int TILE_DIM_BITS = 3;
+	static constexpr int TILE_DIM = 1 << TILE_DIM_BITS;
+	static constexpr int TILE_MASK = TILE_DIM - 1;
+	static constexpr int TILE_SIZE = TILE_DIM * TILE_DIM;
+
+	struct Tile
+	{
+		T value; // Every element's value if uniform.
+		int denseIndex; // Index into the dense tile pool, or negative if uniform.
+	};
+
+	std::vector<Tile> tiles;
+	std::vector<T> denseValues; // TILE_SIZE elements per dense tile.
+	std::vector<int> denseTileOwners; // Index of the tile using each dense tile.
+	int width, height, depth;
+	int tileCountX, tileCountZ;
+
+	int getTileIndex(int x, int y, int z) const
+	{
+		DebugAssert(x >= 0);
+		DebugAssert(y >= 0);
+		DebugAssert(z >= 0);
+		DebugAssert(x < this->width);
+		DebugAssert(y < this->height);
+		DebugAssert(z < this->depth);
+		return (x >> TILE_DIM_BITS) + ((z >> TILE_DIM_BITS) * this->tileCountX) +
+			(y * this->tileCountX * this->tileCountZ);
+	}
+
+	static int getTileElementIndex(int x, int z)
+	{
+		return (x & TILE_MASK) + ((z & TILE_MASK) << TILE_DIM_BITS);
+	}
+
+	int allocateDenseTile(int tileIndex, const T &value)
+	{
+		// Dense tiles are only given back by compact() and fill(), which rebuild the pool.
+		const int denseIndex = static_cast<int>(this->denseTileOwners.size());
+		this->denseValues.resize(this->denseValues.size() + TILE_SIZE);
+		this->denseTileOwners.emplace_back(tileIndex);
+
+		T *denseBegin = this->denseValues.data() + (denseIndex * TILE_SIZE);
+		std::fill(denseBegin, denseBegin + TILE_SIZE, value);
+		return denseIndex;
+	}
+public:
+	CompressedBuffer3D()
+	{
+		this->width = 0;
+		this->height = 0;
+		this->depth = 0;
+		this->tileCountX = 0;
+		this->tileCountZ = 0;
+	}
+
+	CompressedBuffer3D(int width, int height, int depth)
+	{
+		this->init(width, height, depth);
+	}
+
+	// Every element starts as a default T. Existing storage is reused, so re-initializing a buffer
+	// that was cleared doesn't reallocate unless it grows.
+	void init(int width, int height, int depth)
+	{
+		DebugAssert(width >= 0);
+		DebugAssert(height >= 0);
+		DebugAssert(depth >= 0);
+		this->width = width;
+		this->height = height;
+		this->depth = depth;
+		this->tileCountX = (width + TILE_MASK) >> TILE_DIM_BITS;
+		this->tileCountZ = (depth + TILE_MASK) >> TILE_DIM_BITS;
+		this->tiles.assign(this->tileCountX * height * this->tileCountZ, Tile { T(), -1 });
+		this->denseValues.clear();
+		this->denseTileOwners.clear();
+	}
+
+	bool isValid() const
+	{
+		return this->tiles.size() > 0;
+	}
+
+	T get(int x, int y, int z) const
+	{
+		const Tile &tile = this->tiles[this->getTileIndex(x, y, z)];
+		if (tile.denseIndex < 0)
+		{
+			return tile.value;
+		}
+
+		return this->denseValues[(tile.denseIndex * TILE_SIZE) + CompressedBuffer3D::getTileElementIndex(x, z)];
+	}
+
+	int getWidth() const
+	{
+		return this->width;
+	}
+
+	int getHeight() const
+	{
+		return this->height;
+	}
+
+	int getDepth() const
+	{
+		return this->depth;
+	}
+
+	// Number of tiles storing each of their elements.
+	int getDenseTileCount() const
+	{
+		return static_cast<int>(this->denseTileOwners.size());
+	}
+
+	// Bytes used by the buffer's elements and bookkeeping.
+	size_t getByteCount() const
+	{
+		return (this->tiles.capacity() * sizeof(Tile)) + (this->denseValues.capacity() * sizeof(T)) +
+			(this->denseTileOwners.capacity() * sizeof(int));
+	}
+
+	void set(int x, int y, int z, const T &value)
+	{
+		const int tileIndex = this->getTileIndex(x, y, z);
+		Tile &tile = this->tiles[tileIndex];
+		if (tile.denseIndex < 0)
+		{
+			if (tile.value == value)
+			{
+				return;
+			}
+
+			tile.denseIndex = this->allocateDenseTile(tileIndex, tile.value);
+		}
+
+		this->denseValues[(tile.denseIndex * TILE_SIZE) + CompressedBuffer3D::getTileElementIndex(x, z)] = value;
+	}
+
+	void fill(const T &value)
+	{
+		DebugAssert(this->isValid());
+		for (Tile &tile : this->tiles)
+		{
+			tile.value = value;
+			tile.denseIndex = -1;
+		}
+
+		this->denseValues.clear();
+		this->denseTileOwners.clear();
+	}
+
+	// Turns dense tiles whose elements all match back into uniform ones and packs the dense tile pool.
+	// Elements of edge tiles past the buffer's dimensions keep the value the tile had when it became
+	// dense, so an edge tile might stay dense. The pool is packed in place in pool order, so a dense
+	// tile is never moved over one that hasn't been visited yet.
+	void compact()
+	{
+		int newDenseTileCount = 0;
+		for (int denseIndex = 0; denseIndex < static_cast<int>(this->denseTileOwners.size()); denseIndex++)
+		{
+			const int tileIndex = this->denseTileOwners[denseIndex];
+			Tile &tile = this->tiles[tileIndex];
+			DebugAssert(tile.denseIndex == denseIndex);
+
+			const T *denseBegin = this->denseValues.data() + (denseIndex * TILE_SIZE);
+			const T *denseEnd = denseBegin + TILE_SIZE;
+			const T firstValue = *denseBegin;
+			const bool isUniform = std::all_of(denseBegin, denseEnd,
+				[&firstValue](const T &value) { return value == firstValue; });
+
+			if (isUniform)
+			{
+				tile.value = firstValue;
+				tile.denseIndex = -1;
+			}
+			else
+			{
+				if (newDenseTileCount != denseIndex)
+				{
+					T *newDenseBegin = this->denseValues.data() + (newDenseTileCount * TILE_SIZE);
+					std::copy(denseBegin, denseEnd, newDenseBegin);
+				}
+
+				tile.denseIndex = newDenseTileCount;
+				this->denseTileOwners[newDenseTileCount] = tileIndex;
+				newDenseTileCount++;
+			}
+		}
+
+		this->denseValues.resize(newDenseTileCount * TILE_SIZE);
+		this->denseTileOwners.resize(newDenseTileCount);
+	}
+
+	// Keeps allocated storage so a pooled buffer can be initialized again without reallocating.
+	void clear()
+	{
+		this->tiles.clear();
+		this->denseValues.clear();
+		this->denseTileOwners.clear();
+		this->width = 0;
+		this->height = 0;
+		this->depth = 0;
+		this->tileCountX = 0;
+		this->tileCountZ = 0;
+	}
+};
+
+#endif